@@ -0,0 +1,503 @@
+/**
+ * \file event_list_hold_model.cpp
+ *
+ * \brief Micro-benchmark of the future event list.
+ *
+ * Measures the cost of the event-list operations for the access patterns
+ * generated by \c engine::schedule_event and \c engine::reschedule_event:
+ * - hold: the classic hold model (extract the next event and insert it again
+ *   with an incremented fire time) on a list of constant size;
+ * - updown: fill an empty list with N events and then empty it;
+ * - reschedule: a hold operation followed by the rescheduling (i.e., erase and
+ *   re-insertion) of a random pending event.
+ * Time increments are drawn from exponential, bimodal, triangular and camel
+ * (two-humped) distributions, all with unit mean.
+ *
+ * For every pattern, distribution and list size (from --min-size to
+ * --max-size, by factors of 10), the benchmark prints the mean time per
+ * operation (in nanoseconds) and, where hardware counters are available
+ * (Linux perf events), the number of cache misses per operation.
+ * Rows of the same pattern and distribution form the scaling curve.
+ *
+ * Usage: event_list_hold_model [--min-size N] [--max-size N] [--ops N]
+ *                              [--pattern hold|updown|reschedule|all]
+ *                              [--distr exp|bimodal|triangular|camel|all]
+ *                              [--seed N]
+ *
+ * Note: the default event list keeps events in an ordered list, whose
+ * insertion cost is linear in the list size; hence the default maximum size
+ * is 10^4. Larger sizes (up to 10^7) are meant for sub-linear event lists.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <boost/cstdint.hpp>
+#include <boost/random/uniform_01.hpp>
+#include <boost/smart_ptr.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dcs/des/event.hpp>
+#include <dcs/des/event_list.hpp>
+#include <dcs/des/event_source.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif // __linux__
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t size_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::event<real_type> event_type;
+typedef boost::shared_ptr<event_type> event_pointer;
+typedef dcs::des::event_source<real_type> event_source_type;
+typedef dcs::des::event_list<event_type> event_list_type;
+
+
+enum access_pattern
+{
+	hold_pattern,
+	up_down_pattern,
+	reschedule_pattern
+};
+
+
+enum increment_distribution
+{
+	exponential_increment,
+	bimodal_increment,
+	triangular_increment,
+	camel_increment
+};
+
+
+const access_pattern patterns[] = {hold_pattern, up_down_pattern, reschedule_pattern};
+const increment_distribution distributions[] = {exponential_increment, bimodal_increment, triangular_increment, camel_increment};
+
+
+const char* pattern_name(access_pattern p)
+{
+	switch (p)
+	{
+		case hold_pattern:
+			return "hold";
+		case up_down_pattern:
+			return "updown";
+		case reschedule_pattern:
+			return "reschedule";
+	}
+	return "unknown";
+}
+
+
+const char* distribution_name(increment_distribution d)
+{
+	switch (d)
+	{
+		case exponential_increment:
+			return "exp";
+		case bimodal_increment:
+			return "bimodal";
+		case triangular_increment:
+			return "triangular";
+		case camel_increment:
+			return "camel";
+	}
+	return "unknown";
+}
+
+
+/// Draw a (unit mean) time increment from the given distribution.
+real_type increment(increment_distribution d, random_generator_type& rng)
+{
+	boost::uniform_01<real_type> u01;
+
+	switch (d)
+	{
+		case exponential_increment:
+			return -std::log(real_type(1)-u01(rng));
+		case bimodal_increment:
+			// Mostly short increments, with few long ones:
+			//  U(0,0.2) w.p. 0.9, U(9,9.2) w.p. 0.1
+			if (u01(rng) < real_type(0.9))
+			{
+				return real_type(0.2)*u01(rng);
+			}
+			return real_type(9)+real_type(0.2)*u01(rng);
+		case triangular_increment:
+			// Density increasing linearly on [0,1.5]
+			return real_type(1.5)*std::sqrt(u01(rng));
+		case camel_increment:
+			{
+				// Two triangular humps of half-width 0.25 centered at 0.5
+				// and 1.5
+				real_type c(u01(rng) < real_type(0.5) ? real_type(0.5) : real_type(1.5));
+				return c+real_type(0.25)*(u01(rng)-u01(rng));
+			}
+	}
+	return 0;
+}
+
+
+/// Wall-clock timer with nanosecond resolution (where available).
+class timer
+{
+	public: timer()
+	: start_(now())
+	{
+	}
+
+
+	public: void start()
+	{
+		start_ = now();
+	}
+
+
+	/// Return the time elapsed since the last start (in nanoseconds).
+	public: real_type elapsed() const
+	{
+		return now()-start_;
+	}
+
+
+	private: static real_type now()
+	{
+#if defined(CLOCK_MONOTONIC)
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return real_type(ts.tv_sec)*real_type(1e9)+real_type(ts.tv_nsec);
+#else
+		return real_type(std::clock())*real_type(1e9)/real_type(CLOCKS_PER_SEC);
+#endif // CLOCK_MONOTONIC
+	}
+
+
+	private: real_type start_;
+};
+
+
+/// Counter of the cache misses of the calling thread (Linux perf events).
+class cache_miss_counter
+{
+	public: cache_miss_counter()
+	: fd_(-1)
+	{
+#if defined(__linux__)
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif // __linux__
+	}
+
+
+	public: ~cache_miss_counter()
+	{
+#if defined(__linux__)
+		if (fd_ >= 0)
+		{
+			close(fd_);
+		}
+#endif // __linux__
+	}
+
+
+	public: bool available() const
+	{
+		return fd_ >= 0;
+	}
+
+
+	public: void start()
+	{
+#if defined(__linux__)
+		if (fd_ >= 0)
+		{
+			ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif // __linux__
+	}
+
+
+	public: boost::uint64_t stop()
+	{
+		boost::uint64_t count(0);
+#if defined(__linux__)
+		if (fd_ >= 0)
+		{
+			ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(fd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+			{
+				count = 0;
+			}
+		}
+#endif // __linux__
+		return count;
+	}
+
+
+	private: cache_miss_counter(cache_miss_counter const&);
+	private: cache_miss_counter& operator=(cache_miss_counter const&);
+
+
+	private: int fd_;
+};
+
+
+struct measure
+{
+	real_type ns_per_op;
+	real_type misses_per_op;
+};
+
+
+/// Fill the event list with \a n events scheduled at \a now plus a random
+/// increment.
+void fill(event_list_type& evt_list, std::vector<event_pointer>& evts, size_type n, real_type now, increment_distribution d, random_generator_type& rng)
+{
+	for (size_type i = 0; i < n; ++i)
+	{
+		evts[i]->fire_time(now+increment(d, rng));
+		evt_list.push(evts[i]);
+	}
+}
+
+
+/// Hold operation: extract the next event and insert it again.
+inline
+real_type hold(event_list_type& evt_list, increment_distribution d, random_generator_type& rng)
+{
+	event_pointer ptr_evt(evt_list.top());
+	evt_list.pop();
+	real_type now(ptr_evt->fire_time());
+	ptr_evt->fire_time(now+increment(d, rng));
+	evt_list.push(ptr_evt);
+	return now;
+}
+
+
+measure run(access_pattern p, increment_distribution d, size_type n, size_type num_ops, random_generator_type& rng, cache_miss_counter& misses)
+{
+	boost::shared_ptr<event_source_type> ptr_src(new event_source_type("Benchmark"));
+	std::vector<event_pointer> evts(n);
+	for (size_type i = 0; i < n; ++i)
+	{
+		evts[i] = boost::make_shared<event_type>(ptr_src);
+	}
+
+	event_list_type evt_list;
+	boost::uniform_01<real_type> u01;
+	timer t;
+	size_type ops(0);
+	boost::uint64_t nmisses(0);
+
+	switch (p)
+	{
+		case hold_pattern:
+			{
+				fill(evt_list, evts, n, 0, d, rng);
+				// Warm-up, to reach the steady-state distribution of fire times
+				for (size_type i = 0; i < n && i < num_ops; ++i)
+				{
+					hold(evt_list, d, rng);
+				}
+				misses.start();
+				t.start();
+				for (; ops < num_ops; ++ops)
+				{
+					hold(evt_list, d, rng);
+				}
+			}
+			break;
+		case up_down_pattern:
+			{
+				real_type now(0);
+				misses.start();
+				t.start();
+				while (ops < num_ops)
+				{
+					fill(evt_list, evts, n, now, d, rng);
+					while (!evt_list.empty())
+					{
+						now = evt_list.top()->fire_time();
+						evt_list.pop();
+					}
+					ops += 2*n;
+				}
+			}
+			break;
+		case reschedule_pattern:
+			{
+				fill(evt_list, evts, n, 0, d, rng);
+				misses.start();
+				t.start();
+				while (ops < num_ops)
+				{
+					real_type now(hold(evt_list, d, rng));
+					event_pointer ptr_evt(evts[static_cast<size_type>(u01(rng)*n) % n]);
+					evt_list.erase(ptr_evt);
+					ptr_evt->fire_time(now+increment(d, rng));
+					evt_list.push(ptr_evt);
+					ops += 2;
+				}
+			}
+			break;
+	}
+
+	real_type elapsed(t.elapsed());
+	nmisses = misses.stop();
+
+	measure m;
+	m.ns_per_op = elapsed/real_type(ops);
+	m.misses_per_op = real_type(nmisses)/real_type(ops);
+
+	return m;
+}
+
+
+size_type parse_size(char const* s)
+{
+	return static_cast<size_type>(std::strtod(s, 0));
+}
+
+} // Namespace <unnamed>
+
+
+int main(int argc, char* argv[])
+{
+	size_type min_size(10);
+	size_type max_size(10000);
+	size_type num_ops(10000);
+	std::string pattern("all");
+	std::string distr("all");
+	unsigned long seed(5489UL);
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string opt(argv[i]);
+
+		if (i+1 == argc)
+		{
+			std::cerr << "Missing value for option '" << opt << "'." << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if (opt == "--min-size")
+		{
+			min_size = parse_size(argv[++i]);
+		}
+		else if (opt == "--max-size")
+		{
+			max_size = parse_size(argv[++i]);
+		}
+		else if (opt == "--ops")
+		{
+			num_ops = parse_size(argv[++i]);
+		}
+		else if (opt == "--pattern")
+		{
+			pattern = argv[++i];
+		}
+		else if (opt == "--distr")
+		{
+			distr = argv[++i];
+		}
+		else if (opt == "--seed")
+		{
+			seed = std::strtoul(argv[++i], 0, 10);
+		}
+		else
+		{
+			std::cerr << "Unknown option '" << opt << "'." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (min_size < 1 || max_size < min_size || num_ops < 1)
+	{
+		std::cerr << "Invalid sizes or number of operations." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	random_generator_type rng(seed);
+	cache_miss_counter misses;
+
+	std::cout << "# pattern distribution size ns/op cache-misses/op" << std::endl;
+	if (!misses.available())
+	{
+		std::cout << "# (hardware cache-miss counters not available)" << std::endl;
+	}
+
+	for (size_type i = 0; i < sizeof(patterns)/sizeof(patterns[0]); ++i)
+	{
+		if (pattern != "all" && pattern != pattern_name(patterns[i]))
+		{
+			continue;
+		}
+
+		for (size_type j = 0; j < sizeof(distributions)/sizeof(distributions[0]); ++j)
+		{
+			if (distr != "all" && distr != distribution_name(distributions[j]))
+			{
+				continue;
+			}
+
+			for (size_type n = min_size; n <= max_size; n *= 10)
+			{
+				measure m(run(patterns[i], distributions[j], n, num_ops, rng, misses));
+
+				std::cout << std::setw(10) << std::left << pattern_name(patterns[i])
+						  << " " << std::setw(10) << std::left << distribution_name(distributions[j])
+						  << " " << std::setw(10) << std::right << n
+						  << " " << std::setw(12) << std::right << std::fixed << std::setprecision(1) << m.ns_per_op;
+				if (misses.available())
+				{
+					std::cout << " " << std::setw(10) << std::right << std::setprecision(3) << m.misses_per_op;
+				}
+				else
+				{
+					std::cout << " " << std::setw(10) << std::right << "n/a";
+				}
+				std::cout << std::endl;
+			}
+		}
+	}
+}
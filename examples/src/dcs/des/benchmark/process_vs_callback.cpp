@@ -0,0 +1,419 @@
+/**
+ * \file process_vs_callback.cpp
+ *
+ * \brief Benchmark of process-style models against callback-style models.
+ *
+ * Simulates the same M/M/c queue in two ways:
+ * - callback: arrivals and departures are events of two event sources, whose
+ *   handlers are bound with \c dcs::functional::bind and carry the arrival
+ *   time of the customer in the event state (i.e., the style of the
+ *   \c simple_simulator and \c bank examples);
+ * - process: customers are processes (see \c dcs::des::process) acquiring a
+ *   \c dcs::des::process_resource, holding it for their service time and
+ *   releasing it, and are spawned by an arrival-generator process.
+ * Both models draw interarrival and service times from the same random number
+ * stream in the same order, and thus compute the same mean response time.
+ *
+ * For each model, the benchmark prints the number of served customers, the
+ * mean response time and the mean wall-clock time per served customer (in
+ * nanoseconds).
+ *
+ * Usage: process_vs_callback [--lambda X] [--mu X] [--servers N]
+ *                            [--length X] [--seed N]
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <boost/random/uniform_01.hpp>
+#include <boost/smart_ptr.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <dcs/des/engine_context.hpp>
+#include <dcs/des/process.hpp>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/functional/bind.hpp>
+#include <dcs/macro.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t size_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::replications::engine<real_type,size_type> engine_type;
+typedef boost::shared_ptr<engine_type> engine_pointer;
+typedef engine_type::event_type event_type;
+typedef engine_type::event_source_type event_source_type;
+typedef boost::shared_ptr<event_source_type> event_source_pointer;
+typedef engine_type::engine_context_type engine_context_type;
+
+
+/// Draw an exponential variate with the given rate.
+real_type exponential(real_type rate, random_generator_type& rng)
+{
+	boost::uniform_01<real_type> u01;
+
+	return -std::log(real_type(1)-u01(rng))/rate;
+}
+
+
+/// Wall-clock timer with nanosecond resolution (where available).
+class timer
+{
+	public: timer()
+	: start_(now())
+	{
+	}
+
+
+	public: void start()
+	{
+		start_ = now();
+	}
+
+
+	/// Return the time elapsed since the last start (in nanoseconds).
+	public: real_type elapsed() const
+	{
+		return now()-start_;
+	}
+
+
+	private: static real_type now()
+	{
+#if defined(CLOCK_MONOTONIC)
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return real_type(ts.tv_sec)*real_type(1e9)+real_type(ts.tv_nsec);
+#else
+		return real_type(std::clock())*real_type(1e9)/real_type(CLOCKS_PER_SEC);
+#endif // CLOCK_MONOTONIC
+	}
+
+
+	private: real_type start_;
+};
+
+
+/// Parameters and results shared by both models.
+struct model_data
+{
+	model_data(real_type lambda_, real_type mu_, size_type num_servers_, unsigned long seed_)
+	: lambda(lambda_),
+	  mu(mu_),
+	  num_servers(num_servers_),
+	  seed(seed_),
+	  num_served(0),
+	  sum_response_time(0)
+	{
+	}
+
+	real_type lambda;
+	real_type mu;
+	size_type num_servers;
+	unsigned long seed;
+	random_generator_type rng;
+	size_type num_served;
+	real_type sum_response_time;
+};
+
+
+/// M/M/c queue written as event callbacks.
+class callback_model
+{
+	public: callback_model(model_data& data, engine_pointer const& ptr_eng)
+	: data_(data),
+	  ptr_eng_(ptr_eng),
+	  ptr_arr_src_(new event_source_type("Arrival")),
+	  ptr_dep_src_(new event_source_type("Departure")),
+	  num_busy_(0)
+	{
+		ptr_arr_src_->connect(
+			dcs::functional::bind(
+				&callback_model::process_arrival,
+				this,
+				dcs::functional::placeholders::_1,
+				dcs::functional::placeholders::_2
+			)
+		);
+		ptr_dep_src_->connect(
+			dcs::functional::bind(
+				&callback_model::process_departure,
+				this,
+				dcs::functional::placeholders::_1,
+				dcs::functional::placeholders::_2
+			)
+		);
+		ptr_eng_->begin_of_replication_event_source().connect(
+			dcs::functional::bind(
+				&callback_model::process_begin_of_replication,
+				this,
+				dcs::functional::placeholders::_1,
+				dcs::functional::placeholders::_2
+			)
+		);
+	}
+
+
+	private: void process_begin_of_replication(event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+
+		num_busy_ = 0;
+		waiting_.clear();
+		ctx.schedule_event(ptr_arr_src_, ctx.simulated_time()+exponential(data_.lambda, data_.rng));
+	}
+
+
+	private: void process_arrival(event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+
+		real_type now(ctx.simulated_time());
+
+		if (num_busy_ < data_.num_servers)
+		{
+			++num_busy_;
+			ctx.schedule_event(ptr_dep_src_, now+exponential(data_.mu, data_.rng), now);
+		}
+		else
+		{
+			waiting_.push_back(now);
+		}
+
+		ctx.schedule_event(ptr_arr_src_, now+exponential(data_.lambda, data_.rng));
+	}
+
+
+	private: void process_departure(event_type const& evt, engine_context_type& ctx)
+	{
+		real_type now(ctx.simulated_time());
+
+		++data_.num_served;
+		data_.sum_response_time += now-evt.unfolded_state<real_type>();
+
+		if (!waiting_.empty())
+		{
+			real_type arr_time(waiting_.front());
+			waiting_.pop_front();
+			ctx.schedule_event(ptr_dep_src_, now+exponential(data_.mu, data_.rng), arr_time);
+		}
+		else
+		{
+			--num_busy_;
+		}
+	}
+
+
+	private: model_data& data_;
+	private: engine_pointer ptr_eng_;
+	private: event_source_pointer ptr_arr_src_;
+	private: event_source_pointer ptr_dep_src_;
+	private: size_type num_busy_;
+	private: std::deque<real_type> waiting_;
+};
+
+
+/// A customer of the process-style M/M/c queue.
+class customer: public dcs::des::process<real_type>
+{
+	public: customer(model_data& data, resource_type& server)
+	: ptr_data_(&data),
+	  ptr_server_(&server),
+	  arr_time_(0)
+	{
+	}
+
+
+	private: void do_run(engine_context_type& ctx)
+	{
+		DCS_DES_PROCESS_BEGIN;
+			arr_time_ = ctx.simulated_time();
+			DCS_DES_PROCESS_ACQUIRE( *ptr_server_ );
+			DCS_DES_PROCESS_HOLD( exponential(ptr_data_->mu, ptr_data_->rng) );
+			DCS_DES_PROCESS_RELEASE( *ptr_server_ );
+			++ptr_data_->num_served;
+			ptr_data_->sum_response_time += ctx.simulated_time()-arr_time_;
+		DCS_DES_PROCESS_END;
+	}
+
+
+	private: model_data* ptr_data_;
+	private: resource_type* ptr_server_;
+	private: real_type arr_time_;
+};
+
+
+/// The arrival generator of the process-style M/M/c queue.
+class generator: public dcs::des::process<real_type>
+{
+	public: generator(model_data& data, resource_type& server)
+	: ptr_data_(&data),
+	  ptr_server_(&server)
+	{
+	}
+
+
+	private: void do_run(engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+
+		DCS_DES_PROCESS_BEGIN;
+			for (;;)
+			{
+				DCS_DES_PROCESS_HOLD( exponential(ptr_data_->lambda, ptr_data_->rng) );
+				this->scheduler().spawn(customer(*ptr_data_, *ptr_server_));
+			}
+		DCS_DES_PROCESS_END;
+	}
+
+
+	private: model_data* ptr_data_;
+	private: resource_type* ptr_server_;
+};
+
+
+/// M/M/c queue written as processes.
+class process_model
+{
+	public: process_model(model_data& data, engine_pointer const& ptr_eng)
+	: data_(data),
+	  ptr_eng_(ptr_eng),
+	  sched_(ptr_eng),
+	  server_(data.num_servers)
+	{
+		ptr_eng_->begin_of_replication_event_source().connect(
+			dcs::functional::bind(
+				&process_model::process_begin_of_replication,
+				this,
+				dcs::functional::placeholders::_1,
+				dcs::functional::placeholders::_2
+			)
+		);
+	}
+
+
+	private: void process_begin_of_replication(event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+
+		sched_.clear();
+		server_.reset();
+		sched_.spawn(generator(data_, server_));
+	}
+
+
+	private: model_data& data_;
+	private: engine_pointer ptr_eng_;
+	private: dcs::des::process_scheduler<real_type> sched_;
+	private: dcs::des::process_resource<real_type> server_;
+};
+
+
+template <typename ModelT>
+void run(char const* name, real_type lambda, real_type mu, size_type num_servers, real_type length, unsigned long seed)
+{
+	model_data data(lambda, mu, num_servers, seed);
+	data.rng.seed(seed);
+
+	engine_pointer ptr_eng(new engine_type(length, 1));
+	ModelT model(data, ptr_eng);
+
+	timer t;
+	ptr_eng->run();
+	real_type ns(t.elapsed());
+
+	std::cout << name
+			  << " " << data.num_served
+			  << " " << (data.num_served > 0 ? data.sum_response_time/data.num_served : real_type(0))
+			  << " " << std::setprecision(4) << (data.num_served > 0 ? ns/data.num_served : real_type(0))
+			  << std::setprecision(6)
+			  << std::endl;
+}
+
+} // Namespace <unnamed>
+
+
+int main(int argc, char* argv[])
+{
+	real_type lambda(0.9);
+	real_type mu(1);
+	size_type num_servers(1);
+	real_type length(1e6);
+	unsigned long seed(5489UL);
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string opt(argv[i]);
+
+		if (i+1 == argc)
+		{
+			std::cerr << "Missing value for option '" << opt << "'." << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if (opt == "--lambda")
+		{
+			lambda = std::strtod(argv[++i], 0);
+		}
+		else if (opt == "--mu")
+		{
+			mu = std::strtod(argv[++i], 0);
+		}
+		else if (opt == "--servers")
+		{
+			num_servers = static_cast<size_type>(std::strtod(argv[++i], 0));
+		}
+		else if (opt == "--length")
+		{
+			length = std::strtod(argv[++i], 0);
+		}
+		else if (opt == "--seed")
+		{
+			seed = std::strtoul(argv[++i], 0, 10);
+		}
+		else
+		{
+			std::cerr << "Unknown option '" << opt << "'." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (lambda <= 0 || mu <= 0 || num_servers < 1 || length <= 0)
+	{
+		std::cerr << "Invalid rates, number of servers or simulation length." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "# model served mean-response-time ns/customer" << std::endl;
+
+	run<callback_model>("callback", lambda, mu, num_servers, length, seed);
+	run<process_model>("process", lambda, mu, num_servers, length, seed);
+}
@@ -0,0 +1,224 @@
+/**
+ * \file statistic_group.cpp
+ *
+ * \brief Benchmark of batch means statistic groups.
+ *
+ * Generates the waiting, service and response times of the customers of an
+ * M/M/1 queue (by means of the Lindley recursion) and analyzes them according
+ * to the Batch Means method:
+ * - independent: each series has its own transient phase and batch size
+ *   detectors;
+ * - lead: the three series form a \c dcs::des::batch_means::statistic_group
+ *   whose decisions are taken on the response time series only;
+ * - conservative: the three series form a statistic group taking the longest
+ *   warm-up and the largest batch size detected on all of them.
+ *
+ * For each analysis, the benchmark prints, for every series, the estimate,
+ * the half width, the transient phase length and the number of observations,
+ * followed by the mean wall-clock time per customer (in nanoseconds).
+ *
+ * Usage: statistic_group [--lambda X] [--mu X] [--customers N] [--seed N]
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <algorithm>
+#include <boost/random/uniform_01.hpp>
+#include <boost/smart_ptr.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <dcs/des/batch_means/analyzable_statistic.hpp>
+#include <dcs/des/batch_means/pawlikowski1990_batch_size_detector.hpp>
+#include <dcs/des/batch_means/statistic_group.hpp>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/spectral/pawlikowski1990_transient_detector.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::mean_estimator<real_type,uint_type> statistic_type;
+typedef dcs::des::spectral::pawlikowski1990_transient_detector<real_type,uint_type> transient_detector_type;
+typedef dcs::des::batch_means::pawlikowski1990_batch_size_detector<real_type,uint_type> batch_size_detector_type;
+typedef dcs::des::batch_means::statistic_group<transient_detector_type,batch_size_detector_type> group_type;
+typedef boost::shared_ptr<group_type> group_pointer;
+typedef dcs::des::batch_means::group_transient_detector<group_type> group_transient_detector_type;
+typedef dcs::des::batch_means::group_batch_size_detector<group_type> group_batch_size_detector_type;
+typedef dcs::des::base_analyzable_statistic<real_type,uint_type> base_statistic_type;
+typedef boost::shared_ptr<base_statistic_type> statistic_pointer;
+
+const ::std::size_t num_series = 3;
+const char* series_names[num_series] = { "response", "waiting", "service" };
+
+
+/// Draw an exponential variate with the given rate.
+real_type exponential(real_type rate, random_generator_type& rng)
+{
+	boost::uniform_01<real_type> u01;
+
+	return -std::log(real_type(1)-u01(rng))/rate;
+}
+
+
+/// Wall-clock timer with nanosecond resolution (where available).
+real_type now()
+{
+#if defined(CLOCK_MONOTONIC)
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return real_type(ts.tv_sec)*real_type(1e9)+real_type(ts.tv_nsec);
+#else
+	return real_type(std::clock())*real_type(1e9)/real_type(CLOCKS_PER_SEC);
+#endif // CLOCK_MONOTONIC
+}
+
+
+void make_independent(statistic_pointer* stats)
+{
+	typedef dcs::des::batch_means::analyzable_statistic<statistic_type,transient_detector_type,batch_size_detector_type> analyzable_statistic_type;
+
+	for (::std::size_t i = 0; i < num_series; ++i)
+	{
+		stats[i] = statistic_pointer(new analyzable_statistic_type(statistic_type(), transient_detector_type(), batch_size_detector_type()));
+	}
+}
+
+
+void make_grouped(statistic_pointer* stats, dcs::des::batch_means::statistic_group_policy policy)
+{
+	typedef dcs::des::batch_means::analyzable_statistic<statistic_type,group_transient_detector_type,group_batch_size_detector_type> analyzable_statistic_type;
+
+	group_pointer ptr_group(new group_type(policy));
+
+	for (::std::size_t i = 0; i < num_series; ++i)
+	{
+		// The response time (i.e., the first series) leads the group
+		group_type::member_identifier_type id(ptr_group->add_member(i == 0));
+
+		stats[i] = statistic_pointer(new analyzable_statistic_type(statistic_type(), group_transient_detector_type(ptr_group, id), group_batch_size_detector_type(ptr_group, id)));
+	}
+}
+
+
+void run(char const* name, statistic_pointer* stats, real_type lambda, real_type mu, uint_type num_customers, unsigned long seed)
+{
+	random_generator_type rng(seed);
+
+	real_type start(now());
+
+	real_type wait(0);
+	for (uint_type n = 0; n < num_customers; ++n)
+	{
+		real_type svc(exponential(mu, rng));
+
+		(*stats[0])(wait+svc);
+		(*stats[1])(wait);
+		(*stats[2])(svc);
+
+		wait = std::max(real_type(0), wait+svc-exponential(lambda, rng));
+	}
+
+	real_type ns(now()-start);
+
+	for (::std::size_t i = 0; i < num_series; ++i)
+	{
+		std::cout << name
+				  << " " << series_names[i]
+				  << " " << stats[i]->estimate()
+				  << " " << stats[i]->half_width()
+				  << " " << stats[i]->transient_phase_length()
+				  << " " << stats[i]->num_observations()
+				  << std::endl;
+	}
+	std::cout << name << " ns/customer " << std::setprecision(4) << (ns/num_customers) << std::setprecision(6) << std::endl;
+}
+
+} // Namespace <unnamed>
+
+
+int main(int argc, char* argv[])
+{
+	real_type lambda(0.8);
+	real_type mu(1);
+	uint_type num_customers(2000000);
+	unsigned long seed(5489UL);
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string opt(argv[i]);
+
+		if (i+1 == argc)
+		{
+			std::cerr << "Missing value for option '" << opt << "'." << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if (opt == "--lambda")
+		{
+			lambda = std::strtod(argv[++i], 0);
+		}
+		else if (opt == "--mu")
+		{
+			mu = std::strtod(argv[++i], 0);
+		}
+		else if (opt == "--customers")
+		{
+			num_customers = static_cast<uint_type>(std::strtod(argv[++i], 0));
+		}
+		else if (opt == "--seed")
+		{
+			seed = std::strtoul(argv[++i], 0, 10);
+		}
+		else
+		{
+			std::cerr << "Unknown option '" << opt << "'." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (lambda <= 0 || mu <= lambda || num_customers < 1)
+	{
+		std::cerr << "Invalid rates or number of customers." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "# analysis series estimate half-width transient-length observations" << std::endl;
+
+	statistic_pointer stats[num_series];
+
+	make_independent(stats);
+	run("independent", stats, lambda, mu, num_customers, seed);
+
+	make_grouped(stats, dcs::des::batch_means::lead_series_group_policy);
+	run("lead", stats, lambda, mu, num_customers, seed);
+
+	make_grouped(stats, dcs::des::batch_means::most_conservative_group_policy);
+	run("conservative", stats, lambda, mu, num_customers, seed);
+}
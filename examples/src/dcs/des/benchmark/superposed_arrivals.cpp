@@ -0,0 +1,229 @@
+/**
+ * \file superposed_arrivals.cpp
+ *
+ * \brief Benchmark of the superposition of Poisson arrival streams.
+ *
+ * Simulates an open queueing network made of a source, a single-server FCFS
+ * station and a sink, visited by a number of open classes with Poisson
+ * arrivals (class rates are proportional to 1, 2, ..., K and sum up to the
+ * total arrival rate), with exponential service times.
+ * The network is simulated twice:
+ * - separate: every class has its own chain of arrival events;
+ * - superposed: the source merges the arrivals of all classes into a single
+ *   chain (see \c dcs::des::model::qn::source_node::superpose_poisson_classes).
+ *
+ * For each run, the benchmark prints the mean network response time and
+ * throughput, the number of fired events and the wall-clock time (in
+ * milliseconds).
+ *
+ * Usage: superposed_arrivals [--classes N] [--lambda X] [--svc-time X]
+ *                            [--length X] [--seed N]
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <dcs/des/base_analyzable_statistic.hpp>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/model/qn/deterministic_routing_strategy.hpp>
+#include <dcs/des/model/qn/fcfs_queueing_strategy.hpp>
+#include <dcs/des/model/qn/load_independent_service_strategy.hpp>
+#include <dcs/des/model/qn/network_node.hpp>
+#include <dcs/des/model/qn/open_customer_class.hpp>
+#include <dcs/des/model/qn/output_statistic_category.hpp>
+#include <dcs/des/model/qn/queueing_network.hpp>
+#include <dcs/des/model/qn/queueing_network_traits.hpp>
+#include <dcs/des/model/qn/queueing_station_node.hpp>
+#include <dcs/des/model/qn/sink_node.hpp>
+#include <dcs/des/model/qn/source_node.hpp>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <dcs/math/stats/distributions.hpp>
+#include <dcs/memory.hpp>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::replications::engine<real_type,uint_type> des_engine_type;
+typedef dcs::des::base_analyzable_statistic<real_type,uint_type> analyzable_statistic_type;
+typedef dcs::des::model::qn::queueing_network<uint_type,real_type,random_generator_type,des_engine_type> network_type;
+typedef dcs::des::model::qn::queueing_network_traits<network_type> network_traits_type;
+typedef dcs::des::model::qn::open_customer_class<network_traits_type> customer_class_type;
+typedef dcs::des::model::qn::network_node<network_traits_type> network_node_type;
+typedef dcs::des::model::qn::source_node<network_traits_type> source_node_type;
+typedef dcs::des::model::qn::fcfs_queueing_strategy<network_traits_type> queueing_strategy_type;
+typedef dcs::des::model::qn::load_independent_service_strategy<network_traits_type> service_strategy_type;
+typedef dcs::des::model::qn::deterministic_routing_strategy<network_traits_type> routing_strategy_type;
+typedef dcs::math::stats::any_distribution<real_type> probability_distribution_type;
+
+enum node_identifier
+{
+	source_node_id = 0,
+	station_node_id,
+	sink_node_id
+};
+
+
+/// Wall-clock time (in milliseconds).
+real_type now()
+{
+#if defined(CLOCK_MONOTONIC)
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return real_type(ts.tv_sec)*real_type(1e3)+real_type(ts.tv_nsec)*real_type(1e-6);
+#else
+	return real_type(std::clock())*real_type(1e3)/real_type(CLOCKS_PER_SEC);
+#endif // CLOCK_MONOTONIC
+}
+
+
+void run(char const* name, bool superpose, uint_type num_classes, real_type lambda, real_type svc_time, real_type length, unsigned long seed)
+{
+	dcs::shared_ptr<des_engine_type> ptr_eng = dcs::make_shared<des_engine_type>(length, 1);
+	dcs::shared_ptr<random_generator_type> ptr_rng = dcs::make_shared<random_generator_type>(seed);
+
+	network_type qn(ptr_rng, ptr_eng);
+
+	dcs::shared_ptr<routing_strategy_type> ptr_routing = dcs::make_shared<routing_strategy_type>();
+	std::vector<probability_distribution_type> svc_distrs;
+	for (uint_type c = 0; c < num_classes; ++c)
+	{
+		ptr_routing->add_route(source_node_id, c, station_node_id, c);
+		ptr_routing->add_route(station_node_id, c, sink_node_id, c);
+		svc_distrs.push_back(dcs::math::stats::make_any_distribution(dcs::math::stats::exponential_distribution<real_type>(1.0/svc_time)));
+	}
+
+	dcs::shared_ptr<source_node_type> ptr_source = dcs::make_shared<source_node_type>(source_node_id, "Source", ptr_routing);
+	ptr_source->superpose_poisson_classes(superpose);
+	qn.add_node(ptr_source);
+	qn.add_node(
+		dcs::make_shared< dcs::des::model::qn::queueing_station_node<network_traits_type> >(
+			station_node_id,
+			"Station",
+			dcs::make_shared<queueing_strategy_type>(),
+			dcs::make_shared<service_strategy_type>(1, svc_distrs.begin(), svc_distrs.end()),
+			ptr_routing
+		)
+	);
+	qn.add_node(dcs::make_shared< dcs::des::model::qn::sink_node<network_traits_type> >(sink_node_id, "Sink"));
+
+	// Class c has rate proportional to c+1
+	real_type sum_weights(real_type(num_classes)*real_type(num_classes+1)/real_type(2));
+	for (uint_type c = 0; c < num_classes; ++c)
+	{
+		dcs::shared_ptr<customer_class_type> ptr_class = dcs::make_shared<customer_class_type>(
+				c,
+				"Open Class",
+				dcs::math::stats::exponential_distribution<real_type>(lambda*real_type(c+1)/sum_weights)
+			);
+		ptr_class->reference_node(source_node_id);
+		qn.add_class(ptr_class);
+	}
+
+	dcs::shared_ptr<analyzable_statistic_type> ptr_rt_stat = ptr_eng->make_analyzable_statistic(dcs::des::mean_estimator<real_type,uint_type>());
+	qn.statistic(dcs::des::model::qn::net_response_time_statistic_category, ptr_rt_stat);
+	dcs::shared_ptr<analyzable_statistic_type> ptr_tput_stat = ptr_eng->make_analyzable_statistic(dcs::des::mean_estimator<real_type,uint_type>());
+	qn.statistic(dcs::des::model::qn::net_throughput_statistic_category, ptr_tput_stat);
+
+	real_type start(now());
+	ptr_eng->run();
+	real_type ms(now()-start);
+
+	des_engine_type::snapshot_type snap;
+	ptr_eng->snapshot(snap);
+
+	std::cout << name
+			  << " " << ptr_rt_stat->estimate()
+			  << " " << ptr_tput_stat->estimate()
+			  << " " << snap.num_events
+			  << " " << std::setprecision(4) << ms << std::setprecision(6)
+			  << std::endl;
+}
+
+} // Namespace <unnamed>
+
+
+int main(int argc, char* argv[])
+{
+	uint_type num_classes(200);
+	real_type lambda(5);
+	real_type svc_time(0.06);
+	real_type length(20000);
+	unsigned long seed(5489UL);
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string opt(argv[i]);
+
+		if (i+1 == argc)
+		{
+			std::cerr << "Missing value for option '" << opt << "'." << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if (opt == "--classes")
+		{
+			num_classes = static_cast<uint_type>(std::strtod(argv[++i], 0));
+		}
+		else if (opt == "--lambda")
+		{
+			lambda = std::strtod(argv[++i], 0);
+		}
+		else if (opt == "--svc-time")
+		{
+			svc_time = std::strtod(argv[++i], 0);
+		}
+		else if (opt == "--length")
+		{
+			length = std::strtod(argv[++i], 0);
+		}
+		else if (opt == "--seed")
+		{
+			seed = std::strtoul(argv[++i], 0, 10);
+		}
+		else
+		{
+			std::cerr << "Unknown option '" << opt << "'." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (num_classes < 1 || lambda <= 0 || svc_time <= 0 || lambda*svc_time >= 1 || length <= 0)
+	{
+		std::cerr << "Invalid number of classes, rates or simulation length." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "# run response-time throughput events ms" << std::endl;
+
+	run("separate", false, num_classes, lambda, svc_time, length, seed);
+	run("superposed", true, num_classes, lambda, svc_time, length, seed);
+}
@@ -0,0 +1,492 @@
+/**
+ * \file dcs/des/async_analyzable_statistic.hpp
+ *
+ * \brief Analyzable statistic whose output analysis is run by a helper
+ *  thread.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_ASYNC_ANALYZABLE_STATISTIC_HPP
+#define DCS_DES_ASYNC_ANALYZABLE_STATISTIC_HPP
+
+
+#include <boost/atomic.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/smart_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <dcs/des/base_analyzable_statistic.hpp>
+#include <dcs/des/statistic_categories.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+namespace dcs { namespace des {
+
+/**
+ * \brief Analyzable statistic whose output analysis is run by a helper
+ *  thread.
+ *
+ * \tparam ValueT The type of the observations.
+ * \tparam UIntT The type used for unsigned integral numbers.
+ *
+ * The wrapped statistic (e.g., a batch means statistic with its transient
+ * phase and batch size detectors) is owned by a helper thread.
+ * Collecting an observation only pushes it into a lock-free single-producer
+ * single-consumer ring, so that the simulation thread never stalls on the
+ * (possibly expensive) tests run by detectors and estimators.
+ * The helper thread consumes the ring and, after each drained chunk, publishes
+ * the decisions the engine polls after every event (reached relative
+ * precision, steady-state entrance, completeness and enable status).
+ *
+ * Decisions may lag behind the simulation by the observations still in the
+ * ring; thus the simulation may run a little longer than it would with the
+ * synchronous analysis.
+ * All the other queries (e.g., the estimate) first wait for the ring to be
+ * drained, so that they are exact.
+ * When the ring is full, collecting an observation waits for the helper
+ * thread to make room.
+ *
+ * An exception thrown by the wrapped statistic on the helper thread is
+ * rethrown on the simulation thread by the next collected observation or
+ * query; the helper thread discards the observations collected after it, and
+ * the statistic should not be used any more.
+ *
+ * The wrapped statistic must not be used directly (nor analyzed by an engine)
+ * while it is wrapped.
+ *
+ * \note Linking with Boost.Thread is required.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename ValueT, typename UIntT=::std::size_t>
+class async_analyzable_statistic: public base_analyzable_statistic<ValueT,UIntT>,
+								  private ::boost::noncopyable
+{
+	private: typedef base_analyzable_statistic<ValueT,UIntT> base_type;
+	public: typedef ValueT value_type;
+	public: typedef UIntT uint_type;
+	public: typedef ::std::size_t size_type;
+	public: typedef base_analyzable_statistic<value_type,uint_type> statistic_type;
+	public: typedef ::boost::shared_ptr<statistic_type> statistic_pointer;
+	private: struct observation
+	{
+		value_type value;
+		value_type weight;
+	};
+	private: typedef ::boost::lockfree::spsc_queue<observation> queue_type;
+
+
+	public: static const size_type default_capacity = 8192;
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param ptr_stat The statistic to be analyzed by the helper thread.
+	 * \param capacity The number of observations the ring can hold.
+	 */
+	public: explicit async_analyzable_statistic(statistic_pointer const& ptr_stat, size_type capacity = default_capacity)
+	: base_type(ptr_stat->target_relative_precision()),
+	  ptr_stat_(ptr_stat),
+	  queue_(capacity),
+	  num_pushed_(0),
+	  num_popped_(0),
+	  stop_(false),
+	  failed_(false),
+	  rel_prec_(ptr_stat->relative_precision()),
+	  steady_(ptr_stat->steady_state_entered()),
+	  complete_(ptr_stat->observation_complete()),
+	  stat_enabled_(ptr_stat->enabled()),
+	  steady_start_time_(0)
+	{
+		// pre: capacity > 0
+		DCS_ASSERT(
+			capacity > 0,
+			throw ::std::invalid_argument("[dcs::des::async_analyzable_statistic::ctor] Capacity must be a positive number.")
+		);
+
+		this->name(ptr_stat->name());
+
+		thread_ = ::boost::thread(consumer(this));
+	}
+
+
+	public: ~async_analyzable_statistic()
+	{
+		stop_.store(true, ::boost::memory_order_release);
+		thread_.join();
+	}
+
+
+	/**
+	 * \brief Wait for the helper thread to analyze all the collected
+	 *  observations.
+	 *
+	 * \exception Rethrows the exception thrown by the wrapped statistic on the
+	 *  helper thread, if any.
+	 */
+	public: void flush() const
+	{
+		while (num_popped_.load(::boost::memory_order_acquire) != num_pushed_)
+		{
+			::boost::this_thread::yield();
+		}
+
+		check_failure();
+	}
+
+
+	/// Return the wrapped statistic, once all the collected observations have
+	/// been analyzed.
+	public: statistic_pointer statistic() const
+	{
+		flush();
+
+		return ptr_stat_;
+	}
+
+
+	private: statistic_category do_category() const
+	{
+		return ptr_stat_->category();
+	}
+
+
+	private: void do_collect(value_type obs, value_type weight)
+	{
+		check_failure();
+
+		if (!this->enabled())
+		{
+			return;
+		}
+
+		if (!stat_enabled_.load(::boost::memory_order_acquire))
+		{
+			// The wrapped statistic disabled itself (e.g., because of the
+			// maximum number of observations).
+			this->enable(false);
+			return;
+		}
+
+		observation item;
+		item.value = obs;
+		item.weight = weight;
+
+		while (!queue_.push(item))
+		{
+			::boost::this_thread::yield();
+		}
+		++num_pushed_;
+	}
+
+
+	private: void do_reset()
+	{
+		flush();
+
+		ptr_stat_->reset();
+
+		publish();
+	}
+
+
+	private: uint_type do_num_observations() const
+	{
+		flush();
+
+		return ptr_stat_->num_observations();
+	}
+
+
+	private: value_type do_estimate() const
+	{
+		flush();
+
+		return ptr_stat_->estimate();
+	}
+
+
+	private: value_type do_variance() const
+	{
+		flush();
+
+		return ptr_stat_->variance();
+	}
+
+
+	private: value_type do_half_width() const
+	{
+		flush();
+
+		return ptr_stat_->half_width();
+	}
+
+
+	private: value_type do_relative_precision() const
+	{
+		return rel_prec_.load(::boost::memory_order_acquire);
+	}
+
+
+	private: uint_type do_max_num_observations() const
+	{
+		return ptr_stat_->max_num_observations();
+	}
+
+
+	private: bool do_steady_state_entered() const
+	{
+		return steady_.load(::boost::memory_order_acquire);
+	}
+
+
+	private: uint_type do_transient_phase_length() const
+	{
+		flush();
+
+		return ptr_stat_->transient_phase_length();
+	}
+
+
+	private: value_type do_steady_state_enter_time() const
+	{
+		return steady_start_time_;
+	}
+
+
+	private: void do_steady_state_enter_time(value_type value)
+	{
+		steady_start_time_ = value;
+	}
+
+
+	private: bool do_observation_complete() const
+	{
+		return complete_.load(::boost::memory_order_acquire);
+	}
+
+
+	protected: void do_initialize_for_experiment()
+	{
+		flush();
+
+		ptr_stat_->initialize_for_experiment();
+
+		publish();
+	}
+
+
+	protected: void do_finalize_for_experiment()
+	{
+		flush();
+
+		ptr_stat_->finalize_for_experiment();
+
+		publish();
+	}
+
+
+	protected: void do_enable(bool value)
+	{
+		flush();
+
+		ptr_stat_->enable(value);
+
+		publish();
+
+		base_type::do_enable(value);
+	}
+
+
+	/// Publish the decisions of the wrapped statistic (called either by the
+	/// helper thread or while the ring is drained).
+	private: void publish()
+	{
+		rel_prec_.store(ptr_stat_->relative_precision(), ::boost::memory_order_release);
+		steady_.store(ptr_stat_->steady_state_entered(), ::boost::memory_order_release);
+		complete_.store(ptr_stat_->observation_complete(), ::boost::memory_order_release);
+		stat_enabled_.store(ptr_stat_->enabled(), ::boost::memory_order_release);
+	}
+
+
+	/// Rethrow on the simulation thread the exception thrown by the wrapped
+	/// statistic on the helper thread, if any.
+	private: void check_failure() const
+	{
+		if (failed_.load(::boost::memory_order_acquire))
+		{
+			::boost::rethrow_exception(ptr_error_);
+		}
+	}
+
+
+	/// The loop of the helper thread.
+	private: void consume()
+	{
+		const unsigned int max_num_spins(64);
+
+		unsigned int num_spins(0);
+		observation item;
+		bool failed(false);
+
+		while (true)
+		{
+			size_type n(0);
+			while (queue_.pop(item))
+			{
+				// After a failure, observations are only counted so that
+				// flush() does not wait forever.
+				if (!failed)
+				{
+					try
+					{
+						(*ptr_stat_)(item.value, item.weight);
+					}
+					catch (...)
+					{
+						failed = true;
+						ptr_error_ = ::boost::current_exception();
+					}
+				}
+				++n;
+			}
+
+			if (n > 0)
+			{
+				if (!failed)
+				{
+					try
+					{
+						publish();
+					}
+					catch (...)
+					{
+						failed = true;
+						ptr_error_ = ::boost::current_exception();
+					}
+				}
+				if (failed)
+				{
+					// Make the exception visible before the popped count.
+					failed_.store(true, ::boost::memory_order_release);
+				}
+				num_popped_.fetch_add(n, ::boost::memory_order_release);
+				num_spins = 0;
+			}
+			else if (stop_.load(::boost::memory_order_acquire))
+			{
+				break;
+			}
+			else if (num_spins < max_num_spins)
+			{
+				++num_spins;
+				::boost::this_thread::yield();
+			}
+			else
+			{
+				::boost::this_thread::sleep(::boost::posix_time::microseconds(100));
+			}
+		}
+	}
+
+
+	private: struct consumer
+	{
+		explicit consumer(async_analyzable_statistic* ptr)
+		: ptr(ptr)
+		{
+		}
+
+		void operator()()
+		{
+			ptr->consume();
+		}
+
+		async_analyzable_statistic* ptr;
+	};
+
+
+	private: statistic_pointer ptr_stat_;
+	/// The ring from the simulation thread to the helper thread.
+	private: queue_type queue_;
+	/// The number of observations pushed (simulation thread only).
+	private: size_type num_pushed_;
+	/// The number of observations analyzed by the helper thread.
+	private: ::boost::atomic<size_type> num_popped_;
+	private: ::boost::atomic<bool> stop_;
+	/// Tell if the wrapped statistic has thrown an exception on the helper
+	/// thread.
+	private: ::boost::atomic<bool> failed_;
+	/// The exception thrown by the wrapped statistic on the helper thread
+	/// (written before \c failed_ is set).
+	private: ::boost::exception_ptr ptr_error_;
+	private: ::boost::atomic<value_type> rel_prec_;
+	private: ::boost::atomic<bool> steady_;
+	private: ::boost::atomic<bool> complete_;
+	private: ::boost::atomic<bool> stat_enabled_;
+	private: value_type steady_start_time_;
+	private: ::boost::thread thread_;
+};
+
+
+/**
+ * \brief Wrap the given statistic so that its output analysis is run by a
+ *  helper thread, and make the wrapper analyzed by the given engine.
+ *
+ * If the given statistic is analyzed by the engine, it is replaced by the
+ * wrapper.
+ */
+template <typename ValueT, typename UIntT, typename EngineT>
+::boost::shared_ptr< async_analyzable_statistic<ValueT,UIntT> > make_async_analyzable_statistic(::boost::shared_ptr< base_analyzable_statistic<ValueT,UIntT> > const& ptr_stat, EngineT& des_engine, ::std::size_t capacity = async_analyzable_statistic<ValueT,UIntT>::default_capacity)
+{
+	typedef async_analyzable_statistic<ValueT,UIntT> statistic_type;
+
+	// pre: ptr_stat must be a valid pointer
+	DCS_ASSERT(
+		ptr_stat,
+		throw ::std::invalid_argument("[dcs::des::make_async_analyzable_statistic] Invalid statistic.")
+	);
+
+	if (des_engine.is_analyzed_statistic(ptr_stat))
+	{
+		des_engine.remove_statistic(ptr_stat);
+	}
+
+	::boost::shared_ptr<statistic_type> ptr_async(new statistic_type(ptr_stat, capacity));
+
+	des_engine.analyze_statistic(ptr_async);
+
+	return ptr_async;
+}
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_ASYNC_ANALYZABLE_STATISTIC_HPP
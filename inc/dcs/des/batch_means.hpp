@@ -31,6 +31,7 @@
 #include <dcs/des/batch_means/dummy_batch_size_detector.hpp>
 #include <dcs/des/batch_means/engine.hpp>
 #include <dcs/des/batch_means/pawlikowski1990_batch_size_detector.hpp>
+#include <dcs/des/batch_means/statistic_group.hpp>
 #include <dcs/des/core.hpp>
 #include <dcs/des/spectral/pawlikowski1990_transient_detector.hpp>
 
@@ -34,6 +34,7 @@
 #include <dcs/debug.hpp>
 #include <dcs/des/base_analyzable_statistic.hpp>
 #include <dcs/des/batch_means/pawlikowski1990_batch_size_detector.hpp>
+#include <dcs/des/memory_accounting.hpp>
 #include <dcs/des/spectral/pawlikowski1990_transient_detector.hpp>
 #include <dcs/des/statistic_categories.hpp>
 #include <dcs/des/weighted_mean_estimator.hpp>
@@ -199,7 +200,7 @@ class analyzable_statistic: public base_analyzable_statistic<
 	 * \brief Collect a new observation.
 	 * \param obs The new observation to be collected.
 	 */
-	private: void do_collect(value_type obs, value_type weight)
+	protected: void do_collect(value_type obs, value_type weight)
 	{
 		if (!this->enabled())
 		{
@@ -602,7 +603,7 @@ class analyzable_statistic: public base_analyzable_statistic<
 	private: uint_type batch_size_;
 	//private: value_type batch_mean_;
 	private: weighted_mean_estimator<value_type,uint_type> batch_mean_;
-	private: ::std::vector<value_type> batch_means_;
+	private: ::std::vector<value_type, typename memory_accounting_allocator<value_type,batch_means_memory_category>::type> batch_means_;
 	private: value_type steady_start_time_;
 };
 
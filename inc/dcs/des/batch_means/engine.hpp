@@ -41,6 +41,8 @@
 #include <dcs/des/null_transient_detector.hpp>
 #include <dcs/des/output_analysis.hpp>
 #include <dcs/des/output_analysis_categories.hpp>
+#include <dcs/des/static_engine.hpp>
+#include <dcs/macro.hpp>
 #include <dcs/math/constants.hpp>
 
 
@@ -69,6 +71,9 @@ namespace batch_means {
  *   of simulator engine actually used.
  * .
  *
+ * The simulation is a single experiment, run by the statically dispatched loop
+ * of \c dcs::des::static_engine.
+ *
  * \author Cosimo Anglano (cosimo.anglano@di.unipmn.it)
  * \author Marco Guazzone (marco.guazzone@gmail.com)
  */
@@ -76,9 +81,9 @@ template <
 	typename RealT=double,
 	typename UIntT=::std::size_t
 >
-class engine: public ::dcs::des::engine<RealT>
+class engine: public ::dcs::des::static_engine<engine<RealT,UIntT>,RealT>
 {
-	private: typedef ::dcs::des::engine<RealT> base_type;
+	private: typedef ::dcs::des::static_engine<engine<RealT,UIntT>,RealT> base_type;
 	public: typedef typename base_type::real_type real_type;
 	public: typedef typename base_type::size_type size_type;
 //	public: typedef TransientPhaseDetectorT transient_phase_detector_type;
@@ -91,6 +96,9 @@ class engine: public ::dcs::des::engine<RealT>
 	private: typedef typename base_type::analyzable_statistic_pointer analyzable_statistic_pointer;
 
 
+	friend class ::dcs::des::static_engine<engine<RealT,UIntT>,RealT>;
+
+
 	protected: void prepare_simulation(engine_context_type& ctx)
 	{
 		base_type::prepare_simulation(ctx);
@@ -105,31 +113,38 @@ class engine: public ::dcs::des::engine<RealT>
 	}
 
 
-	private: void do_run()
+	private: bool more_experiments() const
 	{
-		DCS_DEBUG_TRACE( "Begin SIMULATION" );
+		return this->num_experiments() == 0;
+	}
 
-		engine_context_type ctx(this);
 
-		this->prepare_simulation(ctx);
+	private: void prepare_experiment(engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+	}
 
-		while (!this->end_of_simulation() && !this->future_event_list().empty())
-		{
-			DCS_DEBUG_TRACE( "Simulation time: " << this->simulated_time());
 
-			this->fire_next_event(ctx);
+	private: bool end_of_experiment() const
+	{
+		return this->end_of_simulation();
+	}
+
+
+	private: void monitor_experiment()
+	{
+		this->monitor_statistics();
+	}
 
-			this->monitor_statistics();
-		}
+
+	private: void finalize_experiment(engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
 
 		if (this->end_of_simulation())
 		{
 			this->future_event_list().clear();
 		}
-
-		this->finalize_simulation(ctx);
-
-		DCS_DEBUG_TRACE( "End SIMULATION" );
 	}
 
 
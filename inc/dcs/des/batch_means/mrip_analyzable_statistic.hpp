@@ -0,0 +1,186 @@
+/**
+ * \file dcs/des/batch_means/mrip_analyzable_statistic.hpp
+ *
+ * \brief Output statistic of a single trajectory of the Multiple Replications
+ *  In Parallel (MRIP) scheme.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_BATCH_MEANS_MRIP_ANALYZABLE_STATISTIC_HPP
+#define DCS_DES_BATCH_MEANS_MRIP_ANALYZABLE_STATISTIC_HPP
+
+
+#include <boost/smart_ptr.hpp>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <dcs/des/batch_means/analyzable_statistic.hpp>
+#include <dcs/des/batch_means/engine.hpp>
+#include <dcs/des/batch_means/mrip_analyzer.hpp>
+#include <dcs/des/batch_means/pawlikowski1990_batch_size_detector.hpp>
+#include <dcs/des/spectral/pawlikowski1990_transient_detector.hpp>
+#include <stdexcept>
+
+
+namespace dcs { namespace des { namespace batch_means {
+
+/**
+ * \brief Output statistic of a single trajectory of the Multiple Replications
+ *  In Parallel (MRIP) scheme.
+ *
+ * \tparam ValueT The type of the observations.
+ * \tparam UIntT The type used for unsigned integral numbers.
+ * \tparam TransientDetectorT The type of the transient phase detector.
+ * \tparam BatchSizeDetectorT The type of the batch size detector.
+ *
+ * Each trajectory detects its own transient phase and batch size, exactly as
+ * the sequential batch means statistic does; steady-state batch means are then
+ * submitted to the shared \c mrip_analyzer.
+ * Since all the estimates refer to the combined sample, the engine running the
+ * trajectory stops when the combined confidence interval reaches the target
+ * relative precision.
+ * Trajectories which are still in their transient phase (or detecting their
+ * batch size) when the target precision is reached disable this statistic, so
+ * that their engine stops too.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <
+	typename ValueT=double,
+	typename UIntT=::std::size_t,
+	typename TransientDetectorT=::dcs::des::spectral::pawlikowski1990_transient_detector<ValueT,UIntT>,
+	typename BatchSizeDetectorT=pawlikowski1990_batch_size_detector<ValueT,UIntT>
+>
+class mrip_analyzable_statistic: public analyzable_statistic<
+											mrip_statistic<ValueT,UIntT>,
+											TransientDetectorT,
+											BatchSizeDetectorT
+										>
+{
+	private: typedef analyzable_statistic<mrip_statistic<ValueT,UIntT>,TransientDetectorT,BatchSizeDetectorT> base_type;
+	public: typedef ValueT value_type;
+	public: typedef UIntT uint_type;
+	public: typedef mrip_statistic<value_type,uint_type> statistic_type;
+	public: typedef typename statistic_type::analyzer_type analyzer_type;
+	public: typedef typename statistic_type::analyzer_pointer analyzer_pointer;
+	public: typedef TransientDetectorT transient_phase_detector_type;
+	public: typedef BatchSizeDetectorT batch_size_detector_type;
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param ptr_analyzer The shared analyzer, which also provides the target
+	 *  relative precision and the minimum number of batches.
+	 * \param trajectory The index of this trajectory, in
+	 *  <tt>[0,num_trajectories)</tt>.
+	 * \param transient_detector The transient phase detector of this
+	 *  trajectory.
+	 * \param size_detector The batch size detector of this trajectory.
+	 * \param max_num_obs The maximum number of observations of this
+	 *  trajectory.
+	 */
+	public: mrip_analyzable_statistic(analyzer_pointer const& ptr_analyzer,
+									  uint_type trajectory,
+									  transient_phase_detector_type const& transient_detector,
+									  batch_size_detector_type const& size_detector,
+									  uint_type max_num_obs = base_type::default_max_num_obs)
+	: base_type(statistic_type(ptr_analyzer, trajectory),
+				transient_detector,
+				size_detector,
+				ptr_analyzer->target_relative_precision(),
+				max_num_obs,
+				ptr_analyzer->min_num_batches()),
+	  ptr_analyzer_(ptr_analyzer)
+	{
+	}
+
+
+	public: analyzer_pointer analyzer() const
+	{
+		return ptr_analyzer_;
+	}
+
+
+	protected: void do_collect(value_type obs, value_type weight)
+	{
+		if (ptr_analyzer_->done())
+		{
+			// Combined precision reached by other trajectories.
+			if (this->enabled())
+			{
+				this->enable(false);
+			}
+			return;
+		}
+
+		base_type::do_collect(obs, weight);
+	}
+
+
+	private: analyzer_pointer ptr_analyzer_;
+};
+
+
+/**
+ * \brief Make an output statistic of a MRIP trajectory and make it analyzed by
+ *  the given engine.
+ */
+template <
+	typename ValueT,
+	typename UIntT,
+	typename TransientDetectorT,
+	typename BatchSizeDetectorT,
+	typename RealT,
+	typename EngineUIntT
+>
+::boost::shared_ptr<
+	mrip_analyzable_statistic<ValueT,UIntT,TransientDetectorT,BatchSizeDetectorT>
+> make_mrip_analyzable_statistic(::boost::shared_ptr< mrip_analyzer<ValueT,UIntT> > const& ptr_analyzer, UIntT trajectory, TransientDetectorT const& transient_detector, BatchSizeDetectorT const& size_detector, engine<RealT,EngineUIntT>& des_engine, UIntT max_num_obs = mrip_analyzable_statistic<ValueT,UIntT,TransientDetectorT,BatchSizeDetectorT>::default_max_num_obs)
+{
+	typedef mrip_analyzable_statistic<ValueT,UIntT,TransientDetectorT,BatchSizeDetectorT> statistic_type;
+
+	// pre: analyzer must be a valid pointer
+	DCS_ASSERT(
+		ptr_analyzer,
+		throw ::std::invalid_argument("[dcs::des::batch_means::make_mrip_analyzable_statistic] Invalid analyzer.")
+	);
+
+	::boost::shared_ptr<statistic_type> ptr_stat(
+			new statistic_type(
+				ptr_analyzer,
+				trajectory,
+				transient_detector,
+				size_detector,
+				max_num_obs
+			)
+	);
+
+	des_engine.analyze_statistic(ptr_stat);
+
+	return ptr_stat;
+}
+
+}}} // Namespace dcs::des::batch_means
+
+
+#endif // DCS_DES_BATCH_MEANS_MRIP_ANALYZABLE_STATISTIC_HPP
@@ -0,0 +1,511 @@
+/**
+ * \file dcs/des/batch_means/mrip_analyzer.hpp
+ *
+ * \brief Central sequential analyzer for the Multiple Replications In
+ *  Parallel (MRIP) scheme.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_BATCH_MEANS_MRIP_ANALYZER_HPP
+#define DCS_DES_BATCH_MEANS_MRIP_ANALYZER_HPP
+
+
+#include <boost/atomic.hpp>
+#include <boost/smart_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <dcs/assert.hpp>
+#include <dcs/des/base_statistic.hpp>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/statistic_categories.hpp>
+#include <dcs/math/constants.hpp>
+#include <stdexcept>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace batch_means {
+
+/**
+ * \brief Central sequential analyzer for the Multiple Replications In
+ *  Parallel (MRIP) scheme.
+ *
+ * \tparam ValueT The type of the observations.
+ * \tparam UIntT The type used for unsigned integral numbers.
+ *
+ * In the MRIP scheme (Pawlikowski et al., 1994), several independent
+ * trajectories of the same model are run in parallel (e.g., one per thread).
+ * Each trajectory detects its own transient phase and batch size, and then
+ * submits its steady-state batch means to a single analyzer, which pools them
+ * into a combined confidence interval.
+ * The simulation stops as soon as the combined confidence interval reaches the
+ * target relative precision.
+ *
+ * Batch means are pooled by rounds: each trajectory has its own buffer, and a
+ * round is closed only when every running trajectory past its warm-up has
+ * delivered a batch mean; the round (one batch mean per trajectory) is then
+ * fed to the combined estimator and the stopping rule is checked.
+ * Thus a faster trajectory cannot dominate the combined sample, which would
+ * bias the estimate when trajectories run at different speeds (e.g., because
+ * they detected different batch sizes).
+ * A trajectory joins the rounds with its first batch mean, so that a
+ * trajectory still in its transient phase does not hold back the others.
+ * Buffers are bounded too: when a trajectory has buffered \c max_lag batch
+ * means, the round is closed without the trajectories lagging behind.
+ * A trajectory which ends on its own must be retired through \c retire, so
+ * that the remaining ones can keep closing rounds (\c mrip_runner does it).
+ *
+ * This class is the shared analyzer; all its member functions can be safely
+ * called by concurrent trajectories.
+ * Batch means are assumed to be approximately independent and identically
+ * distributed across trajectories, which holds when all trajectories detect a
+ * batch size large enough to make their own batch means uncorrelated.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename ValueT=double, typename UIntT=::std::size_t>
+class mrip_analyzer
+{
+	public: typedef ValueT value_type;
+	public: typedef UIntT uint_type;
+	private: typedef ::boost::mutex mutex_type;
+	private: typedef ::boost::lock_guard<mutex_type> lock_type;
+	private: typedef ::std::deque<value_type> buffer_type;
+
+
+	public: static const uint_type default_min_num_batches = 10;
+	public: static const uint_type default_max_lag = 100;
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param num_trajectories The number of trajectories feeding this
+	 *  analyzer.
+	 * \param relative_precision The target relative precision of the combined
+	 *  confidence interval.
+	 * \param min_num_batches The minimum number of batch means (over all the
+	 *  trajectories) to collect before checking for relative precision.
+	 * \param ci_level The level of the combined confidence interval.
+	 * \param max_lag The maximum number of batch means a trajectory can
+	 *  buffer while waiting for the other trajectories.
+	 */
+	public: mrip_analyzer(uint_type num_trajectories,
+						  value_type relative_precision,
+						  uint_type min_num_batches = default_min_num_batches,
+						  value_type ci_level = base_statistic<value_type,uint_type>::default_confidence_level,
+						  uint_type max_lag = default_max_lag)
+	: target_rel_prec_(relative_precision),
+	  min_num_batches_(min_num_batches),
+	  max_lag_(max_lag),
+	  stat_(ci_level),
+	  buffers_(num_trajectories),
+	  running_(num_trajectories, true),
+	  started_(num_trajectories, false),
+	  num_rounds_(0),
+	  done_(false)
+	{
+		// pre: num_trajectories > 0
+		DCS_ASSERT(
+			num_trajectories > 0,
+			throw ::std::invalid_argument("[dcs::des::batch_means::mrip_analyzer::ctor] Number of trajectories must be a positive number.")
+		);
+		// pre: relative precision > 0
+		DCS_ASSERT(
+			relative_precision > 0,
+			throw ::std::invalid_argument("[dcs::des::batch_means::mrip_analyzer::ctor] Relative precision must be a positive number.")
+		);
+		// pre: max_lag > 0
+		DCS_ASSERT(
+			max_lag > 0,
+			throw ::std::invalid_argument("[dcs::des::batch_means::mrip_analyzer::ctor] Maximum lag must be a positive number.")
+		);
+	}
+
+
+	/**
+	 * \brief Submit a new steady-state batch mean of the given trajectory.
+	 *
+	 * The batch mean is buffered until all the running trajectories past
+	 * their warm-up have delivered a batch mean for the current round, or
+	 * until the buffer of this trajectory is full.
+	 */
+	public: void collect(uint_type trajectory, value_type batch_mean)
+	{
+		// pre: trajectory < num_trajectories
+		DCS_ASSERT(
+			trajectory < buffers_.size(),
+			throw ::std::invalid_argument("[dcs::des::batch_means::mrip_analyzer::collect] Trajectory out of range.")
+		);
+
+		lock_type lock(mutex_);
+
+		if (done_ || !running_[trajectory])
+		{
+			return;
+		}
+
+		started_[trajectory] = true;
+		buffers_[trajectory].push_back(batch_mean);
+
+		close_rounds();
+	}
+
+
+	/**
+	 * \brief Tell that the given trajectory will not deliver batch means
+	 *  anymore.
+	 *
+	 * Its batch means not yet pooled in a round are discarded, and later
+	 * rounds are made of the remaining trajectories.
+	 */
+	public: void retire(uint_type trajectory)
+	{
+		// pre: trajectory < num_trajectories
+		DCS_ASSERT(
+			trajectory < buffers_.size(),
+			throw ::std::invalid_argument("[dcs::des::batch_means::mrip_analyzer::retire] Trajectory out of range.")
+		);
+
+		lock_type lock(mutex_);
+
+		if (!running_[trajectory])
+		{
+			return;
+		}
+
+		running_[trajectory] = false;
+		buffers_[trajectory].clear();
+
+		if (!done_)
+		{
+			close_rounds();
+		}
+	}
+
+
+	/**
+	 * \brief Tell if the combined confidence interval has reached the target
+	 *  relative precision.
+	 *
+	 * This is cheap enough to be polled for each observation.
+	 */
+	public: bool done() const
+	{
+		return done_;
+	}
+
+
+	/// Forcibly stop the analysis (e.g., when a trajectory fails).
+	public: void abort()
+	{
+		done_ = true;
+	}
+
+
+	/// Clear the collected batch means to start a new analysis.
+	public: void reset()
+	{
+		lock_type lock(mutex_);
+
+		stat_.reset();
+		for (uint_type i = 0; i < buffers_.size(); ++i)
+		{
+			buffers_[i].clear();
+			running_[i] = true;
+			started_[i] = false;
+		}
+		num_rounds_ = 0;
+		done_ = false;
+	}
+
+
+	public: uint_type num_trajectories() const
+	{
+		return buffers_.size();
+	}
+
+
+	public: value_type target_relative_precision() const
+	{
+		return target_rel_prec_;
+	}
+
+
+	public: uint_type min_num_batches() const
+	{
+		return min_num_batches_;
+	}
+
+
+	public: uint_type max_lag() const
+	{
+		return max_lag_;
+	}
+
+
+	public: value_type confidence_level() const
+	{
+		return stat_.confidence_level();
+	}
+
+
+	/// Return the number of rounds pooled so far.
+	public: uint_type num_rounds() const
+	{
+		lock_type lock(mutex_);
+
+		return num_rounds_;
+	}
+
+
+	/// Return the number of batch means pooled over all trajectories.
+	public: uint_type num_batches() const
+	{
+		lock_type lock(mutex_);
+
+		return stat_.num_observations();
+	}
+
+
+	/// Return the grand mean of the collected batch means.
+	public: value_type estimate() const
+	{
+		lock_type lock(mutex_);
+
+		return stat_.estimate();
+	}
+
+
+	/// Return the sample variance of the collected batch means.
+	public: value_type variance() const
+	{
+		lock_type lock(mutex_);
+
+		return stat_.variance();
+	}
+
+
+	/// Return the half-width of the combined confidence interval.
+	public: value_type half_width() const
+	{
+		lock_type lock(mutex_);
+
+		return stat_.half_width();
+	}
+
+
+	/// Return the relative precision of the combined confidence interval.
+	public: value_type relative_precision() const
+	{
+		lock_type lock(mutex_);
+
+		return stat_.relative_precision();
+	}
+
+
+	/// Pool every complete round and check the stopping rule after each one.
+	private: void close_rounds()
+	{
+		while (!done_)
+		{
+			// A round is complete when every running trajectory past its
+			// warm-up has a batch mean, or forced when a buffer is full.
+			bool complete = true;
+			bool empty = true;
+			::std::size_t longest = 0;
+			for (uint_type i = 0; i < buffers_.size(); ++i)
+			{
+				if (!running_[i] || !started_[i])
+				{
+					continue;
+				}
+
+				if (buffers_[i].empty())
+				{
+					complete = false;
+				}
+				else
+				{
+					empty = false;
+					if (buffers_[i].size() > longest)
+					{
+						longest = buffers_[i].size();
+					}
+				}
+			}
+			if (empty || (!complete && longest < max_lag_))
+			{
+				break;
+			}
+
+			for (uint_type i = 0; i < buffers_.size(); ++i)
+			{
+				if (!running_[i] || buffers_[i].empty())
+				{
+					continue;
+				}
+
+				stat_(buffers_[i].front());
+				buffers_[i].pop_front();
+			}
+			++num_rounds_;
+
+			if (stat_.num_observations() > 1
+				&& stat_.num_observations() >= min_num_batches_
+				&& stat_.relative_precision() <= target_rel_prec_)
+			{
+				done_ = true;
+			}
+		}
+	}
+
+
+	private: value_type target_rel_prec_;
+	private: uint_type min_num_batches_;
+	private: uint_type max_lag_;
+	/// The estimator of the grand mean of batch means.
+	private: mean_estimator<value_type,uint_type> stat_;
+	/// Batch means of each trajectory not yet pooled in a round.
+	private: ::std::vector<buffer_type> buffers_;
+	/// Tells which trajectories still deliver batch means.
+	private: ::std::vector<bool> running_;
+	/// Tells which trajectories have delivered a batch mean (i.e., are past their warm-up).
+	private: ::std::vector<bool> started_;
+	private: uint_type num_rounds_;
+	/// Tells if the combined confidence interval is precise enough.
+	private: ::boost::atomic<bool> done_;
+	private: mutable mutex_type mutex_;
+};
+
+
+/**
+ * \brief Statistic forwarding batch means to a shared MRIP analyzer.
+ *
+ * \tparam ValueT The type of the observations.
+ * \tparam UIntT The type used for unsigned integral numbers.
+ *
+ * It is meant to be the statistic type of the batch means analyzable
+ * statistic of each trajectory: the batch means computed by the trajectory
+ * are forwarded to the shared analyzer and all the estimates refer to the
+ * combined sample, so that the per-trajectory confidence interval is the
+ * combined one.
+ *
+ * Each trajectory must have its own statistic, identified by the index of the
+ * trajectory in <tt>[0,num_trajectories)</tt>.
+ *
+ * Resetting this statistic does not reset the shared analyzer, since
+ * trajectories may (re)start at different times; call
+ * \c mrip_analyzer::reset before running the trajectories.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename ValueT=double, typename UIntT=::std::size_t>
+class mrip_statistic: public base_statistic<ValueT,UIntT>
+{
+	private: typedef base_statistic<ValueT,UIntT> base_type;
+	public: typedef ValueT value_type;
+	public: typedef UIntT uint_type;
+	public: typedef mean_statistic_category category_type;
+	public: typedef mrip_analyzer<value_type,uint_type> analyzer_type;
+	public: typedef ::boost::shared_ptr<analyzer_type> analyzer_pointer;
+
+
+	public: mrip_statistic(analyzer_pointer const& ptr_analyzer, uint_type trajectory)
+	: base_type(ptr_analyzer->confidence_level(), "Mean"),
+	  ptr_analyzer_(ptr_analyzer),
+	  trajectory_(trajectory)
+	{
+	}
+
+
+	public: analyzer_pointer analyzer() const
+	{
+		return ptr_analyzer_;
+	}
+
+
+	public: uint_type trajectory() const
+	{
+		return trajectory_;
+	}
+
+
+	private: statistic_category do_category() const
+	{
+		return mean_statistic;
+	}
+
+
+	private: void do_collect(value_type obs, value_type /*ignored_weight*/)
+	{
+		ptr_analyzer_->collect(trajectory_, obs);
+	}
+
+
+	private: void do_reset()
+	{
+		// Empty: the shared analyzer is reset by its owner.
+	}
+
+
+	private: uint_type do_num_observations() const
+	{
+		return ptr_analyzer_->num_batches();
+	}
+
+
+	private: value_type do_estimate() const
+	{
+		return ptr_analyzer_->estimate();
+	}
+
+
+	private: value_type do_variance() const
+	{
+		return ptr_analyzer_->variance();
+	}
+
+
+	private: value_type do_half_width() const
+	{
+		return ptr_analyzer_->half_width();
+	}
+
+
+	private: value_type do_relative_precision() const
+	{
+		return ptr_analyzer_->relative_precision();
+	}
+
+
+	private: analyzer_pointer ptr_analyzer_;
+	private: uint_type trajectory_;
+};
+
+}}} // Namespace dcs::des::batch_means
+
+
+#endif // DCS_DES_BATCH_MEANS_MRIP_ANALYZER_HPP
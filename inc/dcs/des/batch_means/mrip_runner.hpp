@@ -0,0 +1,223 @@
+/**
+ * \file dcs/des/batch_means/mrip_runner.hpp
+ *
+ * \brief Runner of the trajectories of the Multiple Replications In Parallel
+ *  (MRIP) scheme.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_BATCH_MEANS_MRIP_RUNNER_HPP
+#define DCS_DES_BATCH_MEANS_MRIP_RUNNER_HPP
+
+
+#include <boost/smart_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <dcs/des/batch_means/mrip_analyzer.hpp>
+#include <dcs/des/random_substream.hpp>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+
+namespace dcs { namespace des { namespace batch_means {
+
+/**
+ * \brief Runner of the trajectories of the Multiple Replications In Parallel
+ *  (MRIP) scheme.
+ *
+ * \tparam ValueT The type of the observations.
+ * \tparam UIntT The type used for unsigned integral numbers.
+ *
+ * The runner starts one thread per trajectory and waits for all of them to
+ * end.
+ * Each thread calls the given trajectory function object as
+ * <tt>fun(worker_index, seed)</tt>, where \c worker_index is in
+ * <tt>[0,num_workers)</tt> and \c seed is the seed of the random number
+ * generator of the trajectory.
+ * The function object must build its own engine, model and random number
+ * generator, make the output statistics of the trajectory through
+ * \c make_mrip_analyzable_statistic (passing \c worker_index as the
+ * trajectory) and run the engine.
+ * When the function object returns, its trajectory is retired from the
+ * analyzer.
+ *
+ * Besides the analyzer, trajectories share the library-wide counters that
+ * number events and event sources; these are atomic, so IDs stay unique but
+ * are interleaved among trajectories.
+ * With \c DCS_DES_CONFIG_MEMORY_ACCOUNTING, the memory accounting registry is
+ * shared too, and accounts the memory of all the trajectories.
+ *
+ * Seeds are derived from the base seed by \c substream_seed, so that different
+ * workers get well separated substreams and runs are reproducible.
+ *
+ * \note Linking with Boost.Thread is required.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename ValueT=double, typename UIntT=::std::size_t>
+class mrip_runner
+{
+	public: typedef ValueT value_type;
+	public: typedef UIntT uint_type;
+	public: typedef ::std::size_t size_type;
+	public: typedef unsigned long seed_type;
+	public: typedef mrip_analyzer<value_type,uint_type> analyzer_type;
+	public: typedef ::boost::shared_ptr<analyzer_type> analyzer_pointer;
+
+
+	public: static const seed_type default_seed = 5489UL;
+
+
+	public: mrip_runner(size_type num_workers, analyzer_pointer const& ptr_analyzer, seed_type seed = default_seed)
+	: num_workers_(num_workers),
+	  ptr_analyzer_(ptr_analyzer),
+	  seed_(seed)
+	{
+		// pre: num_workers > 0
+		DCS_ASSERT(
+			num_workers > 0,
+			throw ::std::invalid_argument("[dcs::des::batch_means::mrip_runner::ctor] Number of workers must be a positive number.")
+		);
+		// pre: analyzer must be a valid pointer
+		DCS_ASSERT(
+			ptr_analyzer,
+			throw ::std::invalid_argument("[dcs::des::batch_means::mrip_runner::ctor] Invalid analyzer.")
+		);
+		// pre: one analyzer trajectory per worker
+		DCS_ASSERT(
+			ptr_analyzer->num_trajectories() == num_workers,
+			throw ::std::invalid_argument("[dcs::des::batch_means::mrip_runner::ctor] The analyzer must have one trajectory per worker.")
+		);
+	}
+
+
+	public: size_type num_workers() const
+	{
+		return num_workers_;
+	}
+
+
+	public: analyzer_pointer analyzer() const
+	{
+		return ptr_analyzer_;
+	}
+
+
+	/// Return the seed of the random number generator of the given worker.
+	public: seed_type worker_seed(size_type worker) const
+	{
+		return ::dcs::des::substream_seed(seed_, worker);
+	}
+
+
+	/**
+	 * \brief Run all the trajectories and wait for them to end.
+	 *
+	 * The analyzer is reset before starting the trajectories.
+	 * If a trajectory throws, the analysis is aborted (so that the other
+	 * trajectories stop as soon as possible) and the error is rethrown as a
+	 * \c std::runtime_error once all the threads are done.
+	 */
+	public: template <typename FuncT>
+		void run(FuncT fun)
+	{
+		ptr_analyzer_->reset();
+		error_.clear();
+
+		::boost::thread_group threads;
+		for (size_type i = 0; i < num_workers_; ++i)
+		{
+			threads.create_thread(worker_task<FuncT>(this, fun, i));
+		}
+		threads.join_all();
+
+		if (!error_.empty())
+		{
+			throw ::std::runtime_error("[dcs::des::batch_means::mrip_runner::run] Trajectory failed: " + error_);
+		}
+	}
+
+
+	private: template <typename FuncT>
+		struct worker_task
+	{
+		worker_task(mrip_runner* ptr_runner, FuncT const& fun, size_type worker)
+		: ptr_runner(ptr_runner),
+		  fun(fun),
+		  worker(worker)
+		{
+		}
+
+		void operator()()
+		{
+			try
+			{
+				fun(worker, ptr_runner->worker_seed(worker));
+			}
+			catch (::std::exception const& e)
+			{
+				ptr_runner->fail(e.what());
+			}
+			catch (...)
+			{
+				ptr_runner->fail("unknown error");
+			}
+
+			ptr_runner->analyzer()->retire(worker);
+		}
+
+		mrip_runner* ptr_runner;
+		FuncT fun;
+		size_type worker;
+	};
+
+
+	private: void fail(::std::string const& msg)
+	{
+		::boost::lock_guard< ::boost::mutex > lock(error_mutex_);
+
+		if (error_.empty())
+		{
+			error_ = msg;
+		}
+
+		ptr_analyzer_->abort();
+	}
+
+
+	private: size_type num_workers_;
+	private: analyzer_pointer ptr_analyzer_;
+	private: seed_type seed_;
+	/// The message of the first error thrown by a trajectory.
+	private: ::std::string error_;
+	private: ::boost::mutex error_mutex_;
+};
+
+}}} // Namespace dcs::des::batch_means
+
+
+#endif // DCS_DES_BATCH_MEANS_MRIP_RUNNER_HPP
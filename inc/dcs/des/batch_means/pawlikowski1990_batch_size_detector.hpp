@@ -31,6 +31,7 @@
 
 
 #include <boost/numeric/ublas/expression_types.hpp>
+#include <boost/numeric/ublas/storage.hpp>
 #include <boost/numeric/ublas/traits.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
 #include <boost/numeric/ublasx/operation/size.hpp>
@@ -38,6 +39,7 @@
 #include <cstddef>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
+#include <dcs/des/memory_accounting.hpp>
 #include <dcs/des/weighted_mean_estimator.hpp>
 #include <dcs/math/constants.hpp>
 #include <dcs/math/function/sqr.hpp>
@@ -159,7 +161,7 @@ class pawlikowski1990_batch_size_detector
 	public: typedef RealT real_type;
 	public: typedef UIntT uint_type;
 	public: typedef ::std::vector<real_type> vector_type;
-	private: typedef ::boost::numeric::ublas::vector<real_type> internal_vector_type;
+	private: typedef ::boost::numeric::ublas::vector<real_type, ::boost::numeric::ublas::unbounded_array<real_type, typename memory_accounting_allocator<real_type,batch_means_memory_category>::type> > internal_vector_type;
 
 
 	/// Constant for setting the duration of batch size determination
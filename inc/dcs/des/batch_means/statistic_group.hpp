@@ -0,0 +1,708 @@
+/**
+ * \file dcs/des/batch_means/statistic_group.hpp
+ *
+ * \brief Groups of correlated output statistics sharing the transient phase
+ *  and batch size decisions.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_BATCH_MEANS_STATISTIC_GROUP_HPP
+#define DCS_DES_BATCH_MEANS_STATISTIC_GROUP_HPP
+
+
+#include <algorithm>
+#include <boost/smart_ptr.hpp>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <dcs/debug.hpp>
+#include <dcs/des/batch_means/pawlikowski1990_batch_size_detector.hpp>
+#include <dcs/des/memory_accounting.hpp>
+#include <dcs/des/spectral/pawlikowski1990_transient_detector.hpp>
+#include <dcs/des/weighted_mean_estimator.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace batch_means {
+
+/// Policies for taking the decisions of a statistic group.
+enum statistic_group_policy
+{
+	/// Decisions are taken by the detectors run on the lead series only.
+	lead_series_group_policy,
+	/// Detectors are run on every member series; the transient phase of the
+	/// group is over when every member has detected its own, and the largest
+	/// batch size is taken.
+	most_conservative_group_policy
+};
+
+
+/**
+ * \brief A group of correlated output statistics sharing one transient phase
+ *  decision and one batch size decision.
+ *
+ * Statistics collected at the same points of a simulation (e.g., the
+ * response time, waiting time and service time of the customers of a node)
+ * are closely related, and running a transient phase detector and a batch
+ * size detector for each of them is mostly wasted work.
+ * The members of a group are \c analyzable_statistic objects whose detectors
+ * are a \c group_transient_detector and a \c group_batch_size_detector bound
+ * to the group.
+ *
+ * With the \c lead_series_group_policy policy, only the observations of the
+ * lead member go through the detectors: the detection work of the group is the
+ * one of a single statistic.
+ * With the \c most_conservative_group_policy policy, every member runs its
+ * own detectors until they have all taken a decision, and the group takes the
+ * longest warm-up and the largest batch size estimated by its members.
+ *
+ * The truncation point of the group is counted in observations and applied to
+ * every member, which assumes that members are observed at the same rate.
+ * Members keep their observations until the transient phase of the group is
+ * over (except the lead series of the \c lead_series_group_policy policy,
+ * whose detector keeps them), and then put back the ones past the
+ * truncation point (the one which notified them of the decision included).
+ * During batch size detection they only accumulate the means of blocks of
+ * \c block_size observations, from which they build their batch means once the
+ * batch size is known; the batch size is thus rounded up to a multiple of the
+ * block size, which should be the initial batch size of the batch size
+ * detector.
+ * Like the partial batch of the sequential batch size detectors, the
+ * observations past the last complete batch (the blocks which do not fill a
+ * batch and the current partial block, i.e., less than a batch) are not taken
+ * back.
+ *
+ * The batch means engine runs a single experiment; a group used for more
+ * simulations must be reset (by means of \c reset) before each of them.
+ *
+ * \tparam TransientDetectorT The type of the transient phase detector.
+ * \tparam BatchSizeDetectorT The type of the batch size detector.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <
+	typename TransientDetectorT,
+	typename BatchSizeDetectorT
+>
+class statistic_group
+{
+	public: typedef TransientDetectorT transient_phase_detector_type;
+	public: typedef BatchSizeDetectorT batch_size_detector_type;
+	public: typedef typename transient_phase_detector_type::real_type real_type;
+	public: typedef typename transient_phase_detector_type::uint_type uint_type;
+	public: typedef ::std::size_t member_identifier_type;
+	public: typedef typename transient_phase_detector_type::sample_container sample_container;
+	public: typedef typename batch_size_detector_type::vector_type vector_type;
+	private: typedef ::std::vector<transient_phase_detector_type> transient_phase_detector_container;
+	private: typedef ::std::vector<batch_size_detector_type> batch_size_detector_container;
+
+
+	public: static const uint_type default_block_size = 50;
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param policy The policy for taking decisions.
+	 * \param transient_detector The transient phase detector, copied for
+	 *  every series running it.
+	 * \param size_detector The batch size detector, copied for every series
+	 *  running it.
+	 * \param block_size The number of observations whose mean is accumulated
+	 *  by members during batch size detection.
+	 */
+	public: explicit statistic_group(statistic_group_policy policy = lead_series_group_policy,
+									 transient_phase_detector_type const& transient_detector = transient_phase_detector_type(),
+									 batch_size_detector_type const& size_detector = batch_size_detector_type(),
+									 uint_type block_size = default_block_size)
+	: policy_(policy),
+	  trans_proto_(transient_detector),
+	  size_proto_(size_detector),
+	  block_size_(block_size),
+	  lead_(0),
+	  num_members_(0)
+	{
+		// pre: block_size > 0
+		DCS_ASSERT(
+			block_size_ > 0,
+			throw ::std::invalid_argument("[dcs::des::batch_means::statistic_group::ctor] Block size must be positive.")
+		);
+
+		reset();
+	}
+
+
+	/**
+	 * \brief Add a new member to this group.
+	 *
+	 * \param lead If \c true, the new member is the lead series of the group
+	 *  (by default, the lead series is the first member).
+	 * \return The identifier of the new member.
+	 */
+	public: member_identifier_type add_member(bool lead = false)
+	{
+		member_identifier_type id(num_members_++);
+
+		if (lead)
+		{
+			lead_ = id;
+		}
+
+		if (policy_ == most_conservative_group_policy)
+		{
+			trans_detectors_.push_back(trans_proto_);
+			size_detectors_.push_back(size_proto_);
+			trans_done_.push_back(false);
+			size_done_.push_back(false);
+		}
+
+		return id;
+	}
+
+
+	public: ::std::size_t num_members() const
+	{
+		return num_members_;
+	}
+
+
+	public: statistic_group_policy policy() const
+	{
+		return policy_;
+	}
+
+
+	public: uint_type block_size() const
+	{
+		return block_size_;
+	}
+
+
+	/// Tells if the given member runs the detectors of the group.
+	public: bool drives(member_identifier_type id) const
+	{
+		return policy_ == most_conservative_group_policy || id == lead_;
+	}
+
+
+	/**
+	 * \brief Tells if the given member must keep its observations until the
+	 *  transient phase of the group is over.
+	 *
+	 * Only the lead series of the \c lead_series_group_policy policy surely
+	 * takes the decision, and its detector already keeps its observations.
+	 */
+	public: bool keeps_transient_observations(member_identifier_type id) const
+	{
+		return policy_ == most_conservative_group_policy || id != lead_;
+	}
+
+
+	/// Clear the decisions of the group and the state of its detectors.
+	public: void reset()
+	{
+		if (policy_ == most_conservative_group_policy)
+		{
+			trans_detectors_.assign(num_members_, trans_proto_);
+			size_detectors_.assign(num_members_, size_proto_);
+			trans_done_.assign(num_members_, false);
+			size_done_.assign(num_members_, false);
+		}
+		else
+		{
+			trans_detectors_.assign(1, trans_proto_);
+			size_detectors_.assign(1, size_proto_);
+		}
+
+		trans_detected_ = trans_aborted_
+						= size_detected_
+						= size_aborted_
+						= false;
+		num_trans_done_ = num_size_done_
+						= ::std::size_t(0);
+		trans_decider_ = num_members_;
+		trans_len_ = batch_size_
+				   = uint_type(0);
+	}
+
+
+	//@{ Transient phase
+
+	/**
+	 * \brief Pass an observation of the given member to the transient phase
+	 *  detector of the group.
+	 *
+	 * \return \c true if the transient phase of the group is over; \c false
+	 *  otherwise.
+	 */
+	public: bool detect_transient(member_identifier_type id, real_type obs, real_type weight)
+	{
+		if (trans_detected_ || trans_aborted_)
+		{
+			return trans_detected_;
+		}
+		if (!drives(id))
+		{
+			return false;
+		}
+
+		::std::size_t i(pipeline(id));
+
+		if (policy_ == most_conservative_group_policy && trans_done_[i])
+		{
+			// Waiting for the other members
+			return false;
+		}
+
+		if (trans_detectors_[i].detect(obs, weight))
+		{
+			// Recorded now, since detectors are reset once they are done
+			trans_len_ = ::std::max(trans_len_, trans_detectors_[i].estimated_size());
+
+			if (policy_ == most_conservative_group_policy)
+			{
+				trans_done_[i] = true;
+				++num_trans_done_;
+				if (num_trans_done_ < num_members_)
+				{
+					// Observations of this member are kept by its member
+					// detector until the other members are done.
+					trans_detectors_[i].reset();
+					return false;
+				}
+			}
+
+			DCS_DEBUG_TRACE("(" << this << ") Transient phase of the group detected by member #" << id << ".");
+
+			trans_detected_ = true;
+			trans_decider_ = id;
+		}
+		else if (trans_detectors_[i].aborted())
+		{
+			DCS_DEBUG_TRACE("(" << this << ") Transient phase detection of the group aborted by member #" << id << ".");
+
+			trans_aborted_ = true;
+		}
+
+		return trans_detected_;
+	}
+
+
+	public: bool transient_phase_detected() const
+	{
+		return trans_detected_;
+	}
+
+
+	public: bool transient_phase_aborted() const
+	{
+		return trans_aborted_;
+	}
+
+
+	/// Tells if the given member has taken the transient phase decision.
+	public: bool transient_phase_decider(member_identifier_type id) const
+	{
+		return trans_detected_ && id == trans_decider_;
+	}
+
+
+	/// The truncation point of the group, that is the longest transient
+	/// length estimated by the members running the detectors.
+	public: uint_type decider_transient_length() const
+	{
+		return trans_len_;
+	}
+
+
+	/// The steady-state observations kept by the detector of the lead series
+	/// (with the \c lead_series_group_policy policy).
+	public: sample_container decider_steady_state_observations() const
+	{
+		return trans_detectors_[pipeline(trans_decider_)].steady_state_observations();
+	}
+
+
+	/// Release the memory of the transient phase detectors once the decision
+	/// has been taken.
+	public: void release_transient_detectors()
+	{
+		if (trans_detected_)
+		{
+			for (::std::size_t i = 0; i < trans_detectors_.size(); ++i)
+			{
+				trans_detectors_[i].reset();
+			}
+		}
+	}
+
+	//@} Transient phase
+
+
+	//@{ Batch size
+
+	/**
+	 * \brief Pass an observation of the given member to the batch size
+	 *  detector of the group.
+	 *
+	 * \return \c true if the batch size of the group has been detected;
+	 *  \c false otherwise.
+	 */
+	public: bool detect_batch_size(member_identifier_type id, real_type obs, real_type weight)
+	{
+		if (size_detected_ || size_aborted_)
+		{
+			return size_detected_;
+		}
+		if (!drives(id))
+		{
+			return false;
+		}
+
+		::std::size_t i(pipeline(id));
+
+		if (policy_ == most_conservative_group_policy && size_done_[i])
+		{
+			// Waiting for the other members
+			return false;
+		}
+
+		if (size_detectors_[i].detect(obs, weight))
+		{
+			batch_size_ = ::std::max(batch_size_, size_detectors_[i].estimated_size());
+			size_detectors_[i].reset();
+
+			if (policy_ == most_conservative_group_policy)
+			{
+				size_done_[i] = true;
+				++num_size_done_;
+				if (num_size_done_ < num_members_)
+				{
+					return false;
+				}
+			}
+
+			// Round up to a multiple of the block size
+			batch_size_ = ((batch_size_+block_size_-1)/block_size_)*block_size_;
+
+			DCS_DEBUG_TRACE("(" << this << ") Batch size of the group detected by member #" << id << ": " << batch_size_);
+
+			size_detected_ = true;
+		}
+		else if (size_detectors_[i].aborted())
+		{
+			DCS_DEBUG_TRACE("(" << this << ") Batch size detection of the group aborted by member #" << id << ".");
+
+			size_aborted_ = true;
+		}
+
+		return size_detected_;
+	}
+
+
+	public: bool batch_size_detected() const
+	{
+		return size_detected_;
+	}
+
+
+	public: bool batch_size_aborted() const
+	{
+		return size_aborted_;
+	}
+
+
+	public: uint_type batch_size() const
+	{
+		return batch_size_;
+	}
+
+	//@} Batch size
+
+
+	/// Index of the detectors run for the given member.
+	private: ::std::size_t pipeline(member_identifier_type id) const
+	{
+		return policy_ == most_conservative_group_policy ? id : 0;
+	}
+
+
+	private: statistic_group_policy policy_;
+	private: transient_phase_detector_type trans_proto_;
+	private: batch_size_detector_type size_proto_;
+	private: uint_type block_size_;
+	private: member_identifier_type lead_;
+	private: ::std::size_t num_members_;
+	private: transient_phase_detector_container trans_detectors_;
+	private: batch_size_detector_container size_detectors_;
+	private: ::std::vector<bool> trans_done_;
+	private: ::std::vector<bool> size_done_;
+	private: ::std::size_t num_trans_done_;
+	private: ::std::size_t num_size_done_;
+	private: bool trans_detected_;
+	private: bool trans_aborted_;
+	private: member_identifier_type trans_decider_;
+	private: uint_type trans_len_;
+	private: bool size_detected_;
+	private: bool size_aborted_;
+	private: uint_type batch_size_;
+};
+
+
+/**
+ * \brief Transient phase detector of a member of a statistic group.
+ *
+ * Models the TransientDetector concept used by \c analyzable_statistic.
+ *
+ * \tparam GroupT The type of the statistic group.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename GroupT>
+class group_transient_detector
+{
+	public: typedef GroupT group_type;
+	public: typedef ::boost::shared_ptr<group_type> group_pointer;
+	public: typedef typename group_type::real_type real_type;
+	public: typedef typename group_type::uint_type uint_type;
+	public: typedef typename group_type::member_identifier_type member_identifier_type;
+	public: typedef typename group_type::sample_container sample_container;
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param ptr_group The group.
+	 * \param id The identifier of the member in the group (see
+	 *  \c statistic_group::add_member).
+	 */
+	public: group_transient_detector(group_pointer const& ptr_group, member_identifier_type id)
+	: ptr_group_(ptr_group),
+	  id_(id),
+	  num_obs_(0)
+	{
+	}
+
+
+	public: bool detect(real_type obs, real_type weight)
+	{
+		++num_obs_;
+		if (ptr_group_->keeps_transient_observations(id_))
+		{
+			obs_.push_back(::std::make_pair(obs, weight));
+		}
+
+		return ptr_group_->detect_transient(id_, obs, weight);
+	}
+
+
+	public: bool detected() const
+	{
+		return ptr_group_->transient_phase_detected();
+	}
+
+
+	public: bool aborted() const
+	{
+		return ptr_group_->transient_phase_aborted();
+	}
+
+
+	/// The number of observations deleted by this member.
+	public: uint_type estimated_size() const
+	{
+		if (ptr_group_->transient_phase_decider(id_))
+		{
+			return ptr_group_->decider_transient_length();
+		}
+
+		return ::std::min(num_obs_, ptr_group_->decider_transient_length());
+	}
+
+
+	/// The steady-state observations to put back, that is the ones past the
+	/// truncation point of the group.
+	public: sample_container steady_state_observations() const
+	{
+		if (!ptr_group_->keeps_transient_observations(id_))
+		{
+			return ptr_group_->decider_steady_state_observations();
+		}
+
+		::std::size_t n0(::std::min(obs_.size(), ::std::size_t(ptr_group_->decider_transient_length())));
+
+		return sample_container(obs_.begin()+n0, obs_.end());
+	}
+
+
+	public: void reset()
+	{
+		num_obs_ = 0;
+		sample_container().swap(obs_);
+		if (ptr_group_->transient_phase_decider(id_))
+		{
+			ptr_group_->release_transient_detectors();
+		}
+	}
+
+
+	private: group_pointer ptr_group_;
+	private: member_identifier_type id_;
+	private: uint_type num_obs_;
+	/// The observations kept until the transient phase of the group is over.
+	private: sample_container obs_;
+};
+
+
+/**
+ * \brief Batch size detector of a member of a statistic group.
+ *
+ * Models the BatchSizeDetector concept used by \c analyzable_statistic.
+ * While the group detects the batch size, the member only keeps the means of
+ * blocks of observations and, once the batch size is known, combines them
+ * into the batch means taken back by the statistic.
+ *
+ * \tparam GroupT The type of the statistic group.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename GroupT>
+class group_batch_size_detector
+{
+	public: typedef GroupT group_type;
+	public: typedef ::boost::shared_ptr<group_type> group_pointer;
+	public: typedef typename group_type::real_type real_type;
+	public: typedef typename group_type::uint_type uint_type;
+	public: typedef typename group_type::member_identifier_type member_identifier_type;
+	public: typedef ::std::vector<real_type> vector_type;
+	private: typedef ::std::vector<real_type, typename memory_accounting_allocator<real_type,batch_means_memory_category>::type> block_container;
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param ptr_group The group.
+	 * \param id The identifier of the member in the group (see
+	 *  \c statistic_group::add_member).
+	 */
+	public: group_batch_size_detector(group_pointer const& ptr_group, member_identifier_type id)
+	: ptr_group_(ptr_group),
+	  id_(id),
+	  block_num_obs_(0)
+	{
+	}
+
+
+	public: bool detect(real_type obs, real_type weight)
+	{
+		block_mean_(obs, weight);
+		++block_num_obs_;
+		if (block_num_obs_ == ptr_group_->block_size())
+		{
+			blocks_.push_back(block_mean_.estimate());
+			block_mean_.reset();
+			block_num_obs_ = 0;
+		}
+
+		return ptr_group_->detect_batch_size(id_, obs, weight);
+	}
+
+
+	public: bool detected() const
+	{
+		return ptr_group_->batch_size_detected();
+	}
+
+
+	public: bool aborted() const
+	{
+		return ptr_group_->batch_size_aborted();
+	}
+
+
+	public: uint_type estimated_size() const
+	{
+		return ptr_group_->batch_size();
+	}
+
+
+	/// The batch means made of the complete batches of blocks collected so
+	/// far.
+	public: vector_type computed_estimators() const
+	{
+		vector_type means;
+
+		if (!ptr_group_->batch_size_detected())
+		{
+			return means;
+		}
+
+		::std::size_t m(ptr_group_->batch_size()/ptr_group_->block_size());
+		::std::size_t n(blocks_.size()/m);
+
+		means.reserve(n);
+		for (::std::size_t i = 0; i < n; ++i)
+		{
+			real_type sum(0);
+			for (::std::size_t j = i*m; j < (i+1)*m; ++j)
+			{
+				sum += blocks_[j];
+			}
+			means.push_back(sum/real_type(m));
+		}
+
+		return means;
+	}
+
+
+	public: void reset()
+	{
+		blocks_.clear();
+		block_mean_.reset();
+		block_num_obs_ = 0;
+	}
+
+
+	private: group_pointer ptr_group_;
+	private: member_identifier_type id_;
+	private: block_container blocks_;
+	private: weighted_mean_estimator<real_type,uint_type> block_mean_;
+	private: uint_type block_num_obs_;
+};
+
+
+/// Default statistic group.
+template <typename RealT=double, typename UIntT=::std::size_t>
+struct default_statistic_group
+{
+	typedef statistic_group<
+				::dcs::des::spectral::pawlikowski1990_transient_detector<RealT,UIntT>,
+				pawlikowski1990_batch_size_detector<RealT,UIntT>
+			> type;
+};
+
+}}} // Namespace dcs::des::batch_means
+
+
+#endif // DCS_DES_BATCH_MEANS_STATISTIC_GROUP_HPP
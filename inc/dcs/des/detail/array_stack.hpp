@@ -0,0 +1,158 @@
+/**
+ * \file dcs/des/detail/array_stack.hpp
+ *
+ * \brief Fixed-capacity LIFO stack stored in a contiguous array.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_DETAIL_ARRAY_STACK_HPP
+#define DCS_DES_DETAIL_ARRAY_STACK_HPP
+
+
+#include <cstddef>
+#include <dcs/debug.hpp>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace detail {
+
+/**
+ * \brief Fixed-capacity LIFO stack stored in a contiguous array.
+ *
+ * \tparam T The type of the elements; it must be default-constructible and
+ *  assignable.
+ *
+ * Storage is allocated once (at construction or by \c reserve) and is never
+ * allocated by \c push and \c pop.
+ * Popped slots are overwritten with a default-constructed value, so that
+ * resources held by the element (e.g., a shared pointer) are released at once.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename T>
+class array_stack
+{
+	public: typedef T value_type;
+	public: typedef value_type& reference;
+	public: typedef value_type const& const_reference;
+	public: typedef ::std::size_t size_type;
+
+
+	public: explicit array_stack(size_type capacity = 0)
+	: buf_(capacity),
+	  size_(0)
+	{
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+
+
+	public: void push(value_type const& value)
+	{
+		// pre: stack is not full
+		DCS_DEBUG_ASSERT( !full() );
+
+		buf_[size_++] = value;
+	}
+
+
+	public: void pop()
+	{
+		// pre: stack is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		buf_[--size_] = value_type();
+	}
+
+
+	public: reference top()
+	{
+		// pre: stack is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		return buf_[size_-1];
+	}
+
+
+	public: const_reference top() const
+	{
+		// pre: stack is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		return buf_[size_-1];
+	}
+
+
+	public: bool empty() const
+	{
+		return size_ == 0;
+	}
+
+
+	public: bool full() const
+	{
+		return size_ == buf_.size();
+	}
+
+
+	public: size_type size() const
+	{
+		return size_;
+	}
+
+
+	public: size_type capacity() const
+	{
+		return buf_.size();
+	}
+
+
+	/// Grow the capacity to at least \a n elements, keeping the stored ones.
+	public: void reserve(size_type n)
+	{
+		if (n > buf_.size())
+		{
+			buf_.resize(n);
+		}
+	}
+
+
+	public: void clear()
+	{
+		while (!empty())
+		{
+			pop();
+		}
+	}
+
+
+	private: ::std::vector<value_type> buf_;
+	private: size_type size_;
+};
+
+}}} // Namespace dcs::des::detail
+
+
+#endif // DCS_DES_DETAIL_ARRAY_STACK_HPP
@@ -0,0 +1,183 @@
+/**
+ * \file dcs/des/detail/ring_buffer.hpp
+ *
+ * \brief Fixed-capacity FIFO ring buffer.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_DETAIL_RING_BUFFER_HPP
+#define DCS_DES_DETAIL_RING_BUFFER_HPP
+
+
+#include <cstddef>
+#include <dcs/debug.hpp>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace detail {
+
+/**
+ * \brief Fixed-capacity FIFO ring buffer.
+ *
+ * \tparam T The type of the elements; it must be default-constructible and
+ *  assignable.
+ *
+ * Storage is allocated once (at construction or by \c reserve) and is never
+ * allocated by \c push_back and \c pop_front.
+ * Popped slots are overwritten with a default-constructed value, so that
+ * resources held by the element (e.g., a shared pointer) are released at once.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename T>
+class ring_buffer
+{
+	public: typedef T value_type;
+	public: typedef value_type& reference;
+	public: typedef value_type const& const_reference;
+	public: typedef ::std::size_t size_type;
+
+
+	public: explicit ring_buffer(size_type capacity = 0)
+	: buf_(capacity),
+	  head_(0),
+	  size_(0)
+	{
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+
+
+	public: void push_back(value_type const& value)
+	{
+		// pre: buffer is not full
+		DCS_DEBUG_ASSERT( !full() );
+
+		size_type tail(head_+size_);
+		if (tail >= buf_.size())
+		{
+			tail -= buf_.size();
+		}
+		buf_[tail] = value;
+		++size_;
+	}
+
+
+	public: void pop_front()
+	{
+		// pre: buffer is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		buf_[head_] = value_type();
+		if (++head_ == buf_.size())
+		{
+			head_ = 0;
+		}
+		--size_;
+	}
+
+
+	public: reference front()
+	{
+		// pre: buffer is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		return buf_[head_];
+	}
+
+
+	public: const_reference front() const
+	{
+		// pre: buffer is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		return buf_[head_];
+	}
+
+
+	public: bool empty() const
+	{
+		return size_ == 0;
+	}
+
+
+	public: bool full() const
+	{
+		return size_ == buf_.size();
+	}
+
+
+	public: size_type size() const
+	{
+		return size_;
+	}
+
+
+	public: size_type capacity() const
+	{
+		return buf_.size();
+	}
+
+
+	/// Grow the capacity to at least \a n elements, keeping the stored ones.
+	public: void reserve(size_type n)
+	{
+		if (n <= buf_.size())
+		{
+			return;
+		}
+
+		const size_type sz(size_);
+		::std::vector<value_type> buf(n);
+		for (size_type i = 0; i < sz; ++i)
+		{
+			buf[i] = front();
+			pop_front();
+		}
+		buf_.swap(buf);
+		head_ = 0;
+		size_ = sz;
+	}
+
+
+	public: void clear()
+	{
+		while (!empty())
+		{
+			pop_front();
+		}
+		head_ = 0;
+	}
+
+
+	private: ::std::vector<value_type> buf_;
+	private: size_type head_;
+	private: size_type size_;
+};
+
+}}} // Namespace dcs::des::detail
+
+
+#endif // DCS_DES_DETAIL_RING_BUFFER_HPP
@@ -0,0 +1,376 @@
+/**
+ * \file dcs/des/detail/segmented_ring.hpp
+ *
+ * \brief Unbounded FIFO queue made of fixed-size chunks which are recycled.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_DETAIL_SEGMENTED_RING_HPP
+#define DCS_DES_DETAIL_SEGMENTED_RING_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <dcs/debug.hpp>
+#include <iterator>
+
+
+namespace dcs { namespace des { namespace detail {
+
+/**
+ * \brief Unbounded FIFO queue made of fixed-size chunks which are recycled.
+ *
+ * \tparam T The type of the elements; it must be default-constructible and
+ *  assignable.
+ * \tparam ChunkSize The number of elements stored in each chunk.
+ *
+ * Elements are stored in a linked list of chunks.
+ * A chunk drained by \c pop_front is kept in a free list and reused by a later
+ * \c push_back, so that once the queue has reached its peak length no further
+ * memory is allocated (unlike \c std::deque, which frees and allocates its
+ * blocks as the queue moves through memory).
+ * Memory held by the free list is released by \c shrink_to_fit or by the
+ * destructor.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename T, ::std::size_t ChunkSize=64>
+class segmented_ring
+{
+	public: typedef T value_type;
+	public: typedef value_type& reference;
+	public: typedef value_type const& const_reference;
+	public: typedef ::std::size_t size_type;
+	private: struct chunk
+	{
+		chunk()
+		: next(0)
+		{
+		}
+
+		value_type data[ChunkSize];
+		chunk* next;
+	};
+
+
+	public: class const_iterator: public ::std::iterator< ::std::forward_iterator_tag, value_type, ::std::ptrdiff_t, value_type const*, value_type const& >
+	{
+		public: const_iterator()
+		: ptr_chunk_(0),
+		  pos_(0),
+		  left_(0)
+		{
+		}
+
+
+		public: const_iterator(chunk const* ptr_chunk, size_type pos, size_type left)
+		: ptr_chunk_(ptr_chunk),
+		  pos_(pos),
+		  left_(left)
+		{
+		}
+
+
+		public: value_type const& operator*() const
+		{
+			return ptr_chunk_->data[pos_];
+		}
+
+
+		public: value_type const* operator->() const
+		{
+			return &(ptr_chunk_->data[pos_]);
+		}
+
+
+		public: const_iterator& operator++()
+		{
+			--left_;
+			if (++pos_ == ChunkSize && left_ > 0)
+			{
+				ptr_chunk_ = ptr_chunk_->next;
+				pos_ = 0;
+			}
+			return *this;
+		}
+
+
+		public: const_iterator operator++(int)
+		{
+			const_iterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+
+		public: friend bool operator==(const_iterator const& x, const_iterator const& y)
+		{
+			return x.left_ == y.left_;
+		}
+
+
+		public: friend bool operator!=(const_iterator const& x, const_iterator const& y)
+		{
+			return x.left_ != y.left_;
+		}
+
+
+		private: chunk const* ptr_chunk_;
+		private: size_type pos_;
+		/// Number of elements from the current one to the end of the queue.
+		private: size_type left_;
+	};
+
+
+	public: segmented_ring()
+	: head_(0),
+	  tail_(0),
+	  head_pos_(0),
+	  tail_pos_(0),
+	  size_(0),
+	  free_(0)
+	{
+	}
+
+
+	public: segmented_ring(segmented_ring const& that)
+	: head_(0),
+	  tail_(0),
+	  head_pos_(0),
+	  tail_pos_(0),
+	  size_(0),
+	  free_(0)
+	{
+		for (const_iterator it = that.begin(), end_it = that.end(); it != end_it; ++it)
+		{
+			push_back(*it);
+		}
+	}
+
+
+	public: ~segmented_ring()
+	{
+		release(head_);
+		release(free_);
+	}
+
+
+	public: segmented_ring& operator=(segmented_ring const& rhs)
+	{
+		if (this != &rhs)
+		{
+			segmented_ring tmp(rhs);
+			swap(tmp);
+		}
+
+		return *this;
+	}
+
+
+	public: void swap(segmented_ring& that)
+	{
+		::std::swap(head_, that.head_);
+		::std::swap(tail_, that.tail_);
+		::std::swap(head_pos_, that.head_pos_);
+		::std::swap(tail_pos_, that.tail_pos_);
+		::std::swap(size_, that.size_);
+		::std::swap(free_, that.free_);
+	}
+
+
+	public: void push_back(value_type const& value)
+	{
+		if (!tail_)
+		{
+			head_ = tail_ = acquire();
+			head_pos_ = tail_pos_ = 0;
+		}
+		else if (tail_pos_ == ChunkSize)
+		{
+			chunk* ptr_chunk(acquire());
+			tail_->next = ptr_chunk;
+			tail_ = ptr_chunk;
+			tail_pos_ = 0;
+		}
+		tail_->data[tail_pos_++] = value;
+		++size_;
+	}
+
+
+	public: void pop_front()
+	{
+		// pre: queue is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		head_->data[head_pos_++] = value_type();
+		--size_;
+
+		if (size_ == 0)
+		{
+			// Keep the only chunk and restart from its beginning
+			head_pos_ = tail_pos_ = 0;
+		}
+		else if (head_pos_ == ChunkSize)
+		{
+			chunk* ptr_chunk(head_);
+			head_ = head_->next;
+			head_pos_ = 0;
+			recycle(ptr_chunk);
+		}
+	}
+
+
+	public: reference front()
+	{
+		// pre: queue is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		return head_->data[head_pos_];
+	}
+
+
+	public: const_reference front() const
+	{
+		// pre: queue is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		return head_->data[head_pos_];
+	}
+
+
+	public: reference back()
+	{
+		// pre: queue is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		return tail_->data[tail_pos_-1];
+	}
+
+
+	public: const_reference back() const
+	{
+		// pre: queue is not empty
+		DCS_DEBUG_ASSERT( !empty() );
+
+		return tail_->data[tail_pos_-1];
+	}
+
+
+	public: bool empty() const
+	{
+		return size_ == 0;
+	}
+
+
+	public: size_type size() const
+	{
+		return size_;
+	}
+
+
+	public: const_iterator begin() const
+	{
+		return const_iterator(head_, head_pos_, size_);
+	}
+
+
+	public: const_iterator end() const
+	{
+		return const_iterator();
+	}
+
+
+	/// Remove all the elements, keeping their chunks for later reuse.
+	public: void clear()
+	{
+		while (head_)
+		{
+			chunk* ptr_chunk(head_);
+			head_ = head_->next;
+			for (size_type i = 0; i < ChunkSize; ++i)
+			{
+				ptr_chunk->data[i] = value_type();
+			}
+			recycle(ptr_chunk);
+		}
+		tail_ = 0;
+		head_pos_ = tail_pos_ = 0;
+		size_ = 0;
+	}
+
+
+	/// Release the memory held by recycled chunks.
+	public: void shrink_to_fit()
+	{
+		release(free_);
+		free_ = 0;
+	}
+
+
+	private: chunk* acquire()
+	{
+		if (free_)
+		{
+			chunk* ptr_chunk(free_);
+			free_ = free_->next;
+			ptr_chunk->next = 0;
+			return ptr_chunk;
+		}
+
+		return new chunk();
+	}
+
+
+	private: void recycle(chunk* ptr_chunk)
+	{
+		ptr_chunk->next = free_;
+		free_ = ptr_chunk;
+	}
+
+
+	private: static void release(chunk* ptr_chunk)
+	{
+		while (ptr_chunk)
+		{
+			chunk* ptr_next(ptr_chunk->next);
+			delete ptr_chunk;
+			ptr_chunk = ptr_next;
+		}
+	}
+
+
+	private: chunk* head_;
+	private: chunk* tail_;
+	/// Position of the first element in the head chunk.
+	private: size_type head_pos_;
+	/// Position past the last element in the tail chunk.
+	private: size_type tail_pos_;
+	private: size_type size_;
+	/// Chunks drained and kept for reuse.
+	private: chunk* free_;
+};
+
+}}} // Namespace dcs::des::detail
+
+
+#endif // DCS_DES_DETAIL_SEGMENTED_RING_HPP
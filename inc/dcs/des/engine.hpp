@@ -42,16 +42,21 @@
 #include <dcs/des/base_statistic.hpp>
 #include <dcs/des/event.hpp>
 #include <dcs/des/engine_context.hpp>
+#include <dcs/des/engine_diagnostics.hpp>
+#include <dcs/des/engine_snapshot.hpp>
 #include <dcs/des/event_list.hpp>
 #include <dcs/des/event_source.hpp>
+#include <dcs/des/memory_accounting.hpp>
+#include <dcs/des/null_engine_hooks.hpp>
 #include <dcs/exception.hpp>
 #include <dcs/macro.hpp>
 #include <dcs/math/traits/float.hpp>
 //#include <functional>
 #include <iostream>
+#include <limits>
 //#include <queue>
-//#include <vector>
 #include <map>
+#include <stdexcept>
 
 
 namespace dcs { namespace des {
@@ -64,6 +69,9 @@ namespace dcs { namespace des {
  * This simulator engine does not provide by itself any output analysis method.
  * Use one of simulator engine classes derived from this one (e.g., see
  * \c dcs::des::batch_means::engine for the batch means output analysis).
+ * Output analysis engines are built on \c dcs::des::static_engine, whose
+ * run loop is statically dispatched; this class is the dynamic interface
+ * seen by simulation models.
  *
  * There are three types of events: core, custom, and auxiliary.
  *
@@ -91,6 +99,7 @@ class engine
 	public: typedef ::std::size_t size_type;
 	public: typedef event<RealT> event_type;
 	public: typedef ::boost::shared_ptr<event_type> event_pointer;
+	public: typedef typename event_type::tick_type tick_type;
 	public: typedef engine_context<real_type> engine_context_type;
 	public: typedef event_source<real_type> event_source_type;
 	public: typedef ::boost::shared_ptr<event_source_type> event_source_pointer;
@@ -102,6 +111,14 @@ class engine
 	private: typedef ::std::map<analyzable_statistic_pointer,bool> analyzable_statistic_container;
 	protected: typedef typename analyzable_statistic_container::iterator analyzable_statistic_iterator;
 	protected: typedef typename analyzable_statistic_container::const_iterator analyzable_statistic_const_iterator;
+	private: typedef typename memory_accounting_allocator<event_type,event_list_memory_category>::type event_allocator_type;
+	public: typedef engine_snapshot<real_type> snapshot_type;
+	public: typedef ::dcs::des::snapshot_publisher<real_type> snapshot_publisher_type;
+	public: typedef ::boost::shared_ptr<snapshot_publisher_type> snapshot_publisher_pointer;
+
+
+	/// The default number of fired events between two published snapshots.
+	public: static const size_type default_snapshot_period = 10000;
 
 
 	public: template <typename RT> friend ::std::ostream& operator<<(::std::ostream&, engine<RT> const&);
@@ -117,14 +134,24 @@ class engine
 		  ptr_si_evt_src_(new event_source_type("System Initialization")),
 		  ptr_sf_evt_src_(new event_source_type("System Finalization")),
 		  sim_time_(0),
+		  sim_tick_(0),
+		  tick_res_(0),
 		  last_evt_time_(0),
 		  end_of_sim_(true),
 		  num_events_(0),
 		  num_usr_events_(0),
-		  mon_stats_()
+		  mon_stats_(),
 		  //ptr_mon_stat_()
+		  diag_(),
+		  ptr_snap_pub_(),
+		  snap_period_(default_snapshot_period),
+		  next_snap_evt_(0),
+		  snap_()
 	{
-		// empty
+		register_internal_event_source(ptr_bos_evt_src_);
+		register_internal_event_source(ptr_eos_evt_src_);
+		register_internal_event_source(ptr_bef_evt_src_);
+		register_internal_event_source(ptr_aef_evt_src_);
 	}
 
 
@@ -174,20 +201,31 @@ class engine
 
 		if (!ptr_src->enabled())
 		{
-			::std::clog << "[Warning] Tried to schedule an event from the disabled event source '" << *ptr_src << "' at time: " << time << " (Clock: " << sim_time_ << ")" << ::std::endl;
+			if (diag_.record(schedule_disabled_source_diagnostic))
+			{
+				diag_.stream() << "[Warning] Tried to schedule an event from the disabled event source '" << *ptr_src << "' at time: " << time << " (Clock: " << sim_time_ << ")" << ::std::endl;
+			}
 			return event_pointer();
 		}
 
+		tick_type tick(0);
+		quantize(time, tick);
+
 		// check: only schedule future (or immediate) events
-		if (time < sim_time_)
+		if (is_past(time, tick))
 		{
-			::std::clog << "[Warning] Fire time of event <" << *ptr_src << ", @ " << time << "> refers to the past: synched to current time (" << sim_time_ << ")." << ::std::endl;
+			if (diag_.record(schedule_past_time_diagnostic))
+			{
+				diag_.stream() << "[Warning] Fire time of event <" << *ptr_src << ", @ " << time << "> refers to the past: synched to current time (" << sim_time_ << ")." << ::std::endl;
+			}
 
 			time = sim_time_;
+			tick = sim_tick_;
 		}
 
 //		evt_list_.push(event_type(ptr_src, time));
-		event_pointer ptr_evt = ::boost::make_shared<event_type>(ptr_src, sim_time_, time);
+		event_pointer ptr_evt = ::boost::allocate_shared<event_type>(event_allocator_type(), ptr_src, sim_time_, time);
+		ptr_evt->fire_tick(tick);
 		evt_list_.push(ptr_evt);
 		return ptr_evt;
 	}
@@ -213,25 +251,80 @@ class engine
 
 		if (!ptr_src->enabled())
 		{
-			::std::clog << "[Warning] Tried to schedule an event from the disabled event source '" << *ptr_src << "' at time: " << time << " (Clock: " << sim_time_ << ")" << ::std::endl;
+			if (diag_.record(schedule_disabled_source_diagnostic))
+			{
+				diag_.stream() << "[Warning] Tried to schedule an event from the disabled event source '" << *ptr_src << "' at time: " << time << " (Clock: " << sim_time_ << ")" << ::std::endl;
+			}
 			return event_pointer();
 		}
 
+		tick_type tick(0);
+		quantize(time, tick);
+
 		// check: only future (or immediate) events can be scheduled
-		if (time < sim_time_)
+		if (is_past(time, tick))
 		{
-			::std::clog << "[Warning] Fire time of event <" << *ptr_src << ", @ " << time << "> refers to the past: synched to current time (" << sim_time_ << ")." << ::std::endl;
+			if (diag_.record(schedule_past_time_diagnostic))
+			{
+				diag_.stream() << "[Warning] Fire time of event <" << *ptr_src << ", @ " << time << "> refers to the past: synched to current time (" << sim_time_ << ")." << ::std::endl;
+			}
 
 			time = sim_time_;
+			tick = sim_tick_;
 		}
 
 //		evt_list_.push(event_type(ptr_src, time, state));
-		event_pointer ptr_evt = ::boost::make_shared<event_type>(ptr_src, sim_time_, time, state);
+		event_pointer ptr_evt = ::boost::allocate_shared<event_type>(event_allocator_type(), ptr_src, sim_time_, time, state);
+		ptr_evt->fire_tick(tick);
 		evt_list_.push(ptr_evt);
 		return ptr_evt;
 	}
 
 
+	/**
+	 * \brief Add a new event, directly delivered to the given handler, to be
+	 *  scheduled at the specified time.
+	 * \param ptr_src The event source the event belongs to.
+	 * \param time The time the event is to be scheduled.
+	 * \param handler The function called when the event is fired.
+	 * \param ptr_target The object passed to \a handler.
+	 *
+	 * The event does not go through the sinks connected to \a ptr_src (see
+	 * \c event::handler).
+	 */
+	public: event_pointer schedule_event(event_source_pointer const& ptr_src, real_type time, typename event_type::handler_type handler, void* ptr_target)
+	{
+		event_pointer ptr_evt = schedule_event(ptr_src, time);
+
+		if (ptr_evt)
+		{
+			ptr_evt->handler(handler, ptr_target);
+		}
+
+		return ptr_evt;
+	}
+
+
+	/**
+	 * \brief Add a new event with the given state, directly delivered to the
+	 *  given handler, to be scheduled at the specified time.
+	 *
+	 * See \c schedule_event(ptr_src, time, handler, ptr_target).
+	 */
+	public: template <typename T>
+		event_pointer schedule_event(event_source_pointer const& ptr_src, real_type time, T const& state, typename event_type::handler_type handler, void* ptr_target)
+	{
+		event_pointer ptr_evt = schedule_event(ptr_src, time, state);
+
+		if (ptr_evt)
+		{
+			ptr_evt->handler(handler, ptr_target);
+		}
+
+		return ptr_evt;
+	}
+
+
 	public: void reschedule_event(event_pointer const& ptr_evt, real_type time)
 	{
 		// check: paranoid check
@@ -239,7 +332,10 @@ class engine
 
 		if (!ptr_evt->source().enabled())
 		{
-			::std::clog << "[Warning] Tried to reschedule an event from the disabled event source '" << ptr_evt->source() << "' at time: " << time << " (Clock: " << sim_time_ << ")" << ::std::endl;
+			if (diag_.record(reschedule_disabled_source_diagnostic))
+			{
+				diag_.stream() << "[Warning] Tried to reschedule an event from the disabled event source '" << ptr_evt->source() << "' at time: " << time << " (Clock: " << sim_time_ << ")" << ::std::endl;
+			}
 			return;
 		}
 
@@ -249,32 +345,52 @@ class engine
 //				DCS_EXCEPTION_THROW( ::std::invalid_argument, "Cannot reschedule events from a disabled event source." )
 //			);
 
-		if (time < sim_time_)
+		tick_type tick(0);
+		quantize(time, tick);
+
+		if (is_past(time, tick))
 		{
-			if (ptr_evt->fire_time() > sim_time_)
+			if (is_future(*ptr_evt))
 			{
-				::std::clog << "[Warning] New fire time (" << time << ") of event " << *ptr_evt << "> refers to the past and will be adjusted to current time (" << sim_time_ << ")." << ::std::endl;
+				if (diag_.record(reschedule_past_time_adjusted_diagnostic))
+				{
+					diag_.stream() << "[Warning] New fire time (" << time << ") of event " << *ptr_evt << "> refers to the past and will be adjusted to current time (" << sim_time_ << ")." << ::std::endl;
+				}
 				time = sim_time_;
+				tick = sim_tick_;
 			}
 			else
 			{
-				::std::clog << "[Warning] New fire time (" << time << ") of event " << *ptr_evt << "> refers to the past and will not be rescheduled." << ::std::endl;
+				if (diag_.record(reschedule_past_time_ignored_diagnostic))
+				{
+					diag_.stream() << "[Warning] New fire time (" << time << ") of event " << *ptr_evt << "> refers to the past and will not be rescheduled." << ::std::endl;
+				}
 				return;
 			}
 		}
 
-		if (::dcs::math::float_traits<real_type>::essentially_equal(time, ptr_evt->fire_time()))
+		if (tick_res_ > 0
+			? tick == ptr_evt->fire_tick()
+			: ::dcs::math::float_traits<real_type>::essentially_equal(time, ptr_evt->fire_time()))
 		{
 			// Avoid to reschedule events with unchanged fire-time
-			::std::clog << "[Warning] New fire time (" << time << ") of event " << *ptr_evt << "> is approximately equal to the old one and will not be rescheduled." << ::std::endl;
+			if (diag_.record(reschedule_unchanged_time_diagnostic))
+			{
+				diag_.stream() << "[Warning] New fire time (" << time << ") of event " << *ptr_evt << "> is approximately equal to the old one and will not be rescheduled." << ::std::endl;
+			}
 			return;
 		}
 
 		// Only future (or immediate) events are rescheduled
 //		ptr_evt->fire_time(time);
 //		evt_list_.touch(ptr_evt);
-		evt_list_.erase(ptr_evt);
+		if (!evt_list_.erase(ptr_evt)
+			&& diag_.record(event_not_found_diagnostic))
+		{
+			diag_.stream() << "[Warning] Event " << *ptr_evt << " not removed because it has not been found." << ::std::endl;
+		}
 		ptr_evt->fire_time(time);
+		ptr_evt->fire_tick(tick);
 		evt_list_.push(ptr_evt);
 	}
 
@@ -497,6 +613,13 @@ class engine
 	}
 
 
+	/// Tell if the given statistic is analyzed by this engine.
+	public: bool is_analyzed_statistic(analyzable_statistic_pointer const& ptr_stat) const
+	{
+		return mon_stats_.count(ptr_stat) > 0;
+	}
+
+
 	/// Deregister all the analyzable statistics.
 	//public: void ignore_statistics()
 	public: void remove_statistics()
@@ -561,6 +684,101 @@ class engine
 	}
 
 
+	/**
+	 * \brief Set the resolution of the simulated clock.
+	 * \param res The length of a tick (in simulated time units), or zero for
+	 *  a continuous simulated clock (the default).
+	 *
+	 * With a positive resolution the engine runs in <em>integer-tick
+	 * mode</em>: every fire time is rounded to the nearest multiple of the
+	 * resolution and kept as a 64-bit number of ticks, so that events are
+	 * ordered, and compared to the simulated clock, through exact integer
+	 * comparisons (e.g., simultaneous events are exactly detected and fired in
+	 * FIFO order).
+	 * Times at the public interface are still expressed as real numbers.
+	 */
+	public: void time_resolution(real_type res)
+	{
+		// pre: resolution must be a non-negative number
+		DCS_ASSERT(
+			res >= 0,
+			throw ::std::invalid_argument("[dcs::des::engine::time_resolution] Invalid resolution.")
+		);
+		// pre: cannot change the clock resolution while the simulation is running
+		DCS_ASSERT(
+			end_of_sim_,
+			throw ::std::logic_error("[dcs::des::engine::time_resolution] Cannot change resolution while running.")
+		);
+
+		tick_res_ = res;
+	}
+
+
+	public: real_type time_resolution() const
+	{
+		return tick_res_;
+	}
+
+
+	/// Return the simulated time to date, expressed in integer ticks (zero if
+	/// integer-tick mode is not enabled).
+	public: tick_type simulated_ticks() const
+	{
+		return sim_tick_;
+	}
+
+
+	/// Convert the given simulated time to the nearest number of ticks.
+	public: tick_type to_ticks(real_type time) const
+	{
+		// pre: integer-tick mode must be enabled
+		DCS_ASSERT(
+			tick_res_ > 0,
+			throw ::std::logic_error("[dcs::des::engine::to_ticks] Integer-tick mode not enabled.")
+		);
+
+		real_type k(::std::floor(time/tick_res_+real_type(0.5)));
+
+		if (k >= static_cast<real_type>(::std::numeric_limits<tick_type>::max()))
+		{
+			return ::std::numeric_limits<tick_type>::max();
+		}
+		if (k <= static_cast<real_type>(-::std::numeric_limits<tick_type>::max()))
+		{
+			return -::std::numeric_limits<tick_type>::max();
+		}
+
+		return static_cast<tick_type>(k);
+	}
+
+
+	/// Convert the given number of ticks to simulated time.
+	public: real_type from_ticks(tick_type tick) const
+	{
+		return static_cast<real_type>(tick)*tick_res_;
+	}
+
+
+	/**
+	 * \brief Return the counters of the anomalies detected during the
+	 *  simulation.
+	 *
+	 * Anomalies (e.g., events scheduled in the past) are counted by kind and
+	 * only the first occurrences of each kind are reported; a summary is
+	 * reported at the end of the simulation.
+	 */
+	public: engine_diagnostics& diagnostics()
+	{
+		return diag_;
+	}
+
+
+	public: engine_diagnostics const& diagnostics() const
+	{
+		return diag_;
+	}
+
+
 	/**
 	 * \brief Tell if simulation is done.
 	 * \return \c true if simulation is done; \c false otherwise.
@@ -606,6 +824,62 @@ class engine
 	}
 
 
+	/**
+	 * \brief Publish a snapshot of the simulation to the given publisher
+	 *  every \a period fired events, and at the end of the simulation.
+	 *
+	 * Snapshots can be read from any other thread while the simulation is
+	 * running (see \c snapshot_publisher).
+	 * Pass a null pointer to stop publishing.
+	 */
+	public: void snapshot_publisher(snapshot_publisher_pointer const& ptr_pub, size_type period = default_snapshot_period)
+	{
+		// pre: period > 0
+		DCS_ASSERT(
+			period > 0,
+			throw ::std::invalid_argument("[dcs::des::engine::snapshot_publisher] Invalid period.")
+		);
+
+		ptr_snap_pub_ = ptr_pub;
+		snap_period_ = period;
+		next_snap_evt_ = num_events_+period;
+	}
+
+
+	public: snapshot_publisher_pointer snapshot_publisher() const
+	{
+		return ptr_snap_pub_;
+	}
+
+
+	/// Take a snapshot of the simulation and of the monitored statistics.
+	public: void snapshot(snapshot_type& snap) const
+	{
+		snap.simulated_time = sim_time_;
+		snap.num_events = num_events_;
+		snap.num_user_events = num_usr_events_;
+		snap.end_of_simulation = end_of_sim_;
+		snap.statistics.resize(mon_stats_.size());
+
+		::std::size_t i(0);
+		analyzable_statistic_const_iterator end_it(mon_stats_.end());
+		for (
+			analyzable_statistic_const_iterator it = mon_stats_.begin();
+			it != end_it;
+			++it
+		) {
+			typename snapshot_type::statistic_snapshot_type& stat_snap(snap.statistics[i++]);
+
+			stat_snap.id = it->first.get();
+			stat_snap.estimate = it->first->estimate();
+			stat_snap.half_width = it->first->half_width();
+			stat_snap.relative_precision = it->first->relative_precision();
+			stat_snap.num_observations = it->first->num_observations();
+			stat_snap.steady_state = it->first->steady_state_entered();
+		}
+	}
+
+
 	/// Stop the simulation just now.
 	public: void stop_now()
 	{
@@ -630,12 +904,27 @@ class engine
 	}
 
 
-	protected: virtual bool is_internal_event(event_type const& evt) const
+	/**
+	 * \brief Tell if the given event has been fired by a source registered
+	 *  as internal (see \c register_internal_event_source).
+	 *
+	 * Internal events are not counted as user events.
+	 * This is called for every fired event: the check is a flag of the event
+	 * source, not a lookup.
+	 */
+	protected: bool is_internal_event(event_type const& evt) const
+	{
+		return evt.source().internal();
+	}
+
+
+	/// Register the given event source as a source of internal events.
+	protected: void register_internal_event_source(event_source_pointer const& ptr_src)
 	{
-		return evt.source() == *ptr_bos_evt_src_
-			   || evt.source() == *ptr_eos_evt_src_
-			   || evt.source() == *ptr_bef_evt_src_
-			   || evt.source() == *ptr_aef_evt_src_;
+		// check: paranoid check
+		DCS_DEBUG_ASSERT( ptr_src );
+
+		ptr_src->internal(true);
 	}
 
 
@@ -663,8 +952,10 @@ class engine
 	{
 		sim_time_ = last_evt_time_
 				  = real_type(0);
+		sim_tick_ = tick_type(0);
 
 		num_events_ = size_type(0);
+		next_snap_evt_ = snap_period_;
 
 		end_of_sim_ = false;
 
@@ -684,6 +975,9 @@ class engine
 		// Reset statistics
 		reset_statistics();
 
+		// Reset anomaly counters
+		diag_.reset();
+
 //		// Insert a new begin-of-simulation event
 //		schedule_event(ptr_bos_evt_src_, real_type(0));
 //		// Fire the begin of simulation event
@@ -714,6 +1008,18 @@ class engine
 		// Immediately (schedule and) fire the END-OF-SIMULATION event
 //		engine_context_type ctx(this);
 		fire_immediate_event(ptr_eos_evt_src_, ctx);
+
+		if (ptr_snap_pub_)
+		{
+			publish_snapshot();
+		}
+
+		// Report the anomalies detected during the simulation
+		diag_.summary();
+
+#ifdef DCS_DES_CONFIG_MEMORY_ACCOUNTING
+		memory_accounting::report(::std::clog);
+#endif // DCS_DES_CONFIG_MEMORY_ACCOUNTING
 	}
 
 
@@ -740,6 +1046,19 @@ class engine
 
 
 	protected: void fire_next_event(engine_context_type& ctx)
+	{
+		null_engine_hooks<real_type> hooks;
+
+		fire_next_event(ctx, hooks);
+	}
+
+
+	/**
+	 * \brief Fire the next event of the future event list, calling the given
+	 *  (statically bound) hooks just before and just after firing it.
+	 */
+	protected: template <typename HooksT>
+		void fire_next_event(engine_context_type& ctx, HooksT& hooks)
 	{
 		if (!evt_list_.empty())
 		{
@@ -751,7 +1070,10 @@ class engine
 
 			if (!ptr_cur_evt->source().enabled())
 			{
-				::std::clog << "[Warning] Event '" << *ptr_cur_evt << "' will not be fired since its source is disabled." << ::std::endl;
+				if (diag_.record(fire_disabled_source_diagnostic))
+				{
+					diag_.stream() << "[Warning] Event '" << *ptr_cur_evt << "' will not be fired since its source is disabled." << ::std::endl;
+				}
 				return;
 			}
 
@@ -769,6 +1091,7 @@ class engine
 			//real_type cur_time = cur_evt.fire_time();
 			real_type cur_time = ptr_cur_evt->fire_time();
 			sim_time_ = cur_time;
+			sim_tick_ = ptr_cur_evt->fire_tick();
 
 			//DCS_DEBUG_TRACE_L(1, "Firing EVENT #" << num_events_ << ": " << cur_evt );
 			DCS_DEBUG_TRACE_L(1, "Firing EVENT #" << num_events_ << ": " << *ptr_cur_evt );
@@ -781,9 +1104,13 @@ class engine
 				++num_events_;
 			}
 
+			hooks.before_event(*ptr_cur_evt, ctx);
+
 			//cur_evt.fire(ctx);
 			ptr_cur_evt->fire(ctx);
 
+			hooks.after_event(*ptr_cur_evt, ctx);
+
 			// Firing the after-event-firing event
 			if (!ptr_aef_evt_src_->empty())
 			{
@@ -800,17 +1127,34 @@ class engine
 			{
 				end_of_sim_ = true;
 			}
+
+			if (ptr_snap_pub_ && num_events_ >= next_snap_evt_)
+			{
+				publish_snapshot();
+			}
 		}
 	}
 
 
+	private: void publish_snapshot()
+	{
+		snapshot(snap_);
+		ptr_snap_pub_->publish(snap_);
+		next_snap_evt_ = num_events_+snap_period_;
+	}
+
+
 	protected: void fire_immediate_event(event_source_pointer const& ptr_src, engine_context_type& ctx)
 	{
 		event_type cur_evt(ptr_src, sim_time_, sim_time_);
+		cur_evt.fire_tick(sim_tick_);
 
 		if (!cur_evt.source().enabled())
 		{
-			::std::clog << "[Warning] Immediate event '" << cur_evt << "' will not be fired since its source is disabled." << ::std::endl;
+			if (diag_.record(fire_disabled_source_diagnostic))
+			{
+				diag_.stream() << "[Warning] Immediate event '" << cur_evt << "' will not be fired since its source is disabled." << ::std::endl;
+			}
 			return;
 		}
 
@@ -853,10 +1197,14 @@ class engine
 		void fire_immediate_event(event_source_pointer const& ptr_src, engine_context_type& ctx, T const& state)
 	{
 		event_type cur_evt(ptr_src, sim_time_, sim_time_, state);
+		cur_evt.fire_tick(sim_tick_);
 
 		if (!cur_evt.source().enabled())
 		{
-			::std::clog << "[Warning] Immediate event '" << cur_evt << "' will not be fired since its source is disabled." << ::std::endl;
+			if (diag_.record(fire_disabled_source_diagnostic))
+			{
+				diag_.stream() << "[Warning] Immediate event '" << cur_evt << "' will not be fired since its source is disabled." << ::std::endl;
+			}
 			return;
 		}
 
@@ -998,6 +1346,14 @@ class engine
 	protected: void simulated_time(real_type value)
 	{
 		sim_time_ = value;
+		sim_tick_ = (tick_res_ > 0) ? to_ticks(value) : tick_type(0);
+	}
+
+
+	/// Tell if the given event fires at the current simulated time.
+	protected: bool is_concurrent_event(event_type const& evt) const
+	{
+		return (tick_res_ > 0) ? evt.fire_tick() == sim_tick_ : evt.fire_time() == sim_time_;
 	}
 
 
@@ -1015,7 +1371,36 @@ class engine
 
 	protected: event_type make_internal_event(event_source_pointer const& ptr_evt_src, event_type const& embedded_evt)
 	{
-		return event_type(ptr_evt_src, sim_time_, sim_time_, embedded_evt);
+		event_type evt(ptr_evt_src, sim_time_, sim_time_, embedded_evt);
+		evt.fire_tick(sim_tick_);
+		return evt;
+	}
+
+
+	/// In integer-tick mode, round the given time to the tick grid and return
+	/// the corresponding number of ticks (otherwise, leave it unchanged).
+	private: void quantize(real_type& time, tick_type& tick) const
+	{
+		if (tick_res_ > 0)
+		{
+			tick = to_ticks(time);
+			if (tick != ::std::numeric_limits<tick_type>::max())
+			{
+				time = from_ticks(tick);
+			}
+		}
+	}
+
+
+	private: bool is_past(real_type time, tick_type tick) const
+	{
+		return (tick_res_ > 0) ? tick < sim_tick_ : time < sim_time_;
+	}
+
+
+	private: bool is_future(event_type const& evt) const
+	{
+		return (tick_res_ > 0) ? evt.fire_tick() > sim_tick_ : evt.fire_time() > sim_time_;
 	}
 
 
@@ -1060,6 +1445,10 @@ class engine
 	private: event_source_pointer ptr_sf_evt_src_;
 	/// The simulated time (does not include pause time).
 	private: real_type sim_time_;
+	/// The simulated time in integer ticks (integer-tick mode only).
+	private: tick_type sim_tick_;
+	/// The length of a tick (zero for a continuous simulated clock).
+	private: real_type tick_res_;
 	/// The time of the last fired event.
 	private: real_type last_evt_time_;
 	/// Tell if simulation is done.
@@ -1072,6 +1461,16 @@ class engine
 	private: size_type num_usr_events_;
 	private: analyzable_statistic_container mon_stats_;
 	//private: analyzable_statistic_pointer ptr_mon_stat_;
+	/// Counters of the detected anomalies.
+	private: engine_diagnostics diag_;
+	/// The publisher of the snapshots of the simulation (if any).
+	private: snapshot_publisher_pointer ptr_snap_pub_;
+	/// The number of fired events between two published snapshots.
+	private: size_type snap_period_;
+	/// The number of fired events at which the next snapshot is published.
+	private: size_type next_snap_evt_;
+	/// The snapshot being published (reused to avoid allocations).
+	private: snapshot_type snap_;
 
 	//@} Member variables
 }; // engine
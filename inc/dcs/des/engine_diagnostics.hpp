@@ -0,0 +1,237 @@
+/**
+ * \file dcs/des/engine_diagnostics.hpp
+ *
+ * \brief Counters and rate-limited reporting for engine anomalies.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_ENGINE_DIAGNOSTICS_HPP
+#define DCS_DES_ENGINE_DIAGNOSTICS_HPP
+
+
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace dcs { namespace des {
+
+/// Kinds of anomalies detected by the simulation engines.
+enum engine_diagnostic_category
+{
+	schedule_disabled_source_diagnostic = 0, ///< Event scheduled from a disabled source.
+	schedule_past_time_diagnostic, ///< Event scheduled in the past (synched to the current time).
+	reschedule_disabled_source_diagnostic, ///< Event rescheduled from a disabled source.
+	reschedule_past_time_adjusted_diagnostic, ///< Event rescheduled in the past (adjusted to the current time).
+	reschedule_past_time_ignored_diagnostic, ///< Event rescheduled in the past (not rescheduled).
+	reschedule_unchanged_time_diagnostic, ///< Event rescheduled at (approximately) the same time.
+	fire_disabled_source_diagnostic, ///< Event not fired since its source is disabled.
+	event_not_found_diagnostic, ///< Event not removed since it is not in the event list.
+	empty_event_list_diagnostic, ///< Replication forcibly ended since the event list is empty.
+	num_engine_diagnostic_categories
+};
+
+
+/**
+ * \brief Counters and rate-limited reporting for engine anomalies.
+ *
+ * Every anomaly is counted by kind; only the first \c sample_size
+ * occurrences of each kind are reported on the output stream, so that the
+ * (possibly very frequent) anomalies of hot paths do not pay for formatted
+ * stream I/O.
+ * A summary with the counts of all the detected anomalies can be printed at
+ * the end of the simulation.
+ *
+ * Typical usage:
+ * <pre>
+ * if (diag.record(schedule_past_time_diagnostic))
+ * {
+ *     diag.stream() << "[Warning] ..." << ::std::endl;
+ * }
+ * </pre>
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+class engine_diagnostics
+{
+	public: typedef ::std::size_t size_type;
+
+
+	public: static const size_type default_sample_size = 10;
+
+
+	public: engine_diagnostics()
+	: counts_(num_engine_diagnostic_categories, 0),
+	  sample_size_(default_sample_size),
+	  ptr_os_(&::std::clog)
+	{
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+
+
+	/**
+	 * \brief Count an occurrence of the given anomaly.
+	 * \return \c true if the occurrence should be reported on the output
+	 *  stream; \c false otherwise.
+	 */
+	public: bool record(engine_diagnostic_category category)
+	{
+		return ++counts_[category] <= sample_size_ && ptr_os_;
+	}
+
+
+	/// The stream where sampled anomalies are reported.
+	public: ::std::ostream& stream()
+	{
+		// pre: output stream must be a valid pointer
+		DCS_ASSERT(
+			ptr_os_,
+			throw ::std::logic_error("[dcs::des::engine_diagnostics::stream] No output stream.")
+		);
+
+		return *ptr_os_;
+	}
+
+
+	/// Set the stream where sampled anomalies are reported (a null pointer
+	/// silences reporting while keeping counting).
+	public: void stream(::std::ostream* ptr_os)
+	{
+		ptr_os_ = ptr_os;
+	}
+
+
+	/// Set the number of occurrences reported for each kind of anomaly.
+	public: void sample_size(size_type n)
+	{
+		sample_size_ = n;
+	}
+
+
+	public: size_type sample_size() const
+	{
+		return sample_size_;
+	}
+
+
+	public: size_type count(engine_diagnostic_category category) const
+	{
+		return counts_[category];
+	}
+
+
+	public: size_type total_count() const
+	{
+		size_type n(0);
+		for (size_type i = 0; i < counts_.size(); ++i)
+		{
+			n += counts_[i];
+		}
+		return n;
+	}
+
+
+	public: void reset()
+	{
+		counts_.assign(num_engine_diagnostic_categories, 0);
+	}
+
+
+	/// Print the counts of all the detected anomalies.
+	public: void summary(::std::ostream& os) const
+	{
+		if (total_count() == 0)
+		{
+			return;
+		}
+
+		os << "[Warning] Engine diagnostics summary:" << ::std::endl;
+		for (size_type i = 0; i < counts_.size(); ++i)
+		{
+			if (counts_[i] > 0)
+			{
+				os << "  " << category_name(static_cast<engine_diagnostic_category>(i)) << ": " << counts_[i];
+				if (counts_[i] > sample_size_)
+				{
+					os << " (" << (counts_[i]-sample_size_) << " not reported)";
+				}
+				os << ::std::endl;
+			}
+		}
+	}
+
+
+	/// Print the summary on the output stream (if any).
+	public: void summary()
+	{
+		if (ptr_os_)
+		{
+			summary(*ptr_os_);
+		}
+	}
+
+
+	public: static char const* category_name(engine_diagnostic_category category)
+	{
+		switch (category)
+		{
+			case schedule_disabled_source_diagnostic:
+				return "Events scheduled from a disabled source";
+			case schedule_past_time_diagnostic:
+				return "Events scheduled in the past";
+			case reschedule_disabled_source_diagnostic:
+				return "Events rescheduled from a disabled source";
+			case reschedule_past_time_adjusted_diagnostic:
+				return "Events rescheduled in the past (adjusted)";
+			case reschedule_past_time_ignored_diagnostic:
+				return "Events rescheduled in the past (ignored)";
+			case reschedule_unchanged_time_diagnostic:
+				return "Events rescheduled at an unchanged time";
+			case fire_disabled_source_diagnostic:
+				return "Events not fired from a disabled source";
+			case event_not_found_diagnostic:
+				return "Events not found in the event list";
+			case empty_event_list_diagnostic:
+				return "Replications ended by an empty event list";
+			default:
+				break;
+		}
+
+		return "Unknown";
+	}
+
+
+	private: ::std::vector<size_type> counts_;
+	private: size_type sample_size_;
+	private: ::std::ostream* ptr_os_;
+};
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_ENGINE_DIAGNOSTICS_HPP
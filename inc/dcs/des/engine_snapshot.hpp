@@ -0,0 +1,442 @@
+/**
+ * \file dcs/des/engine_snapshot.hpp
+ *
+ * \brief Snapshots of a running simulation, readable from other threads.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_ENGINE_SNAPSHOT_HPP
+#define DCS_DES_ENGINE_SNAPSHOT_HPP
+
+
+#include <algorithm>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <dcs/assert.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace dcs { namespace des {
+
+/// The state of a monitored statistic at a given point of the simulation.
+template <typename RealT=double>
+struct statistic_snapshot
+{
+	typedef RealT real_type;
+
+	statistic_snapshot()
+	: id(0),
+	  estimate(0),
+	  half_width(0),
+	  relative_precision(0),
+	  num_observations(0),
+	  steady_state(false)
+	{
+	}
+
+	/// The address of the statistic (i.e., the raw analyzable statistic
+	/// pointer), to tell statistics apart.
+	void const* id;
+	real_type estimate;
+	real_type half_width;
+	real_type relative_precision;
+	::boost::uint64_t num_observations;
+	/// Tell if the statistic has entered the steady state.
+	bool steady_state;
+};
+
+
+/// The state of a simulation engine and of its monitored statistics at a
+/// given point of the simulation.
+template <typename RealT=double>
+struct engine_snapshot
+{
+	typedef RealT real_type;
+	typedef statistic_snapshot<real_type> statistic_snapshot_type;
+
+	engine_snapshot()
+	: simulated_time(0),
+	  num_events(0),
+	  num_user_events(0),
+	  end_of_simulation(false),
+	  statistics()
+	{
+	}
+
+	real_type simulated_time;
+	::boost::uint64_t num_events;
+	::boost::uint64_t num_user_events;
+	bool end_of_simulation;
+	::std::vector<statistic_snapshot_type> statistics;
+};
+
+
+namespace detail { namespace /*<unnamed>*/ {
+
+/// Magic header of binary snapshot time series.
+static const char snapshot_magic[8] = { 'D', 'C', 'S', 'S', 'N', 'A', 'P', '1' };
+
+
+template <typename T>
+inline void write_snapshot_field(::std::ostream& os, T value)
+{
+	os.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+
+template <typename T>
+inline bool read_snapshot_field(::std::istream& is, T& value)
+{
+	return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+}} // Namespace detail::<unnamed>
+
+
+/**
+ * \brief Write the header of a binary snapshot time series.
+ *
+ * The header is the 8-byte magic string \c DCSSNAP1.
+ */
+inline void write_snapshot_binary_header(::std::ostream& os)
+{
+	os.write(detail::snapshot_magic, sizeof(detail::snapshot_magic));
+}
+
+
+/**
+ * \brief Append a snapshot to a binary snapshot time series.
+ *
+ * A snapshot is stored as the simulated time (double), the number of events
+ * and of user events (64-bit unsigned integers), the end-of-simulation flag
+ * (one byte) and the number of statistics (32-bit unsigned integer), followed,
+ * for every statistic, by the estimate, half-width and relative precision
+ * (doubles), the number of observations (64-bit unsigned integer) and the
+ * steady-state flag (one byte); numbers are stored in the native byte order.
+ */
+template <typename RealT>
+void write_snapshot_binary(::std::ostream& os, engine_snapshot<RealT> const& snap)
+{
+	typedef typename engine_snapshot<RealT>::statistic_snapshot_type statistic_snapshot_type;
+
+	detail::write_snapshot_field(os, static_cast<double>(snap.simulated_time));
+	detail::write_snapshot_field(os, snap.num_events);
+	detail::write_snapshot_field(os, snap.num_user_events);
+	detail::write_snapshot_field(os, static_cast< ::boost::uint8_t >(snap.end_of_simulation));
+	detail::write_snapshot_field(os, static_cast< ::boost::uint32_t >(snap.statistics.size()));
+
+	typename ::std::vector<statistic_snapshot_type>::const_iterator end_it(snap.statistics.end());
+	for (typename ::std::vector<statistic_snapshot_type>::const_iterator it = snap.statistics.begin(); it != end_it; ++it)
+	{
+		detail::write_snapshot_field(os, static_cast<double>(it->estimate));
+		detail::write_snapshot_field(os, static_cast<double>(it->half_width));
+		detail::write_snapshot_field(os, static_cast<double>(it->relative_precision));
+		detail::write_snapshot_field(os, it->num_observations);
+		detail::write_snapshot_field(os, static_cast< ::boost::uint8_t >(it->steady_state));
+	}
+}
+
+
+/**
+ * \brief Read the header of a binary snapshot time series.
+ *
+ * \exception std::runtime_error Bad header.
+ */
+inline void read_snapshot_binary_header(::std::istream& is)
+{
+	char magic[sizeof(detail::snapshot_magic)];
+
+	is.read(magic, sizeof(magic));
+	if (!is || ::std::memcmp(magic, detail::snapshot_magic, sizeof(magic)) != 0)
+	{
+		throw ::std::runtime_error("[dcs::des::read_snapshot_binary_header] Bad snapshot header.");
+	}
+}
+
+
+/**
+ * \brief Read the next snapshot of a binary snapshot time series (see
+ *  \c write_snapshot_binary).
+ *
+ * Statistic identifiers are not stored and are read as null pointers.
+ *
+ * \return \c true if a snapshot has been read; \c false at the end of the
+ *  time series.
+ * \exception std::runtime_error Truncated snapshot.
+ */
+template <typename RealT>
+bool read_snapshot_binary(::std::istream& is, engine_snapshot<RealT>& snap)
+{
+	double time(0);
+	::boost::uint8_t eos(0);
+	::boost::uint32_t n(0);
+
+	if (!detail::read_snapshot_field(is, time))
+	{
+		return false;
+	}
+	if (!detail::read_snapshot_field(is, snap.num_events)
+		|| !detail::read_snapshot_field(is, snap.num_user_events)
+		|| !detail::read_snapshot_field(is, eos)
+		|| !detail::read_snapshot_field(is, n))
+	{
+		throw ::std::runtime_error("[dcs::des::read_snapshot_binary] Truncated snapshot.");
+	}
+	snap.simulated_time = static_cast<RealT>(time);
+	snap.end_of_simulation = eos != 0;
+	snap.statistics.resize(n);
+
+	for (::boost::uint32_t i = 0; i < n; ++i)
+	{
+		double est(0);
+		double hw(0);
+		double rp(0);
+		::boost::uint8_t steady(0);
+
+		if (!detail::read_snapshot_field(is, est)
+			|| !detail::read_snapshot_field(is, hw)
+			|| !detail::read_snapshot_field(is, rp)
+			|| !detail::read_snapshot_field(is, snap.statistics[i].num_observations)
+			|| !detail::read_snapshot_field(is, steady))
+		{
+			throw ::std::runtime_error("[dcs::des::read_snapshot_binary] Truncated snapshot.");
+		}
+		snap.statistics[i].id = 0;
+		snap.statistics[i].estimate = static_cast<RealT>(est);
+		snap.statistics[i].half_width = static_cast<RealT>(hw);
+		snap.statistics[i].relative_precision = static_cast<RealT>(rp);
+		snap.statistics[i].steady_state = steady != 0;
+	}
+
+	return true;
+}
+
+
+/**
+ * \brief Publishes the snapshots of a running simulation to reader threads.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * The simulation thread publishes snapshots (see
+ * \c engine::snapshot_publisher) and any other thread reads the last published
+ * one at any time, without locks: snapshots are published under a sequence
+ * lock, so that the writer never waits for readers, and a reader retries when
+ * it overlaps a publication.
+ * Storage for the statistics is allocated at construction, for a given
+ * maximum number of statistics; further statistics are not published.
+ *
+ * Optionally, published snapshots are also appended to a binary time series
+ * (see \c dump and \c write_snapshot_binary), by the simulation thread.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT=double>
+class snapshot_publisher
+{
+	public: typedef RealT real_type;
+	public: typedef engine_snapshot<real_type> snapshot_type;
+	public: typedef statistic_snapshot<real_type> statistic_snapshot_type;
+	public: typedef ::std::size_t size_type;
+	public: typedef unsigned long sequence_type;
+
+
+	public: static const size_type default_max_num_statistics = 32;
+
+
+	public: explicit snapshot_publisher(size_type max_num_stats = default_max_num_statistics)
+	: seq_(0),
+	  simulated_time_(0),
+	  num_events_(0),
+	  num_user_events_(0),
+	  end_of_sim_(false),
+	  num_stats_(0),
+	  stats_(max_num_stats),
+	  ptr_dump_os_(0),
+	  dump_period_(0),
+	  last_dump_time_(0),
+	  next_dump_time_(0)
+	{
+	}
+
+
+	/// Return the maximum number of published statistics.
+	public: size_type max_num_statistics() const
+	{
+		return stats_.size();
+	}
+
+
+	/**
+	 * \brief Also append the published snapshots to the given binary stream,
+	 *  at most once every \a period units of simulated time.
+	 *
+	 * The header of the time series is written at once; the stream must
+	 * outlive this object (or the dump must be stopped with \c stop_dump).
+	 * This is meant to be called before the simulation starts.
+	 */
+	public: void dump(::std::ostream& os, real_type period = real_type/*zero*/())
+	{
+		// pre: period >= 0
+		DCS_ASSERT(
+			period >= 0,
+			throw ::std::invalid_argument("[dcs::des::snapshot_publisher::dump] Invalid period.")
+		);
+
+		write_snapshot_binary_header(os);
+
+		ptr_dump_os_ = &os;
+		dump_period_ = period;
+		last_dump_time_ = next_dump_time_
+						= 0;
+	}
+
+
+	/// Stop appending the published snapshots to the binary stream.
+	public: void stop_dump()
+	{
+		if (ptr_dump_os_)
+		{
+			ptr_dump_os_->flush();
+		}
+		ptr_dump_os_ = 0;
+	}
+
+
+	/**
+	 * \brief Publish a new snapshot.
+	 *
+	 * Only the simulation thread may call this function.
+	 */
+	public: void publish(snapshot_type const& snap)
+	{
+		sequence_type seq(seq_.load(::boost::memory_order_relaxed));
+
+		// An odd sequence number marks a publication in progress
+		seq_.store(seq+1, ::boost::memory_order_relaxed);
+		::boost::atomic_thread_fence(::boost::memory_order_release);
+
+		simulated_time_ = snap.simulated_time;
+		num_events_ = snap.num_events;
+		num_user_events_ = snap.num_user_events;
+		end_of_sim_ = snap.end_of_simulation;
+		num_stats_ = ::std::min(snap.statistics.size(), stats_.size());
+		::std::copy(snap.statistics.begin(), snap.statistics.begin()+num_stats_, stats_.begin());
+
+		seq_.store(seq+2, ::boost::memory_order_release);
+
+		// The simulated time restarts from zero at every replication
+		if (ptr_dump_os_
+			&& (snap.simulated_time >= next_dump_time_
+				|| snap.simulated_time < last_dump_time_
+				|| snap.end_of_simulation))
+		{
+			write_snapshot_binary(*ptr_dump_os_, snap);
+			last_dump_time_ = snap.simulated_time;
+			next_dump_time_ = snap.simulated_time+dump_period_;
+			if (snap.end_of_simulation)
+			{
+				ptr_dump_os_->flush();
+			}
+		}
+	}
+
+
+	/**
+	 * \brief Try to read the last published snapshot.
+	 *
+	 * \return \c false if the read overlapped a publication, in which case
+	 *  \a snap is unspecified.
+	 */
+	public: bool try_read(snapshot_type& snap) const
+	{
+		// Allocate outside of the read section
+		snap.statistics.resize(stats_.size());
+
+		sequence_type seq(seq_.load(::boost::memory_order_acquire));
+		if (seq & 1)
+		{
+			return false;
+		}
+
+		snap.simulated_time = simulated_time_;
+		snap.num_events = num_events_;
+		snap.num_user_events = num_user_events_;
+		snap.end_of_simulation = end_of_sim_;
+		size_type n(::std::min(num_stats_, stats_.size()));
+		::std::copy(stats_.begin(), stats_.begin()+n, snap.statistics.begin());
+
+		::boost::atomic_thread_fence(::boost::memory_order_acquire);
+		if (seq_.load(::boost::memory_order_relaxed) != seq)
+		{
+			return false;
+		}
+
+		snap.statistics.resize(n);
+
+		return true;
+	}
+
+
+	/// Read the last published snapshot, retrying while publications overlap.
+	public: void read(snapshot_type& snap) const
+	{
+		while (!try_read(snap))
+		{
+			// Retry
+		}
+	}
+
+
+	/// Return the number of published snapshots.
+	public: sequence_type num_published() const
+	{
+		return seq_.load(::boost::memory_order_acquire)/2;
+	}
+
+
+	private: snapshot_publisher(snapshot_publisher const&);
+	private: snapshot_publisher& operator=(snapshot_publisher const&);
+
+
+	/// The sequence number (odd while a publication is in progress).
+	private: ::boost::atomic<sequence_type> seq_;
+	private: real_type simulated_time_;
+	private: ::boost::uint64_t num_events_;
+	private: ::boost::uint64_t num_user_events_;
+	private: bool end_of_sim_;
+	private: size_type num_stats_;
+	private: ::std::vector<statistic_snapshot_type> stats_;
+	private: ::std::ostream* ptr_dump_os_;
+	private: real_type dump_period_;
+	private: real_type last_dump_time_;
+	private: real_type next_dump_time_;
+};
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_ENGINE_SNAPSHOT_HPP
@@ -31,6 +31,8 @@
 
 #include <dcs/des/event_source.hpp>
 #include <dcs/des/fwd.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/smart_ptr.hpp>
 #include <dcs/type_traits/add_const.hpp>
 #include <dcs/type_traits/add_reference.hpp>
@@ -60,10 +62,15 @@ class event
 	public: typedef event_source<real_type> event_source_type;
 	public: typedef engine_context<real_type> engine_context_type;
 	public: typedef ::dcs::util::any state_type;
+	/// The type of the fire time expressed in integer ticks.
+	public: typedef ::boost::int64_t tick_type;
+	/// The type of the handler an event can be directly delivered to.
+	public: typedef void (*handler_type)(void*, event<RealT> const&, engine_context_type&);
 
 
 	//FIXME: let the creator of the event decide what ID to assigne
-	private: static unsigned long next_id;
+	/// The next event ID; atomic since events are created concurrently by the threaded runners.
+	private: static ::boost::atomic<unsigned long> next_id;
 
 
 	/**
@@ -76,8 +83,11 @@ class event
 		: ptr_src_(ptr_src),
 		  sched_time_(sched_time),
 		  fire_time_(fire_time),
+		  fire_tick_(0),
 		  state_(state),
-		  id_(next_id++)
+		  id_(next_id++),
+		  handler_(0),
+		  ptr_target_(0)
 	{
 		// empty
 	}
@@ -89,8 +99,11 @@ class event
 	: ptr_src_(that.ptr_src_),
 	  sched_time_(that.sched_time_),
 	  fire_time_(that.fire_time_),
+	  fire_tick_(that.fire_tick_),
 	  state_(that.state_),
-	  id_(that.id_)
+	  id_(that.id_),
+	  handler_(that.handler_),
+	  ptr_target_(that.ptr_target_)
 	  //id_(next_id++)
 	{
 		// FIXME: What to do with id_?
@@ -106,8 +119,11 @@ class event
 			ptr_src_ = rhs.ptr_src_;
 			sched_time_ = rhs.sched_time_;
 			fire_time_ = rhs.fire_time_;
+			fire_tick_ = rhs.fire_tick_;
 			state_ = rhs.state_;
 			id_ = rhs.id_;
+			handler_ = rhs.handler_;
+			ptr_target_ = rhs.ptr_target_;
 		}
 
 		return *this;
@@ -144,6 +160,25 @@ class event
 	}
 
 
+	/**
+	 * \brief Return the fire time expressed in integer ticks.
+	 *
+	 * When the engine runs in integer-tick mode, events are ordered by fire
+	 * tick; otherwise, the fire tick is always zero and events are ordered by
+	 * fire time.
+	 */
+	public: tick_type fire_tick() const
+	{
+		return fire_tick_;
+	}
+
+
+	public: void fire_tick(tick_type tick)
+	{
+		fire_tick_ = tick;
+	}
+
+
 	public: event_source_type const& source() const
 	{
 		return *ptr_src_;
@@ -152,7 +187,31 @@ class event
 
 	public: void fire(engine_context_type& ctx)
 	{
-		ptr_src_->emit(*this, ctx);
+		if (handler_)
+		{
+			if (ptr_src_->enabled())
+			{
+				handler_(ptr_target_, *this, ctx);
+			}
+		}
+		else
+		{
+			ptr_src_->emit(*this, ctx);
+		}
+	}
+
+
+	/**
+	 * \brief Deliver this event directly to the given handler.
+	 *
+	 * When fired, the event calls \a handler with \a ptr_target instead of
+	 * emitting a signal through its event source, which is then only used for
+	 * identification and for enabling/disabling the event.
+	 */
+	public: void handler(handler_type handler, void* ptr_target)
+	{
+		handler_ = handler;
+		ptr_target_ = ptr_target;
 	}
 
 
@@ -200,16 +259,22 @@ class event
 	private: real_type sched_time_;
 	/// The time this event is fired.
 	private: real_type fire_time_;
+	/// The time this event is fired, expressed in integer ticks.
+	private: tick_type fire_tick_;
 	/// The event state.
 	private: state_type state_;
 	/// The event identifier
 	private: unsigned long id_;
+	/// The handler this event is directly delivered to (if any).
+	private: handler_type handler_;
+	/// The object passed to the handler.
+	private: void* ptr_target_;
 
 	//@} Member variables
 };
 
 template <typename RealT>
-unsigned long event<RealT>::next_id = 0UL;
+::boost::atomic<unsigned long> event<RealT>::next_id(0UL);
 
 
 template <typename CharT, typename CharTraitsT, typename RealT>
@@ -231,14 +296,15 @@ template <typename CharT, typename CharTraitsT, typename RealT>
 template <typename RealT>
 bool operator<(event<RealT> const& x, event<RealT> const& y)
 {
-	return x.fire_time() < y.fire_time();
+	return x.fire_tick() < y.fire_tick()
+		   || (x.fire_tick() == y.fire_tick() && x.fire_time() < y.fire_time());
 }
 
 
 template <typename RealT>
 bool operator==(event<RealT> const& x, event<RealT> const& y)
 {
-	return x.fire_time() == y.fire_time();
+	return x.fire_tick() == y.fire_tick() && x.fire_time() == y.fire_time();
 }
 
 
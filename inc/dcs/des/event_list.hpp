@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <boost/smart_ptr.hpp>
+#include <dcs/des/memory_accounting.hpp>
 #include <functional>
 #include <list>
 #include <queue>
@@ -68,7 +69,7 @@ template <
 >
 class ordered_list
 {
-	private: typedef ::std::list<T> list_impl_type;
+	private: typedef ::std::list<T, typename memory_accounting_allocator<T,event_list_memory_category>::type> list_impl_type;
 	public: typedef T value_type;
 	public: typedef ComparatorT comparator_type;
 	public: typedef typename list_impl_type::pointer pointer;
@@ -299,7 +300,12 @@ class event_list
 	}
 
 
-	public: void erase(value_type const& evt)
+	/**
+	 * \brief Remove the given event from the list.
+	 * \return \c true if the event has been removed; \c false if it has not
+	 *  been found.
+	 */
+	public: bool erase(value_type const& evt)
 	{
 		//seq_.erase(::std::find(seq_.begin(), seq_.end(), evt));
 
@@ -314,14 +320,14 @@ class event_list
 		{
 			++it;
 		}
-		if (it != end_it)
-		{
-			seq_.erase(it);
-		}
-		else
+		if (it == end_it)
 		{
-			::std::clog << "[Warning] Event " << *evt << " not removed because it has not been found." << ::std::endl;
+			return false;
 		}
+
+		seq_.erase(it);
+
+		return true;
 	}
 
 
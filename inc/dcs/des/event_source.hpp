@@ -29,6 +29,7 @@
 #define DCS_DES_EVENT_SOURCE_HPP
 
 
+#include <boost/atomic.hpp>
 #include <boost/signals2.hpp>
 #include <boost/smart_ptr.hpp>
 #include <cstddef>
@@ -77,15 +78,17 @@ class event_source
 	public: typedef typename ::boost::signals2::connection connection_type;
 
 
-	private: static uint_type counter_;
+	/// The last assigned event source ID; atomic since sources are created concurrently by the threaded runners.
+	private: static ::boost::atomic<uint_type> counter_;
 
 
 	/// Default constructor.
 	public: event_source()
 	: id_(++counter_),
-	  name_(detail::make_name(id_)),
+	  name_(),
 	  ptr_sig_(new signal_type()),
-	  enabled_(true)
+	  enabled_(true),
+	  internal_(false)
 	{
 		// empty
 	}
@@ -95,7 +98,8 @@ class event_source
 		: id_(++counter_),
 		  name_(name),
 		  ptr_sig_(new signal_type()),
-		  enabled_(true)
+		  enabled_(true),
+		  internal_(false)
 	{
 		// empty
 	}
@@ -106,7 +110,8 @@ class event_source
 	: id_(++counter_), // non-copyable
 	  name_(that.name_),
 	  ptr_sig_(new signal_type()), // non-copyable
-	  enabled_(that.enabled_)
+	  enabled_(that.enabled_),
+	  internal_(that.internal_)
 	{
 		// empty
 	}
@@ -121,6 +126,7 @@ class event_source
 			name_ = rhs.name_;
 			ptr_sig_ = ::boost::make_shared<signal_type>(); // non-copyable
 			enabled_ = rhs.enabled_;
+			internal_ = rhs.internal_;
 		}
 
 		return *this;
@@ -135,6 +141,13 @@ class event_source
 
 	public: ::std::string const& name() const
 	{
+		// Unnamed sources get their default name only when it is first
+		// asked for, since formatting it is costly for large models.
+		if (name_.empty())
+		{
+			name_ = detail::make_name(id_);
+		}
+
 		return name_;
 	}
 
@@ -191,15 +204,30 @@ class event_source
 	}
 
 
+	/// Tell if the events of this source are internal to the engine.
+	public: bool internal() const
+	{
+		return internal_;
+	}
+
+
+	public: void internal(bool value)
+	{
+		internal_ = value;
+	}
+
+
 	private: uint_type id_;
-	private: ::std::string name_;
+	private: mutable ::std::string name_;
 	private: ::boost::shared_ptr<signal_type> ptr_sig_;
 	private: bool enabled_;
+	/// Tells if this is a source of engine-internal events.
+	private: bool internal_;
 };
 
 
 template <typename RealT>
-typename event_source<RealT>::uint_type event_source<RealT>::counter_ = 0;
+::boost::atomic<typename event_source<RealT>::uint_type> event_source<RealT>::counter_(0);
 
 
 template <typename RealT>
@@ -0,0 +1,311 @@
+/**
+ * \file dcs/des/memory_accounting.hpp
+ *
+ * \brief Opt-in accounting of the memory used by the simulation subsystems.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MEMORY_ACCOUNTING_HPP
+#define DCS_DES_MEMORY_ACCOUNTING_HPP
+
+
+#include <boost/atomic.hpp>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+
+
+/**
+ * Define the macro \c DCS_DES_CONFIG_MEMORY_ACCOUNTING (before including any
+ * header of this library) to enable memory accounting.
+ * When the macro is not defined, accounted containers use the standard
+ * allocator, so that accounting has no run-time cost.
+ */
+
+
+namespace dcs { namespace des {
+
+/// Subsystems whose memory usage is accounted.
+enum memory_category
+{
+	event_list_memory_category = 0, ///< Future event list (list nodes and events).
+	customer_memory_category, ///< Customers and their per-node history.
+	runtime_info_memory_category, ///< Runtime information of customers in service.
+	batch_means_memory_category, ///< Batch means kept by batch means statistics.
+	detector_memory_category, ///< Observations buffered by transient and replication size detectors.
+	num_memory_categories
+};
+
+
+/**
+ * \brief Registry of the memory used by the simulation subsystems.
+ *
+ * For each subsystem, it keeps the number of live bytes, the high-water mark
+ * (i.e., the maximum number of live bytes since the last reset) and the
+ * number of allocations.
+ * The registry is global and can be queried at any time during the
+ * simulation.
+ *
+ * Counters are atomic, so that simulations run concurrently (e.g., by
+ * \c mrip_runner or \c parameter_sweep) can share the registry; their
+ * allocations are then summed up.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+class memory_accounting
+{
+	public: typedef ::std::size_t size_type;
+
+
+	/// Tell if memory accounting has been enabled at compile time.
+	public: static bool enabled()
+	{
+#ifdef DCS_DES_CONFIG_MEMORY_ACCOUNTING
+		return true;
+#else
+		return false;
+#endif // DCS_DES_CONFIG_MEMORY_ACCOUNTING
+	}
+
+
+	public: static void allocate(memory_category category, size_type n)
+	{
+		counters& c(data()[category]);
+
+		size_type live(c.live.fetch_add(n, ::boost::memory_order_relaxed)+n);
+		size_type peak(c.peak.load(::boost::memory_order_relaxed));
+		while (live > peak && !c.peak.compare_exchange_weak(peak, live, ::boost::memory_order_relaxed))
+		{
+			// empty
+		}
+		c.nallocs.fetch_add(1, ::boost::memory_order_relaxed);
+	}
+
+
+	public: static void deallocate(memory_category category, size_type n)
+	{
+		counters& c(data()[category]);
+
+		size_type live(c.live.load(::boost::memory_order_relaxed));
+		while (!c.live.compare_exchange_weak(live, (n < live) ? (live-n) : 0, ::boost::memory_order_relaxed))
+		{
+			// empty
+		}
+	}
+
+
+	/// Return the number of live bytes of the given subsystem.
+	public: static size_type live_bytes(memory_category category)
+	{
+		return data()[category].live;
+	}
+
+
+	/// Return the number of live bytes of all the subsystems.
+	public: static size_type live_bytes()
+	{
+		size_type n(0);
+		for (int i = 0; i < num_memory_categories; ++i)
+		{
+			n += data()[i].live;
+		}
+		return n;
+	}
+
+
+	/// Return the high-water mark of the given subsystem.
+	public: static size_type high_water_bytes(memory_category category)
+	{
+		return data()[category].peak;
+	}
+
+
+	/// Return the number of allocations made by the given subsystem.
+	public: static size_type num_allocations(memory_category category)
+	{
+		return data()[category].nallocs;
+	}
+
+
+	/// Restart high-water marks from the current live bytes.
+	public: static void reset_high_water()
+	{
+		for (int i = 0; i < num_memory_categories; ++i)
+		{
+			data()[i].peak.store(data()[i].live.load());
+		}
+	}
+
+
+	public: static char const* category_name(memory_category category)
+	{
+		switch (category)
+		{
+			case event_list_memory_category:
+				return "Event list";
+			case customer_memory_category:
+				return "Customers";
+			case runtime_info_memory_category:
+				return "Runtime info";
+			case batch_means_memory_category:
+				return "Batch means";
+			case detector_memory_category:
+				return "Detectors";
+			default:
+				break;
+		}
+
+		return "Unknown";
+	}
+
+
+	/// Print the live bytes and high-water marks of all the subsystems.
+	public: static void report(::std::ostream& os)
+	{
+		os << "Memory usage (live bytes / high-water bytes / allocations):" << ::std::endl;
+		for (int i = 0; i < num_memory_categories; ++i)
+		{
+			memory_category category(static_cast<memory_category>(i));
+
+			os << "  " << category_name(category) << ": "
+			   << live_bytes(category) << " / "
+			   << high_water_bytes(category) << " / "
+			   << num_allocations(category) << ::std::endl;
+		}
+	}
+
+
+	private: struct counters
+	{
+		::boost::atomic<size_type> live;
+		::boost::atomic<size_type> peak;
+		::boost::atomic<size_type> nallocs;
+	};
+
+
+	private: static counters* data()
+	{
+		// Zero-initialized, as any object with static storage duration
+		static counters c[num_memory_categories];
+
+		return c;
+	}
+};
+
+
+/**
+ * \brief Standard-conforming allocator which accounts its memory to the given
+ *  subsystem.
+ *
+ * \tparam T The type of allocated objects.
+ * \tparam CategoryV The subsystem the memory is accounted to.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename T, memory_category CategoryV>
+class accounted_allocator: public ::std::allocator<T>
+{
+	private: typedef ::std::allocator<T> base_type;
+	public: typedef typename base_type::size_type size_type;
+	public: typedef typename base_type::pointer pointer;
+
+
+	public: template <typename U>
+		struct rebind
+	{
+		typedef accounted_allocator<U,CategoryV> other;
+	};
+
+
+	public: accounted_allocator() throw()
+	: base_type()
+	{
+	}
+
+
+	public: accounted_allocator(accounted_allocator const& that) throw()
+	: base_type(that)
+	{
+	}
+
+
+	public: template <typename U>
+		accounted_allocator(accounted_allocator<U,CategoryV> const& that) throw()
+	: base_type(that)
+	{
+	}
+
+
+	public: pointer allocate(size_type n, void const* hint = 0)
+	{
+		pointer p(base_type::allocate(n, hint));
+
+		memory_accounting::allocate(CategoryV, n*sizeof(T));
+
+		return p;
+	}
+
+
+	public: void deallocate(pointer p, size_type n)
+	{
+		base_type::deallocate(p, n);
+
+		memory_accounting::deallocate(CategoryV, n*sizeof(T));
+	}
+};
+
+template <typename T, typename U, memory_category CategoryV>
+inline
+bool operator==(accounted_allocator<T,CategoryV> const&, accounted_allocator<U,CategoryV> const&)
+{
+	return true;
+}
+
+template <typename T, typename U, memory_category CategoryV>
+inline
+bool operator!=(accounted_allocator<T,CategoryV> const&, accounted_allocator<U,CategoryV> const&)
+{
+	return false;
+}
+
+
+/**
+ * \brief The allocator to use for containers of the given subsystem.
+ *
+ * It is \c accounted_allocator when memory accounting is enabled, and
+ * \c std::allocator otherwise.
+ */
+template <typename T, memory_category CategoryV>
+struct memory_accounting_allocator
+{
+#ifdef DCS_DES_CONFIG_MEMORY_ACCOUNTING
+	typedef accounted_allocator<T,CategoryV> type;
+#else
+	typedef ::std::allocator<T> type;
+#endif // DCS_DES_CONFIG_MEMORY_ACCOUNTING
+};
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_MEMORY_ACCOUNTING_HPP
@@ -30,11 +30,17 @@
 
 
 #include <boost/smart_ptr.hpp>
+#include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
+#include <dcs/des/memory_accounting.hpp>
 #include <dcs/des/model/qn/queueing_network_traits.hpp>
 #include <dcs/des/model/qn/runtime_info.hpp>
+#include <dcs/des/model/qn/server_utilization_profile.hpp>
+#include <dcs/macro.hpp>
+#include <functional>
 #include <map>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 
@@ -58,8 +64,11 @@ class base_service_strategy
 	public: typedef ::boost::shared_ptr<runtime_info_type> runtime_info_pointer;
 	public: typedef service_station_node<traits_type> service_node_type;
 	public: typedef service_node_type* service_node_pointer;
+	public: typedef server_utilization_profile<real_type> utilization_profile_type;
+	public: typedef ::boost::shared_ptr<utilization_profile_type> utilization_profile_pointer;
 	private: typedef typename customer_type::identifier_type customer_identifier_type;
-	private: typedef ::std::map<customer_identifier_type,runtime_info_pointer> runtime_info_map;
+	private: typedef ::std::map<customer_identifier_type,runtime_info_pointer,::std::less<customer_identifier_type>,typename memory_accounting_allocator< ::std::pair<customer_identifier_type const,runtime_info_pointer>,runtime_info_memory_category>::type> runtime_info_map;
+	private: typedef typename memory_accounting_allocator<runtime_info_type,runtime_info_memory_category>::type runtime_info_allocator_type;
 
 
 	public: base_service_strategy()
@@ -68,7 +77,9 @@ class base_service_strategy
 	  rt_infos_(),
 	  ptr_node_(0),
 	  busy_time_(0),
-	  last_state_update_time_(0)
+	  last_state_update_time_(0),
+	  ptr_util_profile_(),
+	  customer_util_profiles_(false)
 	{
 	}
 
@@ -127,6 +138,13 @@ class base_service_strategy
 
 		multiplier_ = m;
 
+		// Let the station work clocks run at the new capacity before
+		// strategies possibly reschedule their customers.
+		if (ptr_node_)
+		{
+			ptr_node_->update_work_rate();
+		}
+
 		do_update_service();
 	}
 
@@ -163,7 +181,7 @@ class base_service_strategy
 //		runtime_info_type rt_info(runtime);
 //		rt_info.customer_id(ptr_customer->id());
 		runtime_info_type rt_info = do_serve(ptr_customer, rng);
-		rt_infos_[ptr_customer->id()] = ::boost::make_shared<runtime_info_type>(rt_info);
+		rt_infos_[ptr_customer->id()] = ::boost::allocate_shared<runtime_info_type>(runtime_info_allocator_type(), rt_info);
 
 		DCS_DEBUG_TRACE_L(3, "Generated new service time: Service Demand: " << rt_info.service_demand() << " --> Runtime: " << rt_info.runtime());//XXX
 
@@ -173,6 +191,58 @@ class base_service_strategy
 	}
 
 
+	/**
+	 * \brief Draw the service demand of the given customer, without serving
+	 *  it.
+	 *
+	 * This is used by queueing strategies which need to know service demands
+	 * in advance (e.g., SJF); the customer is later served through
+	 * \c resume.
+	 */
+	public: real_type sample_demand(customer_pointer const& ptr_customer, random_generator_type& rng)
+	{
+		// pre: customer pointer must be a valid pointer.
+		DCS_ASSERT(
+			ptr_customer,
+			throw ::std::invalid_argument("[dcs::des::model::qn::base_service_strategy::sample_demand] Invalid customer.")
+		);
+
+		return do_sample_demand(ptr_customer, rng);
+	}
+
+
+	/**
+	 * \brief Serve the given customer with the given service demand.
+	 *
+	 * This is used to serve customers whose demand has been drawn in advance
+	 * or to resume the service of a preempted customer.
+	 */
+	public: runtime_info_type resume(customer_pointer const& ptr_customer, real_type demand)
+	{
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Resuming of Customer: " << *ptr_customer << ".");///XXX
+
+		// pre: customer pointer must be a valid pointer.
+		DCS_ASSERT(
+			ptr_customer,
+			throw ::std::invalid_argument("[dcs::des::model::qn::base_service_strategy::resume] Invalid customer.")
+		);
+		// pre: demand >= 0
+		DCS_ASSERT(
+			demand >= 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::base_service_strategy::resume] Service demand must be a non-negative number.")
+		);
+
+		update_state();
+
+		runtime_info_type rt_info = do_resume(ptr_customer, demand);
+		rt_infos_[ptr_customer->id()] = ::boost::allocate_shared<runtime_info_type>(runtime_info_allocator_type(), rt_info);
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Resuming of Customer: " << *ptr_customer << ".");///XXX
+
+		return rt_info;
+	}
+
+
 	public: void remove(customer_pointer const& ptr_customer)
 	{
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Removal of Customer: " << *ptr_customer << ".");///XXX
@@ -308,6 +378,10 @@ class base_service_strategy
 		rt_infos_.clear();
 		last_state_update_time_ = busy_time_
 								= real_type/*zero*/();
+		if (ptr_util_profile_)
+		{
+			ptr_util_profile_->clear();
+		}
 //Don't reset multiplier: let the client do this
 //		multiplier_ = 1;
 
@@ -333,6 +407,69 @@ class base_service_strategy
 	}
 
 
+	/**
+	 * \brief The number of work lanes.
+	 *
+	 * Customers in the same lane receive service demand at the same rate (see
+	 * \c work_rate), so that the station keys their end-of-service on a common
+	 * work clock (see \c service_station_node).
+	 */
+	public: uint_type num_work_lanes() const
+	{
+		return do_num_work_lanes();
+	}
+
+
+	/// The work lane of the given customer in service.
+	public: uint_type work_lane(customer_type const& customer) const
+	{
+		return do_work_lane(customer);
+	}
+
+
+	/// The service demand received per unit of time by each customer in the
+	/// given work lane.
+	public: real_type work_rate(uint_type lane) const
+	{
+		return do_work_rate(lane);
+	}
+
+
+	/**
+	 * \brief Record the utilization profile of the station into the given
+	 *  profile.
+	 *
+	 * Each segment of the profile holds the sum of the shares of the customers
+	 * in service.
+	 * The profile is cleared on \c reset; passing a null pointer stops the
+	 * recording.
+	 */
+	public: void utilization_profile(utilization_profile_pointer const& ptr_profile)
+	{
+		ptr_util_profile_ = ptr_profile;
+	}
+
+
+	public: utilization_profile_pointer utilization_profile() const
+	{
+		return ptr_util_profile_;
+	}
+
+
+	/// Tell if the utilization profile of each served customer must be
+	/// recorded in the customer (see \c customer::node_utilization_profile).
+	public: void record_customer_utilization_profiles(bool val)
+	{
+		customer_util_profiles_ = val;
+	}
+
+
+	public: bool record_customer_utilization_profiles() const
+	{
+		return customer_util_profiles_;
+	}
+
+
 	protected: void update_state()
 	{
 		typedef typename runtime_info_map::const_iterator iterator;
@@ -344,6 +481,7 @@ class base_service_strategy
 		if (cur_time > last_state_update_time_)
 		{
 			real_type start_busy_time(cur_time);
+			real_type busy_share(0);
 
 			iterator end_it(rt_infos_.end());
 			for (iterator it = rt_infos_.begin(); it != end_it; ++it)
@@ -369,9 +507,11 @@ class base_service_strategy
 				}
 //				real_type elapsed_time(cur_time-start_time);
 //				ptr_customer->runtime(ptr_customer->runtime()+elapsed_time);
-				server_utilization_profile<real_type> profile;
-				profile(start_time, cur_time, share);
-				rt_info.utilization_profile(profile);
+				if (customer_util_profiles_)
+				{
+					rt_info.utilization_profile(start_time, cur_time, share);
+				}
+				busy_share += share;
 //				busy_time_ += elapsed_time*share;
 
 //				DCS_DEBUG_TRACE_L(3, "Updated Busy Time: " << busy_time_);//XXX
@@ -381,6 +521,13 @@ class base_service_strategy
 
 			busy_time_ += cur_time-start_busy_time;
 
+			// The state is updated whenever a customer enters or leaves
+			// service, so the shares are constant since the last update.
+			if (ptr_util_profile_)
+			{
+				(*ptr_util_profile_)(last_state_update_time_, cur_time, busy_share);
+			}
+
 			DCS_DEBUG_TRACE_L(3, "Updated Busy Time: " << busy_time_);//XXX
 
 			last_state_update_time_ = cur_time;
@@ -405,6 +552,24 @@ class base_service_strategy
 	private: virtual runtime_info_type do_serve(customer_pointer const& ptr_customer, random_generator_type& rng) = 0;
 
 
+	private: virtual real_type do_sample_demand(customer_pointer const& ptr_customer, random_generator_type& rng)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ptr_customer );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( rng );
+
+		throw ::std::logic_error("[dcs::des::model::qn::base_service_strategy::do_sample_demand] Drawing service demands in advance is not supported by this service strategy.");
+	}
+
+
+	private: virtual runtime_info_type do_resume(customer_pointer const& ptr_customer, real_type demand)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ptr_customer );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( demand );
+
+		throw ::std::logic_error("[dcs::des::model::qn::base_service_strategy::do_resume] Serving with a given service demand is not supported by this service strategy.");
+	}
+
+
 	private: virtual void do_remove(customer_pointer const& ptr_customer) = 0;
 
 
@@ -427,6 +592,28 @@ class base_service_strategy
 
 	private: virtual uint_type do_num_busy_servers() const = 0;
 
+
+	private: virtual uint_type do_num_work_lanes() const
+	{
+		return 1;
+	}
+
+
+	private: virtual uint_type do_work_lane(customer_type const& customer) const
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( customer );
+
+		return 0;
+	}
+
+
+	private: virtual real_type do_work_rate(uint_type lane) const
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( lane );
+
+		return multiplier_;
+	}
+
 	//@} Interface member functions
 
 
@@ -442,6 +629,10 @@ class base_service_strategy
 	private: service_node_pointer ptr_node_;
 	private: real_type busy_time_;
 	private: real_type last_state_update_time_;
+	/// The station utilization profile (if any) being recorded.
+	private: utilization_profile_pointer ptr_util_profile_;
+	/// Tells if customer utilization profiles must be recorded.
+	private: bool customer_util_profiles_;
 
 	//@} Data members
 };
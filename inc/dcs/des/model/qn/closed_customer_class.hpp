@@ -29,6 +29,7 @@
 #define DCS_DES_MODEL_QN_CLOSED_CUSTOMER_CLASS_HPP
 
 
+#include <boost/smart_ptr.hpp>
 #include <cstddef>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
@@ -45,6 +46,7 @@ class closed_customer_class: public customer_class<TraitsT>
 	public: typedef typename base_type::identifier_type identifier_type;
 	private: typedef typename base_type::customer_type customer_type;
 	private: typedef typename base_type::customer_pointer customer_pointer;
+	private: typedef typename base_type::customer_allocator_type customer_allocator_type;
 
 
 	public: closed_customer_class(::std::string const& name, ::std::size_t size)
@@ -100,7 +102,8 @@ class closed_customer_class: public customer_class<TraitsT>
 		);
  
 		customer_pointer ptr_customer(
-				new customer_type(
+				::boost::allocate_shared<customer_type>(
+					customer_allocator_type(),
 					this->network_ptr()->generate_customer_id(),
 					this->id(),
 					this->reference_node()
@@ -0,0 +1,739 @@
+/**
+ * \file dcs/des/model/qn/ctmc_simulator.hpp
+ *
+ * \brief Continuous-time Markov chain simulator for Markovian queueing
+ *  networks.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_CTMC_SIMULATOR_HPP
+#define DCS_DES_MODEL_QN_CTMC_SIMULATOR_HPP
+
+
+#include <boost/random/uniform_01.hpp>
+#include <boost/smart_ptr.hpp>
+#include <cmath>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <dcs/debug.hpp>
+#include <dcs/des/base_statistic.hpp>
+#include <dcs/des/model/qn/customer_class_category.hpp>
+#include <dcs/des/model/qn/detail/accumulate_stat.hpp>
+#include <dcs/des/model/qn/detail/fenwick_rate_tree.hpp>
+#include <dcs/des/model/qn/network_node_category.hpp>
+#include <dcs/des/model/qn/output_statistic_category.hpp>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace model { namespace qn {
+
+/**
+ * \brief Continuous-time Markov chain simulator for Markovian queueing
+ *  networks.
+ *
+ * When all interarrival and service times are exponential, the state of a
+ * queueing network is fully described by the number of customers of each
+ * class at each station.
+ * This simulator samples the jump chain of such a CTMC directly (Gillespie's
+ * direct method): transition rates are kept in Fenwick trees, one over the
+ * open class arrivals and the stations and one per station over its classes,
+ * so that a transition only updates the rates it affects, at a cost of
+ * O(log C + log S) (where C and S are the number of classes and of stations).
+ * Two random variates select the next transition (the arrival or the station,
+ * and then the class completing service) and no customer object or pending
+ * event is ever created.
+ *
+ * Supported stations are queueing stations with \c m servers sharing their
+ * capacity among customers (i.e., PS; this is the same as FCFS for stations
+ * visited by a single class) and delay stations (infinite servers).
+ * A PS station pools its servers: with \c n customers, each one is served at
+ * rate \f$\min(1,m/n)\f$ times its service rate.
+ * This differs from \c ps_service_strategy when \c m > 1, since the latter
+ * binds each customer to a single server, which is shared only among the
+ * customers bound to it; the two agree for single-server stations and, for
+ * \c m > 1, as long as no server holds more than one customer.
+ * FCFS stations visited by more than one class are not Markovian in the
+ * per-class counts and are rejected.
+ * Customer classes may be open (Poisson arrivals to a reference station) or
+ * closed (a fixed population starting at a reference station); routing is
+ * probabilistic and may switch class, and the probabilities of the routes of
+ * each served class must sum to 1.
+ *
+ * Since customers are not tracked individually, per-customer indices are
+ * computed per run through Little's law from the time-integrated number of
+ * customers (e.g., response time is the mean number of customers at the
+ * station divided by its throughput), and fed to the same node-level and
+ * network-level statistic categories used by the event-driven model.
+ * As in the event-driven model, customers of PS and delay stations are all in
+ * service, and the number of waiting customers is the one seen just after
+ * each arrival (the observation of a run is the mean of these samples).
+ *
+ * \tparam TraitsT The queueing network traits type.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename TraitsT>
+class ctmc_simulator
+{
+	public: typedef TraitsT traits_type;
+	public: typedef typename traits_type::real_type real_type;
+	public: typedef typename traits_type::uint_type uint_type;
+	public: typedef typename traits_type::node_identifier_type node_identifier_type;
+	public: typedef typename traits_type::class_identifier_type class_identifier_type;
+	public: typedef base_statistic<real_type,uint_type> output_statistic_type;
+	public: typedef ::boost::shared_ptr<output_statistic_type> output_statistic_pointer;
+	public: typedef ::std::size_t size_type;
+	private: typedef ::std::vector<output_statistic_pointer> output_statistic_container;
+	private: typedef ::std::map<node_output_statistic_category,output_statistic_container> node_statistic_category_container;
+	private: typedef ::std::map<network_output_statistic_category,output_statistic_container> network_statistic_category_container;
+	private: typedef detail::fenwick_rate_tree<real_type> rate_tree_type;
+
+
+	/// The tolerance on the sum of the routing probabilities of a class.
+	public: static const real_type route_probability_tolerance;
+
+	/// A routing destination with its cumulative probability.
+	private: struct route_type
+	{
+		node_identifier_type node;
+		class_identifier_type klass;
+		real_type cum_prob;
+	};
+
+	private: typedef ::std::vector<route_type> route_container;
+
+	private: struct station_type
+	{
+		network_node_category category;
+		uint_type num_servers;
+		bool fcfs;
+	};
+
+	private: struct class_type
+	{
+		customer_class_category category;
+		node_identifier_type reference_node;
+		real_type arrival_rate;
+		uint_type population;
+	};
+
+
+	/// Return the pseudo-identifier to use as routing destination for
+	/// leaving the network.
+	public: static node_identifier_type sink()
+	{
+		return traits_type::invalid_node_id();
+	}
+
+
+	public: ctmc_simulator()
+	{
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+
+
+	/**
+	 * \brief Add a queueing station with the given number of servers.
+	 *
+	 * \param fcfs Tell if the discipline is FCFS rather than PS.
+	 */
+	public: node_identifier_type add_queueing_station(uint_type num_servers, bool fcfs = true)
+	{
+		// pre: num_servers > 0
+		DCS_ASSERT(
+			num_servers > 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::add_queueing_station] Invalid number of servers.")
+		);
+
+		station_type s;
+		s.category = service_station_node_category;
+		s.num_servers = num_servers;
+		s.fcfs = fcfs;
+
+		return add_station(s);
+	}
+
+
+	/// Add a delay (infinite-server) station.
+	public: node_identifier_type add_delay_station()
+	{
+		station_type s;
+		s.category = delay_station_node_category;
+		s.num_servers = 0;
+		s.fcfs = false;
+
+		return add_station(s);
+	}
+
+
+	/// Add an open class with Poisson arrivals to the given station.
+	public: class_identifier_type add_open_class(real_type arrival_rate, node_identifier_type reference_node)
+	{
+		// pre: arrival_rate > 0
+		DCS_ASSERT(
+			arrival_rate > 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::add_open_class] Invalid arrival rate.")
+		);
+
+		class_type c;
+		c.category = open_customer_class_category;
+		c.reference_node = reference_node;
+		c.arrival_rate = arrival_rate;
+		c.population = 0;
+
+		return add_class(c);
+	}
+
+
+	/// Add a closed class whose population starts at the given station.
+	public: class_identifier_type add_closed_class(uint_type population, node_identifier_type reference_node)
+	{
+		class_type c;
+		c.category = closed_customer_class_category;
+		c.reference_node = reference_node;
+		c.arrival_rate = 0;
+		c.population = population;
+
+		return add_class(c);
+	}
+
+
+	/// Set the (exponential) service rate of the given class at the given
+	/// station.
+	public: void service_rate(node_identifier_type node, class_identifier_type klass, real_type rate)
+	{
+		// pre: valid node and class
+		DCS_ASSERT(
+			node < stations_.size() && klass < classes_.size(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::service_rate] Invalid node or class.")
+		);
+		// pre: rate > 0
+		DCS_ASSERT(
+			rate > 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::service_rate] Invalid service rate.")
+		);
+
+		ensure_space();
+
+		svc_rates_[slot(node, klass)] = rate;
+	}
+
+
+	/// Route customers of class \a src_class leaving \a src_node to
+	/// \a dst_node as class \a dst_class with probability \a prob.
+	public: void add_route(node_identifier_type src_node,
+						   class_identifier_type src_class,
+						   node_identifier_type dst_node,
+						   class_identifier_type dst_class,
+						   real_type prob)
+	{
+		// pre: valid source
+		DCS_ASSERT(
+			src_node < stations_.size() && src_class < classes_.size(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::add_route] Invalid source node or class.")
+		);
+		// pre: valid destination
+		DCS_ASSERT(
+			(dst_node == sink() || dst_node < stations_.size()) && dst_class < classes_.size(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::add_route] Invalid destination node or class.")
+		);
+		// pre: prob in (0,1]
+		DCS_ASSERT(
+			prob > 0 && prob <= 1,
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::add_route] Invalid probability.")
+		);
+
+		ensure_space();
+
+		route_container& routes(routes_[slot(src_node, src_class)]);
+
+		route_type r;
+		r.node = dst_node;
+		r.klass = dst_class;
+		r.cum_prob = (routes.empty() ? real_type(0) : routes.back().cum_prob) + prob;
+		routes.push_back(r);
+	}
+
+
+	/// Associate a statistic to the given category of the given station.
+	public: void statistic(node_identifier_type node, node_output_statistic_category category, output_statistic_pointer const& ptr_stat)
+	{
+		// pre: valid node
+		DCS_ASSERT(
+			node < node_stats_.size(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::statistic] Invalid node.")
+		);
+		// pre: statistic pointer must be a valid pointer.
+		DCS_ASSERT(
+			ptr_stat,
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::statistic] Invalid statistic.")
+		);
+
+		node_stats_[node][category].push_back(ptr_stat);
+	}
+
+
+	/// Associate a statistic to the given network-level category.
+	public: void statistic(network_output_statistic_category category, output_statistic_pointer const& ptr_stat)
+	{
+		// pre: statistic pointer must be a valid pointer.
+		DCS_ASSERT(
+			ptr_stat,
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::statistic] Invalid statistic.")
+		);
+
+		net_stats_[category].push_back(ptr_stat);
+	}
+
+
+	public: size_type num_stations() const
+	{
+		return stations_.size();
+	}
+
+
+	public: size_type num_classes() const
+	{
+		return classes_.size();
+	}
+
+
+	/// Return the number of transitions fired by the last run.
+	public: uint_type num_transitions() const
+	{
+		return ntrans_;
+	}
+
+
+	/// Simulate a single run of the given length.
+	public: template <typename UniformRandomGeneratorT>
+		void evaluate(real_type horizon, UniformRandomGeneratorT& rng)
+	{
+		// pre: horizon > 0
+		DCS_ASSERT(
+			horizon > 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::evaluate] Invalid horizon.")
+		);
+
+		check_model();
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Evaluating CTMC (Horizon: " << horizon << ")");//XXX
+
+		const size_type ns(stations_.size());
+		const size_type nc(classes_.size());
+
+		init_run();
+
+		::boost::uniform_01<real_type> u01;
+
+		real_type t(0);
+		ntrans_ = 0;
+		while (true)
+		{
+			real_type total(rates_.total());
+
+			if (total <= 0)
+			{
+				// Absorbing state
+				break;
+			}
+
+			t += -::std::log(real_type(1)-u01(rng))/total;
+			if (t > horizon)
+			{
+				break;
+			}
+
+			size_type i(rates_.find(u01(rng)*total));
+
+			if (i < nc)
+			{
+				// External arrival of an open class
+				++net_narr_;
+				net_area_ += net_num_*(t-net_last_time_);
+				net_last_time_ = t;
+				++net_num_;
+				arrive(classes_[i].reference_node, i, t);
+			}
+			else
+			{
+				// Service completion
+				node_identifier_type k(i-nc);
+				rate_tree_type const& class_rates(class_rates_[k]);
+				class_identifier_type c(class_rates.find(u01(rng)*class_rates.total()));
+
+				depart(k, c, t);
+
+				route_container const& routes(routes_[slot(k, c)]);
+				real_type u(u01(rng));
+				typename route_container::const_iterator it(routes.begin());
+				typename route_container::const_iterator end_it(routes.end()-1);
+				while (it != end_it && it->cum_prob <= u)
+				{
+					++it;
+				}
+
+				if (it->node == sink())
+				{
+					++net_ndep_;
+					net_area_ += net_num_*(t-net_last_time_);
+					net_last_time_ = t;
+					--net_num_;
+				}
+				else
+				{
+					arrive(it->node, it->klass, t);
+				}
+			}
+
+			++ntrans_;
+		}
+
+		// Close the time integrals at the horizon
+		for (size_type k = 0; k < ns; ++k)
+		{
+			update_area(k, horizon);
+		}
+		net_area_ += net_num_*(horizon-net_last_time_);
+
+		// Per-run observations
+		for (size_type k = 0; k < ns; ++k)
+		{
+			real_type area_svc(area_n_[k]-area_q_[k]);
+
+			accumulate_stat(k, busy_time_statistic_category, busy_[k]);
+			accumulate_stat(k, utilization_statistic_category, busy_[k]/horizon);
+			accumulate_stat(k, throughput_statistic_category, ndep_[k]/horizon);
+			accumulate_stat(k, num_arrivals_statistic_category, narr_[k]);
+			accumulate_stat(k, num_departures_statistic_category, ndep_[k]);
+			accumulate_stat(k, num_busy_statistic_category, area_svc/horizon);
+			if (narr_[k] > 0)
+			{
+				accumulate_stat(k, num_waiting_statistic_category, sum_nw_[k]/narr_[k]);
+			}
+			if (ndep_[k] > 0)
+			{
+				accumulate_stat(k, response_time_statistic_category, area_n_[k]/ndep_[k]);
+				accumulate_stat(k, waiting_time_statistic_category, area_q_[k]/ndep_[k]);
+				accumulate_stat(k, service_time_statistic_category, area_svc/ndep_[k]);
+			}
+		}
+		accumulate_stat(net_throughput_statistic_category, net_ndep_/horizon);
+		accumulate_stat(net_num_arrivals_statistic_category, net_narr_);
+		accumulate_stat(net_num_departures_statistic_category, net_ndep_);
+		if (net_ndep_ > 0)
+		{
+			accumulate_stat(net_response_time_statistic_category, net_area_/net_ndep_);
+		}
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Evaluating CTMC (Horizon: " << horizon << ", Transitions: " << ntrans_ << ")");//XXX
+	}
+
+
+	private: node_identifier_type add_station(station_type const& s)
+	{
+		stations_.push_back(s);
+		node_stats_.push_back(node_statistic_category_container());
+
+		return stations_.size()-1;
+	}
+
+
+	private: class_identifier_type add_class(class_type const& c)
+	{
+		// pre: valid reference node
+		DCS_ASSERT(
+			c.reference_node < stations_.size(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::ctmc_simulator::add_class] Invalid reference node.")
+		);
+		// pre: classes must be added before any rate or route, since
+		//      per-class data are laid out by class identifier.
+		DCS_ASSERT(
+			svc_rates_.empty(),
+			throw ::std::logic_error("[dcs::des::model::qn::ctmc_simulator::add_class] Classes must be added before service rates and routes.")
+		);
+
+		classes_.push_back(c);
+
+		return classes_.size()-1;
+	}
+
+
+	/// Return the index of the given station/class pair.
+	private: size_type slot(node_identifier_type node, class_identifier_type klass) const
+	{
+		return node*classes_.size()+klass;
+	}
+
+
+	private: void ensure_space()
+	{
+		const size_type n(stations_.size()*classes_.size());
+
+		if (svc_rates_.size() < n)
+		{
+			svc_rates_.resize(n, 0);
+			routes_.resize(n);
+		}
+	}
+
+
+	private: void check_model()
+	{
+		const size_type ns(stations_.size());
+		const size_type nc(classes_.size());
+
+		// pre: at least one station and one class
+		DCS_ASSERT(
+			ns > 0 && nc > 0,
+			throw ::std::logic_error("[dcs::des::model::qn::ctmc_simulator::check_model] Empty network.")
+		);
+
+		ensure_space();
+
+		for (size_type k = 0; k < ns; ++k)
+		{
+			size_type nvisit(0);
+			for (size_type c = 0; c < nc; ++c)
+			{
+				size_type s(slot(k, c));
+
+				if (svc_rates_[s] > 0)
+				{
+					++nvisit;
+
+					// pre: served customers must be routed somewhere
+					DCS_ASSERT(
+						!routes_[s].empty(),
+						throw ::std::logic_error("[dcs::des::model::qn::ctmc_simulator::check_model] Missing route for a served class.")
+					);
+				}
+
+				// pre: routing probabilities must sum to 1
+				DCS_ASSERT(
+					routes_[s].empty() || ::std::abs(routes_[s].back().cum_prob-real_type(1)) <= route_probability_tolerance,
+					throw ::std::logic_error("[dcs::des::model::qn::ctmc_simulator::check_model] Routing probabilities do not sum to 1.")
+				);
+			}
+
+			// pre: multi-class FCFS stations are not Markovian in class counts
+			DCS_ASSERT(
+				!stations_[k].fcfs || nvisit <= 1,
+				throw ::std::logic_error("[dcs::des::model::qn::ctmc_simulator::check_model] FCFS station visited by more than one class.")
+			);
+		}
+	}
+
+
+	private: void init_run()
+	{
+		const size_type ns(stations_.size());
+		const size_type nc(classes_.size());
+
+		num_.assign(ns*nc, 0);
+		tot_.assign(ns, 0);
+		narr_.assign(ns, 0);
+		ndep_.assign(ns, 0);
+		busy_.assign(ns, 0);
+		area_n_.assign(ns, 0);
+		area_q_.assign(ns, 0);
+		sum_nw_.assign(ns, 0);
+		last_time_.assign(ns, 0);
+		net_narr_ = net_ndep_ = net_num_ = 0;
+		net_area_ = net_last_time_ = 0;
+
+		rates_ = rate_tree_type(nc+ns);
+		class_rates_.assign(ns, rate_tree_type(nc));
+		for (size_type c = 0; c < nc; ++c)
+		{
+			rates_.rate(c, classes_[c].arrival_rate);
+
+			if (classes_[c].category == closed_customer_class_category)
+			{
+				node_identifier_type k(classes_[c].reference_node);
+
+				num_[slot(k, c)] += classes_[c].population;
+				tot_[k] += classes_[c].population;
+			}
+		}
+		for (size_type k = 0; k < ns; ++k)
+		{
+			for (size_type c = 0; c < nc; ++c)
+			{
+				update_rates(k, c);
+			}
+		}
+	}
+
+
+	private: void arrive(node_identifier_type k, class_identifier_type c, real_type t)
+	{
+		update_area(k, t);
+
+		++num_[slot(k, c)];
+		++tot_[k];
+		++narr_[k];
+		sum_nw_[k] += num_waiting(k);
+
+		update_rates(k, c);
+	}
+
+
+	private: void depart(node_identifier_type k, class_identifier_type c, real_type t)
+	{
+		update_area(k, t);
+
+		--num_[slot(k, c)];
+		--tot_[k];
+		++ndep_[k];
+
+		update_rates(k, c);
+	}
+
+
+	/// Bring the time integrals of the given station up to time \a t.
+	private: void update_area(node_identifier_type k, real_type t)
+	{
+		real_type dt(t-last_time_[k]);
+		uint_type n(tot_[k]);
+
+		if (n > 0)
+		{
+			busy_[k] += dt;
+			area_n_[k] += n*dt;
+			area_q_[k] += num_waiting(k)*dt;
+		}
+		last_time_[k] = t;
+	}
+
+
+	/// Return the number of customers of the given station which do not
+	/// hold a server (only FCFS stations make customers wait).
+	private: uint_type num_waiting(node_identifier_type k) const
+	{
+		uint_type n(tot_[k]);
+
+		if (stations_[k].fcfs && n > stations_[k].num_servers)
+		{
+			return n-stations_[k].num_servers;
+		}
+
+		return 0;
+	}
+
+
+	/**
+	 * \brief Update the rates affected by a change in the number of customers
+	 *  of class \a c at station \a k.
+	 *
+	 * The capacity share of a customer is the same for all classes, so the
+	 * per-class rates are kept without it and the share only scales the
+	 * service completion rate of the station.
+	 */
+	private: void update_rates(node_identifier_type k, class_identifier_type c)
+	{
+		size_type s(slot(k, c));
+		uint_type n(tot_[k]);
+
+		class_rates_[k].rate(c, num_[s]*svc_rates_[s]);
+
+		// Per-customer capacity share
+		real_type share(1);
+		if (stations_[k].category == service_station_node_category && n > stations_[k].num_servers)
+		{
+			share = static_cast<real_type>(stations_[k].num_servers)/n;
+		}
+
+		rates_.rate(classes_.size()+k, class_rates_[k].total()*share);
+	}
+
+
+	private: void accumulate_stat(node_identifier_type k, node_output_statistic_category category, real_type value)
+	{
+		detail::accumulate_stat(node_stats_[k], category, value);
+	}
+
+
+	private: void accumulate_stat(network_output_statistic_category category, real_type value)
+	{
+		detail::accumulate_stat(net_stats_, category, value);
+	}
+
+
+	//@{ Model
+
+	private: ::std::vector<station_type> stations_;
+	private: ::std::vector<class_type> classes_;
+	/// Service rates indexed by station/class slot.
+	private: ::std::vector<real_type> svc_rates_;
+	/// Routing destinations indexed by station/class slot.
+	private: ::std::vector<route_container> routes_;
+	private: ::std::vector<node_statistic_category_container> node_stats_;
+	private: network_statistic_category_container net_stats_;
+
+	//@} Model
+
+	//@{ Run state
+
+	/// Transition rates: open class arrivals first, then stations.
+	private: rate_tree_type rates_;
+	/// Service completion rates of the classes at each station, regardless
+	/// of the capacity share.
+	private: ::std::vector<rate_tree_type> class_rates_;
+	/// Number of customers indexed by station/class slot.
+	private: ::std::vector<uint_type> num_;
+	/// Number of customers at each station.
+	private: ::std::vector<uint_type> tot_;
+	private: ::std::vector<uint_type> narr_;
+	private: ::std::vector<uint_type> ndep_;
+	private: ::std::vector<real_type> busy_;
+	/// Time integral of the number of customers at each station.
+	private: ::std::vector<real_type> area_n_;
+	/// Time integral of the number of waiting customers at each station.
+	private: ::std::vector<real_type> area_q_;
+	/// Sum of the number of waiting customers seen just after each arrival at
+	/// each station.
+	private: ::std::vector<real_type> sum_nw_;
+	private: ::std::vector<real_type> last_time_;
+	private: uint_type net_narr_;
+	private: uint_type net_ndep_;
+	private: uint_type net_num_;
+	private: real_type net_area_;
+	private: real_type net_last_time_;
+	private: uint_type ntrans_;
+
+	//@} Run state
+};
+
+template <typename TraitsT>
+const typename ctmc_simulator<TraitsT>::real_type ctmc_simulator<TraitsT>::route_probability_tolerance = 1e-9;
+
+}}}} // Namespace dcs::des::model::qn
+
+
+#endif // DCS_DES_MODEL_QN_CTMC_SIMULATOR_HPP
@@ -29,15 +29,19 @@
 #define DCS_DES_MODEL_QN_CUSTOMER_HPP
 
 
+#include <boost/cstdint.hpp>
 #include <boost/smart_ptr.hpp>
 #include <cstddef>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
+#include <dcs/des/memory_accounting.hpp>
 #include <dcs/des/model/qn/server_utilization_profile.hpp>
+#include <functional>
 #include <iostream>
 //#include <limits>
 #include <map>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 
@@ -57,6 +61,9 @@ class customer
 	public: typedef typename traits_type::network_type network_type;
 	public: typedef ::boost::shared_ptr<network_type> network_pointer;
 	public: typedef server_utilization_profile<real_type> utilization_profile_type;//EXP
+	private: typedef ::std::vector<real_type, typename memory_accounting_allocator<real_type,customer_memory_category>::type> time_container;
+	private: typedef ::std::map<node_identifier_type, time_container, ::std::less<node_identifier_type>, typename memory_accounting_allocator< ::std::pair<node_identifier_type const,time_container>,customer_memory_category>::type> node_time_container;
+	private: typedef ::std::map<node_identifier_type, utilization_profile_type, ::std::less<node_identifier_type>, typename memory_accounting_allocator< ::std::pair<node_identifier_type const,utilization_profile_type>,customer_memory_category>::type> node_utilization_profile_container;
 //	public: typedef typename traits_type::network_type* network_pointer;
 
 
@@ -91,6 +98,8 @@ class customer
 	  arrtime_(0),
 	  runtime_(0),
 	  deptime_(0),
+	  residual_demand_(-1),
+	  queue_seq_(0),
 	  node_arrtimes_(),
 //	  node_runtimes_(),
 	  node_deptimes_(),
@@ -111,6 +120,8 @@ class customer
 	  arrtime_(0),
 	  runtime_(0),
 	  deptime_(0),
+	  residual_demand_(-1),
+	  queue_seq_(0),
 	  node_arrtimes_(),
 //	  node_runtimes_(),
 	  node_deptimes_()
@@ -248,6 +259,34 @@ class customer
 	}
 
 
+	/// Set the service demand this customer still has to receive at the
+	/// current node (a negative value means that it is not known yet).
+	public: void residual_demand(real_type demand)
+	{
+		residual_demand_ = demand;
+	}
+
+
+	public: real_type residual_demand() const
+	{
+		return residual_demand_;
+	}
+
+
+	/// Set the arrival sequence number of this customer in the queue of the
+	/// current node (kept when a preempted customer is queued again).
+	public: void queue_sequence(::boost::uint64_t seq)
+	{
+		queue_seq_ = seq;
+	}
+
+
+	public: ::boost::uint64_t queue_sequence() const
+	{
+		return queue_seq_;
+	}
+
+
 	public: void node_arrival_time(node_identifier_type node_id, real_type time)
 	{
 //		if (node_id >= node_arrtimes_.size())
@@ -262,8 +301,8 @@ class customer
 
 		if (node_arrtimes_.count(node_id) == 0)
 		{
-			node_arrtimes_[node_id] = ::std::vector<real_type>();
-			node_deptimes_[node_id] = ::std::vector<real_type>();
+			node_arrtimes_[node_id] = time_container();
+			node_deptimes_[node_id] = time_container();
 		}
 
 		node_arrtimes_[node_id].push_back(time);
@@ -282,7 +321,9 @@ class customer
 			return ::std::vector<real_type>();
 		}
 
-		return node_arrtimes_.at(node_id);
+		time_container const& times(node_arrtimes_.at(node_id));
+
+		return ::std::vector<real_type>(times.begin(), times.end());
 	}
 
 
@@ -300,7 +341,7 @@ class customer
 
 		if (node_deptimes_.count(node_id) == 0)
 		{
-			node_deptimes_[node_id] = ::std::vector<real_type>();
+			node_deptimes_[node_id] = time_container();
 		}
 
 		node_deptimes_[node_id].push_back(time);
@@ -318,23 +359,35 @@ class customer
 		{
 			return ::std::vector<real_type>();
 		}
-		return node_deptimes_.at(node_id);
+		time_container const& times(node_deptimes_.at(node_id));
+
+		return ::std::vector<real_type>(times.begin(), times.end());
 	}
 
 
+	/// Append the segment <code>[t1,t2)</code> with utilization \a u to the
+	/// utilization profile of the given node.
+	public: void node_utilization_profile(node_identifier_type node_id, real_type t1, real_type t2, real_type u)
+	{
+		node_util_profiles_[node_id](t1, t2, u);
+	}
+
+
+	/// Append the given profile to the utilization profile of the given node.
 	public: void node_utilization_profile(node_identifier_type node_id, utilization_profile_type const& profile)
 	{
-		node_util_profiles_[node_id].push_back(profile);
+		node_util_profiles_[node_id](profile);
 	}
 
 
-	public: ::std::vector<utilization_profile_type> node_utilization_profiles(node_identifier_type node_id) const
+	/// The utilization profile of all the passages through the given node.
+	public: utilization_profile_type const& node_utilization_profile(node_identifier_type node_id) const
 	{
-		if (node_util_profiles_.count(node_id) == 0)
-		{
-			return ::std::vector<utilization_profile_type>();
-		}
-		return node_util_profiles_.at(node_id);
+		static const utilization_profile_type empty_profile;
+
+		typename node_utilization_profile_container::const_iterator it(node_util_profiles_.find(node_id));
+
+		return it != node_util_profiles_.end() ? it->second : empty_profile;
 	}
 
 
@@ -348,7 +401,8 @@ class customer
 	private: node_identifier_type node_id_;
 	/// The identifier of the node where this customer previously resided.
 	private: node_identifier_type old_node_id_;
-	/// The current customer priority (not *yet* used).
+	/// The current customer priority (the lower the value the higher the
+	/// priority).
 	private: priority_type priority_;
 	/// The current life status of this customer.
 	private: life_status status_;
@@ -358,13 +412,18 @@ class customer
 	private: real_type runtime_;
 	/// The departure time from the network.
 	private: real_type deptime_;
+	/// The service demand still to be received at the current node.
+	private: real_type residual_demand_;
+	/// The arrival sequence number in the queue of the current node.
+	private: ::boost::uint64_t queue_seq_;
 	/// The arrival time of every passage to each node.
-	private: ::std::map< node_identifier_type ,::std::vector<real_type> > node_arrtimes_;
+	private: node_time_container node_arrtimes_;
 //	private: ::std::vector<real_type> runtimes_;
 	/// The departure time of every passage from each node.
-	private: ::std::map< node_identifier_type, ::std::vector<real_type> > node_deptimes_;
-	/// The per-node collection of utilization profiles
-	private: ::std::map< node_identifier_type, ::std::vector<utilization_profile_type> > node_util_profiles_;
+	private: node_time_container node_deptimes_;
+	/// The per-node utilization profiles (recorded only on request of the
+	/// service strategy).
+	private: node_utilization_profile_container node_util_profiles_;
 };
 
 
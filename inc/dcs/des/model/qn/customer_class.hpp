@@ -32,6 +32,7 @@
 #include <boost/smart_ptr.hpp>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
+#include <dcs/des/memory_accounting.hpp>
 #include <dcs/des/model/qn/customer_class_category.hpp>
 #include <iostream>
 #include <stdexcept>
@@ -53,6 +54,7 @@ class customer_class
 	public: typedef node_type* node_pointer;
 	//public: typedef ::boost::shared_ptr<node_type> node_pointer;
 	public: typedef ::boost::shared_ptr<customer_type> customer_pointer;
+	protected: typedef typename memory_accounting_allocator<customer_type,customer_memory_category>::type customer_allocator_type;
 	private: typedef typename traits_type::node_identifier_type node_identifier_type;
 
 
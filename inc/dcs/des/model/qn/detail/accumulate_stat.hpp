@@ -0,0 +1,64 @@
+/**
+ * \file dcs/des/model/qn/detail/accumulate_stat.hpp
+ *
+ * \brief Feed an observation to the output statistics of a category.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_DETAIL_ACCUMULATE_STAT_HPP
+#define DCS_DES_MODEL_QN_DETAIL_ACCUMULATE_STAT_HPP
+
+
+namespace dcs { namespace des { namespace model { namespace qn { namespace detail {
+
+/**
+ * \brief Feed the given value to all the statistics associated to the given
+ *  category.
+ *
+ * \tparam StatisticMapT A map from output statistic categories to containers
+ *  of pointers to output statistics.
+ *
+ * Categories with no statistic are ignored.
+ */
+template <typename StatisticMapT, typename CategoryT, typename RealT>
+void accumulate_stat(StatisticMapT& stats, CategoryT category, RealT value)
+{
+	typename StatisticMapT::iterator it(stats.find(category));
+
+	if (it == stats.end())
+	{
+		return;
+	}
+
+	typedef typename StatisticMapT::mapped_type::iterator stats_iterator;
+	stats_iterator end_it(it->second.end());
+	for (stats_iterator stats_it = it->second.begin(); stats_it != end_it; ++stats_it)
+	{
+		(*(*stats_it))(value);
+	}
+}
+
+}}}}} // Namespace dcs::des::model::qn::detail
+
+
+#endif // DCS_DES_MODEL_QN_DETAIL_ACCUMULATE_STAT_HPP
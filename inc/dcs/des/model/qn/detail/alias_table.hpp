@@ -0,0 +1,170 @@
+/**
+ * \file dcs/des/model/qn/detail/alias_table.hpp
+ *
+ * \brief Alias table for sampling discrete distributions in constant time.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_DETAIL_ALIAS_TABLE_HPP
+#define DCS_DES_MODEL_QN_DETAIL_ALIAS_TABLE_HPP
+
+
+#include <boost/random/uniform_01.hpp>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <stdexcept>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace model { namespace qn { namespace detail {
+
+/**
+ * \brief Alias table for sampling a discrete distribution in constant time.
+ *
+ * The table is built by Vose's method in time linear in the number of
+ * outcomes; each sample costs a single uniform variate.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT>
+class alias_table
+{
+	public: typedef RealT real_type;
+	public: typedef ::std::size_t size_type;
+
+
+	public: alias_table()
+	{
+	}
+
+
+	/// Build the table for the given (non-negative, not normalized) weights.
+	public: template <typename ForwardIterT>
+		alias_table(ForwardIterT first, ForwardIterT last)
+	{
+		assign(first, last);
+	}
+
+
+	/// Build the table for the given (non-negative, not normalized) weights.
+	public: template <typename ForwardIterT>
+		void assign(ForwardIterT first, ForwardIterT last)
+	{
+		::std::vector<real_type> w(first, last);
+		size_type n(w.size());
+
+		real_type sum(0);
+		for (size_type i = 0; i < n; ++i)
+		{
+			// pre: weights must be non-negative
+			DCS_ASSERT(
+				w[i] >= 0,
+				throw ::std::invalid_argument("[dcs::des::model::qn::detail::alias_table::assign] Negative weight.")
+			);
+
+			sum += w[i];
+		}
+
+		// pre: at least one weight must be positive
+		DCS_ASSERT(
+			sum > 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::detail::alias_table::assign] No positive weight.")
+		);
+
+		prob_.assign(n, real_type(1));
+		alias_.resize(n);
+
+		::std::vector<size_type> small;
+		::std::vector<size_type> large;
+		for (size_type i = 0; i < n; ++i)
+		{
+			alias_[i] = i;
+			w[i] *= real_type(n)/sum;
+			if (w[i] < real_type(1))
+			{
+				small.push_back(i);
+			}
+			else
+			{
+				large.push_back(i);
+			}
+		}
+
+		while (!small.empty() && !large.empty())
+		{
+			size_type s(small.back());
+			size_type l(large.back());
+
+			small.pop_back();
+			prob_[s] = w[s];
+			alias_[s] = l;
+			w[l] -= real_type(1)-w[s];
+			if (w[l] < real_type(1))
+			{
+				large.pop_back();
+				small.push_back(l);
+			}
+		}
+		// Entries left in either list have probability 1 (up to rounding).
+	}
+
+
+	public: size_type size() const
+	{
+		return prob_.size();
+	}
+
+
+	public: bool empty() const
+	{
+		return prob_.empty();
+	}
+
+
+	/// Sample an outcome.
+	public: template <typename UniformRandomGeneratorT>
+		size_type operator()(UniformRandomGeneratorT& rng) const
+	{
+		::boost::uniform_01<real_type> u01;
+
+		real_type u(u01(rng)*real_type(prob_.size()));
+		size_type i(static_cast<size_type>(u));
+		if (i >= prob_.size())
+		{
+			i = prob_.size()-1;
+		}
+
+		return (u-real_type(i)) < prob_[i] ? i : alias_[i];
+	}
+
+
+	private: ::std::vector<real_type> prob_;
+	private: ::std::vector<size_type> alias_;
+};
+
+}}}}} // Namespace dcs::des::model::qn::detail
+
+
+#endif // DCS_DES_MODEL_QN_DETAIL_ALIAS_TABLE_HPP
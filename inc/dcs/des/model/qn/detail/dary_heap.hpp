@@ -0,0 +1,176 @@
+/**
+ * \file dcs/des/model/qn/detail/dary_heap.hpp
+ *
+ * \brief Array-based d-ary min-heap.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_DETAIL_DARY_HEAP_HPP
+#define DCS_DES_MODEL_QN_DETAIL_DARY_HEAP_HPP
+
+
+#include <cstddef>
+#include <dcs/debug.hpp>
+#include <functional>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace model { namespace qn { namespace detail {
+
+/**
+ * \brief Array-based d-ary min-heap.
+ *
+ * \tparam T The type of the elements.
+ * \tparam CompareT The strict weak ordering (the top element is the one which
+ *  is not greater than any other).
+ * \tparam Arity The number of children of each node.
+ *
+ * With respect to a binary heap, a d-ary heap (with d equal to 4 or 8) has
+ * a shallower tree, and the children of a node are contiguous in memory, so
+ * that both push and pop touch fewer cache lines.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename T, typename CompareT=::std::less<T>, ::std::size_t Arity=4>
+class dary_heap
+{
+	public: typedef T value_type;
+	public: typedef CompareT compare_type;
+	public: typedef ::std::size_t size_type;
+
+
+	public: explicit dary_heap(compare_type const& comp = compare_type())
+	: comp_(comp)
+	{
+	}
+
+
+	public: void push(value_type const& value)
+	{
+		data_.push_back(value);
+		sift_up(data_.size()-1);
+	}
+
+
+	public: void pop()
+	{
+		// pre: heap is not empty
+		DCS_DEBUG_ASSERT( !data_.empty() );
+
+		data_.front() = data_.back();
+		data_.pop_back();
+		if (!data_.empty())
+		{
+			sift_down(0);
+		}
+	}
+
+
+	public: value_type const& top() const
+	{
+		// pre: heap is not empty
+		DCS_DEBUG_ASSERT( !data_.empty() );
+
+		return data_.front();
+	}
+
+
+	public: bool empty() const
+	{
+		return data_.empty();
+	}
+
+
+	public: size_type size() const
+	{
+		return data_.size();
+	}
+
+
+	public: void clear()
+	{
+		data_.clear();
+	}
+
+
+	private: void sift_up(size_type i)
+	{
+		value_type value(data_[i]);
+
+		while (i > 0)
+		{
+			size_type parent((i-1)/Arity);
+			if (!comp_(value, data_[parent]))
+			{
+				break;
+			}
+			data_[i] = data_[parent];
+			i = parent;
+		}
+		data_[i] = value;
+	}
+
+
+	private: void sift_down(size_type i)
+	{
+		const size_type n(data_.size());
+		value_type value(data_[i]);
+
+		while (true)
+		{
+			size_type first(i*Arity+1);
+			if (first >= n)
+			{
+				break;
+			}
+
+			// Find the smallest child
+			size_type last(first+Arity < n ? first+Arity : n);
+			size_type best(first);
+			for (size_type c = first+1; c < last; ++c)
+			{
+				if (comp_(data_[c], data_[best]))
+				{
+					best = c;
+				}
+			}
+
+			if (!comp_(data_[best], value))
+			{
+				break;
+			}
+			data_[i] = data_[best];
+			i = best;
+		}
+		data_[i] = value;
+	}
+
+
+	private: compare_type comp_;
+	private: ::std::vector<value_type> data_;
+};
+
+}}}}} // Namespace dcs::des::model::qn::detail
+
+
+#endif // DCS_DES_MODEL_QN_DETAIL_DARY_HEAP_HPP
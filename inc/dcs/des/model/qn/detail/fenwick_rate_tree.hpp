@@ -0,0 +1,190 @@
+/**
+ * \file dcs/des/model/qn/detail/fenwick_rate_tree.hpp
+ *
+ * \brief Binary indexed (Fenwick) tree of transition rates.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_DETAIL_FENWICK_RATE_TREE_HPP
+#define DCS_DES_MODEL_QN_DETAIL_FENWICK_RATE_TREE_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace model { namespace qn { namespace detail {
+
+/**
+ * \brief Binary indexed (Fenwick) tree of non-negative rates.
+ *
+ * Supports O(log n) update of a single rate and O(log n) selection of the
+ * slot whose cumulative rate interval contains a given value.
+ * Since incremental updates accumulate round-off errors, the tree is rebuilt
+ * from the exact rates every \c rebuild_period updates.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT>
+class fenwick_rate_tree
+{
+	public: typedef RealT real_type;
+	public: typedef ::std::size_t size_type;
+
+
+	public: static const size_type rebuild_period = 1 << 16;
+
+
+	public: explicit fenwick_rate_tree(size_type n = 0)
+	: rates_(n, 0),
+	  tree_(n+1, 0),
+	  top_(1),
+	  nupd_(0)
+	{
+		while ((top_ << 1) <= n)
+		{
+			top_ <<= 1;
+		}
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+
+
+	public: size_type size() const
+	{
+		return rates_.size();
+	}
+
+
+	public: real_type rate(size_type i) const
+	{
+		return rates_[i];
+	}
+
+
+	public: void rate(size_type i, real_type r)
+	{
+		real_type delta(r-rates_[i]);
+
+		if (delta == 0)
+		{
+			return;
+		}
+
+		rates_[i] = r;
+
+		if (++nupd_ >= rebuild_period)
+		{
+			rebuild();
+			return;
+		}
+
+		const size_type n(rates_.size());
+		for (size_type k = i+1; k <= n; k += k & (~k+1))
+		{
+			tree_[k] += delta;
+		}
+	}
+
+
+	/// Return the sum of all rates.
+	public: real_type total() const
+	{
+		const size_type n(rates_.size());
+		real_type s(0);
+		for (size_type k = n; k > 0; k -= k & (~k+1))
+		{
+			s += tree_[k];
+		}
+		return s;
+	}
+
+
+	/// Return the slot \c i such that the sum of the rates before \c i is
+	/// not greater than \a x and the sum up to \c i is greater than \a x.
+	public: size_type find(real_type x) const
+	{
+		const size_type n(rates_.size());
+		size_type pos(0);
+
+		for (size_type step = top_; step > 0; step >>= 1)
+		{
+			if (pos+step <= n && tree_[pos+step] <= x)
+			{
+				pos += step;
+				x -= tree_[pos];
+			}
+		}
+
+		// Guard against round-off: never return a slot with a zero rate
+		size_type i(pos < n ? pos : n-1);
+		while (i > 0 && rates_[i] <= 0)
+		{
+			--i;
+		}
+		while (i < n-1 && rates_[i] <= 0)
+		{
+			++i;
+		}
+
+		return i;
+	}
+
+
+	public: void rebuild()
+	{
+		const size_type n(rates_.size());
+
+		::std::fill(tree_.begin(), tree_.end(), real_type(0));
+		for (size_type k = 1; k <= n; ++k)
+		{
+			tree_[k] += rates_[k-1];
+			size_type parent(k + (k & (~k+1)));
+			if (parent <= n)
+			{
+				tree_[parent] += tree_[k];
+			}
+		}
+
+		nupd_ = 0;
+	}
+
+
+	private: ::std::vector<real_type> rates_;
+	private: ::std::vector<real_type> tree_;
+	private: size_type top_;
+	private: size_type nupd_;
+};
+
+template <typename RealT>
+const typename fenwick_rate_tree<RealT>::size_type fenwick_rate_tree<RealT>::rebuild_period;
+
+}}}}} // Namespace dcs::des::model::qn::detail
+
+
+#endif // DCS_DES_MODEL_QN_DETAIL_FENWICK_RATE_TREE_HPP
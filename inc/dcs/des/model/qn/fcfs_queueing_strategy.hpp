@@ -31,37 +31,56 @@
 
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
+#include <dcs/des/detail/ring_buffer.hpp>
+#include <dcs/des/detail/segmented_ring.hpp>
 #include <dcs/des/model/qn/queueing_strategy.hpp>
 #include <dcs/macro.hpp>
-#include <queue>
+#include <algorithm>
+#include <cstddef>
 #include <stdexcept>
 
 
 namespace dcs { namespace des { namespace model { namespace qn {
 
+/**
+ * \brief First-Come First-Served (FCFS) queueing strategy.
+ *
+ * \tparam TraitsT The queueing network traits type.
+ *
+ * A finite-capacity queue is stored in a ring buffer allocated once for the
+ * whole capacity, while an infinite-capacity queue is stored in a segmented
+ * ring which recycles its chunks; in both cases, once the queue has reached
+ * its peak length, push and pop do not allocate memory.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
 template <typename TraitsT>
 class fcfs_queueing_strategy: public queueing_strategy<TraitsT>
 {
 	public: typedef queueing_strategy<TraitsT> base_type;
 	public: typedef TraitsT traits_type;
 	public: typedef typename base_type::customer_pointer customer_pointer;
-	private: typedef ::std::queue<customer_pointer> customer_container;
 	public: typedef typename base_type::size_type size_type;
+	private: typedef ::dcs::des::detail::ring_buffer<customer_pointer> bounded_customer_container;
+	private: typedef ::dcs::des::detail::segmented_ring<customer_pointer> unbounded_customer_container;
 
 
 	public: fcfs_queueing_strategy()
-	: base_type()
+	: base_type(),
+	  bounded_(false)
 	{
 	}
 
 
 	public: explicit fcfs_queueing_strategy(size_type capacity)
-	: base_type(capacity)
+	: base_type(capacity),
+	  bounded_(!this->infinite_capacity()),
+	  bounded_queue_(bounded_ ? this->capacity() : 0)
 	{
 	}
 
 
-	// Compiler-generator copy-constructor, copy-assignment, and destructor
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
 	// are fine.
 
 
@@ -83,7 +102,7 @@ class fcfs_queueing_strategy: public queueing_strategy<TraitsT>
 			throw ::std::logic_error("[dcs::des::model::qn::fcfs_queueing_strategy::do_push] Queue is full.")
 		);
 
-		queue_.push(ptr_customer);
+		insert(ptr_customer);
 	}
 
 
@@ -97,7 +116,7 @@ class fcfs_queueing_strategy: public queueing_strategy<TraitsT>
 			throw ::std::logic_error("[dcs::des::model::qn::fcfs_queueing_strategy::do_push] Queue is full.")
 		);
 
-		queue_.push(ptr_customer);
+		insert(ptr_customer);
 	}
 
 
@@ -109,19 +128,26 @@ class fcfs_queueing_strategy: public queueing_strategy<TraitsT>
 			throw ::std::logic_error("[dcs::des::model::qn::fcfs_queueing_strategy::do_push] Queue is empty.")
 		);
 
-		queue_.pop();
+		if (bounded_)
+		{
+			bounded_queue_.pop_front();
+		}
+		else
+		{
+			unbounded_queue_.pop_front();
+		}
 	}
 
 
 	private: bool do_empty() const
 	{
-		return queue_.empty();
+		return bounded_ ? bounded_queue_.empty() : unbounded_queue_.empty();
 	}
 
 
 	private: size_type do_size() const
 	{
-		return queue_.size();
+		return bounded_ ? bounded_queue_.size() : unbounded_queue_.size();
 	}
 
 
@@ -133,7 +159,7 @@ class fcfs_queueing_strategy: public queueing_strategy<TraitsT>
 			throw ::std::logic_error("[dcs::des::model::qn::fcfs_queueing_strategy::do_push] Queue is empty.")
 		);
 
-		return queue_.front();
+		return bounded_ ? bounded_queue_.front() : unbounded_queue_.front();
 	}
 
 
@@ -145,17 +171,67 @@ class fcfs_queueing_strategy: public queueing_strategy<TraitsT>
 			throw ::std::logic_error("[dcs::des::model::qn::fcfs_queueing_strategy::do_push] Queue is empty.")
 		);
 
-		return queue_.front();
+		return bounded_ ? bounded_queue_.front() : unbounded_queue_.front();
 	}
 
 
 	private: void do_reset()
 	{
-		queue_ = customer_container();
+		bounded_queue_.clear();
+		unbounded_queue_.clear();
+	}
+
+
+	private: void insert(customer_pointer const& ptr_customer)
+	{
+		// The capacity of the queue may have been changed since the last
+		// push; in that case, move the waiting customers to the right
+		// container.
+		const bool bounded(!this->infinite_capacity());
+		if (bounded != bounded_
+			|| (bounded && bounded_queue_.capacity() < static_cast< ::std::size_t >(this->capacity())))
+		{
+			adapt_container(bounded);
+		}
+
+		if (bounded_)
+		{
+			bounded_queue_.push_back(ptr_customer);
+		}
+		else
+		{
+			unbounded_queue_.push_back(ptr_customer);
+		}
+	}
+
+
+	private: void adapt_container(bool bounded)
+	{
+		if (bounded)
+		{
+			bounded_queue_.reserve(::std::max(static_cast< ::std::size_t >(this->capacity()), unbounded_queue_.size()+bounded_queue_.size()));
+			while (!unbounded_queue_.empty())
+			{
+				bounded_queue_.push_back(unbounded_queue_.front());
+				unbounded_queue_.pop_front();
+			}
+		}
+		else
+		{
+			while (!bounded_queue_.empty())
+			{
+				unbounded_queue_.push_back(bounded_queue_.front());
+				bounded_queue_.pop_front();
+			}
+		}
+		bounded_ = bounded;
 	}
 
 
-	private: customer_container queue_;
+	/// Tell if customers are stored in the bounded container.
+	private: bool bounded_;
+	private: bounded_customer_container bounded_queue_;
+	private: unbounded_customer_container unbounded_queue_;
 };
 
 }}}} // Namespace dcs::des::model::qn
@@ -0,0 +1,305 @@
+/**
+ * \file dcs/des/model/qn/heap_queueing_strategy.hpp
+ *
+ * \brief Queueing strategy serving customers in order of a key, backed by a
+ *  d-ary heap.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_HEAP_QUEUEING_STRATEGY_HPP
+#define DCS_DES_MODEL_QN_HEAP_QUEUEING_STRATEGY_HPP
+
+
+#include <boost/cstdint.hpp>
+#include <dcs/assert.hpp>
+#include <dcs/debug.hpp>
+#include <dcs/macro.hpp>
+#include <dcs/des/model/qn/detail/dary_heap.hpp>
+#include <dcs/des/model/qn/queueing_strategy.hpp>
+#include <stdexcept>
+
+
+namespace dcs { namespace des { namespace model { namespace qn {
+
+/// Key ordering customers by priority (the lower the value the higher the
+/// priority).
+template <typename TraitsT>
+struct customer_priority_key
+{
+	typedef typename TraitsT::real_type real_type;
+	typedef ::boost::shared_ptr<typename TraitsT::customer_type> customer_pointer;
+
+	static const bool demand_based = false;
+
+	real_type operator()(customer_pointer const& ptr_customer, real_type demand) const
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( demand );
+
+		return static_cast<real_type>(ptr_customer->priority());
+	}
+};
+
+
+/// Key ordering customers by the service demand they still have to receive.
+template <typename TraitsT>
+struct customer_demand_key
+{
+	typedef typename TraitsT::real_type real_type;
+	typedef ::boost::shared_ptr<typename TraitsT::customer_type> customer_pointer;
+
+	static const bool demand_based = true;
+
+	real_type operator()(customer_pointer const& ptr_customer, real_type demand) const
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ptr_customer );
+
+		return demand;
+	}
+};
+
+
+/**
+ * \brief Queueing strategy serving customers in order of a key, backed by a
+ *  d-ary heap.
+ *
+ * \tparam TraitsT The queueing network traits type.
+ * \tparam KeyT The function object computing the key of a customer from the
+ *  customer itself and the service demand it still has to receive; it must
+ *  also provide the \c demand_based constant telling if the key needs the
+ *  service demand.
+ * \tparam Arity The arity of the heap.
+ *
+ * Customers with lower keys are served first; customers with the same key are
+ * served in FCFS order.
+ * Both push and pop take \f$O(\log n)\f$ time.
+ *
+ * When preemptive, a waiting customer with a key strictly lower than the one
+ * of a customer in service preempts it, and the preempted customer is queued
+ * again with the service demand it still has to receive (preemptive-resume)
+ * and with its original sequence number, so that it is still served before
+ * the customers with the same key which arrived after it.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename TraitsT, typename KeyT, ::std::size_t Arity=4>
+class heap_queueing_strategy: public queueing_strategy<TraitsT>
+{
+	public: typedef queueing_strategy<TraitsT> base_type;
+	public: typedef TraitsT traits_type;
+	public: typedef KeyT key_type;
+	public: typedef typename base_type::real_type real_type;
+	public: typedef typename base_type::customer_pointer customer_pointer;
+	public: typedef typename base_type::size_type size_type;
+	private: struct entry
+	{
+		real_type key;
+		::boost::uint64_t seq;
+		customer_pointer ptr_customer;
+	};
+	private: struct entry_less
+	{
+		bool operator()(entry const& a, entry const& b) const
+		{
+			return a.key < b.key || (!(b.key < a.key) && a.seq < b.seq);
+		}
+	};
+	private: typedef detail::dary_heap<entry,entry_less,Arity> customer_container;
+
+
+	public: explicit heap_queueing_strategy(bool preemptive = false, key_type const& key = key_type())
+	: base_type(),
+	  preemptive_(preemptive),
+	  key_(key),
+	  seq_(0)
+	{
+	}
+
+
+	public: heap_queueing_strategy(size_type capacity, bool preemptive = false, key_type const& key = key_type())
+	: base_type(capacity),
+	  preemptive_(preemptive),
+	  key_(key),
+	  seq_(0)
+	{
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+
+
+	private: bool do_can_push(customer_pointer const& ptr_customer) const
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ptr_customer );
+
+		return this->infinite_capacity() || (this->size() < this->capacity());
+	}
+
+
+	private: void do_push(customer_pointer const& ptr_customer)
+	{
+		// pre: customer pointer must be a valid pointer.
+		DCS_DEBUG_ASSERT( ptr_customer );
+		// pre: queue is not full
+		DCS_ASSERT(
+			this->can_push(ptr_customer),
+			throw ::std::logic_error("[dcs::des::model::qn::heap_queueing_strategy::do_push] Queue is full.")
+		);
+
+		insert(ptr_customer);
+	}
+
+
+	private: void do_push_back(customer_pointer const& ptr_customer)
+	{
+		// pre: customer pointer must be a valid pointer.
+		DCS_DEBUG_ASSERT( ptr_customer );
+		// pre: queue is not full
+		DCS_ASSERT(
+			this->can_push(ptr_customer),
+			throw ::std::logic_error("[dcs::des::model::qn::heap_queueing_strategy::do_push_back] Queue is full.")
+		);
+
+		insert(ptr_customer);
+	}
+
+
+	private: void do_requeue(customer_pointer const& ptr_customer)
+	{
+		// pre: customer pointer must be a valid pointer.
+		DCS_DEBUG_ASSERT( ptr_customer );
+		// pre: queue is not full
+		DCS_ASSERT(
+			this->can_push(ptr_customer),
+			throw ::std::logic_error("[dcs::des::model::qn::heap_queueing_strategy::do_requeue] Queue is full.")
+		);
+
+		insert(ptr_customer, ptr_customer->queue_sequence());
+	}
+
+
+	private: void do_pop()
+	{
+		// pre: queue is not empty
+		DCS_ASSERT(
+			!this->empty(),
+			throw ::std::logic_error("[dcs::des::model::qn::heap_queueing_strategy::do_pop] Queue is empty.")
+		);
+
+		heap_.pop();
+	}
+
+
+	private: bool do_empty() const
+	{
+		return heap_.empty();
+	}
+
+
+	private: size_type do_size() const
+	{
+		return heap_.size();
+	}
+
+
+	private: customer_pointer const& do_peek() const
+	{
+		// pre: queue is not empty
+		DCS_ASSERT(
+			!this->empty(),
+			throw ::std::logic_error("[dcs::des::model::qn::heap_queueing_strategy::do_peek] Queue is empty.")
+		);
+
+		return heap_.top().ptr_customer;
+	}
+
+
+	private: customer_pointer do_peek()
+	{
+		// pre: queue is not empty
+		DCS_ASSERT(
+			!this->empty(),
+			throw ::std::logic_error("[dcs::des::model::qn::heap_queueing_strategy::do_peek] Queue is empty.")
+		);
+
+		return heap_.top().ptr_customer;
+	}
+
+
+	private: void do_reset()
+	{
+		heap_.clear();
+		seq_ = 0;
+	}
+
+
+	private: bool do_preemptive() const
+	{
+		return preemptive_;
+	}
+
+
+	private: bool do_demand_based() const
+	{
+		return key_type::demand_based;
+	}
+
+
+	private: bool do_precedes(customer_pointer const& ptr_a, real_type demand_a, customer_pointer const& ptr_b, real_type demand_b) const
+	{
+		return key_(ptr_a, demand_a) < key_(ptr_b, demand_b);
+	}
+
+
+	/// Queue a newly arrived customer, giving it the next sequence number.
+	private: void insert(customer_pointer const& ptr_customer)
+	{
+		ptr_customer->queue_sequence(seq_++);
+
+		insert(ptr_customer, ptr_customer->queue_sequence());
+	}
+
+
+	/// Queue a customer with the given sequence number.
+	private: void insert(customer_pointer const& ptr_customer, ::boost::uint64_t seq)
+	{
+		entry e;
+		e.key = key_(ptr_customer, ptr_customer->residual_demand());
+		e.seq = seq;
+		e.ptr_customer = ptr_customer;
+
+		heap_.push(e);
+	}
+
+
+	private: bool preemptive_;
+	private: key_type key_;
+	/// Arrival sequence number, to break ties in FCFS order.
+	private: ::boost::uint64_t seq_;
+	private: customer_container heap_;
+};
+
+}}}} // Namespace dcs::des::model::qn
+
+
+#endif // DCS_DES_MODEL_QN_HEAP_QUEUEING_STRATEGY_HPP
@@ -31,20 +31,35 @@
 
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
+#include <dcs/des/detail/array_stack.hpp>
 #include <dcs/des/model/qn/queueing_strategy.hpp>
-#include <stack>
+#include <cstddef>
 
 
 namespace dcs { namespace des { namespace model { namespace qn {
 
+/**
+ * \brief Last-Come First-Served (LCFS) queueing strategy.
+ *
+ * \tparam TraitsT The queueing network traits type.
+ *
+ * Customers are stored in an array-based stack.
+ * For a finite-capacity queue the stack is allocated once for the whole
+ * capacity; for an infinite-capacity queue it doubles its size when full and
+ * never shrinks.
+ * Either way, push and pop do not allocate memory once the queue has reached
+ * its peak length.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
 template <typename TraitsT>
 class lcfs_queueing_strategy: public queueing_strategy<TraitsT>
 {
 	public: typedef queueing_strategy<TraitsT> base_type;
 	public: typedef TraitsT traits_type;
 	public: typedef typename base_type::customer_pointer customer_pointer;
-	private: typedef ::std::stack<customer_pointer> customer_container;
 	public: typedef typename base_type::size_type size_type;
+	private: typedef ::dcs::des::detail::array_stack<customer_pointer> customer_container;
 
 
 	public: lcfs_queueing_strategy()
@@ -54,7 +69,8 @@ class lcfs_queueing_strategy: public queueing_strategy<TraitsT>
 
 
 	public: explicit lcfs_queueing_strategy(size_type capacity)
-	: base_type(capacity)
+	: base_type(capacity),
+	  stack_(this->infinite_capacity() ? 0 : this->capacity())
 	{
 	}
 
@@ -81,7 +97,7 @@ class lcfs_queueing_strategy: public queueing_strategy<TraitsT>
 			throw ::std::logic_error("[dcs::des::model::qn::lcfs_queueing_strategy::do_push] Queue is full.")
 		);
 
-		stack_.push(ptr_customer);
+		insert(ptr_customer);
 	}
 
 
@@ -95,7 +111,7 @@ class lcfs_queueing_strategy: public queueing_strategy<TraitsT>
 			throw ::std::logic_error("[dcs::des::model::qn::lcfs_queueing_strategy::do_push_back] Queue is full.")
 		);
 
-		stack_.push(ptr_customer);
+		insert(ptr_customer);
 	}
 
 
@@ -149,10 +165,27 @@ class lcfs_queueing_strategy: public queueing_strategy<TraitsT>
 
 	private: void do_reset()
 	{
-		stack_ = customer_container();
+		stack_.clear();
 	}
 
 
+	private: void insert(customer_pointer const& ptr_customer)
+	{
+		if (stack_.full())
+		{
+			// Either the queue is infinite or its capacity has been changed
+			// since the last push
+			::std::size_t n(this->infinite_capacity() ? 2*stack_.capacity() : this->capacity());
+			stack_.reserve(n > min_capacity ? n : min_capacity);
+		}
+
+		stack_.push(ptr_customer);
+	}
+
+
+	private: static const ::std::size_t min_capacity = 16;
+
+
 	private: customer_container stack_;
 };
 
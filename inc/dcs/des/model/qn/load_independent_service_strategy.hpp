@@ -36,6 +36,7 @@
 #include <dcs/math/stats/function/rand.hpp>
 #include <dcs/math/traits/float.hpp>
 //#include <map>
+#include <stdexcept>
 #include <vector>
 
 
@@ -161,6 +162,19 @@ class load_independent_service_strategy: public base_service_strategy<TraitsT>
 	// are fine.
 
 
+	/// Return the service time distribution of the given customer class.
+	public: distribution_type const& distribution(class_identifier_type class_id) const
+	{
+		// pre: class_id must have an associated distribution.
+		DCS_ASSERT(
+			class_id < distrs_.size(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::load_independent_service_strategy::distribution] Unknown class identifier.")
+		);
+
+		return distrs_[class_id];
+	}
+
+
 //	private: real_type common_share() const
 //	{
 //		//return this->capacity_multiplier()/static_cast<real_type>(ns_);
@@ -217,12 +231,10 @@ class load_independent_service_strategy: public base_service_strategy<TraitsT>
 				rt_info.accumulate_work(cur_time);
 				// ... Update the capacity multiplier,...
 				rt_info.capacity_multiplier(new_multiplier);
-				// ... Update the share,...
+				// ... And update the share.
+				// Note: the end-of-service needs not to be rescheduled since
+				// it is keyed in station work-time (see service_station_node).
 				rt_info.share(new_share);
-				// ... Compute the new residual work
-				real_type new_residual_time(rt_info.residual_work()/new_multiplier);
-				// ... And reschedule the end-of-service
-				this->node().reschedule_service(*ptr_customer, new_residual_time);
 
 				DCS_DEBUG_TRACE_L(3, "Updated Customer: " << rt_info.get_customer() << " - Service demand: " << rt_info.service_demand() << " - Multiplier: " << this->capacity_multiplier() << " - new share: " << rt_info.share() << " - new runtime: " << rt_info.runtime() << " - new completed work: " << rt_info.completed_work() << " - new residual-work: " << rt_info.residual_work() << " (Clock: " << this->node().network().engine().simulated_time() << ")");//XXX
 			}
@@ -259,29 +271,55 @@ class load_independent_service_strategy: public base_service_strategy<TraitsT>
 		// pre: customer pointer must be a valid pointer
 		DCS_DEBUG_ASSERT( ptr_customer );
 
-		real_type cur_time(this->node().network().engine().simulated_time());
+		runtime_info_type rt_info(do_resume(ptr_customer, do_sample_demand(ptr_customer, rng)));
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Service");//XXX
+
+		return rt_info;
+	}
+
+
+	private: real_type do_sample_demand(customer_pointer const& ptr_customer, random_generator_type& rng)
+	{
 		real_type svc_time(0);
 
 		typename traits_type::class_identifier_type class_id = ptr_customer->current_class();
 
         while ((svc_time = ::dcs::math::stats::rand(distrs_[class_id], rng)) < 0) ;
 
+		return svc_time;
+	}
+
+
+	private: runtime_info_type do_resume(customer_pointer const& ptr_customer, real_type svc_time)
+	{
+		// pre: make sure to not exceed the max # customer that can be served
+		DCS_DEBUG_ASSERT( num_busy_ < ns_ );
+
+		real_type cur_time(this->node().network().engine().simulated_time());
+
 //		svc_time /= this->capacity_multiplier();
 
+		// Look for the first idle server (servers may be released in any order,
+		// e.g., because of preemption or of different service demands).
+		uint_type sid(0);
+		while (servers_.count(sid) > 0)
+		{
+			++sid;
+		}
+
 		runtime_info_type rt_info(ptr_customer, cur_time, svc_time);
-		rt_info.server_id(num_busy_);
+		rt_info.server_id(sid);
 		rt_info.share(this->share());
 		rt_info.capacity_multiplier(this->capacity_multiplier());
 
-		servers_[num_busy_] = ptr_customer;
+		servers_[sid] = ptr_customer;
 //		customers_servers_[ptr_customer->id()] = num_busy_;
 
 		++num_busy_;
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") Generated service for customer: " << *ptr_customer << " - Service Demand: " << rt_info.service_demand() << " --> Runtime: " << svc_time);//XXX
 
-		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Service");//XXX
-
 		return rt_info;
 	}
 
@@ -116,8 +116,6 @@ class network_node: public ::dcs::des::entity
 //			throw ::std::invalid_argument("[dcs::des::model::qn::network_node::ctor] Network not specified.")
 //		);
 
-		init();
-
 		DCS_DEBUG_TRACE_L(5, "(" << this << ") END Constructor.");//XXX
 	}
 
@@ -136,8 +134,6 @@ class network_node: public ::dcs::des::entity
 	{
 		DCS_DEBUG_TRACE_L(5, "(" << this << ") BEGIN Copy constructor.");//XXX
 
-		init();
-
 		DCS_DEBUG_TRACE_L(5, "(" << this << ") END Copy constructor.");//XXX
 	}
 
@@ -147,8 +143,6 @@ class network_node: public ::dcs::des::entity
 	{
 		DCS_DEBUG_TRACE_L(5, "(" << this << ") BEGIN Destructor.");//XXX
 
-		finit();
-
 		DCS_DEBUG_TRACE_L(5, "(" << this << ") END Destructor.");//XXX
 	}
 
@@ -160,8 +154,6 @@ class network_node: public ::dcs::des::entity
 
 		if (this != &rhs)
 		{
-			finit();
-
 			base_type::operator=(rhs);
 
 			id_ = rhs.id_;
@@ -172,8 +164,6 @@ class network_node: public ::dcs::des::entity
 			narr_ = rhs.narr_;
 			ndep_ = rhs.ndep_;
 			last_evt_time_ = rhs.last_evt_time_;
-
-			init();
 		}
 
 		DCS_DEBUG_TRACE_L(5, "(" << this << ") END Copy Assignment.");//XXX
@@ -259,6 +249,34 @@ class network_node: public ::dcs::des::entity
 	}
 
 
+	/**
+	 * \brief Process the arrival of the given customer at the current
+	 *  simulated time, without going through the future event list.
+	 *
+	 * The sinks connected to the ARRIVAL event source (if any) are notified
+	 * by an event fired at the current simulated time.
+	 */
+	public: void receive_now(customer_pointer const& ptr_customer, engine_context_type& ctx)
+	{
+		// precondition: customer pointer must be a valid pointer.
+		DCS_DEBUG_ASSERT( ptr_customer );
+		// pre: event source pointer must be a valid pointer.
+		DCS_DEBUG_ASSERT( ptr_arr_evt_src_ );
+
+		if (!ptr_arr_evt_src_->enabled())
+		{
+			return;
+		}
+
+		process_arrival(ptr_customer, ctx);
+
+		if (!ptr_arr_evt_src_->empty())
+		{
+			ctx.schedule_event(ptr_arr_evt_src_, ctx.simulated_time(), ptr_customer);
+		}
+	}
+
+
 	public: event_source_type const& arrival_event_source() const
 	{
 		// pre: event source pointer must be a valid pointer
@@ -365,6 +383,13 @@ class network_node: public ::dcs::des::entity
 	}
 
 
+	/// Tell if at least one statistic is associated to the given category.
+	public: bool has_statistic(node_output_statistic_category category) const
+	{
+		return this->check_stat(category);
+	}
+
+
 	public: void initialize_simulation()
 	{
 		// Reset simulation-level statistics
@@ -482,7 +507,9 @@ class network_node: public ::dcs::des::entity
 		ptr_net_->engine().schedule_event(
 				ptr_arr_evt_src_,
 				ptr_net_->engine().simulated_time()+delay,
-				ptr_customer
+				ptr_customer,
+				&self_type::process_arrival_event,
+				this
 		);
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") End Scheduling ARRIVAL at Node " << *this << " for Customer " << *ptr_customer << " with Delay: " << delay << " (Clock: " << ptr_net_->engine().simulated_time() << ")"); //XXX
@@ -503,84 +530,44 @@ class network_node: public ::dcs::des::entity
 		ptr_net_->engine().schedule_event(
 				ptr_dep_evt_src_,
 				ptr_net_->engine().simulated_time()+delay,
-				ptr_customer
+				ptr_customer,
+				&self_type::process_departure_event,
+				this
 		);
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") End Scheduling DEPARTURE at Node " << *this << " for Customer " << *ptr_customer << " with Delay: " << delay << " (Clock: " << ptr_net_->engine().simulated_time() << ")"); //XXX
 	}
 
-	//@} Event triggers
-
 
-	private: void init()
+	/**
+	 * \brief Process the departure of the given customer at the current
+	 *  simulated time, without going through the future event list.
+	 *
+	 * The sinks connected to the DEPARTURE event source (if any) are notified
+	 * by an event fired at the current simulated time.
+	 */
+	protected: void depart_now(customer_pointer const& ptr_customer, engine_context_type& ctx)
 	{
-//		if (this->enabled())
-//		{
-			connect_to_event_sources();
-//		}
-	}
-
-
-	private: void finit()
-	{
-//		if (this->enabled())
-//		{
-			disconnect_from_event_sources();
-//		}
-	}
-
-
-	private: void connect_to_event_sources()
-	{
-		// pre: arrival event source pointer must be a valid pointer.
-		DCS_DEBUG_ASSERT( ptr_arr_evt_src_ );
-		// pre: departure event source pointer must be a valid pointer.
+		// precondition: customer pointer must be a valid pointer.
+		DCS_DEBUG_ASSERT( ptr_customer );
+		// pre: event source pointer must be a valid pointer.
 		DCS_DEBUG_ASSERT( ptr_dep_evt_src_ );
 
-		ptr_arr_evt_src_->connect(
-			::dcs::functional::bind(
-				&self_type::process_arrival,
-				this,
-				::dcs::functional::placeholders::_1,
-				::dcs::functional::placeholders::_2
-			)
-		);
-		ptr_dep_evt_src_->connect(
-			::dcs::functional::bind(
-				&self_type::process_departure,
-				this,
-				::dcs::functional::placeholders::_1,
-				::dcs::functional::placeholders::_2
-			)
-		);
-	}
-
+		if (!ptr_dep_evt_src_->enabled())
+		{
+			return;
+		}
 
-	private: void disconnect_from_event_sources()
-	{
-		// pre: pointer to arrival event source must be a valid pointer.
-		DCS_DEBUG_ASSERT( ptr_arr_evt_src_ );
-		// pre: pointer to departure event source must be a valid pointer.
-		DCS_DEBUG_ASSERT( ptr_dep_evt_src_ );
+		process_departure(ptr_customer, ctx);
 
-		ptr_arr_evt_src_->disconnect(
-			::dcs::functional::bind(
-				&self_type::process_arrival,
-				this,
-				::dcs::functional::placeholders::_1,
-				::dcs::functional::placeholders::_2
-			)
-		);
-		ptr_dep_evt_src_->disconnect(
-			::dcs::functional::bind(
-				&self_type::process_departure,
-				this,
-				::dcs::functional::placeholders::_1,
-				::dcs::functional::placeholders::_2
-			)
-		);
+		if (!ptr_dep_evt_src_->empty())
+		{
+			ctx.schedule_event(ptr_dep_evt_src_, ctx.simulated_time(), ptr_customer);
+		}
 	}
 
+	//@} Event triggers
+
 
 	//@{ Event handlers
 
@@ -604,10 +591,46 @@ class network_node: public ::dcs::des::entity
 //	}
 
 
-	private: void process_arrival(event_type const& evt, engine_context_type& ctx)
+	/**
+	 * \brief Handler for the ARRIVAL event.
+	 *
+	 * Events are delivered directly to the node (see \c event::handler), and
+	 * then to the sinks connected to the ARRIVAL event source (if any).
+	 */
+	private: static void process_arrival_event(void* ptr_target, event_type const& evt, engine_context_type& ctx)
+	{
+		self_type* ptr_node(static_cast<self_type*>(ptr_target));
+
+		ptr_node->process_arrival(evt.template unfolded_state<customer_pointer>(), ctx);
+
+		if (!ptr_node->ptr_arr_evt_src_->empty())
+		{
+			ptr_node->ptr_arr_evt_src_->emit(evt, ctx);
+		}
+	}
+
+
+	/**
+	 * \brief Handler for the DEPARTURE event.
+	 *
+	 * Events are delivered directly to the node (see \c event::handler), and
+	 * then to the sinks connected to the DEPARTURE event source (if any).
+	 */
+	private: static void process_departure_event(void* ptr_target, event_type const& evt, engine_context_type& ctx)
 	{
-		customer_pointer ptr_customer = evt.template unfolded_state<customer_pointer>();
+		self_type* ptr_node(static_cast<self_type*>(ptr_target));
+
+		ptr_node->process_departure(evt.template unfolded_state<customer_pointer>(), ctx);
+
+		if (!ptr_node->ptr_dep_evt_src_->empty())
+		{
+			ptr_node->ptr_dep_evt_src_->emit(evt, ctx);
+		}
+	}
+
 
+	private: void process_arrival(customer_pointer const& ptr_customer, engine_context_type& ctx)
+	{
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") Begin Processing ARRIVAL at Node " << *this << " for Customer " << *ptr_customer << " at Clock: " << ptr_net_->engine().simulated_time()); //XXX
 
 		// check: customer pointer must be a valid pointer
@@ -625,10 +648,8 @@ class network_node: public ::dcs::des::entity
 	}
 
 
-	private: void process_departure(event_type const& evt, engine_context_type& ctx)
+	private: void process_departure(customer_pointer const& ptr_customer, engine_context_type& ctx)
 	{
-		customer_pointer ptr_customer = evt.template unfolded_state<customer_pointer>();
-
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") Begin Processing DEPARTURE at Node " << *this << " for Customer " << *ptr_customer << " at Clock: " << ptr_net_->engine().simulated_time()); //XXX
 
 		// check: customer pointer must be a valid pointer
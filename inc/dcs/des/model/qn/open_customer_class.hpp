@@ -29,10 +29,13 @@
 #define DCS_DES_MODEL_QN_OPEN_CUSTOMER_CLASS_HPP
 
 
+#include <boost/smart_ptr.hpp>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
 #include <dcs/des/model/qn/customer_class.hpp>
+#include <dcs/macro.hpp>
 #include <dcs/math/stats/distribution/any_distribution.hpp>
+#include <dcs/math/stats/distribution/exponential.hpp>
 #include <dcs/math/stats/function/rand.hpp>
 #include <stdexcept>
 #include <string>
@@ -40,6 +43,33 @@
 
 namespace dcs { namespace des { namespace model { namespace qn {
 
+namespace detail {
+
+/// The rate of the arrival process whose interarrival times follow the given
+/// distribution, if it is a Poisson process; zero otherwise.
+template <typename RealT, typename DistributionT>
+struct poisson_rate_traits
+{
+	static RealT rate(DistributionT const& distr)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( distr );
+
+		return RealT(0);
+	}
+};
+
+template <typename RealT, typename ValueT>
+struct poisson_rate_traits< RealT, ::dcs::math::stats::exponential_distribution<ValueT> >
+{
+	static RealT rate(::dcs::math::stats::exponential_distribution<ValueT> const& distr)
+	{
+		return static_cast<RealT>(distr.rate());
+	}
+};
+
+} // Namespace detail
+
+
 template <typename TraitsT>
 class open_customer_class: public customer_class<TraitsT>
 {
@@ -49,13 +79,15 @@ class open_customer_class: public customer_class<TraitsT>
 	private: typedef typename traits_type::real_type real_type;
 	public: typedef ::dcs::math::stats::any_distribution<real_type> distribution_type;
 	private: typedef typename base_type::customer_type customer_type;
-	private: typedef typename base_type::customer_pointer customer_pointer;
+	public: typedef typename base_type::customer_pointer customer_pointer;
+	private: typedef typename base_type::customer_allocator_type customer_allocator_type;
 
 
 	public: template <typename DistributionT>
 		open_customer_class(::std::string const& name, DistributionT distr)
 	: base_type(name),
-	  distr_(::dcs::math::stats::make_any_distribution<DistributionT>(distr))
+	  distr_(::dcs::math::stats::make_any_distribution<DistributionT>(distr)),
+	  poisson_rate_(detail::poisson_rate_traits<real_type,DistributionT>::rate(distr))
 	{
 	}
 
@@ -63,7 +95,8 @@ class open_customer_class: public customer_class<TraitsT>
 	public: template <typename DistributionT>
 		open_customer_class(identifier_type id, ::std::string const& name, DistributionT distr)
 	: base_type(id, name),
-	  distr_(::dcs::math::stats::make_any_distribution<DistributionT>(distr))
+	  distr_(::dcs::math::stats::make_any_distribution<DistributionT>(distr)),
+	  poisson_rate_(detail::poisson_rate_traits<real_type,DistributionT>::rate(distr))
 	{
 	}
 
@@ -91,6 +124,28 @@ class open_customer_class: public customer_class<TraitsT>
 	}
 
 
+	/// The rate of the arrivals of this class if they form a Poisson process
+	/// (i.e., interarrival times are exponential); zero otherwise.
+	public: real_type poisson_rate() const
+	{
+		return poisson_rate_;
+	}
+
+
+	/**
+	 * \brief Create a new customer with the given interarrival time, instead
+	 *  of drawing it from the interarrival distribution.
+	 */
+	public: customer_pointer make_customer_with_interarrival(real_type iatime) const
+	{
+		customer_pointer ptr_customer(allocate_customer());
+
+		ptr_customer->arrival_time(iatime);
+
+		return ptr_customer;
+	}
+
+
 	private: customer_class_category do_category() const
 	{
 		return open_customer_class_category;
@@ -101,6 +156,27 @@ class open_customer_class: public customer_class<TraitsT>
 	{
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Do Making Customer for Class: " << *this << ".");//XXX
 
+		customer_pointer ptr_customer(allocate_customer());
+
+		// Generate interarrival time and set it up as the arrival time
+		real_type iatime(0);
+//		typename traits_type::random_generator_type& ref_rng = const_cast<typename traits_type::random_generator_type&>(this->network().random_generator());
+		typename traits_type::random_generator_type& ref_rng = const_cast<typename traits_type::network_type&>(this->network()).random_generator();
+//		typename traits_type::network_type& ref_net = const_cast<typename traits_type::network_type&>(this->network());
+//		typename traits_type::random_generator_type& ref_rng = ref_net.random_generator();
+		while ((iatime = ::dcs::math::stats::rand(distr_, ref_rng)) < 0) ;
+		ptr_customer->arrival_time(iatime);
+
+		DCS_DEBUG_TRACE_L(3, "Generated new interarrival time: " << iatime); //XXX
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Do Making Customer for Class: " << *this << ".");//XXX
+
+		return ptr_customer;
+	}
+
+
+	private: customer_pointer allocate_customer() const
+	{
 		// precondition: class has already been associated to a network
 		DCS_ASSERT(
 			this->network_ptr(),
@@ -113,31 +189,22 @@ class open_customer_class: public customer_class<TraitsT>
 		);
 
 		customer_pointer ptr_customer(
-				new customer_type(
+				::boost::allocate_shared<customer_type>(
+					customer_allocator_type(),
 					this->network_ptr()->generate_customer_id(),
 					this->id(),
 					this->reference_node()
 				)
 			);
 
-		// Generate interarrival time and set it up as the arrival time
-		real_type iatime(0);
-//		typename traits_type::random_generator_type& ref_rng = const_cast<typename traits_type::random_generator_type&>(this->network().random_generator());
-		typename traits_type::random_generator_type& ref_rng = const_cast<typename traits_type::network_type&>(this->network()).random_generator();
-//		typename traits_type::network_type& ref_net = const_cast<typename traits_type::network_type&>(this->network());
-//		typename traits_type::random_generator_type& ref_rng = ref_net.random_generator();
-		while ((iatime = ::dcs::math::stats::rand(distr_, ref_rng)) < 0) ;
-		ptr_customer->arrival_time(iatime);
-
-		DCS_DEBUG_TRACE_L(3, "Generated new interarrival time: " << iatime); //XXX
-
-		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Do Making Customer for Class: " << *this << ".");//XXX
-
 		return ptr_customer;
 	}
 
 
 	private: distribution_type distr_;
+	/// The rate of the Poisson arrival process (zero if arrivals are not
+	/// Poisson).
+	private: real_type poisson_rate_;
 };
 
 }}}} // Namespace dcs::des::model::qn
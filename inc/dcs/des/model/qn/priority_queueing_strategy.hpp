@@ -0,0 +1,75 @@
+/**
+ * \file dcs/des/model/qn/priority_queueing_strategy.hpp
+ *
+ * \brief Priority queueing strategy.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_PRIORITY_QUEUEING_STRATEGY_HPP
+#define DCS_DES_MODEL_QN_PRIORITY_QUEUEING_STRATEGY_HPP
+
+
+#include <dcs/des/model/qn/heap_queueing_strategy.hpp>
+
+
+namespace dcs { namespace des { namespace model { namespace qn {
+
+/**
+ * \brief Priority queueing strategy.
+ *
+ * Customers are served in order of priority (the lower the value the higher
+ * the priority), and in FCFS order within the same priority.
+ * When preemptive, an arriving customer preempts the lowest priority customer
+ * in service (if its priority is lower), which resumes its service later
+ * (preemptive-resume).
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename TraitsT>
+class priority_queueing_strategy: public heap_queueing_strategy<TraitsT,customer_priority_key<TraitsT> >
+{
+	public: typedef heap_queueing_strategy<TraitsT,customer_priority_key<TraitsT> > base_type;
+	public: typedef TraitsT traits_type;
+	public: typedef typename base_type::size_type size_type;
+
+
+	public: explicit priority_queueing_strategy(bool preemptive = false)
+	: base_type(preemptive)
+	{
+	}
+
+
+	public: priority_queueing_strategy(size_type capacity, bool preemptive = false)
+	: base_type(capacity, preemptive)
+	{
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+};
+
+}}}} // Namespace dcs::des::model::qn
+
+
+#endif // DCS_DES_MODEL_QN_PRIORITY_QUEUEING_STRATEGY_HPP
@@ -67,11 +67,16 @@ class probabilistic_routing_strategy: public base_routing_strategy<TraitsT>
 	private: typedef ::std::map<routing_destination_type,real_type> routing_destination_container;
 	private: typedef ::std::map<routing_destination_type,routing_destination_container> routing_container;
 	private: typedef ::std::vector<routing_destination_type> indexed_routing_destination_container;
-	private: typedef ::std::map<routing_destination_type,indexed_routing_destination_container> indexed_routing_container;
 	//private: typedef typename routing_container::size_type size_type;
 	//private: typedef typename ::dcs::math::stats::discrete_distribution<size_type,real_type> distribution_type;
 	private: typedef typename ::dcs::math::stats::discrete_distribution<real_type> distribution_type;
-	private: typedef ::std::map<routing_destination_type,distribution_type> distribution_map;
+	/// The destinations of a given source along with their distribution.
+	private: struct indexed_routing_destinations
+	{
+		indexed_routing_destination_container destinations;
+		distribution_type distribution;
+	};
+	private: typedef ::std::map<routing_destination_type,indexed_routing_destinations> distribution_map;
 //	private: typedef typename traits_type::network_type network_type;
 //	public: typedef network_type* network_pointer;
 
@@ -158,6 +163,39 @@ class probabilistic_routing_strategy: public base_routing_strategy<TraitsT>
 	}
 
 
+	/**
+	 * \brief Add all the routes in the range [\a first, \a last).
+	 *
+	 * Each element of the range must provide the \c src_node, \c src_class,
+	 * \c dst_node, \c dst_class and \c probability members (see
+	 * \c routing_table_entry).
+	 * Routes sharing the same source are expected to be adjacent in the
+	 * range, so that each source is looked up only once; a route already
+	 * existing is overwritten.
+	 */
+	public: template <typename ForwardIterT>
+		void add_routes(ForwardIterT first, ForwardIterT last)
+	{
+		routing_destination_container* ptr_dsts(0);
+		routing_destination_type src;
+
+		for (; first != last; ++first)
+		{
+			routing_destination_type cur_src(first->src_node, first->src_class);
+			if (!ptr_dsts || cur_src != src)
+			{
+				src = cur_src;
+				ptr_dsts = &routes_[src];
+			}
+
+			(*ptr_dsts)[::std::make_pair(first->dst_node, first->dst_class)] = first->probability;
+		}
+
+		// invalidate the distribution map
+		distrs_.clear();
+	}
+
+
 //	private: routing_destination_type do_route(customer_pointer const& ptr_customer, ::dcs::math::random::any_generator<real_type> rng)
 	private: routing_destination_type do_route(customer_pointer const& ptr_customer)
 	{
@@ -172,13 +210,19 @@ class probabilistic_routing_strategy: public base_routing_strategy<TraitsT>
 			make_distributions();
 		}
 
-		typename distribution_map::key_type key = ::std::make_pair(n, c);
+		typename distribution_map::const_iterator it = distrs_.find(::std::make_pair(n, c));
+
+		// check: there must be at least a route for the current node and class
+		DCS_ASSERT(
+			it != distrs_.end(),
+			throw ::std::logic_error("[dcs::des::model::qn::probabilistic_routing_strategy::do_route] No route for the current node and class.")
+		);
 
 		//registry<traits_type>& reg = registry<traits_type>::instance();
 
 		size_type pos = static_cast<size_type>(
 			::dcs::math::stats::rand(
-				distrs_[key],
+				it->second.distribution,
 				//ptr_net_->random_generator()
 				//ptr_customer->network().random_generator()
 				//reg.random_generator()
@@ -186,7 +230,7 @@ class probabilistic_routing_strategy: public base_routing_strategy<TraitsT>
 			)
 		);
 
-		routing_destination_type dst = ord_routes_[key].at(pos);
+		routing_destination_type dst = it->second.destinations.at(pos);
 
 		return dst;
 	}
@@ -197,29 +241,30 @@ class probabilistic_routing_strategy: public base_routing_strategy<TraitsT>
 		typedef typename routing_container::const_iterator outer_iterator;
 		typedef typename routing_destination_container::const_iterator inner_iterator;
 
+		// Sources are visited in key order, so each one is appended at the
+		// end of the distribution map.
+		::std::vector<real_type> probs;
 		outer_iterator out_end = routes_.end();
 		for (outer_iterator out_it = routes_.begin(); out_it != out_end; ++out_it)
 		{
-			routing_destination_type key = out_it->first;
-			::std::vector<real_type> probs;
-			indexed_routing_destination_container routes;
+			indexed_routing_destinations& dsts = distrs_.insert(distrs_.end(), ::std::make_pair(out_it->first, indexed_routing_destinations()))->second;
 
-			inner_iterator inn_end = routes_[key].end();
-			for (inner_iterator inn_it = routes_[key].begin(); inn_it != inn_end; ++inn_it)
+			probs.clear();
+			dsts.destinations.reserve(out_it->second.size());
+			inner_iterator inn_end = out_it->second.end();
+			for (inner_iterator inn_it = out_it->second.begin(); inn_it != inn_end; ++inn_it)
 			{
 				probs.push_back(inn_it->second);
-				routes.push_back(inn_it->first);
+				dsts.destinations.push_back(inn_it->first);
 			}
 
-			distrs_[key] = distribution_type(probs.begin(), probs.end());
-			ord_routes_[key] = routes;
+			dsts.distribution = distribution_type(probs.begin(), probs.end());
 		}
 	}
 
      
 //	private: network_pointer ptr_net_;
 	private: routing_container routes_;
-	private: indexed_routing_container ord_routes_;
 	private: distribution_map distrs_;
 	private: random_generator_pointer ptr_rng_;
 };
@@ -43,6 +43,15 @@ namespace dcs { namespace des { namespace model { namespace qn {
 /**
  * \brief Processor sharing service strategy.
  *
+ * Each server is a work lane (see \c base_service_strategy::num_work_lanes)
+ * whose virtual time advances at the capacity multiplier divided by the
+ * number of customers sharing the server.
+ * The end-of-service of a customer is keyed by the station on its virtual
+ * finish tag (the virtual time at the start of service plus the service
+ * demand), which does not change when customers join or leave the server:
+ * an arrival or a departure only changes the rate of the lane, and re-times
+ * the single pending end-of-service event of the station.
+ *
  * \author Marco Guazzone (marco.guazzone@gmail.com)
  */
 template <typename TraitsT>
@@ -172,8 +181,6 @@ class ps_service_strategy: public base_service_strategy<TraitsT>
 		typedef typename server_container::const_iterator server_iterator;
 		typedef typename customer_set::const_iterator customer_iterator;
 
-		real_type cur_time(this->node().network().engine().simulated_time());
-
 		server_iterator srv_end_it(servers_.end());
 		for (server_iterator srv_it = servers_.begin(); srv_it != srv_end_it; ++srv_it)
 		{
@@ -188,11 +195,10 @@ class ps_service_strategy: public base_service_strategy<TraitsT>
 
 				DCS_DEBUG_TRACE_L(3, "Updating Customer: " << rt_info.get_customer() << " - Service demand: " << rt_info.service_demand() << " - Multiplier: " << this->capacity_multiplier() << " - old share: " << rt_info.share() << " - old runtime: " << rt_info.runtime() << " - old completed work: " << rt_info.completed_work() << " - old residual-work: " << rt_info.residual_work());//XXX
 
-				// Increment the residual runtime of this customer by a factor of nc
-				rt_info.accumulate_work(cur_time);
+				// Update the share.
+				// Note: the end-of-service needs not to be rescheduled since
+				// it is keyed in lane work-time (see service_station_node).
 				rt_info.share(share);
-				// And reschedule the end-of-service
-				this->node().reschedule_service(rt_info.get_customer(), rt_info.residual_work()/share);
 
 				DCS_DEBUG_TRACE_L(3, "Updated Customer: " << rt_info.get_customer() << " - Service demand: " << rt_info.service_demand() << " - Multiplier: " << this->capacity_multiplier() << " - new share: " << rt_info.share() << " - new runtime: " << rt_info.runtime() << " - new completed work: " << rt_info.completed_work() << " - new residual-work: " << rt_info.residual_work());//XXX
 			}
@@ -231,33 +237,15 @@ class ps_service_strategy: public base_service_strategy<TraitsT>
 		else
 		{
 			// The new customer has found all servers busy and hence it has to
-			// share a server with other (already running) customers.
-			// We need to apply Processor-Sharing strategy and increment the
-			// (residual) service time of each customer running on this server
-			// by a factor of n, where n is the number of customer (included
-			// the last arrived) running on this server.
+			// share a server with other (already running) customers, each of
+			// which now gets 1/n of the server, where n is the number of
+			// customers (included the last arrived) running on this server.
 
 			uint_type nc(servers_[next_srv_].size()+1); // +1 ... to take into consideration the just inserted customer
 
 			share /= static_cast<real_type>(nc);
 
-			typedef typename customer_set::const_iterator customer_iterator;
-
-			customer_iterator end_it(servers_[next_srv_].end());
-			for (customer_iterator it = servers_[next_srv_].begin(); it != end_it; ++it)
-			{
-				runtime_info_type& rt_info(this->info(*it));
-
-				DCS_DEBUG_TRACE_L(3, "Updating Customer: " << rt_info.get_customer() << " - Service demand: " << rt_info.service_demand() << " - Multiplier: " << this->capacity_multiplier() << " - old share: " << rt_info.share() << " - old runtime: " << rt_info.runtime() << " - old completed work: " << rt_info.completed_work() << " - old residual-work: " << rt_info.residual_work());//XXX
-
-				// Increment the residual runtime of this customer by a factor of nc
-				rt_info.accumulate_work(cur_time);
-				rt_info.share(share);
-				// And reschedule the end-of-service
-				this->node().reschedule_service(rt_info.get_customer(), rt_info.residual_work()/share);
-
-				DCS_DEBUG_TRACE_L(3, "Updated Customer: " << rt_info.get_customer() << " - Service demand: " << rt_info.service_demand() << " - Multiplier: " << this->capacity_multiplier() << " - new share: " << rt_info.share() << " - new runtime: " << rt_info.runtime() << " - new completed work: " << rt_info.completed_work() << " - new residual-work: " << rt_info.residual_work());//XXX
-			}
+			update_shares(next_srv_, share);
 		}
 
 //		svc_time /= this->capacity_multiplier();
@@ -265,9 +253,16 @@ class ps_service_strategy: public base_service_strategy<TraitsT>
 		runtime_info_type rt_info(ptr_customer, cur_time, svc_time);
 		rt_info.server_id(next_srv_);
 		rt_info.share(share);
+		// The runtime at the current share is what the station converts into
+		// lane work-time (i.e., into the service demand)
+		rt_info.capacity_multiplier(share);
 
 		servers_[next_srv_].insert(ptr_customer->id());
 
+		// Slow down the virtual time of the server: this only re-times the
+		// pending end-of-service event of the station (if needed)
+		this->node().update_work_rate(next_srv_);
+
 		next_srv_ = next_server(next_srv_);
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") Generated service for customer: " << *ptr_customer << " - Service demand: " << rt_info.service_demand() << " - Multiplier: " << this->capacity_multiplier() << " - Share: " << share << " - Runtime: " << rt_info.runtime() << " - Server: " << next_srv_);//XXX
@@ -302,30 +297,13 @@ class ps_service_strategy: public base_service_strategy<TraitsT>
 		}
 		else
 		{
-			uint_type nc(servers_[sid].size()+1); // +1 ... to take into consideration the just removed customer
-			real_type share(this->common_share()/static_cast<real_type>(nc-1));
-
-			typedef typename customer_set::iterator customer_iterator;
-
-			customer_iterator end_it(servers_[sid].end());
-			real_type cur_time(this->node().network().engine().simulated_time());
-			for (customer_iterator it = servers_[sid].begin(); it != end_it; ++it)
-			{
-				runtime_info_type& rt_info(this->info(*it));
-
-				DCS_DEBUG_TRACE_L(3, "Updating Customer: " << rt_info.get_customer() << " - Service demand: " << rt_info.service_demand() << " - Multiplier: " << this->capacity_multiplier() << " - old share: " << rt_info.share() << " - runtime: " << rt_info.runtime() << " - old completed work: " << rt_info.completed_work() << " - old residual-work: " << rt_info.residual_work());//XXX
-
-				// Decrement the residual runtime of this customer by a factor of 1/nc
-				rt_info.accumulate_work(cur_time);
-				rt_info.share(share);
-
-				// And reschedule the end-of-service
-				this->node().reschedule_service(rt_info.get_customer(), rt_info.residual_work()/share);
-
-				DCS_DEBUG_TRACE_L(3, "Updated Customer: " << rt_info.get_customer() << " - Service demand: " << rt_info.service_demand() << " - Multiplier: " << this->capacity_multiplier() << " - new share: " << rt_info.share() << " - runtime: " << rt_info.runtime() << " - new completed work: " << rt_info.completed_work() << " - new residual-work: " << rt_info.residual_work());//XXX
-			}
+			update_shares(sid, this->common_share()/static_cast<real_type>(servers_[sid].size()));
 		}
 
+		// Speed up the virtual time of the server: this only re-times the
+		// pending end-of-service event of the station (if needed)
+		this->node().update_work_rate(sid);
+
 		next_srv_ = next_server(sid);
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Do-Remove of Customer: " << *ptr_customer);//XXX
@@ -361,9 +339,48 @@ class ps_service_strategy: public base_service_strategy<TraitsT>
 		return num_busy_;
 	}
 
+
+	private: uint_type do_num_work_lanes() const
+	{
+		return ns_;
+	}
+
+
+	private: uint_type do_work_lane(customer_type const& customer) const
+	{
+		return this->info(customer.id()).server_id();
+	}
+
+
+	private: real_type do_work_rate(uint_type lane) const
+	{
+		uint_type nc(servers_[lane].size());
+
+		return nc > 1 ? this->common_share()/static_cast<real_type>(nc) : this->common_share();
+	}
+
 	//@} Interface member functions
 
 
+	/**
+	 * \brief Set the share of the customers running on the given server.
+	 *
+	 * This is runtime bookkeeping only (e.g., for utilization profiles):
+	 * end-of-services are keyed on virtual finish tags and need not to be
+	 * rescheduled.
+	 */
+	private: void update_shares(uint_type sid, real_type share)
+	{
+		typedef typename customer_set::const_iterator customer_iterator;
+
+		customer_iterator end_it(servers_[sid].end());
+		for (customer_iterator it = servers_[sid].begin(); it != end_it; ++it)
+		{
+			this->info(*it).share(share);
+		}
+	}
+
+
 	private: uint_type next_server(uint_type start_sid) const
 	{
 		uint_type best_sid(start_sid);
@@ -43,6 +43,7 @@
 #include <dcs/des/model/qn/queueing_network_traits.hpp>
 #include <dcs/exception.hpp>
 #include <dcs/functional/bind.hpp>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <stdexcept>
@@ -500,6 +501,56 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 	}
 
 
+	/**
+	 * \brief Add all the nodes in the range [\a first, \a last) to this
+	 *  network.
+	 *
+	 * Storage for the nodes is reserved once, before adding them.
+	 */
+	public: template <typename ForwardIterT>
+		void add_nodes(ForwardIterT first, ForwardIterT last)
+	{
+		reserve_nodes(nodes_.size()+::std::distance(first, last));
+
+		for (; first != last; ++first)
+		{
+			add_node(*first);
+		}
+	}
+
+
+	/**
+	 * \brief Add all the customer classes in the range [\a first, \a last) to
+	 *  this network.
+	 *
+	 * Storage for the customer classes is reserved once, before adding them.
+	 */
+	public: template <typename ForwardIterT>
+		void add_classes(ForwardIterT first, ForwardIterT last)
+	{
+		reserve_classes(classes_.size()+::std::distance(first, last));
+
+		for (; first != last; ++first)
+		{
+			add_class(*first);
+		}
+	}
+
+
+	/// Reserve storage for at least \a n nodes.
+	public: void reserve_nodes(node_size_type n)
+	{
+		nodes_.reserve(n);
+	}
+
+
+	/// Reserve storage for at least \a n customer classes.
+	public: void reserve_classes(class_size_type n)
+	{
+		classes_.reserve(n);
+	}
+
+
 	/**
 	 * \brief Retrieve the node associated to the given identifier.
 	 * \param id The identifier of the wanted node.
@@ -703,6 +754,9 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 	 *  the given time delay.
 	 * \param ptr_customer Pointer to the arriving customer.
 	 * \param delay Time offset with respect to the current simulated time.
+	 *
+	 * With a zero delay, the arrival is accounted at once; a NETWORK-ARRIVAL
+	 * event is scheduled only if some sink is connected to its event source.
 	 */
 	public: void schedule_arrival(customer_pointer const& ptr_customer, real_type delay)
 	{
@@ -723,11 +777,25 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") Begin Scheduling NETWORK-ARRIVAL event for Customer: " << *ptr_customer << " at Delay: " << delay << " (Clock: " << ptr_eng_->simulated_time() << ")");//XXX
 
-		ptr_eng_->schedule_event(
-				ptr_arr_evt_src_,
-				ptr_eng_->simulated_time()+delay,
-				ptr_customer
-		);
+		if (delay > 0)
+		{
+			ptr_eng_->schedule_event(
+					ptr_arr_evt_src_,
+					ptr_eng_->simulated_time()+delay,
+					ptr_customer,
+					&self_type::process_arrival_event,
+					this
+			);
+		}
+		else if (ptr_arr_evt_src_->enabled())
+		{
+			process_arrival(ptr_customer);
+
+			if (!ptr_arr_evt_src_->empty())
+			{
+				ptr_eng_->schedule_event(ptr_arr_evt_src_, ptr_eng_->simulated_time(), ptr_customer);
+			}
+		}
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") End scheduling NETWORK-ARRIVAL event for Customer: " << *ptr_customer << " at Delay: " << delay << " (Clock: " << ptr_eng_->simulated_time() << ")");//XXX
 	}
@@ -738,6 +806,10 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 	 *  the given time delay.
 	 * \param ptr_customer Pointer to the departing customer.
 	 * \param delay Time offset with respect to the current simulated time.
+	 *
+	 * With a zero delay, the departure is accounted at once; a
+	 * NETWORK-DEPARTURE event is scheduled only if some sink is connected to
+	 * its event source.
 	 */
 	public: void schedule_departure(customer_pointer const& ptr_customer, real_type delay)
 	{
@@ -758,11 +830,25 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") Begin Scheduling NETWORK-DEPARTURE event for Customer: " << *ptr_customer << " at Delay: " << delay << " (Clock: " << ptr_eng_->simulated_time() << ")");//XXX
 
-		ptr_eng_->schedule_event(
-				ptr_dep_evt_src_,
-				ptr_eng_->simulated_time()+delay,
-				ptr_customer
-		);
+		if (delay > 0)
+		{
+			ptr_eng_->schedule_event(
+					ptr_dep_evt_src_,
+					ptr_eng_->simulated_time()+delay,
+					ptr_customer,
+					&self_type::process_departure_event,
+					this
+			);
+		}
+		else if (ptr_dep_evt_src_->enabled())
+		{
+			process_departure(ptr_customer);
+
+			if (!ptr_dep_evt_src_->empty())
+			{
+				ptr_eng_->schedule_event(ptr_dep_evt_src_, ptr_eng_->simulated_time(), ptr_customer);
+			}
+		}
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") End Scheduling NETWORK-DEPARTURE event for Customer: " << *ptr_customer << " at Delay: " << delay << " (Clock: " << ptr_eng_->simulated_time() << ")");//XXX
 	}
@@ -855,6 +941,13 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 	}
 
 
+	/// Tell if at least one statistic is associated to the given category.
+	public: bool has_statistic(network_output_statistic_category category) const
+	{
+		return check_stat(category);
+	}
+
+
 	//@{ dcs::des::entity implementation
 
 
@@ -974,22 +1067,6 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 
 		// Connect to the local event sources
 
-		ptr_arr_evt_src_->connect(
-			::dcs::functional::bind(
-				&self_type::process_arrival,
-				this,
-				::dcs::functional::placeholders::_1,
-				::dcs::functional::placeholders::_2
-			)
-		);
-		ptr_dep_evt_src_->connect(
-			::dcs::functional::bind(
-				&self_type::process_departure,
-				this,
-				::dcs::functional::placeholders::_1,
-				::dcs::functional::placeholders::_2
-			)
-		);
 		ptr_dis_evt_src_->connect(
 			::dcs::functional::bind(
 				&self_type::process_discard,
@@ -1041,22 +1118,6 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 
 		// Disconnect from local event sources
 
-		ptr_arr_evt_src_->disconnect(
-			::dcs::functional::bind(
-				&self_type::process_arrival,
-				this,
-				::dcs::functional::placeholders::_1,
-				::dcs::functional::placeholders::_2
-			)
-		);
-		ptr_dep_evt_src_->disconnect(
-			::dcs::functional::bind(
-				&self_type::process_departure,
-				this,
-				::dcs::functional::placeholders::_1,
-				::dcs::functional::placeholders::_2
-			)
-		);
 		ptr_dis_evt_src_->disconnect(
 			::dcs::functional::bind(
 				&self_type::process_discard,
@@ -1408,46 +1469,82 @@ class queueing_network: public ::dcs::des::entity//, public dcs::enable_shared_f
 	}
 
 
-	/// Handler for the NETWORK-ARRIVAL event.
-	private: void process_arrival(event_type const& evt, engine_context_type& ctx)
+	/// Account the arrival of the given customer to the network.
+	private: void process_arrival(customer_pointer const& ptr_customer)
 	{
-		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
-		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ptr_customer );
 
-		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Processing NETWORK-ARRIVAL - Customer: " << *(evt.template unfolded_state<customer_pointer>()) << " (Clock: " << ctx.simulated_time() << ").");//XXX
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Processing NETWORK-ARRIVAL - Customer: " << *ptr_customer << " (Clock: " << ptr_eng_->simulated_time() << ").");//XXX
 
 		++narr_;
 
-		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Processing NETWORK-ARRIVAL - Customer: " << *(evt.template unfolded_state<customer_pointer>()) << " (Clock: " << ctx.simulated_time() << ").");//XXX
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Processing NETWORK-ARRIVAL - Customer: " << *ptr_customer << " (Clock: " << ptr_eng_->simulated_time() << ").");//XXX
 	}
 
 
-	/// Handler for the NETWORK-DEPARTURE event.
-	private: void process_departure(event_type const& evt, engine_context_type& ctx)
+	/// Account the departure of the given customer from the network.
+	private: void process_departure(customer_pointer const& ptr_customer)
 	{
-		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
-		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
-
-		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Processing NETWORK-DEPARTURE - Customer: " << *(evt.template unfolded_state<customer_pointer>()) << " (Clock: " << ctx.simulated_time() << ").");//XXX
-
-		customer_pointer ptr_customer = evt.template unfolded_state<customer_pointer>();
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Processing NETWORK-DEPARTURE - Customer: " << *ptr_customer << " (Clock: " << ptr_eng_->simulated_time() << ").");//XXX
 
 		// check: customer pointer must be a valid pointer
 		DCS_DEBUG_ASSERT( ptr_customer );
 
+		real_type sim_time(ptr_eng_->simulated_time());
+
 		// Update customer info
-		ptr_customer->departure_time(ctx.simulated_time());
+		ptr_customer->departure_time(sim_time);
 		ptr_customer->status(customer_type::died_status);
 
 		/// Update statistics
 
 		++ndep_;
 //		accumulate_stat(net_throughput_statistic_category,
-//						ndep_/ctx.simulated_time());
+//						ndep_/sim_time);
 		accumulate_stat(net_response_time_statistic_category,
-						ctx.simulated_time() - ptr_customer->arrival_time());
+						sim_time - ptr_customer->arrival_time());
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Processing NETWORK-DEPARTURE - Customer: " << *ptr_customer << " (Clock: " << ptr_eng_->simulated_time() << ").");//XXX
+	}
+
+
+	/**
+	 * \brief Handler for the (delayed) NETWORK-ARRIVAL event.
+	 *
+	 * Events are delivered directly to the network (see \c event::handler),
+	 * and then to the sinks connected to the NETWORK-ARRIVAL event source (if
+	 * any).
+	 */
+	private: static void process_arrival_event(void* ptr_target, event_type const& evt, engine_context_type& ctx)
+	{
+		self_type* ptr_net(static_cast<self_type*>(ptr_target));
+
+		ptr_net->process_arrival(evt.template unfolded_state<customer_pointer>());
 
-		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Processing NETWORK-DEPARTURE - Customer: " << *(evt.template unfolded_state<customer_pointer>()) << " (Clock: " << ctx.simulated_time() << ").");//XXX
+		if (!ptr_net->ptr_arr_evt_src_->empty())
+		{
+			ptr_net->ptr_arr_evt_src_->emit(evt, ctx);
+		}
+	}
+
+
+	/**
+	 * \brief Handler for the (delayed) NETWORK-DEPARTURE event.
+	 *
+	 * Events are delivered directly to the network (see \c event::handler),
+	 * and then to the sinks connected to the NETWORK-DEPARTURE event source
+	 * (if any).
+	 */
+	private: static void process_departure_event(void* ptr_target, event_type const& evt, engine_context_type& ctx)
+	{
+		self_type* ptr_net(static_cast<self_type*>(ptr_target));
+
+		ptr_net->process_departure(evt.template unfolded_state<customer_pointer>());
+
+		if (!ptr_net->ptr_dep_evt_src_->empty())
+		{
+			ptr_net->ptr_dep_evt_src_->emit(evt, ctx);
+		}
 	}
 
 
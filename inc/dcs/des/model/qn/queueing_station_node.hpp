@@ -38,6 +38,8 @@
 #include <dcs/des/model/qn/service_station_node.hpp>
 #include <dcs/des/model/qn/output_statistic_category.hpp>
 #include <dcs/macro.hpp>
+#include <dcs/math/traits/float.hpp>
+#include <vector>
 
 
 namespace dcs { namespace des { namespace model { namespace qn {
@@ -54,7 +56,7 @@ class queueing_station_node: public service_station_node<TraitsT>
 	public: typedef typename base_type::customer_pointer customer_pointer;
 	public: typedef typename base_type::service_strategy_pointer service_strategy_pointer;
 	public: typedef typename base_type::routing_strategy_pointer routing_strategy_pointer;
-	public: typedef queueing_strategy<traits_type> queueing_strategy_type;
+	public: typedef ::dcs::des::model::qn::queueing_strategy<traits_type> queueing_strategy_type;
 	public: typedef ::boost::shared_ptr<queueing_strategy_type> queueing_strategy_pointer;
 	//public: typedef ::std::size_t size_type;
 	private: typedef typename traits_type::engine_type engine_type;
@@ -173,6 +175,15 @@ class queueing_station_node: public service_station_node<TraitsT>
 	}
 
 
+	public: queueing_strategy_type const& queueing_strategy() const
+	{
+		// pre: queueing strategy pointer must be a valid pointer.
+		DCS_DEBUG_ASSERT( ptr_queue_ );
+
+		return *ptr_queue_;
+	}
+
+
 	protected: void discard_event_source(event_source_pointer const& ptr_evt_src)
 	{
 		// pre: discard event source pointer must be a valid pointer.
@@ -251,6 +262,12 @@ class queueing_station_node: public service_station_node<TraitsT>
 
 //		this->schedule_arrival(ptr_customer, real_type/*zero*/());
 
+		if (ptr_queue_->demand_based() && ptr_customer->residual_demand() < 0)
+		{
+			// The queueing order depends on service demands: draw it now.
+			ptr_customer->residual_demand(this->service_strategy().sample_demand(ptr_customer, this->network().random_generator()));
+		}
+
 		if (ptr_queue_->can_push(ptr_customer))
 		{
 			ptr_queue_->push(ptr_customer);
@@ -259,9 +276,14 @@ class queueing_station_node: public service_station_node<TraitsT>
 
 			// Serve a new customer (if possible)
 			serve(ctx);
+
+			// Preempt a customer in service (if needed)
+			preempt(ctx);
 		}
 		else
 		{
+			ptr_customer->residual_demand(-1);
+
 			this->schedule_discard(ptr_customer, real_type/*zero*/());
 		}
 
@@ -448,7 +470,17 @@ class queueing_station_node: public service_station_node<TraitsT>
 			typename traits_type::random_generator_type& ref_rng = this->network().random_generator();
 			//runtime = this->service_strategy().serve(ptr_customer, ref_rng);
 			runtime_info_type rt_info;
-			rt_info = this->service_strategy().serve(ptr_customer, ref_rng);
+			if (ptr_customer->residual_demand() >= 0)
+			{
+				// Service demand already known (drawn in advance or left by a
+				// preemption)
+				rt_info = this->service_strategy().resume(ptr_customer, ptr_customer->residual_demand());
+				ptr_customer->residual_demand(-1);
+			}
+			else
+			{
+				rt_info = this->service_strategy().serve(ptr_customer, ref_rng);
+			}
 			//runtime = this->service_strategy().info(ptr_customer).runtime();
 			//runtime = rt_info.runtime()/rt_info.share();
 			//runtime = rt_info.runtime()/(rt_info.share()*this->service_strategy().capacity_multiplier());
@@ -458,6 +490,12 @@ class queueing_station_node: public service_station_node<TraitsT>
 
 			DCS_DEBUG_TRACE_L(3, "Serving Customer: " << *ptr_customer << " @ runtime: " << runtime);
 
+			// check: preemption reads the residual demand from the work clocks,
+			//        which needs the work-rate to turn the runtime into the
+			//        service demand
+			DCS_DEBUG_ASSERT( !ptr_queue_->preemptive()
+							  || ::dcs::math::float_traits<real_type>::approximately_equal(runtime*this->service_strategy().work_rate(this->service_strategy().work_lane(*ptr_customer)), rt_info.service_demand()) );
+
 			this->schedule_service(ptr_customer, runtime);
 		}
 #ifdef DCS_DEBUG
@@ -478,6 +516,54 @@ class queueing_station_node: public service_station_node<TraitsT>
 	}
 
 
+	/**
+	 * \brief Let the first waiting customer preempt a customer in service,
+	 *  if all servers are busy and the queueing strategy says so.
+	 *
+	 * The preempted customer is the one in service with the lowest precedence;
+	 * it is queued again with the service demand it still has to receive.
+	 */
+	private: void preempt(engine_context_type const& ctx)
+	{
+		if (!ptr_queue_->preemptive()
+			|| ptr_queue_->empty()
+			|| this->service_strategy().can_serve())
+		{
+			return;
+		}
+
+		customer_pointer ptr_waiting(ptr_queue_->peek());
+		customer_pointer ptr_victim;
+		real_type victim_demand(0);
+
+		::std::vector<customer_pointer> served(this->active_customers());
+		for (typename ::std::vector<customer_pointer>::size_type i = 0; i < served.size(); ++i)
+		{
+			real_type demand(this->residual_service_demand(*served[i]));
+
+			if (ptr_queue_->preempts(ptr_waiting, served[i], demand)
+				&& (!ptr_victim || ptr_queue_->precedes(ptr_victim, victim_demand, served[i], demand)))
+			{
+				ptr_victim = served[i];
+				victim_demand = demand;
+			}
+		}
+
+		if (!ptr_victim)
+		{
+			return;
+		}
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") Customer: " << *ptr_waiting << " preempts Customer: " << *ptr_victim << " (residual demand: " << victim_demand << ")");
+
+		ptr_victim->residual_demand(this->preempt_service(ptr_victim));
+
+		// Serve the preempting customer and queue the preempted one
+		serve(ctx);
+		ptr_queue_->requeue(ptr_victim);
+	}
+
+
 	protected: void do_enable(bool flag)
 	{
 		base_type::do_enable(flag);
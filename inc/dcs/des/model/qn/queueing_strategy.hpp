@@ -33,6 +33,7 @@
 #include <cstddef>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
+#include <dcs/macro.hpp>
 #include <stdexcept>
 
 
@@ -42,6 +43,7 @@ template <typename TraitsT>
 class queueing_strategy
 {
 	public: typedef TraitsT traits_type;
+	public: typedef typename traits_type::real_type real_type;
 	public: typedef typename traits_type::customer_type customer_type;
 	public: typedef typename ::boost::shared_ptr<customer_type> customer_pointer;
 	//public: typedef ::std::size_t size_type;
@@ -149,6 +151,24 @@ class queueing_strategy
 	}
 
 
+	/**
+	 * \brief Queue again a customer preempted while in service.
+	 *
+	 * The customer keeps the position it had among customers with the same
+	 * precedence when it was first queued.
+	 */
+	public: void requeue(customer_pointer const& ptr_customer)
+	{
+		// pre: customer pointer must be a valid pointer.
+		DCS_ASSERT(
+			ptr_customer,
+			throw ::std::invalid_argument("[dcs::des::model::qn::queueing_strategy::requeue] Invalid customer.")
+		);
+
+		do_requeue(ptr_customer);
+	}
+
+
 	public: customer_pointer const& peek() const
 	{
 		return do_peek();
@@ -179,6 +199,59 @@ class queueing_strategy
 	}
 
 
+	/// Tell if customers in service can be preempted by waiting ones.
+	public: bool preemptive() const
+	{
+		return do_preemptive();
+	}
+
+
+	/// Tell if the order of customers depends on their service demand (which
+	/// must then be known before queueing).
+	public: bool demand_based() const
+	{
+		return do_demand_based();
+	}
+
+
+	/**
+	 * \brief Tell if a customer strictly precedes another one in the service
+	 *  order.
+	 *
+	 * \param ptr_a The first customer.
+	 * \param demand_a The service demand the first customer still has to
+	 *  receive.
+	 * \param ptr_b The second customer.
+	 * \param demand_b The service demand the second customer still has to
+	 *  receive.
+	 */
+	public: bool precedes(customer_pointer const& ptr_a, real_type demand_a, customer_pointer const& ptr_b, real_type demand_b) const
+	{
+		// pre: customer pointers must be valid pointers.
+		DCS_ASSERT(
+			ptr_a && ptr_b,
+			throw ::std::invalid_argument("[dcs::des::model::qn::queueing_strategy::precedes] Invalid customer.")
+		);
+
+		return do_precedes(ptr_a, demand_a, ptr_b, demand_b);
+	}
+
+
+	/**
+	 * \brief Tell if a waiting customer must preempt a customer in service.
+	 *
+	 * \param ptr_waiting The waiting customer.
+	 * \param ptr_served The customer in service.
+	 * \param residual_demand The service demand the customer in service still
+	 *  has to receive.
+	 */
+	public: bool preempts(customer_pointer const& ptr_waiting, customer_pointer const& ptr_served, real_type residual_demand) const
+	{
+		return preemptive()
+			   && precedes(ptr_waiting, ptr_waiting->residual_demand(), ptr_served, residual_demand);
+	}
+
+
 	private: virtual bool do_can_push(customer_pointer const& ptr_customer) const = 0;
 
 
@@ -206,6 +279,35 @@ class queueing_strategy
 	private: virtual void do_reset() = 0;
 
 
+	private: virtual void do_requeue(customer_pointer const& ptr_customer)
+	{
+		do_push(ptr_customer);
+	}
+
+
+	private: virtual bool do_preemptive() const
+	{
+		return false;
+	}
+
+
+	private: virtual bool do_demand_based() const
+	{
+		return false;
+	}
+
+
+	private: virtual bool do_precedes(customer_pointer const& ptr_a, real_type demand_a, customer_pointer const& ptr_b, real_type demand_b) const
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ptr_a );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( demand_a );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ptr_b );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( demand_b );
+
+		return false;
+	}
+
+
 	private: size_type capacity_;
 	private: bool is_inf_;
 };
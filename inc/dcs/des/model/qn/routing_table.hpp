@@ -0,0 +1,409 @@
+/**
+ * \file dcs/des/model/qn/routing_table.hpp
+ *
+ * \brief Compact description of the routes of a queueing network, with CSV
+ *  and binary readers and writers.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_ROUTING_TABLE_HPP
+#define DCS_DES_MODEL_QN_ROUTING_TABLE_HPP
+
+
+#include <boost/cstdint.hpp>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace model { namespace qn {
+
+/**
+ * \brief A route of a queueing network.
+ *
+ * A customer of class \c src_class leaving node \c src_node goes to node
+ * \c dst_node as a customer of class \c dst_class with the given probability.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename TraitsT>
+struct routing_table_entry
+{
+	typedef typename TraitsT::node_identifier_type node_identifier_type;
+	typedef typename TraitsT::class_identifier_type class_identifier_type;
+	typedef typename TraitsT::real_type real_type;
+
+	routing_table_entry()
+	: src_node(0),
+	  src_class(0),
+	  dst_node(0),
+	  dst_class(0),
+	  probability(0)
+	{
+	}
+
+	routing_table_entry(node_identifier_type sn, class_identifier_type sc, node_identifier_type dn, class_identifier_type dc, real_type p)
+	: src_node(sn),
+	  src_class(sc),
+	  dst_node(dn),
+	  dst_class(dc),
+	  probability(p)
+	{
+	}
+
+	node_identifier_type src_node;
+	class_identifier_type src_class;
+	node_identifier_type dst_node;
+	class_identifier_type dst_class;
+	real_type probability;
+};
+
+
+namespace detail { namespace /*<unnamed>*/ {
+
+/// Magic header of binary routing tables.
+static const char routing_table_magic[8] = { 'D', 'C', 'S', 'Q', 'N', 'R', 'T', '1' };
+
+/// Size in bytes of a route in a binary routing table.
+static const ::std::size_t routing_table_record_size = 4*sizeof(::boost::uint32_t)+sizeof(double);
+
+
+/// Number of routes read at once from a binary routing table.
+static const ::std::size_t routing_table_chunk_size = 1024;
+
+
+inline void throw_routing_table_csv_error(char const* what, ::std::size_t lineno)
+{
+	::std::ostringstream oss;
+	oss << "[dcs::des::model::qn::read_routing_table_csv] " << what << " at line " << lineno << ".";
+	throw ::std::runtime_error(oss.str());
+}
+
+
+inline char const* skip_routing_table_csv_blanks(char const* p)
+{
+	while (*p == ' ' || *p == '\t' || *p == '\r')
+	{
+		++p;
+	}
+	return p;
+}
+
+
+/// Parse a non-negative integral identifier which must fit in \c IdT.
+template <typename IdT>
+char const* parse_routing_table_csv_id(char const* p, ::std::size_t lineno, IdT& id)
+{
+	p = skip_routing_table_csv_blanks(p);
+	if (*p < '0' || *p > '9')
+	{
+		throw_routing_table_csv_error("Malformed identifier", lineno);
+	}
+
+	char* end(0);
+	errno = 0;
+	unsigned long v(::std::strtoul(p, &end, 10));
+	id = static_cast<IdT>(v);
+	if (errno == ERANGE || static_cast<unsigned long>(id) != v)
+	{
+		throw_routing_table_csv_error("Identifier out of range", lineno);
+	}
+	if (*skip_routing_table_csv_blanks(end) != ',' && *skip_routing_table_csv_blanks(end) != '\0')
+	{
+		throw_routing_table_csv_error("Malformed identifier", lineno);
+	}
+
+	return end;
+}
+
+
+/// Write an identifier as a 32-bit unsigned integer, checking that it fits.
+template <typename IdT>
+::boost::uint32_t routing_table_binary_id(IdT id)
+{
+	::boost::uint32_t v(static_cast< ::boost::uint32_t >(id));
+	if (static_cast<IdT>(v) != id
+		|| (::std::numeric_limits<IdT>::is_signed && static_cast< ::boost::int64_t >(id) < 0))
+	{
+		throw ::std::runtime_error("[dcs::des::model::qn::write_routing_table_binary] Identifier does not fit in 32 bits.");
+	}
+	return v;
+}
+
+
+template <typename EntryT>
+void parse_routing_table_csv_line(::std::string const& line, ::std::size_t lineno, EntryT& entry)
+{
+	char const* p(line.c_str());
+
+	p = parse_routing_table_csv_id(p, lineno, entry.src_node);
+	for (::std::size_t i = 1; i < 5; ++i)
+	{
+		p = skip_routing_table_csv_blanks(p);
+		if (*p != ',')
+		{
+			throw_routing_table_csv_error("Missing field", lineno);
+		}
+		++p;
+
+		switch (i)
+		{
+			case 1:
+				p = parse_routing_table_csv_id(p, lineno, entry.src_class);
+				break;
+			case 2:
+				p = parse_routing_table_csv_id(p, lineno, entry.dst_node);
+				break;
+			case 3:
+				p = parse_routing_table_csv_id(p, lineno, entry.dst_class);
+				break;
+			default:
+				{
+					char* end(0);
+					double prob(::std::strtod(p, &end));
+					if (end == p)
+					{
+						throw_routing_table_csv_error("Malformed probability", lineno);
+					}
+					entry.probability = static_cast<typename EntryT::real_type>(prob);
+					p = end;
+				}
+				break;
+		}
+	}
+
+	if (*skip_routing_table_csv_blanks(p) != '\0')
+	{
+		throw_routing_table_csv_error("Trailing characters", lineno);
+	}
+}
+
+}} // Namespace detail::<unnamed>
+
+
+/**
+ * \brief Read a routing table in CSV format.
+ *
+ * Each line holds a route as
+ * <tt>src_node,src_class,dst_node,dst_class,probability</tt>; empty lines and
+ * lines starting with \c # are skipped.
+ * Identifiers must be non-negative integers fitting the identifier types of
+ * \c TraitsT.
+ *
+ * \return The number of routes read.
+ * \exception std::runtime_error Malformed route.
+ */
+template <typename TraitsT, typename OutputIterT>
+::std::size_t read_routing_table_csv(::std::istream& is, OutputIterT out)
+{
+	routing_table_entry<TraitsT> entry;
+	::std::string line;
+	::std::size_t lineno(0);
+	::std::size_t n(0);
+
+	while (::std::getline(is, line))
+	{
+		++lineno;
+
+		::std::string::size_type pos(line.find_first_not_of(" \t\r"));
+		if (pos == ::std::string::npos || line[pos] == '#')
+		{
+			continue;
+		}
+
+		detail::parse_routing_table_csv_line(line, lineno, entry);
+		*out++ = entry;
+		++n;
+	}
+
+	return n;
+}
+
+
+/// Write a routing table in CSV format.
+template <typename ForwardIterT>
+void write_routing_table_csv(::std::ostream& os, ForwardIterT first, ForwardIterT last)
+{
+	os << "# src_node,src_class,dst_node,dst_class,probability" << ::std::endl;
+	for (; first != last; ++first)
+	{
+		os << first->src_node
+		   << "," << first->src_class
+		   << "," << first->dst_node
+		   << "," << first->dst_class
+		   << "," << first->probability
+		   << "\n";
+	}
+	os.flush();
+}
+
+
+/**
+ * \brief Read a routing table in binary format.
+ *
+ * The binary format, written by \c write_routing_table_binary, is made of the
+ * 8-byte magic string \c DCSQNRT1, the number of routes as a 64-bit unsigned
+ * integer, and the routes, each one as four 32-bit unsigned integers (source
+ * node and class, destination node and class) followed by a double precision
+ * probability; numbers are stored in the native byte order.
+ * Routes are read in chunks of bounded size, so that a corrupted number of
+ * routes cannot trigger a huge allocation.
+ *
+ * \return The number of routes read.
+ * \exception std::runtime_error Bad header or truncated table.
+ */
+template <typename TraitsT, typename OutputIterT>
+::std::size_t read_routing_table_binary(::std::istream& is, OutputIterT out)
+{
+	typedef routing_table_entry<TraitsT> entry_type;
+
+	char magic[sizeof(detail::routing_table_magic)];
+	::boost::uint64_t n(0);
+
+	is.read(magic, sizeof(magic));
+	is.read(reinterpret_cast<char*>(&n), sizeof(n));
+	if (!is || ::std::memcmp(magic, detail::routing_table_magic, sizeof(magic)) != 0)
+	{
+		throw ::std::runtime_error("[dcs::des::model::qn::read_routing_table_binary] Bad routing table header.");
+	}
+
+	if (n > ::std::numeric_limits< ::std::size_t >::max()/detail::routing_table_record_size)
+	{
+		throw ::std::runtime_error("[dcs::des::model::qn::read_routing_table_binary] Too many routes.");
+	}
+
+	::std::vector<char> buf(static_cast< ::std::size_t >(n < detail::routing_table_chunk_size ? n : detail::routing_table_chunk_size)*detail::routing_table_record_size);
+	for (::boost::uint64_t i = 0; i < n; )
+	{
+		::std::size_t m(static_cast< ::std::size_t >((n-i) < detail::routing_table_chunk_size ? (n-i) : detail::routing_table_chunk_size));
+
+		is.read(&buf[0], m*detail::routing_table_record_size);
+		if (static_cast< ::std::size_t >(is.gcount()) != m*detail::routing_table_record_size)
+		{
+			throw ::std::runtime_error("[dcs::des::model::qn::read_routing_table_binary] Truncated routing table.");
+		}
+
+		char const* p(&buf[0]);
+		for (::std::size_t j = 0; j < m; ++j, ++i)
+		{
+			::boost::uint32_t ids[4];
+			double prob;
+
+			::std::memcpy(ids, p, sizeof(ids));
+			::std::memcpy(&prob, p+sizeof(ids), sizeof(prob));
+			p += detail::routing_table_record_size;
+
+			*out++ = entry_type(ids[0], ids[1], ids[2], ids[3], static_cast<typename entry_type::real_type>(prob));
+		}
+	}
+
+	return static_cast< ::std::size_t >(n);
+}
+
+
+/**
+ * \brief Write a routing table in binary format (see
+ *  \c read_routing_table_binary).
+ *
+ * \exception std::runtime_error An identifier does not fit in 32 bits.
+ */
+template <typename ForwardIterT>
+void write_routing_table_binary(::std::ostream& os, ForwardIterT first, ForwardIterT last)
+{
+	::std::vector<char> buf;
+	::boost::uint64_t n(0);
+
+	for (; first != last; ++first)
+	{
+		::boost::uint32_t ids[4] = {
+				detail::routing_table_binary_id(first->src_node),
+				detail::routing_table_binary_id(first->src_class),
+				detail::routing_table_binary_id(first->dst_node),
+				detail::routing_table_binary_id(first->dst_class)
+		};
+		double prob(static_cast<double>(first->probability));
+
+		buf.resize(buf.size()+detail::routing_table_record_size);
+		char* p(&buf[buf.size()-detail::routing_table_record_size]);
+		::std::memcpy(p, ids, sizeof(ids));
+		::std::memcpy(p+sizeof(ids), &prob, sizeof(prob));
+		++n;
+	}
+
+	os.write(detail::routing_table_magic, sizeof(detail::routing_table_magic));
+	os.write(reinterpret_cast<char const*>(&n), sizeof(n));
+	if (!buf.empty())
+	{
+		os.write(&buf[0], buf.size());
+	}
+	os.flush();
+}
+
+
+/**
+ * \brief Load a routing table in CSV format into a routing strategy.
+ *
+ * The routing strategy must provide the \c add_routes member function (see
+ * \c probabilistic_routing_strategy).
+ */
+template <typename TraitsT, typename RoutingStrategyT>
+::std::size_t load_routing_table_csv(::std::istream& is, RoutingStrategyT& routing)
+{
+	::std::vector< routing_table_entry<TraitsT> > routes;
+
+	::std::size_t n = read_routing_table_csv<TraitsT>(is, ::std::back_inserter(routes));
+	routing.add_routes(routes.begin(), routes.end());
+
+	return n;
+}
+
+
+/**
+ * \brief Load a routing table in binary format into a routing strategy.
+ *
+ * The routing strategy must provide the \c add_routes member function (see
+ * \c probabilistic_routing_strategy).
+ */
+template <typename TraitsT, typename RoutingStrategyT>
+::std::size_t load_routing_table_binary(::std::istream& is, RoutingStrategyT& routing)
+{
+	::std::vector< routing_table_entry<TraitsT> > routes;
+
+	::std::size_t n = read_routing_table_binary<TraitsT>(is, ::std::back_inserter(routes));
+	routing.add_routes(routes.begin(), routes.end());
+
+	return n;
+}
+
+}}}} // Namespace dcs::des::model::qn
+
+
+#endif // DCS_DES_MODEL_QN_ROUTING_TABLE_HPP
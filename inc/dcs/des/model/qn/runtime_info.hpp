@@ -234,6 +234,12 @@ DCS_DEBUG_TRACE("(" << this << ") Accumulating work for Customer: " << ::std::se
 	}
 
 
+	public: void utilization_profile(real_type t1, real_type t2, real_type u)
+	{
+		ptr_customer_->node_utilization_profile(ptr_customer_->current_node(), t1, t2, u);
+	}
+
+
 	public: void utilization_profile(utilization_profile_type const& profile)
 	{
 //		return u_prof_;
@@ -244,7 +250,7 @@ DCS_DEBUG_TRACE("(" << this << ") Accumulating work for Customer: " << ::std::se
 	public: utilization_profile_type const& utilization_profile() const
 	{
 //		return u_prof_;
-		return ptr_customer_->node_utilization_profile();
+		return ptr_customer_->node_utilization_profile(ptr_customer_->current_node());
 	}
 
 
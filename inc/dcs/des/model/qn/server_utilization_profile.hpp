@@ -29,371 +29,274 @@
 #define DCS_DES_MODEL_QN_SERVER_UTILIZATION_PROFILE_HPP
 
 
-#include <boost/icl/interval.hpp>
-#include <boost/icl/interval_map.hpp>
-#include <boost/smart_ptr.hpp>
-#include <iosfwd>
-#include <iterator>
-#include <utility>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <dcs/des/memory_accounting.hpp>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
 
 
 namespace dcs { namespace des { namespace model { namespace qn {
 
-namespace detail {
-
-template <typename ItemT>
-struct item_const_wrapper
+/// A time segment of a utilization profile.
+template <typename RealT>
+class server_utilization_profile_item
 {
-	public: typedef ItemT item_type;
-	private: typedef typename item_type::first_type interval_type;
-	public: typedef typename interval_type::domain_type time_type;
-	public: typedef typename item_type::second_type value_type;
-	private: typedef item_type const& reference;
-	private: typedef item_type const* pointer;
-
-	public: item_const_wrapper(item_type const& item)
-	: ptr_item_(&item)
-	{
-	}
-
-	public: time_type begin_time() const { return ::boost::icl::lower(ptr_item_->first); }
-
-	public: time_type end_time() const { return ::boost::icl::upper(ptr_item_->first); }
-
-	public: value_type utilization() const { return ptr_item_->second; }
-
-	private: pointer ptr_item_;
-};
+	public: typedef RealT real_type;
 
 
-template <typename ItemT>
-struct item_wrapper
-{
-	public: typedef ItemT item_type;
-	private: typedef typename ::boost::remove_const<item_type>::first_type interval_type;
-	public: typedef typename interval_type::domain_type time_type;
-	public: typedef typename item_type::second_type value_type;
-	private: typedef item_type& reference;
-	private: typedef item_type* pointer;
-
-	public: item_wrapper(item_type& item)
-	: ptr_item_(&item)
+	public: server_utilization_profile_item()
+	: t1_(0),
+	  t2_(0),
+	  u_(0)
 	{
 	}
 
-	public: time_type begin_time() const { return ::boost::icl::lower(ptr_item_->first); }
 
-	public: time_type end_time() const { return ::boost::icl::upper(ptr_item_->first); }
-
-	public: value_type utilization() const { return ptr_item_->second; }
-	public: void utilization(value_type v) { ptr_item_->second_ = v; }
-
-	private: pointer ptr_item_;
-};
-
-} // Namespace detail
-
-
-//template <typename RealT>
-//class server_utilization_profile_item
-//{
-	//public: typedef RealT real_type;
-
-
-	//public: server_utilization_profile_item()
-	//: t1_(0),
-	  //t2_(0),
-	  //u_(0)
-	//{
-	//}
-
-
-	//public: server_utilization_profile_item(real_type t1, real_type t2, real_type u)
-	//: t1_(t1),
-	  //t2_(t2),
-	  //u_(u)
-	//{
-	//}
+	public: server_utilization_profile_item(real_type t1, real_type t2, real_type u)
+	: t1_(t1),
+	  t2_(t2),
+	  u_(u)
+	{
+	}
 
 
-	//public: void begin_time(real_type t)
-	//{
-		//t1_ = t;
-	//}
+	public: void begin_time(real_type t)
+	{
+		t1_ = t;
+	}
 
 
-	//public: real_type begin_time() const
-	//{
-		//return t1_;
-	//}
+	public: real_type begin_time() const
+	{
+		return t1_;
+	}
 
 
-	//public: void end_time(real_type t)
-	//{
-		//t2_ = t;	
-	//}
+	public: void end_time(real_type t)
+	{
+		t2_ = t;
+	}
 
 
-	//public: real_type end_time() const
-	//{
-		//return t2_;
-	//}
+	public: real_type end_time() const
+	{
+		return t2_;
+	}
 
 
-	//public: void utilization(real_type u)
-	//{
-		//u_ = u;
-	//}
+	public: void utilization(real_type u)
+	{
+		u_ = u;
+	}
 
 
-	//public: real_type utilization() const
-	//{
-		//return u_;
-	//}
+	public: real_type utilization() const
+	{
+		return u_;
+	}
 
 
-	//private: real_type t1_;
-	//private: real_type t2_;
-	//private: real_type u_;
-//};
+	private: real_type t1_;
+	private: real_type t2_;
+	private: real_type u_;
+};
 
 
+/**
+ * \brief Append-only, run-length encoded utilization profile.
+ *
+ * The profile is a time-ordered sequence of right-open segments
+ * <code>[t1,t2)</code>, each with a constant utilization.
+ * A segment which starts where the last one ends and has the same utilization
+ * extends the last segment instead of being stored.
+ *
+ * When a resolution greater than zero is set, the profile is downsampled: a
+ * contiguous segment is also folded into the last one (which takes the
+ * time-weighted mean of the two utilizations) as long as the last one is
+ * shorter than the resolution.
+ *
+ * Segments are stored in a vector, since most profiles (one per customer and
+ * visited node, see \c customer::node_utilization_profile) hold a handful of
+ * segments; its memory is accounted to \c customer_memory_category, can be
+ * preallocated by \c reserve and is kept by \c clear for reuse.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
 template <typename RealT>
 class server_utilization_profile
 {
 	public: typedef RealT real_type;
-//	public: typedef server_utilization_profile_item<real_type> item_type;
-	private: typedef ::boost::icl::interval<real_type> interval_type;
-	private: typedef ::boost::icl::interval_map<real_type,real_type> interval_container;
-
-
-	public: class const_iterator;
-	public: class iterator;
-	public: typedef ::std::reverse_iterator<const_iterator> const_reverse_iterator;
-	public: typedef ::std::reverse_iterator<iterator> reverse_iterator;
-
+	public: typedef server_utilization_profile_item<real_type> item_type;
+	private: typedef ::std::vector<item_type, typename memory_accounting_allocator<item_type,customer_memory_category>::type> item_container;
+	public: typedef typename item_container::size_type size_type;
+	public: typedef typename item_container::const_iterator const_iterator;
+	public: typedef const_iterator iterator;
 
-	template <typename CharT, typename CharTraitsT, typename TT>
-	friend ::std::basic_ostream<CharT,CharTraitsT>& operator<<(::std::basic_ostream<CharT,CharTraitsT>& os, server_utilization_profile<TT> const& profile);
 
-
-	public: void operator()(real_type t1, real_type t2, real_type u)
+	public: server_utilization_profile()
+	: items_(),
+	  res_(0)
 	{
-		items_ += ::std::make_pair(interval_type::right_open(t1, t2), u);
 	}
 
 
-	public: iterator begin()
+	public: explicit server_utilization_profile(real_type resolution)
+	: items_(),
+	  res_(resolution)
 	{
-		return iterator(items_.begin());
+		// pre: resolution >= 0
+		DCS_ASSERT(
+			res_ >= 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::server_utilization_profile::ctor] Negative resolution.")
+		);
 	}
 
 
-	public: iterator end()
-	{
-		return iterator(items_.end());
-	}
+	// Compiler-generated copy-constructor and copy-assignment are fine.
 
 
-	public: const_iterator begin() const
+	/// Append the segment <code>[t1,t2)</code> with utilization \a u.
+	public: void operator()(real_type t1, real_type t2, real_type u)
 	{
-		return const_iterator(items_.begin());
+		// pre: t1 <= t2
+		DCS_ASSERT(
+			t1 <= t2,
+			throw ::std::invalid_argument("[dcs::des::model::qn::server_utilization_profile::()] Segment ends before it begins.")
+		);
+
+		if (t1 == t2)
+		{
+			return;
+		}
+
+		if (!items_.empty())
+		{
+			item_type& last(items_.back());
+
+			// pre: segments are appended in time order
+			DCS_ASSERT(
+				t1 >= last.end_time(),
+				throw ::std::invalid_argument("[dcs::des::model::qn::server_utilization_profile::()] Segment overlaps the profile.")
+			);
+
+			if (t1 == last.end_time())
+			{
+				if (u == last.utilization())
+				{
+					last.end_time(t2);
+					return;
+				}
+
+				real_type d1(last.end_time()-last.begin_time());
+				if (d1 < res_)
+				{
+					real_type d2(t2-t1);
+
+					last.utilization((last.utilization()*d1+u*d2)/(d1+d2));
+					last.end_time(t2);
+					return;
+				}
+			}
+		}
+
+		items_.push_back(item_type(t1, t2, u));
 	}
 
 
-	public: const_iterator end() const
+	/// Append all the segments of the given profile.
+	public: void operator()(server_utilization_profile const& profile)
 	{
-		return const_iterator(items_.end());
+		// Segments are copied by index, since appending to this profile may
+		// reallocate the segments of the given one (if it is this profile).
+		size_type n(profile.size());
+		for (size_type i = 0; i < n; ++i)
+		{
+			item_type item(profile.items_[i]);
+
+			(*this)(item.begin_time(), item.end_time(), item.utilization());
+		}
 	}
 
 
-	public: reverse_iterator rbegin()
+	public: void resolution(real_type val)
 	{
-		return reverse_iterator(items_.rbegin());
+		// pre: val >= 0
+		DCS_ASSERT(
+			val >= 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::server_utilization_profile::resolution] Negative resolution.")
+		);
+
+		res_ = val;
 	}
 
 
-	public: reverse_iterator rend()
+	public: real_type resolution() const
 	{
-		return reverse_iterator(items_.rend());
+		return res_;
 	}
 
 
-	public: const_reverse_iterator rbegin() const
+	/// Preallocate room for \a n segments.
+	public: void reserve(size_type n)
 	{
-		return const_reverse_iterator(items_.rbegin());
+		items_.reserve(n);
 	}
 
 
-	public: const_reverse_iterator rend() const
+	/// Remove all the segments, keeping their memory for later reuse.
+	public: void clear()
 	{
-		return const_reverse_iterator(items_.rend());
+		items_.clear();
 	}
 
 
-	public: class const_iterator
+	public: bool empty() const
 	{
-        private: typedef typename interval_container::const_iterator interval_iterator;
-        public: typedef typename interval_iterator::iterator_category iterator_category;
-        private: typedef typename interval_container::value_type item_type;
-        public: typedef detail::item_const_wrapper<item_type> value_type;
-        public: typedef typename interval_iterator::difference_type difference_type;
-        public: typedef ::boost::shared_ptr<value_type> pointer;
-        public: typedef value_type reference;
-
-
-        public: const_iterator()
-        {
-        }
-
-
-        public: const_iterator(interval_iterator it)
-        : it_(it)
-        {
-        }
-
-
-        public: reference operator*() const
-        {
-			return detail::item_const_wrapper<item_type>(*it_);
-        }
-
-
-        public: pointer operator->() const
-        {
-            return ::boost::make_shared<item_type>(operator*());
-        }
-
-
-        public: const_iterator& operator++()
-        {
-            ++it_;
-            return *this;
-        }
-
-
-        public: const_iterator& operator++(int)
-        {
-            const_iterator tmp(*this);
-            ++it_;
-            return tmp;
-        }
-
-
-        friend bool operator!=(const_iterator const& x, const_iterator const& y)
-        {
-            return x.it_ != y.it_;
-        }
-
-
-        friend bool operator==(const_iterator const& x, const_iterator const& y)
-        {
-            return x.it_ == y.it_;
-        }
-
-
-        friend bool operator>(const_iterator const& x, const_iterator const& y)
-        {
-            return x.it_ > y.it_;
-        }
-
-
-        friend bool operator<(const_iterator const& x, const_iterator const& y)
-        {
-            return x.it_ < y.it_;
-        }
-
-
-        private: interval_iterator it_;
-	}; // const_iterator
+		return items_.empty();
+	}
 
 
-	public: class iterator
+	public: size_type size() const
 	{
-        private: typedef typename interval_container::const_iterator interval_iterator;
-        public: typedef typename interval_iterator::iterator_category iterator_category;
-        private: typedef typename interval_container::value_type item_type;
-        public: typedef detail::item_wrapper<item_type> value_type;
-        public: typedef typename interval_iterator::difference_type difference_type;
-        public: typedef ::boost::shared_ptr<value_type> pointer;
-        public: typedef value_type reference;
-
-
-        public: iterator()
-        {
-        }
-
-
-        public: iterator(interval_iterator it)
-        : it_(it)
-        {
-        }
-
-
-        public: reference operator*() const
-        {
-			return detail::item_wrapper<item_type>(*it_);
-        }
-
-
-        public: pointer operator->() const
-        {
-            return ::boost::make_shared<item_type>(operator*());
-        }
-
-
-        public: iterator& operator++()
-        {
-            ++it_;
-            return *this;
-        }
-
-
-        public: iterator& operator++(int)
-        {
-            iterator tmp(*this);
-            ++it_;
-            return tmp;
-        }
-
-
-        public: friend bool operator!=(iterator const& x, iterator const& y)
-        {
-            return x.it_ != y.it_;
-        }
-
-
-        public: friend bool operator==(iterator const& x, iterator const& y)
-        {
-            return x.it_ == y.it_;
-        }
-
-
-        public: friend bool operator>(iterator const& x, iterator const& y)
-        {
-            return x.it_ > y.it_;
-        }
+		return items_.size();
+	}
 
 
-        public: friend bool operator<(iterator const& x, iterator const& y)
-        {
-            return x.it_ < y.it_;
-        }
+	public: const_iterator begin() const
+	{
+		return items_.begin();
+	}
 
 
-        private: interval_iterator it_;
-	}; // iterator
+	public: const_iterator end() const
+	{
+		return items_.end();
+	}
 
 
-	private: interval_container items_;
+	private: item_container items_;
+	/// Segments shorter than this are merged with the next contiguous one.
+	private: real_type res_;
 }; // server_utilization_profile
 
 
-template <typename CharT, typename CharTraitsT, typename TraitsT>
+template <typename CharT, typename CharTraitsT, typename RealT>
 ::std::basic_ostream<CharT,CharTraitsT>& operator<<(::std::basic_ostream<CharT,CharTraitsT>& os,
-													server_utilization_profile<TraitsT> const& profile)
+													server_utilization_profile<RealT> const& profile)
 {
-	os << profile.items_;
+	typedef typename server_utilization_profile<RealT>::const_iterator iterator;
+
+	os << "{";
+	iterator end_it(profile.end());
+	for (iterator it = profile.begin(); it != end_it; ++it)
+	{
+		os << "([" << it->begin_time() << "," << it->end_time() << ")->" << it->utilization() << ")";
+	}
+	os << "}";
 
 	return os;
 }
@@ -30,15 +30,20 @@
 
 
 #include <algorithm>
+#include <boost/cstdint.hpp>
 #include <boost/smart_ptr.hpp>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
 #include <dcs/des/model/qn/base_routing_strategy.hpp>
 #include <dcs/des/model/qn/base_service_strategy.hpp>
+#include <dcs/des/model/qn/detail/dary_heap.hpp>
 //#include <dcs/des/model/qn/input_strategy.hpp>
 #include <dcs/des/model/qn/network_node.hpp>
 #include <dcs/des/model/qn/network_node_category.hpp>
+#include <dcs/des/model/qn/virtual_work_clock.hpp>
 #include <dcs/macro.hpp>
+#include <dcs/math/constants.hpp>
+#include <dcs/math/traits/float.hpp>
 #include <map>
 #include <string>
 #include <vector>
@@ -46,6 +51,22 @@
 
 namespace dcs { namespace des { namespace model { namespace qn {
 
+/**
+ * \brief Node representing a service station.
+ *
+ * The station keeps a virtual work clock (see \c virtual_work_clock) for each
+ * work lane of its service strategy, whose rate is the service demand
+ * received per unit of time by each customer in that lane (e.g., the capacity
+ * multiplier for a load-independent strategy, or the capacity multiplier
+ * divided by the number of customers sharing a server for a
+ * processor-sharing strategy).
+ * End-of-service times are keyed in lane work-time (the finish tag of the
+ * customer) and only the earliest one is kept in the future event list.
+ * Thus, a change of capacity or of the share of a lane only re-times that
+ * single event instead of rescheduling every in-service customer.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
 template <typename TraitsT>
 class service_station_node: public network_node<TraitsT>
 {
@@ -70,7 +91,33 @@ class service_station_node: public network_node<TraitsT>
 	public: typedef ::boost::shared_ptr<routing_strategy_type> routing_strategy_pointer;
 	private: typedef typename service_strategy_type::runtime_info_type runtime_info_type;
 	private: typedef ::boost::shared_ptr<event_type> event_pointer;
-	private: typedef ::std::map<uint_type,event_pointer> customer_event_map;
+	private: typedef typename customer_type::identifier_type customer_identifier_type;
+	public: typedef virtual_work_clock<real_type> work_clock_type;
+	/// An end-of-service in the completion heap of a lane.
+	private: struct completion
+	{
+		real_type work;
+		::boost::uint64_t seq;
+		customer_identifier_type cid;
+	};
+	private: struct completion_less
+	{
+		bool operator()(completion const& a, completion const& b) const
+		{
+			return a.work < b.work || (!(b.work < a.work) && a.seq < b.seq);
+		}
+	};
+	/// End-of-service work-times of a lane, ordered by increasing work-time.
+	private: typedef detail::dary_heap<completion,completion_less> completion_heap;
+	/// The end-of-service of an in-service customer.
+	private: struct completion_info
+	{
+		uint_type lane;
+		real_type work;
+		::boost::uint64_t seq;
+		customer_pointer ptr_customer;
+	};
+	private: typedef ::std::map<customer_identifier_type,completion_info> customer_completion_map;
 
 
 	private: static const ::std::string service_event_source_name;
@@ -82,7 +129,9 @@ class service_station_node: public network_node<TraitsT>
 	: base_type(id, name),
 	  ptr_srv_(),
 	  ptr_route_(),
-	  ptr_srv_evt_src_(new event_source_type(service_event_source_name))
+	  ptr_srv_evt_src_(new event_source_type(service_event_source_name)),
+	  cmpl_seq_(0),
+	  svc_evt_pending_(false)
 	{
 		// pre: service strategy pointer must be a valid pointer
 		DCS_ASSERT(
@@ -107,7 +156,9 @@ class service_station_node: public network_node<TraitsT>
 	: base_type(id, name),
 	  ptr_srv_(ptr_service),
 	  ptr_route_(ptr_routing),
-	  ptr_srv_evt_src_(new event_source_type(service_event_source_name))
+	  ptr_srv_evt_src_(new event_source_type(service_event_source_name)),
+	  cmpl_seq_(0),
+	  svc_evt_pending_(false)
 	{
 		// pre: service strategy pointer must be a valid pointer
 		DCS_ASSERT(
@@ -129,7 +180,9 @@ class service_station_node: public network_node<TraitsT>
 	: base_type(that),
 	  ptr_srv_(that.ptr_srv_),
 	  ptr_route_(that.ptr_route_),
-	  ptr_srv_evt_src_(new event_source_type(*(that.ptr_srv_evt_src_)))
+	  ptr_srv_evt_src_(new event_source_type(*(that.ptr_srv_evt_src_))),
+	  cmpl_seq_(0),
+	  svc_evt_pending_(false)
 	{
 		init();
 	}
@@ -154,6 +207,11 @@ class service_station_node: public network_node<TraitsT>
 			ptr_srv_ = rhs.ptr_srv_;
 			ptr_route_ = rhs.ptr_route_;
 			ptr_srv_evt_src_ = ::boost::make_shared<event_source_type>(*(rhs.ptr_srv_evt_src_));
+			completions_.clear();
+			cust_cmpl_map_.clear();
+			cmpl_seq_ = 0;
+			ptr_svc_evt_.reset();
+			svc_evt_pending_ = false;
 
 			init();
 		}
@@ -228,25 +286,9 @@ class service_station_node: public network_node<TraitsT>
 		{
 			// Server capacity is *really* changed
 
+			// Capacity change re-times the pending end-of-service only (see
+			// update_work_rate).
 			ptr_srv_->capacity_multiplier(m);
-
-//XXX: already done inside service-strategy
-//			real_type cur_time(this->network().engine().simulated_time());
-//
-//			// ... -> reschedule active events
-//			typedef typename customer_event_map::iterator customer_event_iterator;
-//			customer_event_iterator evt_end_it(cust_evt_map_.end());
-//			for (customer_event_iterator it = cust_evt_map_.begin(); it != evt_end_it; ++it)
-//			{
-//				event_pointer ptr_evt(it->second);
-//				
-//				DCS_DEBUG_ASSERT( it->first == (*ptr_evt).template unfolded_state<customer_pointer>()->id() );
-//
-//				real_type fire_time;
-//				real_type resid_time(ptr_evt->fire_time()-cur_time);
-//				fire_time = cur_time+resid_time*old_m/m;
-//				this->network().engine().reschedule_event(ptr_evt, fire_time);
-//			}
 		}
 	}
 
@@ -260,39 +302,124 @@ class service_station_node: public network_node<TraitsT>
 	}
 
 
-	public: void reschedule_service(customer_type customer, real_type delay)
+	/**
+	 * \brief Synchronize the rate of every work clock with the service
+	 *  strategy (e.g., after a change of capacity multiplier).
+	 *
+	 * Only the pending end-of-service event (if any) is re-timed.
+	 */
+	public: void update_work_rate()
+	{
+		// pre: service strategy pointer must be a valid pointer
+		DCS_DEBUG_ASSERT( ptr_srv_ );
+
+		real_type cur_time(this->network().engine().simulated_time());
+
+		for (uint_type lane = 0; lane < clocks_.size(); ++lane)
+		{
+			clocks_[lane].rate(ptr_srv_->work_rate(lane), cur_time);
+		}
+
+		schedule_next_completion();
+	}
+
+
+	/**
+	 * \brief Synchronize the rate of the work clock of the given lane with the
+	 *  service strategy (e.g., after a change of the number of customers
+	 *  sharing it).
+	 *
+	 * Only the pending end-of-service event (if any) is re-timed.
+	 */
+	public: void update_work_rate(uint_type lane)
+	{
+		// pre: service strategy pointer must be a valid pointer
+		DCS_DEBUG_ASSERT( ptr_srv_ );
+		// pre: lane must be a valid lane
+		DCS_DEBUG_ASSERT( lane < clocks_.size() );
+
+		clocks_[lane].rate(ptr_srv_->work_rate(lane), this->network().engine().simulated_time());
+
+		schedule_next_completion();
+	}
+
+
+	/// Return the work clock of the given lane.
+	public: work_clock_type const& work_clock(uint_type lane = 0) const
+	{
+		// pre: lane must be a valid lane
+		DCS_DEBUG_ASSERT( lane < clocks_.size() );
+
+		return clocks_[lane];
+	}
+
+
+	public: void reschedule_service(customer_type const& customer, real_type delay)
 	{
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Rescheduling Service for  Customer: " << customer);///XXX
 
-		event_pointer ptr_evt(cust_evt_map_.at(customer.id()));
-			
-		// check: paranoid check
-		DCS_DEBUG_ASSERT( customer.id() == (*ptr_evt).template unfolded_state<customer_pointer>()->id() );
+		typename customer_completion_map::iterator cust_it(cust_cmpl_map_.find(customer.id()));
+
+		// pre: customer must be in service
+		DCS_ASSERT(
+			cust_it != cust_cmpl_map_.end(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::service_station_node::reschedule_service] Customer not in service.")
+		);
+
+		completion_info& info(cust_it->second);
+		real_type cur_time(this->network().engine().simulated_time());
 
-		real_type fire_time(this->network().engine().simulated_time()+delay);
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") Old End-of-Service Work-Time: " << info.work << " --> New End-of-Service Work-Time: " << (clocks_[info.lane].value(cur_time)+delay_to_work(info.lane, delay)));///XXX
 
-		DCS_DEBUG_TRACE_L(3, "(" << this << ") Old Fire-Time: " << ptr_evt->fire_time() << " --> New Fire-Time: " << fire_time);///XXX
+		// The old heap entry becomes stale and is discarded when it surfaces
+		info.work = clocks_[info.lane].value(cur_time)+delay_to_work(info.lane, delay);
+		info.seq = cmpl_seq_++;
+		push_completion(customer.id(), info);
 
-		this->network().engine().reschedule_event(ptr_evt, fire_time);
+		schedule_next_completion();
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Rescheduling Service for  Customer: " << customer);///XXX
 	}
 
 
-	public: ::std::vector<customer_pointer> active_customers() const
+	/**
+	 * \brief Return the service demand the given customer in service still has
+	 *  to receive.
+	 *
+	 * Lane work-time is measured in units of service demand only if the
+	 * service strategy schedules each customer for a runtime equal to its
+	 * service demand divided by the work-rate of its lane, as the
+	 * load-independent and processor-sharing strategies do (whatever the
+	 * share or capacity multiplier).
+	 * For strategies which reschedule their customers by slices (e.g.,
+	 * round-robin) the returned value is the work left in the current slice.
+	 */
+	public: real_type residual_service_demand(customer_type const& customer) const
 	{
-		typedef typename customer_event_map::const_iterator iterator;
+		typename customer_completion_map::const_iterator cust_it(cust_cmpl_map_.find(customer.id()));
+
+		// pre: customer must be in service
+		DCS_ASSERT(
+			cust_it != cust_cmpl_map_.end(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::service_station_node::residual_service_demand] Customer not in service.")
+		);
 
-		//update_state();
-		//const_cast<self_type*>(this)->update_state();
+		real_type residual(cust_it->second.work-clocks_[cust_it->second.lane].value(this->network().engine().simulated_time()));
+
+		return residual > 0 ? residual : 0;
+	}
+
+
+	public: ::std::vector<customer_pointer> active_customers() const
+	{
+		typedef typename customer_completion_map::const_iterator iterator;
 
 		::std::vector<customer_pointer> customers;
 
-		iterator evt_end_it(cust_evt_map_.end());
-		for (iterator it = cust_evt_map_.begin(); it != evt_end_it; ++it)
+		iterator end_it(cust_cmpl_map_.end());
+		for (iterator it = cust_cmpl_map_.begin(); it != end_it; ++it)
 		{
-			event_pointer ptr_evt(it->second);
-			customer_pointer ptr_customer((*ptr_evt).template unfolded_state<customer_pointer>());
+			customer_pointer ptr_customer(it->second.ptr_customer);
 
 			// check: double check
 			DCS_DEBUG_ASSERT( it->first == ptr_customer->id() );
@@ -332,25 +459,59 @@ class service_station_node: public network_node<TraitsT>
 	{
 		// precondition: customer pointer must be a valid pointer.
 		DCS_DEBUG_ASSERT( ptr_customer );
-//		// precondition: network pointer must be a valid pointer.
-//		DCS_DEBUG_ASSERT( this->network_ptr() );
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Scheduling SERVICE for Customer at Node " << *this << " for Customer " << *ptr_customer << " with Delay " << delay << " (Clock: " << this->network().engine().simulated_time() << ")"); //XXX
 
-		::boost::shared_ptr<event_type> ptr_evt;//[sguazt] EXP
-		//this->network().engine().schedule_event(
-		ptr_evt = this->network().engine().schedule_event(//[sguazt] EXP
-				ptr_srv_evt_src_,
-				this->network().engine().simulated_time()+delay,
-				ptr_customer
-		);
-		cust_evt_map_[ptr_customer->id()] = ptr_evt;//[sguazt] EXP
-//		ptr_srv_->info(ptr_customer).start_time(this->network().engine().simulated_time());//EXP
+		real_type cur_time(this->network().engine().simulated_time());
+
+		completion_info info;
+		info.lane = ptr_srv_->work_lane(*ptr_customer);
+		info.work = clocks_[info.lane].value(cur_time)+delay_to_work(info.lane, delay);
+		info.seq = cmpl_seq_++;
+		info.ptr_customer = ptr_customer;
+
+		// pre: lane must be a valid lane
+		DCS_DEBUG_ASSERT( info.lane < clocks_.size() );
+
+		cust_cmpl_map_[ptr_customer->id()] = info;
+		push_completion(ptr_customer->id(), info);
+
+		schedule_next_completion();
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Scheduling SERVICE for Customer at Node " << *this << " for Customer " << *ptr_customer << " with Delay " << delay << " (Clock: " << this->network().engine().simulated_time() << ")"); //XXX
 	}
 
 
+	/**
+	 * \brief Stop the service of the given customer, which is released by the
+	 *  service strategy.
+	 *
+	 * \return The service demand the customer still has to receive.
+	 *
+	 * Only the pending end-of-service event is possibly re-timed (if the given
+	 * customer was the next one to complete): the other customers in service
+	 * are not affected.
+	 */
+	protected: real_type preempt_service(customer_pointer const& ptr_customer)
+	{
+		// pre: customer pointer must be a valid pointer.
+		DCS_DEBUG_ASSERT( ptr_customer );
+
+		real_type residual(residual_service_demand(*ptr_customer));
+
+		// The heap entry becomes stale and is discarded when it surfaces
+		cust_cmpl_map_.erase(ptr_customer->id());
+
+		ptr_srv_->remove(ptr_customer);
+
+		// Note: if nothing is left to complete, the pending end-of-service
+		// event (if any) will find the completion list empty.
+		schedule_next_completion();
+
+		return residual;
+	}
+
+
 	protected: virtual void do_enable(bool flag)
 	{
 		base_type::do_enable(flag);
@@ -385,7 +546,17 @@ class service_station_node: public network_node<TraitsT>
 		base_type::do_initialize_experiment();
 
 		ptr_srv_->reset();
-		cust_evt_map_.clear();//[sguazt] EXP
+		cust_cmpl_map_.clear();
+		cmpl_seq_ = 0;
+		ptr_svc_evt_.reset();
+		svc_evt_pending_ = false;
+		make_work_lanes();
+
+		real_type cur_time(this->network().engine().simulated_time());
+		for (uint_type lane = 0; lane < clocks_.size(); ++lane)
+		{
+			clocks_[lane].reset(cur_time);
+		}
 	}
 
 
@@ -393,12 +564,11 @@ class service_station_node: public network_node<TraitsT>
 	{
 		base_type::do_finalize_experiment();
 
-		typedef typename customer_event_map::iterator customer_event_iterator;
-		customer_event_iterator evt_end_it(cust_evt_map_.end());
-		for (customer_event_iterator it = cust_evt_map_.begin(); it != evt_end_it; ++it)
+		typedef typename customer_completion_map::iterator customer_completion_iterator;
+		customer_completion_iterator end_it(cust_cmpl_map_.end());
+		for (customer_completion_iterator it = cust_cmpl_map_.begin(); it != end_it; ++it)
 		{
-			event_pointer ptr_evt(it->second);
-			customer_pointer ptr_customer((*ptr_evt).template unfolded_state<customer_pointer>());
+			customer_pointer ptr_customer(it->second.ptr_customer);
 
 			// check: paranoid check
 			DCS_DEBUG_ASSERT( it->first == ptr_customer->id() );
@@ -407,7 +577,13 @@ class service_station_node: public network_node<TraitsT>
 		}
 
 		ptr_srv_->remove_all();
-		cust_evt_map_.clear();
+		for (uint_type lane = 0; lane < completions_.size(); ++lane)
+		{
+			completions_[lane].clear();
+		}
+		cust_cmpl_map_.clear();
+		ptr_svc_evt_.reset();
+		svc_evt_pending_ = false;
 	}
 
 
@@ -444,6 +620,8 @@ class service_station_node: public network_node<TraitsT>
 
 		ptr_srv_->node(this);
 
+		make_work_lanes();
+
 //		if (this->enabled())
 //		{
 			connect_to_event_sources();
@@ -507,15 +685,168 @@ class service_station_node: public network_node<TraitsT>
 	}
 
 
+	/// Build one work clock (and completion heap) per work lane of the
+	/// service strategy.
+	private: void make_work_lanes()
+	{
+		uint_type nl(ptr_srv_->num_work_lanes());
+
+		clocks_.clear();
+		for (uint_type lane = 0; lane < nl; ++lane)
+		{
+			clocks_.push_back(work_clock_type(ptr_srv_->work_rate(lane)));
+		}
+		completions_.assign(nl, completion_heap());
+	}
+
+
+	/// Convert a service delay at the current rate of the given lane into lane
+	/// work-time.
+	private: real_type delay_to_work(uint_type lane, real_type delay) const
+	{
+		if (delay <= 0)
+		{
+			return 0;
+		}
+		if (clocks_[lane].rate() <= 0 || delay == ::dcs::math::constants::infinity<real_type>::value)
+		{
+			return ::dcs::math::constants::infinity<real_type>::value;
+		}
+
+		return delay*clocks_[lane].rate();
+	}
+
+
+	/// Add the given end-of-service to the completion heap of its lane.
+	private: void push_completion(customer_identifier_type cid, completion_info const& info)
+	{
+		completion c;
+		c.work = info.work;
+		c.seq = info.seq;
+		c.cid = cid;
+
+		completions_[info.lane].push(c);
+
+		// Rebuild the heap when stale entries (left by removed or rescheduled
+		// customers) outnumber the live ones.
+		if (completions_[info.lane].size() > 2*cust_cmpl_map_.size()+16)
+		{
+			completions_[info.lane].clear();
+
+			typename customer_completion_map::const_iterator end_it(cust_cmpl_map_.end());
+			for (typename customer_completion_map::const_iterator it = cust_cmpl_map_.begin(); it != end_it; ++it)
+			{
+				if (it->second.lane == info.lane)
+				{
+					c.work = it->second.work;
+					c.seq = it->second.seq;
+					c.cid = it->first;
+					completions_[info.lane].push(c);
+				}
+			}
+		}
+	}
+
+
+	/// Find the earliest end-of-service over all lanes, discarding stale heap
+	/// entries on the way.
+	private: bool next_completion(uint_type& next_lane, real_type& fire_time)
+	{
+		real_type cur_time(this->network().engine().simulated_time());
+		bool found(false);
+
+		for (uint_type lane = 0; lane < completions_.size(); ++lane)
+		{
+			completion_heap& heap(completions_[lane]);
+
+			while (!heap.empty())
+			{
+				typename customer_completion_map::const_iterator it(cust_cmpl_map_.find(heap.top().cid));
+				if (it != cust_cmpl_map_.end() && it->second.seq == heap.top().seq)
+				{
+					break;
+				}
+				heap.pop();
+			}
+			if (heap.empty())
+			{
+				continue;
+			}
+
+			real_type t(cur_time+clocks_[lane].delay(heap.top().work, cur_time));
+			if (!found || t < fire_time)
+			{
+				next_lane = lane;
+				fire_time = t;
+				found = true;
+			}
+		}
+
+		return found;
+	}
+
+
+	/// Make the (single) end-of-service event fire at the earliest completion.
+	private: void schedule_next_completion()
+	{
+		uint_type lane(0);
+		real_type fire_time(0);
+
+		if (!next_completion(lane, fire_time))
+		{
+			return;
+		}
+
+		customer_pointer ptr_customer(cust_cmpl_map_.find(completions_[lane].top().cid)->second.ptr_customer);
+
+		if (svc_evt_pending_)
+		{
+			ptr_svc_evt_->state() = ptr_customer;
+
+			if (fire_time != ptr_svc_evt_->fire_time()
+				&& !::dcs::math::float_traits<real_type>::essentially_equal(fire_time, ptr_svc_evt_->fire_time()))
+			{
+				this->network().engine().reschedule_event(ptr_svc_evt_, fire_time);
+			}
+		}
+		else
+		{
+			ptr_svc_evt_ = this->network().engine().schedule_event(
+					ptr_srv_evt_src_,
+					fire_time,
+					ptr_customer
+				);
+			svc_evt_pending_ = ptr_svc_evt_ ? true : false;
+		}
+	}
+
+
 	private: void process_service(event_type const& evt, engine_context_type& ctx)
 	{
-		customer_pointer ptr_customer = evt.template unfolded_state<customer_pointer>();
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING(evt);
+
+		svc_evt_pending_ = false;
+
+		// The event always refers to the earliest completion, unless the
+		// customer has been removed meanwhile and nothing is left to complete
+		customer_pointer ptr_customer(evt.template unfolded_state<customer_pointer>());
+		typename customer_completion_map::iterator cust_it(cust_cmpl_map_.find(ptr_customer->id()));
+		if (cust_it == cust_cmpl_map_.end())
+		{
+			schedule_next_completion();
+			return;
+		}
+		uint_type lane(cust_it->second.lane);
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Processing SERVICE at Node " << *this << " for Customer " << *ptr_customer << " (Clock: " << ctx.simulated_time() << ")."); //XXX
 
 		// check: customer pointer must be a valid pointer.
 		DCS_DEBUG_ASSERT( ptr_customer );
 
+		// The heap entry becomes stale and is discarded when it surfaces
+		cust_cmpl_map_.erase(cust_it);
+		clocks_[lane].advance(ctx.simulated_time());
+
 //		real_type runtime(ptr_srv_->info(ptr_customer).runtime());
 //		runtime_info_type& rt_info(ptr_srv_->info(ptr_customer));
 //		real_type capacity(ptr_srv_->capacity_multiplier()/static_cast<real_type>(ptr_srv_->num_servers()));
@@ -528,12 +859,14 @@ class service_station_node: public network_node<TraitsT>
 
 		// ... And remove it from service
 		ptr_srv_->remove(ptr_customer);
-		cust_evt_map_.erase(ptr_customer->id());//[sguazt] EXP
 
 		this->last_event_time(ctx.simulated_time());
 
 		do_process_service(ptr_customer, ctx);
 
+		// Arm the end-of-service event for the next completion (if any)
+		schedule_next_completion();
+
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Processing SERVICE at Node " << *this << " for Customer " << *ptr_customer << " (Clock: " << ctx.simulated_time() << ")."); //XXX
 	}
 
@@ -544,7 +877,19 @@ class service_station_node: public network_node<TraitsT>
 	private: service_strategy_pointer ptr_srv_;
 	private: routing_strategy_pointer ptr_route_;
 	private: event_source_pointer ptr_srv_evt_src_;
-	private: customer_event_map cust_evt_map_;
+	/// The work clock of each lane.
+	private: ::std::vector<work_clock_type> clocks_;
+	/// The end-of-service work-times of each lane.
+	private: ::std::vector<completion_heap> completions_;
+	/// Map each in-service customer to its end-of-service.
+	private: customer_completion_map cust_cmpl_map_;
+	/// Sequence number of the next end-of-service (to break ties in FIFO
+	/// order and to tell stale heap entries).
+	private: ::boost::uint64_t cmpl_seq_;
+	/// The end-of-service event for the earliest completion.
+	private: event_pointer ptr_svc_evt_;
+	/// Tell if \c ptr_svc_evt_ is still in the future event list.
+	private: bool svc_evt_pending_;
 	private: real_type last_state_update_time_;
 };
 
@@ -84,7 +84,8 @@ class sink_node: public network_node<TraitsT>
 		ptr_customer->change_node(this->id());
 		ptr_customer->departure_time(ctx.simulated_time());
 
-		this->schedule_departure(ptr_customer, real_type/*zero*/());
+		// The customer leaves the network at once
+		this->depart_now(ptr_customer, ctx);
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Do Processing ARRIVAL at Node: " << *this << " of Customer: " << *ptr_customer << " (Clock: " << ctx.simulated_time() << ")."); //XXX
 	}
@@ -29,14 +29,18 @@
 #define DCS_DES_MODEL_QN_SOURCE_STATION_HPP
 
 
+#include <boost/random/uniform_01.hpp>
 #include <boost/smart_ptr.hpp>
+#include <cmath>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
 #include <dcs/des/engine_traits.hpp>
 #include <dcs/des/model/qn/base_routing_strategy.hpp>
 #include <dcs/des/model/qn/customer_class_category.hpp>
+#include <dcs/des/model/qn/detail/alias_table.hpp>
 #include <dcs/des/model/qn/network_node.hpp>
 #include <dcs/des/model/qn/network_node_category.hpp>
+#include <dcs/des/model/qn/open_customer_class.hpp>
 #include <dcs/functional/bind.hpp>
 #include <limits>
 #include <set>
@@ -47,6 +51,29 @@
 
 namespace dcs { namespace des { namespace model { namespace qn {
 
+/**
+ * \brief The node generating the customers of open classes.
+ *
+ * Every external arrival costs a single event: when a generated customer is
+ * due to enter the network, the same event sends it to its (already routed)
+ * target node and makes the next customer of the class go through this node,
+ * without further events for the arrival to and the departure from this node
+ * or for the arrival to the network.
+ *
+ * Each open class has its own chain of arrivals, that is one pending event in
+ * the future event list.
+ * When the superposition of Poisson classes is enabled (see
+ * \c superpose_poisson_classes), the open classes of this node whose
+ * interarrival times are exponential share a single chain: the next arrival
+ * is drawn at the total rate of these classes, and its class is sampled (by
+ * means of an alias table) with probability proportional to the class rate.
+ * The future event list then holds one arrival event for all of them.
+ * Note that, with superposition, the initial customers sent by the network
+ * for these classes (but the first one, which starts the merged chain) are
+ * absorbed by this node.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
 template <typename TraitsT>
 class source_node: public network_node<TraitsT>
 {
@@ -64,6 +91,23 @@ class source_node: public network_node<TraitsT>
 	private: typedef typename traits_type::engine_type engine_type;
 	private: typedef typename engine_traits<engine_type>::event_type event_type;
 	private: typedef typename engine_traits<engine_type>::engine_context_type engine_context_type;
+	private: typedef typename base_type::event_source_type event_source_type;
+	private: typedef typename base_type::event_source_pointer event_source_pointer;
+	private: typedef open_customer_class<TraitsT> open_class_type;
+	private: typedef ::std::vector<class_identifier_type> class_identifier_container;
+	private: typedef ::std::vector<open_class_type const*> open_class_pointer_container;
+
+
+	/// The state of a GENERATION event.
+	private: struct generation_state
+	{
+		/// The customer entering the network.
+		customer_pointer ptr_customer;
+		/// The node the entering customer is sent to.
+		identifier_type node_id;
+		/// The next customer going through this node.
+		customer_pointer ptr_next_customer;
+	};
 
 
 	/// A constructor.
@@ -72,7 +116,12 @@ class source_node: public network_node<TraitsT>
 						//network_pointer const&  ptr_net,
 						routing_strategy_pointer const& ptr_output)
 	: base_type(id, name/*, ptr_net*/),
-	  ptr_route_(ptr_output)
+	  ptr_route_(ptr_output),
+	  ptr_gen_evt_src_(new event_source_type("Customer Generation")),
+	  superpose_(false),
+	  merged_rate_(0),
+	  merged_started_(false),
+	  generating_(false)
 	{
 		/// precondition: pointer to output strategy must be a valid pointer.
 		DCS_ASSERT(
@@ -90,8 +139,49 @@ class source_node: public network_node<TraitsT>
 //	}
 
 
-	// Compiler-generated copy-constructor, copy-assignment, and destructor
-	// are fine.
+	/// The copy constructor.
+	public: source_node(source_node const& that)
+	: base_type(that),
+	  classes_(that.classes_),
+	  ptr_route_(that.ptr_route_),
+	  ptr_gen_evt_src_(new event_source_type(*(that.ptr_gen_evt_src_))),
+	  superpose_(that.superpose_),
+	  merged_classes_(that.merged_classes_),
+	  merged_class_ptrs_(that.merged_class_ptrs_),
+	  merged_flags_(that.merged_flags_),
+	  merged_alias_(that.merged_alias_),
+	  merged_rate_(that.merged_rate_),
+	  merged_started_(that.merged_started_),
+	  generating_(false)
+	{
+	}
+
+
+	/// The copy assignment.
+	public: source_node& operator=(source_node const& rhs)
+	{
+		if (this != &rhs)
+		{
+			base_type::operator=(rhs);
+
+			classes_ = rhs.classes_;
+			ptr_route_ = rhs.ptr_route_;
+			ptr_gen_evt_src_ = event_source_pointer(new event_source_type(*(rhs.ptr_gen_evt_src_)));
+			superpose_ = rhs.superpose_;
+			merged_classes_ = rhs.merged_classes_;
+			merged_class_ptrs_ = rhs.merged_class_ptrs_;
+			merged_flags_ = rhs.merged_flags_;
+			merged_alias_ = rhs.merged_alias_;
+			merged_rate_ = rhs.merged_rate_;
+			merged_started_ = rhs.merged_started_;
+			generating_ = false;
+		}
+
+		return *this;
+	}
+
+
+	// Compiler-generated destructor is fine.
 
 
 	/// Add a classs for which this node is the customer generator.
@@ -106,6 +196,31 @@ class source_node: public network_node<TraitsT>
 	}
 
 
+	/**
+	 * \brief Enable or disable the superposition of the Poisson open classes
+	 *  of this node into a single arrival chain.
+	 *
+	 * The setting takes effect at the beginning of the next experiment.
+	 *
+	 * A class is recognized as Poisson from the static type of the
+	 * distribution its \c open_customer_class was built with (see
+	 * \c detail::poisson_rate_traits): an exponential distribution already
+	 * wrapped in an \c any_distribution is not recognized, and the class
+	 * keeps its own arrival chain.
+	 */
+	public: void superpose_poisson_classes(bool flag)
+	{
+		superpose_ = flag;
+	}
+
+
+	/// Tell if the superposition of Poisson open classes is enabled.
+	public: bool superpose_poisson_classes() const
+	{
+		return superpose_;
+	}
+
+
 	/// Return the category for this node.
 	private: network_node_category do_category() const
 	{
@@ -130,8 +245,27 @@ class source_node: public network_node<TraitsT>
 			open_customer_class_category
 		);
 
-		// Notify the departure of the customer from this node
-		this->schedule_departure(ptr_customer, real_type/*zero*/());
+		if (!generating_ && merged(ptr_customer->current_class()))
+		{
+			// Initial customer of a superposed class: the first one starts
+			// the merged chain, the others are absorbed.
+			// The first customer of the chain arrives to this node like any
+			// newly generated one, so that its node arrival time is recorded
+			// before it departs.
+			if (!merged_started_)
+			{
+				merged_started_ = true;
+
+				generating_ = true;
+				this->receive_now(make_merged_customer(), ctx);
+				generating_ = false;
+			}
+
+			return;
+		}
+
+		// The customer leaves this node at once
+		this->depart_now(ptr_customer, ctx);
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Do Processing ARRIVAL at Node: " << *this << " of Customer: " << *ptr_customer << " (Clock: " << ctx.simulated_time() << ")."); //XXX
 	}
@@ -145,6 +279,8 @@ class source_node: public network_node<TraitsT>
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Do Processing DEPARTURE at Node: " << *this << " of Customer: " << *ptr_customer << " (Clock: " << ctx.simulated_time() << ")."); //XXX
 
+		bool merged_arrival(merged(ptr_customer->current_class()));
+
 		// Change the current node of the given customer
 		ptr_customer->change_node(this->id());
 
@@ -166,16 +302,26 @@ class source_node: public network_node<TraitsT>
 		// Change the current class of the given customer
 		ptr_customer->change_class(class_id);
 
-		// Notify the arrival of the customer into the network
-		this->network().schedule_arrival(ptr_customer, iatime);
-
-		DCS_DEBUG_TRACE_L(3, "Sending Customer " << *ptr_customer << " to Node: " << this->network().get_node(node_id));//XXX
+		// Generate a new customer (with the same class of the given customer)
+		// and schedule the entrance of the given customer into the network,
+		// which is also the arrival of the new customer to this node
+		generation_state state;
+		state.ptr_customer = ptr_customer;
+		state.node_id = node_id;
+		state.ptr_next_customer = merged_arrival
+								  ? make_merged_customer()
+								  : this->make_customer(ptr_customer->current_class());
 
-		// Send this customer to the target node
-		this->network().get_node(node_id).receive(ptr_customer, iatime);
-
-		// Generate a new customer arrival (with the same class of the given customer)
-		this->generate(ptr_customer->current_class(), iatime);
+		// check: customer pointer must be a valid pointer
+		DCS_DEBUG_ASSERT( state.ptr_next_customer );
+
+		this->network().engine().schedule_event(
+				ptr_gen_evt_src_,
+				ctx.simulated_time()+iatime,
+				state,
+				&self_type::process_generation_event,
+				this
+		);
 
 		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Do Processing DEPARTURE at Node: " << *this << " of Customer: " << *ptr_customer << " (Clock: " << ctx.simulated_time() << ")."); //XXX
 	}
@@ -187,15 +333,81 @@ class source_node: public network_node<TraitsT>
 	}
 
 
-	/// Generate a new customer for the given class.
-	private: void generate(class_identifier_type class_id, real_type delay)
+	private: void do_enable(bool flag)
 	{
-		customer_pointer ptr_customer = this->make_customer(class_id);
+		base_type::do_enable(flag);
 
-		// check: customer pointer must be a valid pointer
-		DCS_DEBUG_ASSERT( ptr_customer );
+		ptr_gen_evt_src_->enable(flag);
+	}
+
+
+	/// Set-up the superposition of Poisson classes for the new experiment.
+	private: void do_initialize_experiment()
+	{
+		base_type::do_initialize_experiment();
+
+		merged_classes_.clear();
+		merged_class_ptrs_.clear();
+		merged_flags_.clear();
+		merged_rate_ = real_type/*zero*/();
+		merged_started_ = generating_
+						= false;
+
+		if (!superpose_)
+		{
+			return;
+		}
+
+		::std::vector<real_type> rates;
+		class_identifier_type nc(this->network().num_classes());
+		for (class_identifier_type cid = 0; cid < nc; ++cid)
+		{
+			class_type const& ref_class = this->network().get_class(cid);
+
+			if (ref_class.category() != open_customer_class_category
+				|| ref_class.reference_node() != this->id())
+			{
+				continue;
+			}
+
+			open_class_type const* ptr_class = dynamic_cast<open_class_type const*>(&ref_class);
+
+			if (ptr_class && ptr_class->poisson_rate() > 0)
+			{
+				merged_classes_.push_back(cid);
+				merged_class_ptrs_.push_back(ptr_class);
+				rates.push_back(ptr_class->poisson_rate());
+				merged_rate_ += ptr_class->poisson_rate();
+				merged_flags_.resize(cid+1, false);
+				merged_flags_[cid] = true;
+			}
+		}
 
-		this->receive(ptr_customer, delay);
+		if (!merged_classes_.empty())
+		{
+			merged_alias_.assign(rates.begin(), rates.end());
+		}
+	}
+
+
+	/// Handler for the GENERATION event.
+	private: static void process_generation_event(void* ptr_target, event_type const& evt, engine_context_type& ctx)
+	{
+		self_type* ptr_node(static_cast<self_type*>(ptr_target));
+		generation_state const& state(evt.template unfolded_state<generation_state>());
+
+		// Notify the arrival of the customer into the network
+		ptr_node->network().schedule_arrival(state.ptr_customer, real_type/*zero*/());
+
+		DCS_DEBUG_TRACE_L(3, "Sending Customer " << *(state.ptr_customer) << " to Node: " << ptr_node->network().get_node(state.node_id));//XXX
+
+		// Send the customer to the target node
+		ptr_node->network().get_node(state.node_id).receive_now(state.ptr_customer, ctx);
+
+		// The next customer arrives to this node
+		ptr_node->generating_ = true;
+		ptr_node->receive_now(state.ptr_next_customer, ctx);
+		ptr_node->generating_ = false;
 	}
 
 
@@ -209,10 +421,54 @@ class source_node: public network_node<TraitsT>
 	}
 
 
+	/// Tell if the given class is superposed with the other Poisson classes.
+	private: bool merged(class_identifier_type class_id) const
+	{
+		return class_id < merged_flags_.size() && merged_flags_[class_id];
+	}
+
+
+	/**
+	 * \brief Create the next customer of the superposed Poisson classes.
+	 *
+	 * The interarrival time is drawn at the total rate of the superposed
+	 * classes, and the class is drawn from the alias table.
+	 */
+	private: customer_pointer make_merged_customer()
+	{
+		typename traits_type::random_generator_type& ref_rng = this->network().random_generator();
+
+		::boost::uniform_01<real_type> u01;
+		real_type iatime(-::std::log(real_type(1)-u01(ref_rng))/merged_rate_);
+
+		return merged_class_ptrs_[merged_alias_(ref_rng)]->make_customer_with_interarrival(iatime);
+	}
+
+
 	/// Container for classes for which this node is the source.
 	private: class_container classes_;
 	/// Pointer to the routing strategy.
 	private: routing_strategy_pointer ptr_route_;
+	/// GENERATION event source: a generated customer enters the network.
+	private: event_source_pointer ptr_gen_evt_src_;
+	/// Tells if Poisson classes are superposed into a single arrival chain.
+	private: bool superpose_;
+	/// The superposed classes.
+	private: class_identifier_container merged_classes_;
+	/// The superposed classes, in the same order as \c merged_classes_ (cast
+	/// once per experiment rather than at every arrival).
+	private: open_class_pointer_container merged_class_ptrs_;
+	/// Tells, for each class identifier, if the class is superposed.
+	private: ::std::vector<bool> merged_flags_;
+	/// Alias table for drawing the class of a superposed arrival.
+	private: detail::alias_table<real_type> merged_alias_;
+	/// The total rate of the superposed classes.
+	private: real_type merged_rate_;
+	/// Tells if the merged chain has been started in this experiment.
+	private: bool merged_started_;
+	/// Tells if the arrival being processed is the one of a newly generated
+	/// customer (rather than an initial customer sent by the network).
+	private: bool generating_;
 };
 
 }}}} // Namespace dcs::des::model::qn
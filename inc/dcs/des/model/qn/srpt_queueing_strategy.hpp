@@ -0,0 +1,76 @@
+/**
+ * \file dcs/des/model/qn/srpt_queueing_strategy.hpp
+ *
+ * \brief Shortest-Remaining-Processing-Time (SRPT) queueing strategy.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_SRPT_QUEUEING_STRATEGY_HPP
+#define DCS_DES_MODEL_QN_SRPT_QUEUEING_STRATEGY_HPP
+
+
+#include <dcs/des/model/qn/heap_queueing_strategy.hpp>
+
+
+namespace dcs { namespace des { namespace model { namespace qn {
+
+/**
+ * \brief Shortest-Remaining-Processing-Time (SRPT) queueing strategy.
+ *
+ * Customers are served in order of the service demand they still have to
+ * receive (drawn from the service strategy when the customer arrives at the
+ * station).
+ * An arriving customer whose demand is lower than the residual demand of a
+ * customer in service preempts it, and the preempted customer resumes its
+ * service later with its residual demand.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename TraitsT>
+class srpt_queueing_strategy: public heap_queueing_strategy<TraitsT,customer_demand_key<TraitsT> >
+{
+	public: typedef heap_queueing_strategy<TraitsT,customer_demand_key<TraitsT> > base_type;
+	public: typedef TraitsT traits_type;
+	public: typedef typename base_type::size_type size_type;
+
+
+	public: srpt_queueing_strategy()
+	: base_type(true)
+	{
+	}
+
+
+	public: explicit srpt_queueing_strategy(size_type capacity)
+	: base_type(capacity, true)
+	{
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+};
+
+}}}} // Namespace dcs::des::model::qn
+
+
+#endif // DCS_DES_MODEL_QN_SRPT_QUEUEING_STRATEGY_HPP
@@ -0,0 +1,627 @@
+/**
+ * \file dcs/des/model/qn/tandem_line_evaluator.hpp
+ *
+ * \brief Max-plus (Lindley) evaluator for open lines of single-server FCFS
+ *  stations.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_TANDEM_LINE_EVALUATOR_HPP
+#define DCS_DES_MODEL_QN_TANDEM_LINE_EVALUATOR_HPP
+
+
+#include <algorithm>
+#include <boost/smart_ptr.hpp>
+#include <cstddef>
+#include <deque>
+#include <dcs/assert.hpp>
+#include <dcs/debug.hpp>
+#include <dcs/des/base_statistic.hpp>
+#include <dcs/des/model/qn/customer_class_category.hpp>
+#include <dcs/des/model/qn/detail/accumulate_stat.hpp>
+#include <dcs/des/model/qn/fcfs_queueing_strategy.hpp>
+#include <dcs/des/model/qn/load_independent_service_strategy.hpp>
+#include <dcs/des/model/qn/network_node_category.hpp>
+#include <dcs/des/model/qn/open_customer_class.hpp>
+#include <dcs/des/model/qn/output_statistic_category.hpp>
+#include <dcs/des/model/qn/queueing_station_node.hpp>
+#include <dcs/math/stats/distribution/any_distribution.hpp>
+#include <dcs/math/stats/function/rand.hpp>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace model { namespace qn {
+
+namespace detail { namespace /*<unnamed>*/ {
+
+/**
+ * \brief Compute the departure times of a block of customers from a
+ *  single-server FCFS station.
+ *
+ * The Lindley recursion
+ * \f[
+ *   d_i = \max(a_i, d_{i-1}) + s_i
+ * \f]
+ * is rewritten in max-plus form as
+ * \f[
+ *   d_i = P_i + \max(d_{-1}, \max_{j \le i}(a_j - P_{j-1}))
+ * \f]
+ * where \f$P_i\f$ is the block-relative prefix sum of service times.
+ * This way the per-customer work is done by element-wise loops over
+ * contiguous arrays (which the compiler is able to vectorize) and by two
+ * plain scans (a sum and a max).
+ * Prefix sums restart at every block, so their magnitude (and hence the
+ * round-off error) stays bounded by the work of a single block.
+ *
+ * \param arr Arrival times to the station.
+ * \param svc Service times.
+ * \param dep Output departure times.
+ * \param psum Scratch area for the prefix sums.
+ * \param n The number of customers in the block.
+ * \param carry The departure time of the last customer of the previous block.
+ */
+template <typename RealT>
+void lindley_block(RealT const* arr, RealT const* svc, RealT* dep, RealT* psum, ::std::size_t n, RealT carry)
+{
+	// Scan: block-relative prefix sums of service times
+	RealT acc(0);
+	for (::std::size_t i = 0; i < n; ++i)
+	{
+		acc += svc[i];
+		psum[i] = acc;
+	}
+
+	// Element-wise: a_i - P_{i-1}
+	for (::std::size_t i = 0; i < n; ++i)
+	{
+		dep[i] = arr[i] - (psum[i] - svc[i]);
+	}
+
+	// Scan: running max (seeded by the previous block)
+	RealT m(carry);
+	for (::std::size_t i = 0; i < n; ++i)
+	{
+		m = ::std::max(m, dep[i]);
+		dep[i] = m;
+	}
+
+	// Element-wise: P_i + max
+	for (::std::size_t i = 0; i < n; ++i)
+	{
+		dep[i] += psum[i];
+	}
+}
+
+}} // Namespace detail::<unnamed>
+
+
+/**
+ * \brief Max-plus (Lindley) evaluator for open lines of single-server FCFS
+ *  stations.
+ *
+ * For an open customer class flowing through a line of single-server,
+ * infinite-capacity, FCFS stations with deterministic routing, departure
+ * times obey the Lindley recursion and no event needs to be scheduled at all.
+ * This evaluator generates interarrival and service times block by block,
+ * pushes each block through the line with a max-plus kernel, and feeds the
+ * resulting observations to the same node-level and network-level statistics
+ * used by the event-driven model (see \c network_node and
+ * \c queueing_network).
+ *
+ * Stations are evaluated in the order they are added.
+ * A station can either be given explicitly by its service distribution, or
+ * be taken from an existing network node, in which case the node is checked
+ * to be a suitable station (see \c is_lindley_station) and its registered
+ * statistics are reused.
+ *
+ * Each call to \c evaluate corresponds to a single run of the given length;
+ * observations are collected with the same rules of the event-driven model,
+ * that is per-customer observations are taken at arrival or departure time
+ * and per-run observations (e.g., utilization and throughput) at the end of
+ * the run.
+ *
+ * \tparam TraitsT The queueing network traits type.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename TraitsT>
+class tandem_line_evaluator
+{
+	public: typedef TraitsT traits_type;
+	public: typedef typename traits_type::real_type real_type;
+	public: typedef typename traits_type::uint_type uint_type;
+	public: typedef typename traits_type::network_type network_type;
+	public: typedef typename traits_type::node_type node_type;
+	public: typedef typename traits_type::node_identifier_type node_identifier_type;
+	public: typedef typename traits_type::class_identifier_type class_identifier_type;
+	public: typedef typename traits_type::random_generator_type random_generator_type;
+	public: typedef ::dcs::math::stats::any_distribution<real_type> distribution_type;
+	public: typedef base_statistic<real_type,uint_type> output_statistic_type;
+	public: typedef ::boost::shared_ptr<output_statistic_type> output_statistic_pointer;
+	public: typedef ::std::size_t size_type;
+	private: typedef ::std::vector<output_statistic_pointer> output_statistic_container;
+	private: typedef ::std::map<node_output_statistic_category,output_statistic_container> node_statistic_category_container;
+	private: typedef ::std::map<network_output_statistic_category,output_statistic_container> network_statistic_category_container;
+	private: typedef queueing_station_node<traits_type> queueing_station_node_type;
+	private: typedef fcfs_queueing_strategy<traits_type> fcfs_queueing_strategy_type;
+	private: typedef load_independent_service_strategy<traits_type> load_independent_service_strategy_type;
+	private: typedef open_customer_class<traits_type> open_customer_class_type;
+	private: typedef ::std::vector<real_type> real_container;
+
+
+	public: static const size_type default_block_size = 1024;
+
+
+	/// Build an evaluator for the given interarrival time distribution.
+	public: explicit tandem_line_evaluator(distribution_type const& arr_distr, size_type block_size = default_block_size)
+	: arr_distr_(arr_distr),
+	  block_size_(block_size)
+	{
+		// pre: block size must be positive.
+		DCS_ASSERT(
+			block_size_ > 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::tandem_line_evaluator::ctor] Invalid block size.")
+		);
+	}
+
+
+	/**
+	 * \brief Build an evaluator for the given open customer class of a
+	 *  queueing network.
+	 *
+	 * The interarrival time distribution is taken from the customer class and
+	 * the network-level statistics registered in the network are reused.
+	 */
+	public: tandem_line_evaluator(network_type const& net, class_identifier_type class_id, size_type block_size = default_block_size)
+	: block_size_(block_size)
+	{
+		// pre: block size must be positive.
+		DCS_ASSERT(
+			block_size_ > 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::tandem_line_evaluator::ctor] Invalid block size.")
+		);
+		// pre: customer class must be an open class.
+		DCS_ASSERT(
+			net.get_class(class_id).category() == open_customer_class_category,
+			throw ::std::invalid_argument("[dcs::des::model::qn::tandem_line_evaluator::ctor] Customer class is not an open class.")
+		);
+
+		arr_distr_ = dynamic_cast<open_customer_class_type const&>(net.get_class(class_id)).interarrival_distribution();
+
+		import_statistic(net, net_response_time_statistic_category);
+		import_statistic(net, net_throughput_statistic_category);
+		import_statistic(net, net_num_arrivals_statistic_category);
+		import_statistic(net, net_num_departures_statistic_category);
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+
+
+	/**
+	 * \brief Tell if the given node can be evaluated by this evaluator for the
+	 *  given customer class.
+	 *
+	 * The node must be a single-server, infinite-capacity FCFS queueing
+	 * station with a load-independent service strategy.
+	 * Routing is not inspected: the order of the line is the order in which
+	 * stations are added.
+	 */
+	public: static bool is_lindley_station(node_type const& node, class_identifier_type class_id)
+	{
+		if (node.category() != service_station_node_category)
+		{
+			return false;
+		}
+
+		queueing_station_node_type const* ptr_node = dynamic_cast<queueing_station_node_type const*>(&node);
+		if (!ptr_node)
+		{
+			return false;
+		}
+		if (!dynamic_cast<fcfs_queueing_strategy_type const*>(&(ptr_node->queueing_strategy()))
+			|| !ptr_node->queueing_strategy().infinite_capacity())
+		{
+			return false;
+		}
+
+		load_independent_service_strategy_type const* ptr_svc = dynamic_cast<load_independent_service_strategy_type const*>(&(ptr_node->service_strategy()));
+		if (!ptr_svc || ptr_svc->num_servers() != 1)
+		{
+			return false;
+		}
+
+		try
+		{
+			ptr_svc->distribution(class_id);
+		}
+		catch (::std::invalid_argument const&)
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+
+	/// Append a station with the given service time distribution to the line.
+	public: size_type add_station(distribution_type const& svc_distr)
+	{
+		svc_distrs_.push_back(svc_distr);
+		node_stats_.push_back(node_statistic_category_container());
+
+		return svc_distrs_.size()-1;
+	}
+
+
+	/**
+	 * \brief Append the given network node to the line.
+	 *
+	 * The service time distribution for the given class and the node-level
+	 * statistics registered in the node are reused.
+	 */
+	public: size_type add_station(node_type const& node, class_identifier_type class_id)
+	{
+		// pre: node must be a suitable station.
+		DCS_ASSERT(
+			is_lindley_station(node, class_id),
+			throw ::std::invalid_argument("[dcs::des::model::qn::tandem_line_evaluator::add_station] Node is not a single-server FCFS station.")
+		);
+
+		queueing_station_node_type const& station(dynamic_cast<queueing_station_node_type const&>(node));
+		load_independent_service_strategy_type const& svc(dynamic_cast<load_independent_service_strategy_type const&>(station.service_strategy()));
+
+		size_type k(add_station(svc.distribution(class_id)));
+
+		import_statistic(k, node, busy_time_statistic_category);
+		import_statistic(k, node, interarrival_time_statistic_category);
+		import_statistic(k, node, num_waiting_statistic_category);
+		import_statistic(k, node, response_time_statistic_category);
+		import_statistic(k, node, service_time_statistic_category);
+		import_statistic(k, node, throughput_statistic_category);
+		import_statistic(k, node, utilization_statistic_category);
+		import_statistic(k, node, waiting_time_statistic_category);
+		import_statistic(k, node, num_arrivals_statistic_category);
+		import_statistic(k, node, num_departures_statistic_category);
+
+		return k;
+	}
+
+
+	public: size_type num_stations() const
+	{
+		return svc_distrs_.size();
+	}
+
+
+	public: size_type block_size() const
+	{
+		return block_size_;
+	}
+
+
+	/// Associate a statistic to the given category of the given station.
+	public: void statistic(size_type station, node_output_statistic_category category, output_statistic_pointer const& ptr_stat)
+	{
+		// pre: station must be a valid station index.
+		DCS_ASSERT(
+			station < node_stats_.size(),
+			throw ::std::invalid_argument("[dcs::des::model::qn::tandem_line_evaluator::statistic] Invalid station.")
+		);
+		// pre: statistic pointer must be a valid pointer.
+		DCS_ASSERT(
+			ptr_stat,
+			throw ::std::invalid_argument("[dcs::des::model::qn::tandem_line_evaluator::statistic] Invalid statistic.")
+		);
+
+		node_stats_[station][category].push_back(ptr_stat);
+	}
+
+
+	/// Associate a statistic to the given network-level category.
+	public: void statistic(network_output_statistic_category category, output_statistic_pointer const& ptr_stat)
+	{
+		// pre: statistic pointer must be a valid pointer.
+		DCS_ASSERT(
+			ptr_stat,
+			throw ::std::invalid_argument("[dcs::des::model::qn::tandem_line_evaluator::statistic] Invalid statistic.")
+		);
+
+		net_stats_[category].push_back(ptr_stat);
+	}
+
+
+	/**
+	 * \brief Evaluate a single run of the given length.
+	 *
+	 * Customers arriving after \a horizon are not generated; customers still
+	 * in the line at \a horizon contribute to arrival-time observations and
+	 * to busy time, but not to departure-time observations.
+	 */
+	public: void evaluate(real_type horizon, random_generator_type& rng)
+	{
+		// pre: horizon must be a positive value.
+		DCS_ASSERT(
+			horizon > 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::tandem_line_evaluator::evaluate] Invalid horizon.")
+		);
+		// pre: at least one station.
+		DCS_ASSERT(
+			!svc_distrs_.empty(),
+			throw ::std::logic_error("[dcs::des::model::qn::tandem_line_evaluator::evaluate] No station in the line.")
+		);
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") BEGIN Evaluating tandem line (Horizon: " << horizon << ")");//XXX
+
+		const size_type ns(svc_distrs_.size());
+
+		// Per-run state
+		::std::vector<real_type> last_dep(ns, 0); // Departure of the last customer (one per station)
+		::std::vector<real_type> last_arr(ns, 0); // Arrival of the last customer (one per station)
+		::std::vector<real_type> busy(ns, 0);
+		::std::vector<uint_type> narr(ns, 0);
+		::std::vector<uint_type> ndep(ns, 0);
+		::std::vector< ::std::deque<real_type> > pending(ns); // Start times of customers not yet in service
+		uint_type net_narr(0);
+		uint_type net_ndep(0);
+
+		real_container ext_arr(block_size_);
+		real_container arr(block_size_);
+		real_container svc(block_size_);
+		real_container dep(block_size_);
+		real_container psum(block_size_);
+
+		real_type clock(0);
+		bool done(false);
+		while (!done)
+		{
+			// Generate the external arrivals of this block
+			size_type n(0);
+			while (n < block_size_)
+			{
+				real_type t(0);
+				while ((t = ::dcs::math::stats::rand(arr_distr_, rng)) < 0) ;
+				clock += t;
+				if (clock > horizon)
+				{
+					done = true;
+					break;
+				}
+				ext_arr[n] = clock;
+				++n;
+			}
+			if (n == 0)
+			{
+				break;
+			}
+
+			net_narr += n;
+			::std::copy(ext_arr.begin(), ext_arr.begin()+n, arr.begin());
+
+			// Push the block through the line
+			for (size_type k = 0; k < ns; ++k)
+			{
+				for (size_type i = 0; i < n; ++i)
+				{
+					while ((svc[i] = ::dcs::math::stats::rand(svc_distrs_[k], rng)) < 0) ;
+				}
+
+				detail::lindley_block(&arr[0], &svc[0], &dep[0], &psum[0], n, last_dep[k]);
+
+				collect_station(k, &arr[0], &svc[0], &dep[0], n, horizon, last_arr[k], last_dep[k], busy[k], narr[k], ndep[k], pending[k]);
+
+				last_arr[k] = arr[n-1];
+				last_dep[k] = dep[n-1];
+
+				// Departures from this station are arrivals to the next one
+				arr.swap(dep);
+			}
+
+			// Network-level per-customer observations (arr now holds the departures from the line)
+			if (check_stat(net_response_time_statistic_category))
+			{
+				for (size_type i = 0; i < n; ++i)
+				{
+					if (arr[i] <= horizon)
+					{
+						accumulate_stat(net_response_time_statistic_category, arr[i]-ext_arr[i]);
+					}
+				}
+			}
+			for (size_type i = 0; i < n; ++i)
+			{
+				if (arr[i] <= horizon)
+				{
+					++net_ndep;
+				}
+			}
+		}
+
+		// Per-run observations
+		for (size_type k = 0; k < ns; ++k)
+		{
+			accumulate_stat(k, busy_time_statistic_category, busy[k]);
+			accumulate_stat(k, utilization_statistic_category, busy[k]/horizon);
+			accumulate_stat(k, throughput_statistic_category, ndep[k]/horizon);
+			accumulate_stat(k, num_arrivals_statistic_category, narr[k]);
+			accumulate_stat(k, num_departures_statistic_category, ndep[k]);
+		}
+		accumulate_stat(net_throughput_statistic_category, static_cast<real_type>(net_ndep)/horizon);
+		accumulate_stat(net_num_arrivals_statistic_category, net_narr);
+		accumulate_stat(net_num_departures_statistic_category, net_ndep);
+
+		DCS_DEBUG_TRACE_L(3, "(" << this << ") END Evaluating tandem line (Horizon: " << horizon << ", Arrivals: " << net_narr << ", Departures: " << net_ndep << ")");//XXX
+	}
+
+
+	/**
+	 * \brief Collect the per-customer observations of a block at the given
+	 *  station.
+	 *
+	 * \a last_arr and \a last_dep are the arrival and departure times of the
+	 * last customer of the previous block at the same station.
+	 */
+	private: void collect_station(size_type k,
+								  real_type const* arr,
+								  real_type const* svc,
+								  real_type const* dep,
+								  size_type n,
+								  real_type horizon,
+								  real_type last_arr,
+								  real_type last_dep,
+								  real_type& busy,
+								  uint_type& narr,
+								  uint_type& ndep,
+								  ::std::deque<real_type>& pending)
+	{
+		const bool want_iat(check_stat(k, interarrival_time_statistic_category));
+		const bool want_nw(check_stat(k, num_waiting_statistic_category));
+		const bool want_rt(check_stat(k, response_time_statistic_category));
+		const bool want_st(check_stat(k, service_time_statistic_category));
+		const bool want_wt(check_stat(k, waiting_time_statistic_category));
+
+		for (size_type i = 0; i < n; ++i)
+		{
+			if (arr[i] > horizon)
+			{
+				// Arrivals are sorted: the rest of the block is beyond the horizon
+				break;
+			}
+
+			// Service starts when both the customer and the server are
+			// available (computing it as dep[i]-svc[i] would not give back
+			// arr[i] exactly for customers who did not wait)
+			real_type start(::std::max(arr[i], i > 0 ? dep[i-1] : last_dep));
+
+			++narr;
+			if (want_iat)
+			{
+				accumulate_stat(k, interarrival_time_statistic_category, arr[i]-last_arr);
+			}
+			last_arr = arr[i];
+			if (want_nw)
+			{
+				// Number of customers waiting just after this arrival
+				pending.push_back(start);
+				while (!pending.empty() && pending.front() <= arr[i])
+				{
+					pending.pop_front();
+				}
+				accumulate_stat(k, num_waiting_statistic_category, pending.size());
+			}
+			if (start < horizon)
+			{
+				busy += ::std::min(dep[i], horizon) - start;
+			}
+			if (dep[i] <= horizon)
+			{
+				++ndep;
+				if (want_rt)
+				{
+					accumulate_stat(k, response_time_statistic_category, dep[i]-arr[i]);
+				}
+				if (want_st)
+				{
+					accumulate_stat(k, service_time_statistic_category, svc[i]);
+				}
+				if (want_wt)
+				{
+					accumulate_stat(k, waiting_time_statistic_category, start-arr[i]);
+				}
+			}
+		}
+	}
+
+
+	private: void import_statistic(network_type const& net, network_output_statistic_category category)
+	{
+		if (net.has_statistic(category))
+		{
+			output_statistic_container stats(net.statistic(category));
+			output_statistic_container& dst(net_stats_[category]);
+			dst.insert(dst.end(), stats.begin(), stats.end());
+		}
+	}
+
+
+	private: void import_statistic(size_type k, node_type const& node, node_output_statistic_category category)
+	{
+		if (node.has_statistic(category))
+		{
+			output_statistic_container stats(node.statistic(category));
+			output_statistic_container& dst(node_stats_[k][category]);
+			dst.insert(dst.end(), stats.begin(), stats.end());
+		}
+	}
+
+
+	private: bool check_stat(size_type k, node_output_statistic_category category) const
+	{
+		typename node_statistic_category_container::const_iterator it(node_stats_[k].find(category));
+
+		return it != node_stats_[k].end() && !it->second.empty();
+	}
+
+
+	private: bool check_stat(network_output_statistic_category category) const
+	{
+		typename network_statistic_category_container::const_iterator it(net_stats_.find(category));
+
+		return it != net_stats_.end() && !it->second.empty();
+	}
+
+
+	private: void accumulate_stat(size_type k, node_output_statistic_category category, real_type value)
+	{
+		detail::accumulate_stat(node_stats_[k], category, value);
+	}
+
+
+	private: void accumulate_stat(network_output_statistic_category category, real_type value)
+	{
+		detail::accumulate_stat(net_stats_, category, value);
+	}
+
+
+	/// The interarrival time distribution.
+	private: distribution_type arr_distr_;
+	/// The number of customers evaluated per block.
+	private: size_type block_size_;
+	/// The service time distributions (one per station, in line order).
+	private: ::std::vector<distribution_type> svc_distrs_;
+	/// The node-level statistics (one map per station).
+	private: ::std::vector<node_statistic_category_container> node_stats_;
+	/// The network-level statistics.
+	private: network_statistic_category_container net_stats_;
+};
+
+template <typename TraitsT>
+const typename tandem_line_evaluator<TraitsT>::size_type tandem_line_evaluator<TraitsT>::default_block_size;
+
+}}}} // Namespace dcs::des::model::qn
+
+
+#endif // DCS_DES_MODEL_QN_TANDEM_LINE_EVALUATOR_HPP
@@ -0,0 +1,155 @@
+/**
+ * \file dcs/des/model/qn/virtual_work_clock.hpp
+ *
+ * \brief Station-local clock measuring the work done by a service station.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_MODEL_QN_VIRTUAL_WORK_CLOCK_HPP
+#define DCS_DES_MODEL_QN_VIRTUAL_WORK_CLOCK_HPP
+
+
+#include <dcs/assert.hpp>
+#include <dcs/debug.hpp>
+#include <dcs/math/constants.hpp>
+#include <stdexcept>
+
+
+namespace dcs { namespace des { namespace model { namespace qn {
+
+/**
+ * \brief Station-local clock measuring the work done by a service station.
+ *
+ * The clock value is a piecewise-linear function of the simulated time whose
+ * slope (the \e rate) is the current capacity of the station.
+ * Since the work still needed by an in-service customer does not depend on
+ * the station capacity, service completions keyed on this clock stay valid
+ * across capacity changes; only the mapping from work-time to simulated time
+ * (see \c delay) has to be recomputed.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT>
+class virtual_work_clock
+{
+	public: typedef RealT real_type;
+
+
+	public: explicit virtual_work_clock(real_type rate = 1)
+	: value_(0),
+	  rate_(rate),
+	  last_update_time_(0)
+	{
+		// pre: rate must be a non-negative value
+		DCS_ASSERT(
+			rate_ >= 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::virtual_work_clock::ctor] Invalid rate.")
+		);
+	}
+
+
+	// Compiler-generated copy-constructor, copy-assignment, and destructor
+	// are fine.
+
+
+	/// Restart the clock from zero at the given simulated time.
+	public: void reset(real_type t)
+	{
+		value_ = 0;
+		last_update_time_ = t;
+	}
+
+
+	/// Bring the clock up to the given simulated time.
+	public: void advance(real_type t)
+	{
+		if (t > last_update_time_)
+		{
+			value_ += (t-last_update_time_)*rate_;
+			last_update_time_ = t;
+		}
+	}
+
+
+	/// Return the clock value at the given simulated time.
+	public: real_type value(real_type t) const
+	{
+		return (t > last_update_time_) ? (value_+(t-last_update_time_)*rate_) : value_;
+	}
+
+
+	/// Change the rate of the clock starting from the given simulated time.
+	public: void rate(real_type r, real_type t)
+	{
+		// pre: rate must be a non-negative value
+		DCS_ASSERT(
+			r >= 0,
+			throw ::std::invalid_argument("[dcs::des::model::qn::virtual_work_clock::rate] Invalid rate.")
+		);
+
+		advance(t);
+		rate_ = r;
+	}
+
+
+	public: real_type rate() const
+	{
+		return rate_;
+	}
+
+
+	/**
+	 * \brief Return the simulated time to wait, starting from the simulated
+	 *  time \a t, for the clock to reach the value \a v.
+	 */
+	public: real_type delay(real_type v, real_type t) const
+	{
+		real_type cur_v(value(t));
+
+		if (v <= cur_v)
+		{
+			return 0;
+		}
+		if (rate_ <= 0)
+		{
+			return ::dcs::math::constants::infinity<real_type>::value;
+		}
+
+		return (v-cur_v)/rate_;
+	}
+
+
+	/// The clock value at the last update time.
+	private: real_type value_;
+	/// The current rate (i.e., the station capacity).
+	private: real_type rate_;
+	/// The simulated time of the last update.
+	private: real_type last_update_time_;
+};
+
+}}}} // Namespace dcs::des::model::qn
+
+
+#endif // DCS_DES_MODEL_QN_VIRTUAL_WORK_CLOCK_HPP
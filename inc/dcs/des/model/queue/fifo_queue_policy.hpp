@@ -27,7 +27,8 @@
 #define DCS_DES_MODEL_FIFO_QUEUE_POLICY_HPP
 
 
-#include <queue>
+#include <algorithm>
+#include <dcs/des/detail/segmented_ring.hpp>
 
 
 namespace dcs { namespace des { namespace model {
@@ -37,12 +38,16 @@ namespace dcs { namespace des { namespace model {
  *
  * \tparam ValueT The type of queue elements.
  *
+ * Elements are stored in a segmented ring which recycles its chunks, so that
+ * push and pop do not allocate memory once the queue has reached its peak
+ * length.
+ *
  * \author Marco Guazzone (marco.guazzone@gmail.com)
  */
 template <typename ValueT>
 class fifo_queue_policy
 {
-	private: typedef ::std::queue<ValueT> container_type;
+	private: typedef ::dcs::des::detail::segmented_ring<ValueT> container_type;
 	public: typedef typename container_type::value_type value_type;
 	public: typedef typename container_type::reference reference;
 	public: typedef typename container_type::const_reference const_reference;
@@ -54,13 +59,13 @@ class fifo_queue_policy
 
 	public: void push(value_type const& value)
 	{
-		c_.push(value);
+		c_.push_back(value);
 	}
 
 
 	public: void pop()
 	{
-		c_.pop();
+		c_.pop_front();
 	}
 
 
@@ -91,7 +96,8 @@ class fifo_queue_policy
 	template <typename V>
 	friend bool operator==(fifo_queue_policy<V> const& x, fifo_queue_policy<V> const& y)
 	{
-		return x.c_ == y.c_;
+		return x.c_.size() == y.c_.size()
+			   && ::std::equal(x.c_.begin(), x.c_.end(), y.c_.begin());
 	}
 
 
@@ -106,7 +112,7 @@ class fifo_queue_policy
 	template <typename V>
 	friend bool operator<(fifo_queue_policy<V> const& x, fifo_queue_policy<V> const& y)
 	{
-		return x.c_ < y.c_;
+		return ::std::lexicographical_compare(x.c_.begin(), x.c_.end(), y.c_.begin(), y.c_.end());
 	}
 
 
@@ -30,6 +30,7 @@
 
 
 #include <stack>
+#include <vector>
 
 
 namespace dcs { namespace des { namespace model {
@@ -44,7 +45,7 @@ namespace dcs { namespace des { namespace model {
 template <typename ValueT>
 class lifo_queue_policy
 {
-	private: typedef ::std::stack<ValueT> container_type;
+	private: typedef ::std::stack< ValueT, ::std::vector<ValueT> > container_type;
 	public: typedef typename container_type::value_type value_type;
 	public: typedef typename container_type::reference reference;
 	public: typedef typename container_type::const_reference const_reference;
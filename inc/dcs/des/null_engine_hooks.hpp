@@ -0,0 +1,79 @@
+/**
+ * \file dcs/des/null_engine_hooks.hpp
+ *
+ * \brief The do-nothing hooks for the statically dispatched engine loop.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_NULL_ENGINE_HOOKS_HPP
+#define DCS_DES_NULL_ENGINE_HOOKS_HPP
+
+
+#include <dcs/des/engine_context.hpp>
+#include <dcs/des/event.hpp>
+#include <dcs/macro.hpp>
+
+
+namespace dcs { namespace des {
+
+/**
+ * \brief The do-nothing hooks for the statically dispatched engine loop.
+ *
+ * Hooks are the static counterpart of the BEFORE-OF-EVENT-FIRING and
+ * AFTER-OF-EVENT-FIRING event sources: they are called just before and just
+ * after firing every event extracted from the future event list.
+ * Since hooks are bound at compile-time, the calls are inlined and this
+ * class costs nothing.
+ *
+ * A hooks class must provide the same member functions as this one.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT>
+struct null_engine_hooks
+{
+	typedef RealT real_type;
+	typedef event<real_type> event_type;
+	typedef engine_context<real_type> engine_context_type;
+
+
+	void before_event(event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+	}
+
+
+	void after_event(event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+	}
+};
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_NULL_ENGINE_HOOKS_HPP
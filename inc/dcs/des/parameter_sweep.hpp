@@ -0,0 +1,611 @@
+/**
+ * \file dcs/des/parameter_sweep.hpp
+ *
+ * \brief Concurrent runner of a simulation model over a grid of parameters.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_PARAMETER_SWEEP_HPP
+#define DCS_DES_PARAMETER_SWEEP_HPP
+
+
+#include <algorithm>
+#include <boost/smart_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
+#include <deque>
+#include <dcs/assert.hpp>
+#include <dcs/des/random_substream.hpp>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace dcs { namespace des {
+
+/**
+ * \brief The output of a single point of a parameter sweep.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT=double>
+class sweep_point_result
+{
+	public: typedef RealT real_type;
+	public: typedef ::std::size_t size_type;
+
+
+	/// Add a metric with its estimate and the half-width of its confidence
+	/// interval.
+	public: void add(::std::string const& name, real_type estimate, real_type half_width)
+	{
+		names_.push_back(name);
+		estimates_.push_back(estimate);
+		half_widths_.push_back(half_width);
+	}
+
+
+	/// Add a metric from an output statistic.
+	public: template <typename StatisticT>
+		void add(::std::string const& name, StatisticT const& stat)
+	{
+		add(name, stat.estimate(), stat.half_width());
+	}
+
+
+	public: size_type size() const
+	{
+		return names_.size();
+	}
+
+
+	public: ::std::string const& name(size_type i) const
+	{
+		return names_[i];
+	}
+
+
+	public: real_type estimate(size_type i) const
+	{
+		return estimates_[i];
+	}
+
+
+	public: real_type half_width(size_type i) const
+	{
+		return half_widths_[i];
+	}
+
+
+	private: ::std::vector< ::std::string > names_;
+	private: ::std::vector<real_type> estimates_;
+	private: ::std::vector<real_type> half_widths_;
+};
+
+
+/**
+ * \brief Columnar table of the outputs of a parameter sweep.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * There is a row for each point of the sweep (in grid order) and a column for
+ * each parameter, and for the estimate and the confidence interval half-width
+ * of each metric.
+ * Metrics not reported by a point are set to NaN.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT=double>
+class sweep_result_table
+{
+	public: typedef RealT real_type;
+	public: typedef ::std::size_t size_type;
+	public: typedef ::std::vector<real_type> column_type;
+
+
+	public: sweep_result_table()
+	{
+	}
+
+
+	public: sweep_result_table(::std::vector< ::std::string > const& param_names)
+	: param_names_(param_names),
+	  param_cols_(param_names.size())
+	{
+	}
+
+
+	/// Append the row of the given point.
+	public: void add_row(::std::vector<real_type> const& params, sweep_point_result<real_type> const& result)
+	{
+		// pre: size(params) == num_parameters()
+		DCS_ASSERT(
+			params.size() == param_names_.size(),
+			throw ::std::invalid_argument("[dcs::des::sweep_result_table::add_row] Wrong number of parameters.")
+		);
+
+		const size_type nr(num_rows());
+
+		for (size_type j = 0; j < params.size(); ++j)
+		{
+			param_cols_[j].push_back(params[j]);
+		}
+
+		for (size_type k = 0; k < result.size(); ++k)
+		{
+			size_type m(metric_index(result.name(k)));
+			if (m == metric_names_.size())
+			{
+				metric_names_.push_back(result.name(k));
+				estimate_cols_.push_back(column_type(nr, ::std::numeric_limits<real_type>::quiet_NaN()));
+				half_width_cols_.push_back(column_type(nr, ::std::numeric_limits<real_type>::quiet_NaN()));
+			}
+			if (estimate_cols_[m].size() == nr)
+			{
+				estimate_cols_[m].push_back(result.estimate(k));
+				half_width_cols_[m].push_back(result.half_width(k));
+			}
+		}
+
+		// Fill metrics not reported by this point
+		for (size_type m = 0; m < metric_names_.size(); ++m)
+		{
+			if (estimate_cols_[m].size() == nr)
+			{
+				estimate_cols_[m].push_back(::std::numeric_limits<real_type>::quiet_NaN());
+				half_width_cols_[m].push_back(::std::numeric_limits<real_type>::quiet_NaN());
+			}
+		}
+	}
+
+
+	public: size_type num_rows() const
+	{
+		return param_cols_.empty() ? num_rows_no_params() : param_cols_[0].size();
+	}
+
+
+	public: size_type num_parameters() const
+	{
+		return param_names_.size();
+	}
+
+
+	public: size_type num_metrics() const
+	{
+		return metric_names_.size();
+	}
+
+
+	public: ::std::string const& parameter_name(size_type j) const
+	{
+		return param_names_[j];
+	}
+
+
+	public: ::std::string const& metric_name(size_type m) const
+	{
+		return metric_names_[m];
+	}
+
+
+	public: column_type const& parameter_column(size_type j) const
+	{
+		return param_cols_[j];
+	}
+
+
+	public: column_type const& estimate_column(size_type m) const
+	{
+		return estimate_cols_[m];
+	}
+
+
+	public: column_type const& half_width_column(size_type m) const
+	{
+		return half_width_cols_[m];
+	}
+
+
+	/// Return the index of the given metric (or \c num_metrics() if not
+	/// found).
+	public: size_type metric_index(::std::string const& name) const
+	{
+		size_type m(0);
+		while (m < metric_names_.size() && metric_names_[m] != name)
+		{
+			++m;
+		}
+		return m;
+	}
+
+
+	/// Print the table in CSV format.
+	public: void print(::std::ostream& os, char sep = ',') const
+	{
+		for (size_type j = 0; j < param_names_.size(); ++j)
+		{
+			os << param_names_[j] << sep;
+		}
+		for (size_type m = 0; m < metric_names_.size(); ++m)
+		{
+			os << metric_names_[m] << sep
+			   << metric_names_[m] << "_lower" << sep
+			   << metric_names_[m] << "_upper" << sep
+			   << metric_names_[m] << "_half_width";
+			if (m+1 < metric_names_.size())
+			{
+				os << sep;
+			}
+		}
+		os << ::std::endl;
+
+		const size_type nr(num_rows());
+		for (size_type i = 0; i < nr; ++i)
+		{
+			for (size_type j = 0; j < param_cols_.size(); ++j)
+			{
+				os << param_cols_[j][i] << sep;
+			}
+			for (size_type m = 0; m < metric_names_.size(); ++m)
+			{
+				real_type est(estimate_cols_[m][i]);
+				real_type hw(half_width_cols_[m][i]);
+
+				os << est << sep
+				   << (est-hw) << sep
+				   << (est+hw) << sep
+				   << hw;
+				if (m+1 < metric_names_.size())
+				{
+					os << sep;
+				}
+			}
+			os << ::std::endl;
+		}
+	}
+
+
+	private: size_type num_rows_no_params() const
+	{
+		return estimate_cols_.empty() ? 0 : estimate_cols_[0].size();
+	}
+
+
+	private: ::std::vector< ::std::string > param_names_;
+	private: ::std::vector<column_type> param_cols_;
+	private: ::std::vector< ::std::string > metric_names_;
+	private: ::std::vector<column_type> estimate_cols_;
+	private: ::std::vector<column_type> half_width_cols_;
+};
+
+
+template <typename CharT, typename CharTraitsT, typename RealT>
+::std::basic_ostream<CharT,CharTraitsT>& operator<<(::std::basic_ostream<CharT,CharTraitsT>& os, sweep_result_table<RealT> const& table)
+{
+	table.print(os);
+	return os;
+}
+
+
+/**
+ * \brief Concurrent runner of a simulation model over a grid of parameters.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * The grid is the cartesian product of the values of each parameter (e.g.,
+ * arrival rates, numbers of servers, routing probabilities).
+ * For each point of the grid, the model factory is called as
+ * <tt>fun(params, seed, result)</tt>, where \c params are the parameter values
+ * of the point (in the order the parameters have been added), \c seed is the
+ * seed of the random number generator of the point and \c result is the
+ * \c sweep_point_result to fill with the output metrics.
+ * The factory must build its own model (e.g., a \c queueing_network with its
+ * engine and random number generator), run it and report its metrics.
+ * Points share only the library-wide counters that number events and event
+ * sources; these are atomic, so IDs stay unique but are interleaved among
+ * points (IDs never affect the order of events).
+ * With \c DCS_DES_CONFIG_MEMORY_ACCOUNTING, the memory accounting registry is
+ * shared too, and accounts the memory of all the running points.
+ *
+ * Points are run concurrently by a pool of threads with work stealing: points
+ * are initially dealt round-robin to the per-thread queues and a thread that
+ * runs out of points steals from the others, so that long and short points
+ * are balanced automatically.
+ * Seeds are derived from the base seed and the index of the point by
+ * \c substream_seed, so that results do not depend on the number of threads
+ * nor on the scheduling.
+ *
+ * \note Linking with Boost.Thread is required.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT=double>
+class parameter_sweep
+{
+	public: typedef RealT real_type;
+	public: typedef ::std::size_t size_type;
+	public: typedef unsigned long seed_type;
+	public: typedef ::std::vector<real_type> point_type;
+	public: typedef sweep_point_result<real_type> point_result_type;
+	public: typedef sweep_result_table<real_type> result_table_type;
+
+
+	public: static const seed_type default_seed = 5489UL;
+
+
+	public: explicit parameter_sweep(seed_type seed = default_seed)
+	: seed_(seed)
+	{
+	}
+
+
+	/// Add a parameter with the given values to the grid.
+	public: void add_parameter(::std::string const& name, ::std::vector<real_type> const& values)
+	{
+		// pre: values must not be empty
+		DCS_ASSERT(
+			!values.empty(),
+			throw ::std::invalid_argument("[dcs::des::parameter_sweep::add_parameter] Empty set of values.")
+		);
+
+		names_.push_back(name);
+		values_.push_back(values);
+	}
+
+
+	public: size_type num_parameters() const
+	{
+		return names_.size();
+	}
+
+
+	/// Return the number of points of the grid.
+	public: size_type num_points() const
+	{
+		if (values_.empty())
+		{
+			return 0;
+		}
+
+		size_type n(1);
+		for (size_type j = 0; j < values_.size(); ++j)
+		{
+			n *= values_[j].size();
+		}
+		return n;
+	}
+
+
+	/// Return the parameter values of the given point (the last parameter
+	/// varies fastest).
+	public: point_type point(size_type i) const
+	{
+		point_type p(values_.size());
+
+		for (size_type j = values_.size(); j > 0; --j)
+		{
+			size_type n(values_[j-1].size());
+			p[j-1] = values_[j-1][i % n];
+			i /= n;
+		}
+
+		return p;
+	}
+
+
+	public: seed_type point_seed(size_type i) const
+	{
+		return ::dcs::des::substream_seed(seed_, i);
+	}
+
+
+	/**
+	 * \brief Run the model over all the points of the grid.
+	 * \param fun The model factory.
+	 * \param num_threads The number of threads of the pool (zero means the
+	 *  number of hardware threads).
+	 * \return The table of the outputs of all the points.
+	 *
+	 * If the factory throws for a point, no new point is started and the error
+	 * is rethrown as a \c std::runtime_error once all the running points are
+	 * done.
+	 */
+	public: template <typename FuncT>
+		result_table_type run(FuncT fun, size_type num_threads = 0)
+	{
+		if (num_threads == 0)
+		{
+			num_threads = ::std::max(::boost::thread::hardware_concurrency(), 1U);
+		}
+
+		const size_type np(num_points());
+
+		// Deal points round-robin to the per-thread queues
+		queues_.clear();
+		for (size_type t = 0; t < num_threads; ++t)
+		{
+			queues_.push_back(::boost::make_shared<work_queue>());
+		}
+		for (size_type i = 0; i < np; ++i)
+		{
+			queues_[i % num_threads]->points.push_back(i);
+		}
+
+		results_.assign(np, point_result_type());
+		error_.clear();
+		failed_ = false;
+
+		::boost::thread_group threads;
+		for (size_type t = 0; t < num_threads; ++t)
+		{
+			threads.create_thread(worker_task<FuncT>(this, fun, t));
+		}
+		threads.join_all();
+
+		queues_.clear();
+
+		if (failed_)
+		{
+			throw ::std::runtime_error("[dcs::des::parameter_sweep::run] Point failed: " + error_);
+		}
+
+		result_table_type table(names_);
+		for (size_type i = 0; i < np; ++i)
+		{
+			table.add_row(point(i), results_[i]);
+		}
+		results_.clear();
+
+		return table;
+	}
+
+
+	/// A work-stealing queue: its owner takes points from the back, thieves
+	/// from the front.
+	private: struct work_queue
+	{
+		::std::deque<size_type> points;
+		::boost::mutex mutex;
+	};
+
+
+	private: template <typename FuncT>
+		struct worker_task
+	{
+		worker_task(parameter_sweep* ptr_sweep, FuncT const& fun, size_type id)
+		: ptr_sweep(ptr_sweep),
+		  fun(fun),
+		  id(id)
+		{
+		}
+
+		void operator()()
+		{
+			size_type i(0);
+
+			while (ptr_sweep->next_point(id, i))
+			{
+				try
+				{
+					fun(ptr_sweep->point(i), ptr_sweep->point_seed(i), ptr_sweep->results_[i]);
+				}
+				catch (::std::exception const& e)
+				{
+					ptr_sweep->fail(e.what());
+				}
+				catch (...)
+				{
+					ptr_sweep->fail("unknown error");
+				}
+			}
+		}
+
+		parameter_sweep* ptr_sweep;
+		FuncT fun;
+		size_type id;
+	};
+
+
+	/// Get the next point for the given thread, possibly stealing it.
+	private: bool next_point(size_type id, size_type& i)
+	{
+		typedef ::boost::lock_guard< ::boost::mutex > lock_type;
+
+		if (is_failed())
+		{
+			return false;
+		}
+
+		{
+			work_queue& q(*queues_[id]);
+			lock_type lock(q.mutex);
+			if (!q.points.empty())
+			{
+				i = q.points.back();
+				q.points.pop_back();
+				return true;
+			}
+		}
+
+		// Points are never added while running, so a full scan finding all
+		// the queues empty means the sweep is done.
+		const size_type nq(queues_.size());
+		for (size_type k = 1; k < nq; ++k)
+		{
+			work_queue& q(*queues_[(id+k) % nq]);
+			lock_type lock(q.mutex);
+			if (!q.points.empty())
+			{
+				i = q.points.front();
+				q.points.pop_front();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	private: void fail(::std::string const& msg)
+	{
+		::boost::lock_guard< ::boost::mutex > lock(error_mutex_);
+
+		if (!failed_)
+		{
+			error_ = msg;
+			failed_ = true;
+		}
+	}
+
+
+	private: bool is_failed() const
+	{
+		::boost::lock_guard< ::boost::mutex > lock(error_mutex_);
+
+		return failed_;
+	}
+
+
+	private: seed_type seed_;
+	private: ::std::vector< ::std::string > names_;
+	private: ::std::vector< ::std::vector<real_type> > values_;
+	private: ::std::vector< ::boost::shared_ptr<work_queue> > queues_;
+	/// The outputs of the points (each one written by a single thread).
+	private: ::std::vector<point_result_type> results_;
+	private: ::std::string error_;
+	private: bool failed_;
+	private: mutable ::boost::mutex error_mutex_;
+};
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_PARAMETER_SWEEP_HPP
@@ -0,0 +1,646 @@
+/**
+ * \file dcs/des/process.hpp
+ *
+ * \brief Process-interaction modeling on top of the simulation engine.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_PROCESS_HPP
+#define DCS_DES_PROCESS_HPP
+
+
+#include <boost/pool/pool.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/smart_ptr.hpp>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <dcs/debug.hpp>
+#include <dcs/des/detail/segmented_ring.hpp>
+#include <dcs/des/engine.hpp>
+#include <dcs/des/engine_context.hpp>
+#include <dcs/des/event.hpp>
+#include <dcs/des/event_source.hpp>
+#include <dcs/macro.hpp>
+#include <map>
+#include <new>
+#include <stdexcept>
+
+
+/**
+ * \name Process body macros
+ *
+ * The body of a process (i.e., its \c do_run member function) is a stackless
+ * coroutine: it must be enclosed between \c DCS_DES_PROCESS_BEGIN and
+ * \c DCS_DES_PROCESS_END and it is suspended by \c DCS_DES_PROCESS_HOLD and
+ * (possibly) by \c DCS_DES_PROCESS_ACQUIRE.
+ * Since the body returns to the engine at every suspension point, local
+ * variables do not survive suspension; the state of the process must be kept
+ * in data members.
+ * Suspension points must be placed on different source lines.
+ *
+ * No statement falls through into the case labels the macros expand to (the
+ * body jumps over them instead), so that the macros do not trigger implicit
+ * fall-through warnings.
+ */
+//@{
+
+/// Make a label which is unique to the source line.
+#define DCS_DES_PROCESS_LABEL_(name) \
+	BOOST_PP_CAT(dcs_des_process_##name##_, __LINE__)
+
+/// Begin the body of a process.
+#define DCS_DES_PROCESS_BEGIN \
+	switch (this->resume_point()) { case 0:
+
+/// Suspend the process for the given amount of simulated time.
+#define DCS_DES_PROCESS_HOLD(delay) \
+	do { \
+		this->resume_point(__LINE__); \
+		this->hold(delay); \
+		return; \
+		case __LINE__: ; \
+	} while (false)
+
+/// Acquire a unit of the given resource, suspending the process while none
+/// is available.
+#define DCS_DES_PROCESS_ACQUIRE(res) \
+	do { \
+		this->resume_point(__LINE__); \
+		if (this->acquire(res)) \
+		{ \
+			goto DCS_DES_PROCESS_LABEL_(acquired); \
+		} \
+		return; \
+		case __LINE__: \
+		DCS_DES_PROCESS_LABEL_(acquired): ; \
+	} while (false)
+
+/// Release a unit of the given resource.
+#define DCS_DES_PROCESS_RELEASE(res) \
+	this->release(res)
+
+/// End the body of a process; the process terminates and is destroyed.
+#define DCS_DES_PROCESS_END \
+		goto dcs_des_process_end_; \
+		default: \
+		dcs_des_process_end_: ; \
+	} \
+	this->terminate()
+
+//@}
+
+
+namespace dcs { namespace des {
+
+template <typename RealT>
+class process_scheduler;
+
+template <typename RealT>
+class process_resource;
+
+
+/**
+ * \brief Base class for simulation processes.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * A process is a stackless coroutine driven by the simulation engine: derived
+ * classes implement the \c do_run member function with the process body
+ * macros (see \c DCS_DES_PROCESS_BEGIN), for instance:
+ * \code
+ * class customer: public dcs::des::process<double>
+ * {
+ *   ...
+ *   private: void do_run(engine_context_type& ctx)
+ *   {
+ *     DCS_DES_PROCESS_BEGIN;
+ *       arrival_time_ = ctx.simulated_time();
+ *       DCS_DES_PROCESS_ACQUIRE( *ptr_server_ );
+ *       DCS_DES_PROCESS_HOLD( service_time_ );
+ *       DCS_DES_PROCESS_RELEASE( *ptr_server_ );
+ *       ptr_stat_->collect(ctx.simulated_time()-arrival_time_);
+ *     DCS_DES_PROCESS_END;
+ *   }
+ * };
+ * \endcode
+ * Processes are started by \c process_scheduler::spawn, which copies them
+ * into storage owned by the scheduler.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT=double>
+class process
+{
+	friend class process_scheduler<RealT>;
+	friend class process_resource<RealT>;
+
+	public: typedef RealT real_type;
+	public: typedef engine_context<real_type> engine_context_type;
+	public: typedef process_scheduler<real_type> scheduler_type;
+	public: typedef process_resource<real_type> resource_type;
+	private: typedef event<real_type> event_type;
+	private: typedef ::boost::shared_ptr<event_type> event_pointer;
+
+
+	public: process()
+	: resume_point_(0),
+	  terminated_(false),
+	  ptr_sched_(0),
+	  ptr_pool_(0),
+	  ptr_prev_(0),
+	  ptr_next_(0)
+	{
+	}
+
+
+	/// Copy constructor: only the user-defined state is copied, the copy is a
+	/// new process which has not started yet.
+	public: process(process const& that)
+	: resume_point_(0),
+	  terminated_(false),
+	  ptr_sched_(0),
+	  ptr_pool_(0),
+	  ptr_prev_(0),
+	  ptr_next_(0)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( that );
+	}
+
+
+	public: virtual ~process()
+	{
+	}
+
+
+	/// Tell if the process has run to completion.
+	public: bool terminated() const
+	{
+		return terminated_;
+	}
+
+
+	/// Return the scheduler running this process.
+	public: scheduler_type& scheduler()
+	{
+		// pre: process must have been spawned
+		DCS_ASSERT(
+			ptr_sched_,
+			throw ::std::logic_error("[dcs::des::process::scheduler] Process not spawned.")
+		);
+
+		return *ptr_sched_;
+	}
+
+
+	protected: int resume_point() const
+	{
+		return resume_point_;
+	}
+
+
+	protected: void resume_point(int value)
+	{
+		resume_point_ = value;
+	}
+
+
+	protected: void hold(real_type delay)
+	{
+		ptr_sched_->schedule(this, delay);
+	}
+
+
+	protected: bool acquire(resource_type& res)
+	{
+		return res.acquire(this);
+	}
+
+
+	protected: void release(resource_type& res)
+	{
+		res.release();
+	}
+
+
+	protected: void terminate()
+	{
+		terminated_ = true;
+	}
+
+
+	private: process& operator=(process const&);
+
+
+	/// The body of the process.
+	private: virtual void do_run(engine_context_type& ctx) = 0;
+
+
+	/// The point the body resumes from.
+	private: int resume_point_;
+	private: bool terminated_;
+	private: scheduler_type* ptr_sched_;
+	/// The pool the process has been allocated from.
+	private: ::boost::pool<>* ptr_pool_;
+	/// The pending resumption event (if any).
+	private: event_pointer ptr_evt_;
+	/// Links in the list of live processes of the scheduler.
+	private: process* ptr_prev_;
+	private: process* ptr_next_;
+};
+
+
+/**
+ * \brief Runs simulation processes on a simulation engine.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * Processes are allocated from pools owned by the scheduler (one per process
+ * size), so that spawning and terminating processes do not go through the
+ * general-purpose allocator once the pools have grown to the peak number of
+ * live processes.
+ * A process is resumed by an event delivered directly to the scheduler (see
+ * \c event::handler), without going through the signal of an event source
+ * and without any event state.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT=double>
+class process_scheduler
+{
+	friend class process<RealT>;
+	friend class process_resource<RealT>;
+
+	public: typedef RealT real_type;
+	public: typedef ::dcs::des::engine<real_type> engine_type;
+	public: typedef ::boost::shared_ptr<engine_type> engine_pointer;
+	public: typedef process<real_type> process_type;
+	public: typedef ::std::size_t size_type;
+	private: typedef typename engine_type::event_type event_type;
+	private: typedef typename engine_type::event_source_type event_source_type;
+	private: typedef typename engine_type::event_source_pointer event_source_pointer;
+	private: typedef typename engine_type::engine_context_type engine_context_type;
+	private: typedef ::boost::pool<> pool_type;
+	private: typedef ::std::map<size_type,pool_type*> pool_container;
+
+
+	public: explicit process_scheduler(engine_pointer const& ptr_eng)
+	: ptr_eng_(ptr_eng),
+	  ptr_evt_src_(new event_source_type("Process Resume")),
+	  ptr_head_(0),
+	  num_procs_(0)
+	{
+		// pre: engine must be a valid pointer
+		DCS_ASSERT(
+			ptr_eng_,
+			throw ::std::invalid_argument("[dcs::des::process_scheduler::ctor] Invalid engine.")
+		);
+	}
+
+
+	public: ~process_scheduler()
+	{
+		clear();
+
+		typename pool_container::iterator end_it(pools_.end());
+		for (typename pool_container::iterator it = pools_.begin(); it != end_it; ++it)
+		{
+			delete it->second;
+		}
+	}
+
+
+	/**
+	 * \brief Start a copy of the given process after \a delay units of
+	 *  simulated time.
+	 *
+	 * With a zero delay, the process runs at once (i.e., before \c spawn
+	 * returns) until its first suspension point, without going through the
+	 * event list.
+	 *
+	 * \return A pointer to the started process, which is valid until the
+	 *  process terminates, or a null pointer if the process has already
+	 *  terminated.
+	 */
+	public: template <typename ProcessT>
+		ProcessT* spawn(ProcessT const& proto, real_type delay = real_type/*zero*/())
+	{
+		pool_type* ptr_pool(pool(sizeof(ProcessT)));
+
+		void* ptr_mem(ptr_pool->malloc());
+		if (!ptr_mem)
+		{
+			throw ::std::bad_alloc();
+		}
+
+		ProcessT* ptr_proc(0);
+		try
+		{
+			ptr_proc = new (ptr_mem) ProcessT(proto);
+		}
+		catch (...)
+		{
+			ptr_pool->free(ptr_mem);
+			throw;
+		}
+
+		process_type* ptr_base(ptr_proc);
+		ptr_base->ptr_sched_ = this;
+		ptr_base->ptr_pool_ = ptr_pool;
+		link(ptr_base);
+
+		if (delay > 0)
+		{
+			schedule(ptr_base, delay);
+		}
+		else
+		{
+			run(ptr_base);
+			if (ptr_base->terminated_)
+			{
+				return 0;
+			}
+		}
+
+		return ptr_proc;
+	}
+
+
+	/// Return the number of live processes.
+	public: size_type num_processes() const
+	{
+		return num_procs_;
+	}
+
+
+	/**
+	 * \brief Destroy all the live processes.
+	 *
+	 * Their pending resumptions are disabled.
+	 * Resources processes may be waiting for should be reset as well.
+	 */
+	public: void clear()
+	{
+		while (ptr_head_)
+		{
+			destroy(ptr_head_);
+		}
+	}
+
+
+	public: engine_type& engine()
+	{
+		return *ptr_eng_;
+	}
+
+
+	public: engine_type const& engine() const
+	{
+		return *ptr_eng_;
+	}
+
+
+	/// Resume the given process after \a delay units of simulated time.
+	private: void schedule(process_type* ptr_proc, real_type delay)
+	{
+		ptr_proc->ptr_evt_ = ptr_eng_->schedule_event(ptr_evt_src_,
+													  ptr_eng_->simulated_time()+delay,
+													  &process_scheduler::resume,
+													  ptr_proc);
+	}
+
+
+	/// Resume the given process at once.
+	private: void run(process_type* ptr_proc)
+	{
+		engine_context_type ctx(ptr_eng_.get());
+
+		execute(ptr_proc, ctx);
+	}
+
+
+	/// Run the body of the given process until its next suspension point.
+	private: static void execute(process_type* ptr_proc, engine_context_type& ctx)
+	{
+		ptr_proc->do_run(ctx);
+		if (ptr_proc->terminated_)
+		{
+			ptr_proc->ptr_sched_->destroy(ptr_proc);
+		}
+	}
+
+
+	private: pool_type* pool(size_type size)
+	{
+		typename pool_container::iterator it(pools_.find(size));
+		if (it == pools_.end())
+		{
+			it = pools_.insert(::std::make_pair(size, new pool_type(size))).first;
+		}
+
+		return it->second;
+	}
+
+
+	private: void link(process_type* ptr_proc)
+	{
+		ptr_proc->ptr_prev_ = 0;
+		ptr_proc->ptr_next_ = ptr_head_;
+		if (ptr_head_)
+		{
+			ptr_head_->ptr_prev_ = ptr_proc;
+		}
+		ptr_head_ = ptr_proc;
+		++num_procs_;
+	}
+
+
+	private: void unlink(process_type* ptr_proc)
+	{
+		if (ptr_proc->ptr_prev_)
+		{
+			ptr_proc->ptr_prev_->ptr_next_ = ptr_proc->ptr_next_;
+		}
+		else
+		{
+			ptr_head_ = ptr_proc->ptr_next_;
+		}
+		if (ptr_proc->ptr_next_)
+		{
+			ptr_proc->ptr_next_->ptr_prev_ = ptr_proc->ptr_prev_;
+		}
+		--num_procs_;
+	}
+
+
+	private: void destroy(process_type* ptr_proc)
+	{
+		if (ptr_proc->ptr_evt_)
+		{
+			// The event may still be in the event list
+			ptr_proc->ptr_evt_->handler(&process_scheduler::ignore, 0);
+		}
+
+		unlink(ptr_proc);
+
+		pool_type* ptr_pool(ptr_proc->ptr_pool_);
+		ptr_proc->~process_type();
+		ptr_pool->free(ptr_proc);
+	}
+
+
+	private: static void resume(void* ptr_target, event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+
+		process_type* ptr_proc(static_cast<process_type*>(ptr_target));
+
+		ptr_proc->ptr_evt_.reset();
+		execute(ptr_proc, ctx);
+	}
+
+
+	private: static void ignore(void* ptr_target, event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ptr_target );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+	}
+
+
+	private: process_scheduler(process_scheduler const&);
+	private: process_scheduler& operator=(process_scheduler const&);
+
+
+	private: engine_pointer ptr_eng_;
+	/// The event source all the resumption events belong to.
+	private: event_source_pointer ptr_evt_src_;
+	private: pool_container pools_;
+	/// The list of live processes.
+	private: process_type* ptr_head_;
+	private: size_type num_procs_;
+};
+
+
+/**
+ * \brief A resource with a given number of units, acquired and released by
+ *  processes.
+ *
+ * \tparam RealT The type used for real numbers.
+ *
+ * Processes acquiring the resource while all its units are busy wait in FCFS
+ * order; when a unit is released, it is handed to the first waiting process,
+ * whose resumption is scheduled with a zero delay, so that it runs after the
+ * releasing process has been suspended (or terminated) rather than inside its
+ * body.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT=double>
+class process_resource
+{
+	friend class process<RealT>;
+
+	public: typedef RealT real_type;
+	public: typedef process<real_type> process_type;
+	public: typedef ::std::size_t size_type;
+
+
+	public: explicit process_resource(size_type capacity = 1)
+	: capacity_(capacity),
+	  num_busy_(0)
+	{
+	}
+
+
+	public: size_type capacity() const
+	{
+		return capacity_;
+	}
+
+
+	public: size_type num_busy() const
+	{
+		return num_busy_;
+	}
+
+
+	public: size_type num_waiting() const
+	{
+		return waiting_.size();
+	}
+
+
+	/// Release a unit of this resource.
+	public: void release()
+	{
+		// pre: at least a unit must be busy
+		DCS_ASSERT(
+			num_busy_ > 0,
+			throw ::std::logic_error("[dcs::des::process_resource::release] No busy unit to release.")
+		);
+
+		if (!waiting_.empty())
+		{
+			// The unit passes to the first waiting process
+			process_type* ptr_proc(waiting_.front());
+			waiting_.pop_front();
+			ptr_proc->ptr_sched_->schedule(ptr_proc, real_type/*zero*/());
+		}
+		else
+		{
+			--num_busy_;
+		}
+	}
+
+
+	/// Make all the units idle and forget the waiting processes.
+	public: void reset()
+	{
+		num_busy_ = 0;
+		waiting_.clear();
+	}
+
+
+	/// Acquire a unit for the given process, or enqueue it if none is idle.
+	private: bool acquire(process_type* ptr_proc)
+	{
+		if (num_busy_ < capacity_)
+		{
+			++num_busy_;
+			return true;
+		}
+
+		waiting_.push_back(ptr_proc);
+		return false;
+	}
+
+
+	private: size_type capacity_;
+	private: size_type num_busy_;
+	private: ::dcs::des::detail::segmented_ring<process_type*> waiting_;
+};
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_PROCESS_HPP
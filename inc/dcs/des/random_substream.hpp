@@ -0,0 +1,64 @@
+/**
+ * \file dcs/des/random_substream.hpp
+ *
+ * \brief Seeds of independent random number substreams.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_RANDOM_SUBSTREAM_HPP
+#define DCS_DES_RANDOM_SUBSTREAM_HPP
+
+
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+
+namespace dcs { namespace des {
+
+/**
+ * \brief Return the seed of the given random number substream.
+ * \param seed The base seed.
+ * \param index The index of the substream.
+ * \return A 32-bit seed (the seed size of most generators).
+ *
+ * Seeds are derived from the base seed through the (bijective) SplitMix64
+ * finalizer (Steele et al., 2014), so that consecutive substreams get well
+ * separated seeds and runs are reproducible.
+ * This is meant for concurrent runs of the same model (e.g., parallel
+ * replications or the points of a parameter sweep), each with its own
+ * random number generator.
+ */
+inline unsigned long substream_seed(unsigned long seed, ::std::size_t index)
+{
+	::boost::uint64_t z(static_cast< ::boost::uint64_t >(seed)+(static_cast< ::boost::uint64_t >(index)+1)*UINT64_C(0x9E3779B97F4A7C15));
+	z = (z ^ (z >> 30))*UINT64_C(0xBF58476D1CE4E5B9);
+	z = (z ^ (z >> 27))*UINT64_C(0x94D049BB133111EB);
+	z ^= z >> 31;
+
+	return static_cast<unsigned long>(z & 0xFFFFFFFFUL);
+}
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_RANDOM_SUBSTREAM_HPP
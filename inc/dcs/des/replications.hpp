@@ -37,6 +37,8 @@
 #include <dcs/des/replications/engine.hpp>
 #include <dcs/des/replications/fixed_duration_replication_size_detector.hpp>
 #include <dcs/des/replications/fixed_num_obs_replication_size_detector.hpp>
+#include <dcs/des/replications/kim2001_ranking_and_selection.hpp>
+#include <dcs/des/replications/replication_size_detector_traits.hpp>
 
 
 #endif // DCS_DES_REPLICATIONS_HPP
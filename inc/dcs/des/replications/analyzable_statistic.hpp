@@ -38,11 +38,13 @@
 #include <dcs/des/engine_traits.hpp>
 #include <dcs/des/mean_estimator.hpp>
 //#include <dcs/des/replications/engine.hpp>
+#include <dcs/des/replications/replication_size_detector_traits.hpp>
 #include <dcs/des/statistic_categories.hpp>
 #include <dcs/functional/bind.hpp>
 #include <dcs/macro.hpp>
 #include <dcs/math/constants.hpp>
 #include <dcs/math/traits/float.hpp>
+#include <stdexcept>
 
 
 //TODO:
@@ -64,6 +66,12 @@ class engine;
  * \tparam ReplicationSizeDetectorT The type of the replication size detector.
  * \tparam NumReplicationsDetectorT The type of the replication size detector.
  *
+ * The \c retains_observations constant of the traits of the replication size
+ * detector (see \c replication_size_detector_traits) tells whether the
+ * observations consumed during detection must be taken back once the
+ * replication size is detected, or are directly accumulated by this
+ * statistic.
+ *
  * \author Marco Guazzone (marco.guazzone@gmail.com)
  */
 template <
@@ -114,7 +122,14 @@ class analyzable_statistic: public base_analyzable_statistic<
 		  num_repl_detected_(false),
 		  num_repl_(0),
 		  repl_mean_stat_(),
-		  steady_start_time_(0)
+		  steady_start_time_(0),
+		  num_pilots_(0),
+		  pilot_safety_factor_(1),
+		  num_pilots_done_(0),
+		  max_pilot_trans_len_(0),
+		  fixed_trans_len_(0),
+		  warmup_fixed_(false),
+		  num_deleted_(0)
 	{
 		// Empty
 	}
@@ -157,7 +172,14 @@ class analyzable_statistic: public base_analyzable_statistic<
 		  num_repl_detected_(false),
 		  num_repl_(0),
 		  repl_mean_stat_(),
-		  steady_start_time_(0)
+		  steady_start_time_(0),
+		  num_pilots_(0),
+		  pilot_safety_factor_(1),
+		  num_pilots_done_(0),
+		  max_pilot_trans_len_(0),
+		  fixed_trans_len_(0),
+		  warmup_fixed_(false),
+		  num_deleted_(0)
 	{
 		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING(eng);
 
@@ -168,6 +190,77 @@ class analyzable_statistic: public base_analyzable_statistic<
 		);
 	}
 
+	/**
+	 * \brief Enable the reuse of the warm-up period estimated by pilot
+	 *  replications.
+	 *
+	 * \param num_pilots The number of pilot replications.
+	 * \param safety_factor The factor the longest transient phase detected by
+	 *  pilot replications is multiplied by to get the truncation point.
+	 *
+	 * The transient phase detector only runs in the first \a num_pilots
+	 * replications (with a detected transient phase).
+	 * Then, a conservative truncation point (in number of observations) is
+	 * estimated and applied as a fixed deletion to all the later
+	 * replications, which thus neither buffer nor replay observations for
+	 * transient phase detection.
+	 * Pilot replications are kept in the estimate.
+	 */
+	public: void enable_pilot_warmup(uint_type num_pilots, value_type safety_factor = value_type(1))
+	{
+		// pre: num_pilots > 0
+		DCS_ASSERT(
+			num_pilots > 0,
+			throw ::std::invalid_argument("[dcs::des::replications::analyzable_statistic::enable_pilot_warmup] Number of pilot replications must be a positive number.")
+		);
+		// pre: safety_factor >= 1
+		DCS_ASSERT(
+			safety_factor >= 1,
+			throw ::std::invalid_argument("[dcs::des::replications::analyzable_statistic::enable_pilot_warmup] Safety factor must be >= 1.")
+		);
+
+		num_pilots_ = num_pilots;
+		pilot_safety_factor_ = safety_factor;
+	}
+
+	/**
+	 * \brief Disable the reuse of the warm-up period estimated by pilot
+	 *  replications.
+	 *
+	 * If the current replication is still deleting the fixed warm-up, its
+	 * transient phase is detected from now on.
+	 * A replication which has already deleted the fixed warm-up keeps it as
+	 * its transient phase length, since exactly that many observations were
+	 * deleted.
+	 */
+	public: void disable_pilot_warmup()
+	{
+		if (warmup_fixed_ && !trans_detected_)
+		{
+			// The detector was reset when the warm-up was fixed
+			trans_len_ = 0;
+		}
+		num_deleted_ = 0;
+
+		num_pilots_ = 0;
+		num_pilots_done_ = max_pilot_trans_len_
+						 = fixed_trans_len_
+						 = uint_type(0);
+		warmup_fixed_ = false;
+	}
+
+	/// Tells if the truncation point estimated by pilot replications is in use
+	public: bool pilot_warmup_fixed() const
+	{
+		return warmup_fixed_;
+	}
+
+	/// Returns the truncation point estimated by pilot replications
+	public: uint_type pilot_truncation_point() const
+	{
+		return fixed_trans_len_;
+	}
+
 	/// Returns the current number of performed replications
 	public: uint_type actual_num_replications() const
 	{
@@ -207,6 +300,31 @@ class analyzable_statistic: public base_analyzable_statistic<
 	protected: void do_finalize_for_experiment()
 	{
 		do_estimate(stat_.estimate());
+
+		if (num_pilots_ > 0 && !warmup_fixed_)
+		{
+			pilot_warmup_estimation();
+		}
+	}
+
+	private: void pilot_warmup_estimation()
+	{
+		if (trans_detected_)
+		{
+			++num_pilots_done_;
+			max_pilot_trans_len_ = ::std::max(max_pilot_trans_len_, trans_len_);
+		}
+
+		if (num_pilots_done_ >= num_pilots_)
+		{
+			fixed_trans_len_ = static_cast<uint_type>(::std::ceil(max_pilot_trans_len_*pilot_safety_factor_));
+			warmup_fixed_ = true;
+
+			// The detector is not used anymore
+			trans_detector_.reset();
+
+			DCS_DEBUG_TRACE("(" << this << ") Warm-up estimated by " << num_pilots_done_ << " pilot replications: " << fixed_trans_len_ << " observations.");
+		}
 	}
 
 	private: void reset_for_replication()
@@ -236,10 +354,20 @@ class analyzable_statistic: public base_analyzable_statistic<
 //		{
 //			trans_len_ = trans_detector_.estimated_size();
 //		}
-		trans_detector_.reset();
-		trans_detected_ = false;
-		trans_len_ = 0;
-		transient_detection();
+		if (warmup_fixed_)
+		{
+			// Fixed deletion: no transient phase detection
+			num_deleted_ = 0;
+			trans_len_ = fixed_trans_len_;
+			trans_detected_ = (fixed_trans_len_ == 0);
+		}
+		else
+		{
+			trans_detector_.reset();
+			trans_detected_ = false;
+			trans_len_ = 0;
+			transient_detection();
+		}
 		repl_size_detector_.reset();
 		repl_size_ = 0;
 		repl_size_detected_ = false;
@@ -342,7 +470,14 @@ class analyzable_statistic: public base_analyzable_statistic<
 			return;
 		}
 
-		if (repl_size_detected_)
+		if (!trans_detected_ && warmup_fixed_)
+		{
+			// Delete the observation (fixed truncation point)
+
+			++num_deleted_;
+			trans_detected_ = (num_deleted_ >= trans_len_);
+		}
+		else if (repl_size_detected_ && trans_detected_)
 		{
 			stat_(obs, weight);
 		}
@@ -352,7 +487,15 @@ class analyzable_statistic: public base_analyzable_statistic<
 
 			DCS_DEBUG_TRACE("(" << this << ") Detecting replication length...");
 
-			repl_size_detected_ = repl_size_detector_.detect(obs, weight);
+			// Note: the detection outcome is handled (and the consumed
+			// observations are taken back) by replication_size_detection().
+			repl_size_detector_.detect(obs, weight);
+			if (!replication_size_detector_traits<replication_size_detector_type>::retains_observations)
+			{
+				// The detector only looks at the observation: accumulate it
+				// now instead of taking it back once the size is detected.
+				stat_(obs, weight);
+			}
 
 			this->replication_size_detection();
 		}
@@ -362,7 +505,9 @@ class analyzable_statistic: public base_analyzable_statistic<
 
 			DCS_DEBUG_TRACE("(" << this << ") Detecting transient phase...");
 
-			trans_detected_ = trans_detector_.detect(obs, weight);
+			// Note: the detection outcome is handled (and the steady-state
+			// observations are put back) by transient_detection().
+			trans_detector_.detect(obs, weight);
 
 			this->transient_detection();
 		}
@@ -376,7 +521,7 @@ class analyzable_statistic: public base_analyzable_statistic<
 		DCS_DEBUG_TRACE("(" << this << ") Handling detection of transient phase...");
 
 //		if (trans_detected_ || !this->enabled())
-		if (trans_detected_)
+		if (trans_detected_ || warmup_fixed_)
 		{
 			return;
 		}
@@ -442,6 +587,13 @@ class analyzable_statistic: public base_analyzable_statistic<
 		{
 			repl_size_ = repl_size_detector_.estimated_size();
 
+			if (!replication_size_detector_traits<replication_size_detector_type>::retains_observations)
+			{
+				// Observations have already been accumulated by operator().
+				repl_size_detector_.reset();
+				return;
+			}
+
 			DCS_DEBUG_TRACE("(" << this << ") Detected replication size. Taking back " << repl_size_detector_.consumed_observations().size() << " observations consumed during replication size detection.");
 
 			// Replication size just detected.
@@ -612,6 +764,12 @@ class analyzable_statistic: public base_analyzable_statistic<
 
 	private: void do_reset()
 	{
+		// Pilot replications are run again for each simulation
+		num_pilots_done_ = max_pilot_trans_len_
+						 = fixed_trans_len_
+						 = uint_type(0);
+		warmup_fixed_ = false;
+
 		reset_for_replication();
 
 //[FIXME] 2011-05-22
@@ -730,6 +888,17 @@ class analyzable_statistic: public base_analyzable_statistic<
 //	private: value_type repl_mean_;
 	private: mean_estimator<value_type,uint_type> repl_mean_stat_;
 	private: value_type steady_start_time_;
+	/// The number of pilot replications (zero if pilot warm-up is disabled).
+	private: uint_type num_pilots_;
+	private: value_type pilot_safety_factor_;
+	private: uint_type num_pilots_done_;
+	private: uint_type max_pilot_trans_len_;
+	/// The truncation point estimated by pilot replications.
+	private: uint_type fixed_trans_len_;
+	/// Tells if the truncation point estimated by pilot replications is in use.
+	private: bool warmup_fixed_;
+	/// The number of observations deleted in the current replication.
+	private: uint_type num_deleted_;
 
 	//@} Data members
 };
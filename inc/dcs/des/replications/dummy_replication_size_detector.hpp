@@ -29,6 +29,7 @@
 #define DCS_DES_REPLICATIONS_DUMMY_REPLICATION_SIZE_DETECTOR_HPP
 
 
+#include <dcs/des/replications/replication_size_detector_traits.hpp>
 #include <dcs/macro.hpp>
 #include <utility>
 #include <vector>
@@ -75,7 +76,8 @@ class dummy_replication_size_detector
 	 */
 	public: bool detect(real_type obs, real_type weight)
 	{
-		obs_.push_back(::std::make_pair(obs, weight));
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( obs );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( weight );
 
 		return true;
 	}
@@ -109,7 +111,7 @@ class dummy_replication_size_detector
 	/// Reset the state of the detector.
 	public: void reset()
 	{
-		obs_.clear();
+		// empty
 	}
 
 
@@ -121,13 +123,22 @@ class dummy_replication_size_detector
 
 	public: vector_type consumed_observations() const
 	{
-		return obs_;
+		return vector_type();
 	}
+};
 
+/// Observations passed to \c detect are not retained.
+template <typename RealT, typename UIntT>
+struct replication_size_detector_traits< dummy_replication_size_detector<RealT,UIntT> >
+{
+	typedef dummy_replication_size_detector<RealT,UIntT> replication_size_detector_type;
 
-	private: vector_type obs_;
+	static const bool retains_observations = false;
 };
 
+template <typename RealT, typename UIntT>
+const bool replication_size_detector_traits< dummy_replication_size_detector<RealT,UIntT> >::retains_observations;
+
 }}} // Namespace dcs::des::replications
 
 
@@ -39,9 +39,11 @@
 #include <dcs/des/replications/dummy_num_replications_detector.hpp>
 #include <dcs/des/replications/dummy_replication_size_detector.hpp>
 #include <dcs/des/engine.hpp>
+#include <dcs/des/engine_diagnostics.hpp>
 #include <dcs/des/null_transient_detector.hpp>
 #include <dcs/des/output_analysis.hpp>
 #include <dcs/des/output_analysis_categories.hpp>
+#include <dcs/des/static_engine.hpp>
 //#include <dcs/des/spectral/pawlikowski1990_transient_detector.hpp>
 #include <dcs/exception.hpp>
 #include <dcs/functional/bind.hpp>
@@ -57,9 +59,9 @@ namespace dcs { namespace des {
 namespace replications {
 
 template <typename RealT, typename UIntT = std::size_t>
-class engine: public ::dcs::des::engine<RealT>
+class engine: public ::dcs::des::static_engine<engine<RealT,UIntT>,RealT>
 {
-	private: typedef ::dcs::des::engine<RealT> base_type;
+	private: typedef ::dcs::des::static_engine<engine<RealT,UIntT>,RealT> base_type;
 	private: typedef engine<RealT,UIntT> self_type;
 //	public: typedef TransientPhaseDetectorT transient_phase_detector_type;
 //	public: typedef ReplicationSizeDetectorT replication_size_detector_type;
@@ -75,6 +77,9 @@ class engine: public ::dcs::des::engine<RealT>
 	private: typedef typename base_type::analyzable_statistic_pointer analyzable_statistic_pointer;
 
 
+	friend class ::dcs::des::static_engine<engine<RealT,UIntT>,RealT>;
+
+
 	//public: static const size_type default_min_repl_size = 1000;
 	public: static const real_type default_min_repl_duration; // = 1000;
 	public: static const size_type default_min_num_replications = 5;
@@ -216,14 +221,6 @@ class engine: public ::dcs::des::engine<RealT>
 	}
 
 
-	protected: bool is_internal_event(event_type const& evt) const
-	{
-		return base_type::is_internal_event(evt)
-			   || evt.source() == *ptr_bor_evt_src_
-			   || evt.source() == *ptr_eor_evt_src_;
-	}
-
-
 	protected: void monitor_statistics_in_replication()
 	{
 		typedef typename base_type::analyzable_statistic_const_iterator stat_iterator;
@@ -327,6 +324,9 @@ class engine: public ::dcs::des::engine<RealT>
 
 	private: void init()
 	{
+		this->register_internal_event_source(ptr_bor_evt_src_);
+		this->register_internal_event_source(ptr_eor_evt_src_);
+
 		ptr_bor_evt_src_->connect(
 			::dcs::functional::bind(
 				&self_type::process_begin_of_replication,
@@ -354,105 +354,113 @@ class engine: public ::dcs::des::engine<RealT>
 	}
 
 
-	private: void do_run()
+	protected: void prepare_simulation(engine_context_type& ctx)
 	{
-		DCS_DEBUG_TRACE( "Begin SIMULATION" );
+		base_type::prepare_simulation(ctx);
 
-		engine_context_type ctx(this);
-
-		this->prepare_simulation(ctx);
 		end_of_repl_ = false;
 		repl_count_ = 0;
+	}
 
-		//while (repl_count_ < min_num_repl_)
-		while (!this->end_of_simulation())
-		{
-			++repl_count_;
 
-			DCS_DEBUG_TRACE(">> Begin REPLICATION #" << repl_count_ << " - Simulation time: " << this->simulated_time() << " - Min Duration: " << min_repl_duration_);
+	private: bool more_experiments() const
+	{
+		return !this->end_of_simulation();
+	}
 
-			prepare_replication(ctx);
 
-			while (!end_of_repl_ && !this->future_event_list().empty())
-			{
-				DCS_DEBUG_TRACE_L(1,  "Simulation time: " << this->simulated_time() );
+	private: void prepare_experiment(engine_context_type& ctx)
+	{
+		++repl_count_;
 
-				this->fire_next_event(ctx);
+		DCS_DEBUG_TRACE(">> Begin REPLICATION #" << repl_count_ << " - Simulation time: " << this->simulated_time() << " - Min Duration: " << min_repl_duration_);
 
-				// Monitor statistics
-				monitor_statistics_in_replication();
+		prepare_replication(ctx);
+	}
 
-				// Check if simulation has ended (e.g., it may happen if the
-				// client calls the stop_now or stop_at_time method).
-				if (this->end_of_simulation())
-				{
-					end_of_repl_ = true;
-				}
 
-				//FIXME: What should we do when the simulation is done but, for
-				//       instance, the replication is shorter than the specified
-				//       duration?
-				//       Maybe we should use another flag (e.g.,
-				//       forced_end_of_sim_) in order to distinguish the case of
-				//       "normal" and "user-requested" end of simulation.
-				//       Currently, we give priority to the replication length.
+	private: bool end_of_experiment() const
+	{
+		return end_of_repl_;
+	}
 
-				//if (end_of_repl_ && this->simulated_time() < min_repl_duration_)
-				if (end_of_repl_)
-				{
-					// Mkae sure to consume all concurrent events (i.e., events that fire now)
-					if (!this->future_event_list().empty())
-					{
-						if (this->future_event_list().top()->fire_time() == this->simulated_time())
-						{
-							end_of_repl_ = false;
-							this->end_of_simulation(false);
-						}
-					}
-					// Make sure that replication lasts the minimum set duration.
- 					if (this->simulated_time() < min_repl_duration_)
-					{
-						end_of_repl_ = false;
-						this->end_of_simulation(false);
-					}
-				}
-			}
 
-			if (!end_of_repl_ && this->future_event_list().empty())
-			{
-				::std::clog << "[Warning] Replication not ended but event list is empty: forcing end of replication." << ::std::endl;
-			}
+	private: void monitor_experiment()
+	{
+		// Monitor statistics
+		monitor_statistics_in_replication();
 
-			finalize_replication(ctx);
+		// Check if simulation has ended (e.g., it may happen if the
+		// client calls the stop_now or stop_at_time method).
+		if (this->end_of_simulation())
+		{
+			end_of_repl_ = true;
+		}
 
-			this->monitor_statistics();
+		//FIXME: What should we do when the simulation is done but, for
+		//       instance, the replication is shorter than the specified
+		//       duration?
+		//       Maybe we should use another flag (e.g.,
+		//       forced_end_of_sim_) in order to distinguish the case of
+		//       "normal" and "user-requested" end of simulation.
+		//       Currently, we give priority to the replication length.
 
-			// Check for end-of-simulation terminating conditions
-			if (this->end_of_simulation())
+		//if (end_of_repl_ && this->simulated_time() < min_repl_duration_)
+		if (end_of_repl_)
+		{
+			// Mkae sure to consume all concurrent events (i.e., events that fire now)
+			if (!this->future_event_list().empty())
 			{
-				// Make sure that simulation lasts the minimum set replication number.
-
-				if (repl_count_ < min_num_repl_)
+				if (this->is_concurrent_event(*(this->future_event_list().top())))
 				{
+					end_of_repl_ = false;
 					this->end_of_simulation(false);
 				}
 			}
-			else
+			// Make sure that replication lasts the minimum set duration.
+			if (this->simulated_time() < min_repl_duration_)
 			{
-				// Make sure that simulation does not take too long than necessary.
-
-				if (repl_count_ >= min_num_repl_ && this->monitored_statistics().empty())
-				{
-					this->end_of_simulation(true);
-				}
+				end_of_repl_ = false;
+				this->end_of_simulation(false);
 			}
+		}
+	}
 
-			DCS_DEBUG_TRACE(">> End REPLICATION #" << repl_count_ << " - Simulation time: " << this->simulated_time());
+
+	private: void finalize_experiment(engine_context_type& ctx)
+	{
+		if (!end_of_repl_
+			&& this->future_event_list().empty()
+			&& this->diagnostics().record(empty_event_list_diagnostic))
+		{
+			this->diagnostics().stream() << "[Warning] Replication not ended but event list is empty: forcing end of replication." << ::std::endl;
 		}
 
-		this->finalize_simulation(ctx);
+		finalize_replication(ctx);
+
+		this->monitor_statistics();
+
+		// Check for end-of-simulation terminating conditions
+		if (this->end_of_simulation())
+		{
+			// Make sure that simulation lasts the minimum set replication number.
+
+			if (repl_count_ < min_num_repl_)
+			{
+				this->end_of_simulation(false);
+			}
+		}
+		else
+		{
+			// Make sure that simulation does not take too long than necessary.
+
+			if (repl_count_ >= min_num_repl_ && this->monitored_statistics().empty())
+			{
+				this->end_of_simulation(true);
+			}
+		}
 
-		DCS_DEBUG_TRACE( "End SIMULATION" );
+		DCS_DEBUG_TRACE(">> End REPLICATION #" << repl_count_ << " - Simulation time: " << this->simulated_time());
 	}
 
 
@@ -32,6 +32,8 @@
 #include <boost/smart_ptr.hpp>
 #include <cstddef>
 #include <dcs/debug.hpp>
+#include <dcs/des/replications/replication_size_detector_traits.hpp>
+#include <dcs/macro.hpp>
 #include <dcs/math/constants.hpp>
 #include <utility>
 #include <vector>
@@ -70,7 +72,8 @@ class fixed_duration_replication_size_detector
 	public: fixed_duration_replication_size_detector(real_type time,
 													 des_engine_type* ptr_engine)
 	: max_duration_(time),
-	  ptr_eng_(ptr_engine)
+	  ptr_eng_(ptr_engine),
+	  num_obs_(0)
 	{
 		// empty
 	}
@@ -79,7 +82,8 @@ class fixed_duration_replication_size_detector
 	public: fixed_duration_replication_size_detector(real_type time,
 													 boost::shared_ptr<des_engine_type> const& ptr_engine)
 	: max_duration_(time),
-	  ptr_eng_(ptr_engine.get())
+	  ptr_eng_(ptr_engine.get()),
+	  num_obs_(0)
 	{
 		// empty
 	}
@@ -92,7 +96,10 @@ class fixed_duration_replication_size_detector
 	 */
 	public: bool detect(real_type obs, real_type weight)
 	{
-		obs_.push_back(::std::make_pair(obs, weight));
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( obs );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( weight );
+
+		++num_obs_;
 
 //		detected_ = ptr_eng_->simulated_time() >= max_duration_;
 
@@ -133,19 +140,20 @@ class fixed_duration_replication_size_detector
 	{
 //		detect_aborted_ = detected_
 //						= false;
-		obs_.clear();
+		num_obs_ = 0;
 	}
 
 
 	public: uint_type estimated_size() const
 	{
-		return obs_.size();
+		return num_obs_;
 	}
 
 
+	/// Observations are not retained, thus there is nothing to take back.
 	public: vector_type consumed_observations() const
 	{
-		return obs_;
+		return vector_type();
 	}
 
 
@@ -157,10 +165,23 @@ class fixed_duration_replication_size_detector
 //	private: bool detect_aborted_;
 //	/// Tells if replication size has been detected.
 //	private: bool detected_;
-	private: vector_type obs_;
+	/// Number of observations seen during detection.
+	private: uint_type num_obs_;
+
+};
 
+/// Observations passed to \c detect are only counted, not retained.
+template <typename RealT, typename UIntT, typename DesEngineT>
+struct replication_size_detector_traits< fixed_duration_replication_size_detector<RealT,UIntT,DesEngineT> >
+{
+	typedef fixed_duration_replication_size_detector<RealT,UIntT,DesEngineT> replication_size_detector_type;
+
+	static const bool retains_observations = false;
 };
 
+template <typename RealT, typename UIntT, typename DesEngineT>
+const bool replication_size_detector_traits< fixed_duration_replication_size_detector<RealT,UIntT,DesEngineT> >::retains_observations;
+
 }}} // Namespace dcs::des::replications
 
 
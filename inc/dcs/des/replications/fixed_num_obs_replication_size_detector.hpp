@@ -31,6 +31,8 @@
 
 #include <cstddef>
 #include <dcs/debug.hpp>
+#include <dcs/des/replications/replication_size_detector_traits.hpp>
+#include <dcs/macro.hpp>
 #include <dcs/math/constants.hpp>
 #include <utility>
 #include <vector>
@@ -85,7 +87,8 @@ class fixed_num_obs_replication_size_detector
 	 */
 	public: bool detect(real_type obs, real_type weight)
 	{
-		obs_.push_back(::std::make_pair(obs, weight));
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( obs );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( weight );
 
 //NOTE: we already know how many observations to collect.
 //      So it is useless to store all the observations until the wanted number
@@ -131,7 +134,6 @@ class fixed_num_obs_replication_size_detector
 	{
 //		detect_aborted_ = detected_
 //		detect_aborted_ = false;
-		obs_.clear();
 	}
 
 
@@ -142,9 +144,10 @@ class fixed_num_obs_replication_size_detector
 	}
 
 
+	/// Observations are not retained, thus there is nothing to take back.
 	public: vector_type consumed_observations() const
 	{
-		return obs_;
+		return vector_type();
 	}
 
 
@@ -155,12 +158,23 @@ class fixed_num_obs_replication_size_detector
 //	private: bool detect_aborted_;
 //	/// Tells if replication size has been detected.
 //	private: bool detected_;
-	private: vector_type obs_;
 };
 
 template <typename RealT, typename UIntT>
 const UIntT fixed_num_obs_replication_size_detector<RealT,UIntT>::num_obs_infinity = ::dcs::math::constants::infinity<UIntT>::value;
 
+/// Observations passed to \c detect are only counted, not retained.
+template <typename RealT, typename UIntT>
+struct replication_size_detector_traits< fixed_num_obs_replication_size_detector<RealT,UIntT> >
+{
+	typedef fixed_num_obs_replication_size_detector<RealT,UIntT> replication_size_detector_type;
+
+	static const bool retains_observations = false;
+};
+
+template <typename RealT, typename UIntT>
+const bool replication_size_detector_traits< fixed_num_obs_replication_size_detector<RealT,UIntT> >::retains_observations;
+
 }}} // Namespace dcs::des::replications
 
 
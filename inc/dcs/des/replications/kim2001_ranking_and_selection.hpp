@@ -0,0 +1,431 @@
+/**
+ * \file dcs/des/replications/kim2001_ranking_and_selection.hpp
+ *
+ * \brief Fully sequential ranking-and-selection procedure KN (and its variant
+ *  KN++) for selecting the best among competing system designs.
+ *
+ * References:
+ * - S.-H. Kim and B.L. Nelson.
+ *   "A Fully Sequential Procedure for Indifference-Zone Selection in
+ *   Simulation"
+ *   ACM Transactions on Modeling and Computer Simulation, 11(3):251-273, 2001
+ * - S.-H. Kim and B.L. Nelson.
+ *   "On the Asymptotic Validity of Fully Sequential Selection Procedures for
+ *   Steady-State Simulation"
+ *   Operations Research, 54(3):475-488, 2006
+ * .
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_REPLICATIONS_KIM2001_RANKING_AND_SELECTION_HPP
+#define DCS_DES_REPLICATIONS_KIM2001_RANKING_AND_SELECTION_HPP
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <dcs/assert.hpp>
+#include <dcs/debug.hpp>
+#include <dcs/math/constants.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace replications {
+
+/**
+ * \brief Fully sequential ranking-and-selection procedure KN (and its variant
+ *  KN++) for selecting the best among competing system designs.
+ *
+ * \tparam RealT The type used for real numbers.
+ * \tparam UIntT The type used for unsigned integral numbers.
+ *
+ * Given \f$k\f$ designs (e.g., alternative routing probabilities or numbers of
+ * servers of the same queueing network), the procedure selects the one with
+ * the largest (or smallest) mean performance, such that the probability of
+ * correct selection is at least the given confidence level whenever the best
+ * design is better than the others by at least the indifference-zone
+ * parameter \f$\delta\f$.
+ *
+ * After \f$n_0\f$ initial replications of every design, the procedure runs
+ * one more replication of every surviving design per round, and eliminates the
+ * designs whose sample mean falls clearly behind the one of another surviving
+ * design; thus, simulation effort concentrates on the designs still in
+ * contention.
+ * The elimination threshold of each pair of designs depends on the sample
+ * variance of their differences, which is estimated on the first \f$n_0\f$
+ * replications (KN) or updated after every round (KN++, which is also
+ * asymptotically valid for steady-state simulations whose replications are
+ * batch means).
+ *
+ * Replications are run by the function object given to \c run, called as
+ * <tt>fun(design, replication)</tt>; it must run the given replication of the
+ * given design (e.g., through a replications engine whose number of
+ * replications is one, or by consuming the replicate means produced by the
+ * end-of-replication event of a long-lived engine) and return its output.
+ * Using the same random number seed for the same replication number of every
+ * design (i.e., common random numbers) is allowed and usually reduces the
+ * number of replications needed.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename RealT=double, typename UIntT=::std::size_t>
+class kim2001_ranking_and_selection
+{
+	public: typedef RealT real_type;
+	public: typedef UIntT uint_type;
+	public: typedef ::std::size_t size_type;
+
+
+	public: static const uint_type default_num_initial_replications = 10;
+	public: static const real_type default_confidence_level; // = 0.95
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param num_designs The number of competing designs.
+	 * \param indifference_zone The smallest difference in mean performance
+	 *  worth detecting.
+	 * \param confidence_level The minimum probability of correct selection.
+	 * \param num_init_repl The number of initial replications of every design.
+	 * \param maximize Tells if the best design is the one with the largest
+	 *  mean (\c true) or the smallest one (\c false).
+	 */
+	public: kim2001_ranking_and_selection(size_type num_designs,
+										  real_type indifference_zone,
+										  real_type confidence_level = default_confidence_level,
+										  uint_type num_init_repl = default_num_initial_replications,
+										  bool maximize = true)
+	: k_(num_designs),
+	  delta_(indifference_zone),
+	  ci_level_(confidence_level),
+	  n0_(num_init_repl),
+	  maximize_(maximize),
+	  var_update_(false),
+	  r_(0),
+	  tot_num_repl_(0)
+	{
+		// pre: num_designs >= 2
+		DCS_ASSERT(
+			num_designs >= 2,
+			throw ::std::invalid_argument("[dcs::des::replications::kim2001_ranking_and_selection::ctor] Number of designs must be at least 2.")
+		);
+		// pre: indifference_zone > 0
+		DCS_ASSERT(
+			indifference_zone > 0,
+			throw ::std::invalid_argument("[dcs::des::replications::kim2001_ranking_and_selection::ctor] Indifference-zone parameter must be a positive number.")
+		);
+		// pre: 1/k < confidence_level < 1
+		DCS_ASSERT(
+			confidence_level > (real_type(1)/real_type(num_designs)) && confidence_level < 1,
+			throw ::std::invalid_argument("[dcs::des::replications::kim2001_ranking_and_selection::ctor] Confidence level must be in (1/k,1).")
+		);
+		// pre: num_init_repl >= 2
+		DCS_ASSERT(
+			num_init_repl >= 2,
+			throw ::std::invalid_argument("[dcs::des::replications::kim2001_ranking_and_selection::ctor] Number of initial replications must be at least 2.")
+		);
+
+		reset();
+	}
+
+
+	/// Update the variances of differences after every round (KN++).
+	public: void enable_variance_update()
+	{
+		var_update_ = true;
+	}
+
+
+	/// Estimate the variances of differences on the initial replications
+	/// only (KN).
+	public: void disable_variance_update()
+	{
+		var_update_ = false;
+	}
+
+
+	public: bool variance_update_enabled() const
+	{
+		return var_update_;
+	}
+
+
+	/**
+	 * \brief Run the procedure.
+	 *
+	 * \param fun The function object running replications.
+	 * \param max_num_repl The maximum number of replications of each design;
+	 *  when reached, the surviving design with the best sample mean is
+	 *  selected.
+	 * \return The index of the selected design.
+	 */
+	public: template <typename FuncT>
+		size_type run(FuncT fun, uint_type max_num_repl = ::dcs::math::constants::infinity<uint_type>::value)
+	{
+		// pre: max_num_repl >= num_init_repl
+		DCS_ASSERT(
+			max_num_repl >= n0_,
+			throw ::std::invalid_argument("[dcs::des::replications::kim2001_ranking_and_selection::run] Maximum number of replications must not be less than the number of initial replications.")
+		);
+
+		reset();
+
+		// Initial stage
+		while (r_ < n0_)
+		{
+			run_round(fun);
+		}
+		if (!var_update_)
+		{
+			// KN: variances and threshold are fixed after the initial stage
+			h2_ = threshold(n0_);
+			s2_fixed_ = s2_;
+		}
+
+		screen();
+
+		// Sequential stages
+		while (num_surviving() > 1 && r_ < max_num_repl)
+		{
+			run_round(fun);
+			screen();
+		}
+
+		return selected();
+	}
+
+
+	/// Tell if the given design is still in contention.
+	public: bool surviving(size_type design) const
+	{
+		return alive_[design];
+	}
+
+
+	public: size_type num_surviving() const
+	{
+		return static_cast<size_type>(::std::count(alive_.begin(), alive_.end(), true));
+	}
+
+
+	/// Return the surviving design with the best sample mean.
+	public: size_type selected() const
+	{
+		size_type best(k_);
+		for (size_type i = 0; i < k_; ++i)
+		{
+			if (alive_[i] && (best == k_ || sums_[i] > sums_[best]))
+			{
+				best = i;
+			}
+		}
+		return best;
+	}
+
+
+	public: size_type num_designs() const
+	{
+		return k_;
+	}
+
+
+	/// Return the number of replications of the given design.
+	public: uint_type num_replications(size_type design) const
+	{
+		return num_repl_[design];
+	}
+
+
+	/// Return the number of replications over all the designs.
+	public: uint_type total_num_replications() const
+	{
+		return tot_num_repl_;
+	}
+
+
+	/// Return the sample mean of the given design.
+	public: real_type estimate(size_type design) const
+	{
+		if (num_repl_[design] == 0)
+		{
+			return ::std::numeric_limits<real_type>::quiet_NaN();
+		}
+
+		real_type mean(sums_[design]/static_cast<real_type>(num_repl_[design]));
+
+		return maximize_ ? mean : -mean;
+	}
+
+
+	private: void reset()
+	{
+		r_ = 0;
+		tot_num_repl_ = 0;
+		h2_ = 0;
+		alive_.assign(k_, true);
+		num_repl_.assign(k_, 0);
+		sums_.assign(k_, 0);
+		obs_.assign(k_, 0);
+		diff_means_.assign(k_*k_, 0);
+		s2_.assign(k_*k_, 0);
+		s2_fixed_.clear();
+	}
+
+
+	/// Run one replication of every surviving design.
+	private: template <typename FuncT>
+		void run_round(FuncT& fun)
+	{
+		for (size_type i = 0; i < k_; ++i)
+		{
+			if (alive_[i])
+			{
+				real_type x(fun(i, static_cast<uint_type>(r_)));
+
+				obs_[i] = maximize_ ? x : -x;
+				sums_[i] += obs_[i];
+				++num_repl_[i];
+				++tot_num_repl_;
+			}
+		}
+
+		++r_;
+
+		// Update the (Welford) sample variance of differences of the pairs
+		// still in contention; with KN, only the initial stage is needed.
+		if (var_update_ || r_ <= n0_)
+		{
+			const real_type n(static_cast<real_type>(r_));
+
+			for (size_type i = 0; i < k_; ++i)
+			{
+				if (!alive_[i])
+				{
+					continue;
+				}
+				for (size_type l = i+1; l < k_; ++l)
+				{
+					if (!alive_[l])
+					{
+						continue;
+					}
+
+					const size_type p(i*k_+l);
+					const real_type d(obs_[i]-obs_[l]);
+					const real_type delta(d-diff_means_[p]);
+
+					diff_means_[p] += delta/n;
+					// s2_ holds the sum of squared deviations
+					s2_[p] += delta*(d-diff_means_[p]);
+				}
+			}
+		}
+	}
+
+
+	/// Eliminate the designs clearly inferior to another surviving design.
+	private: void screen()
+	{
+		const real_type r(static_cast<real_type>(r_));
+		const real_type h2(var_update_ ? threshold(r_) : h2_);
+		const ::std::vector<real_type>& s2(var_update_ ? s2_ : s2_fixed_);
+		const uint_type df(var_update_ ? r_-1 : n0_-1);
+
+		::std::vector<bool> old_alive(alive_);
+
+		for (size_type i = 0; i < k_; ++i)
+		{
+			if (!old_alive[i])
+			{
+				continue;
+			}
+			for (size_type l = 0; l < k_; ++l)
+			{
+				if (l == i || !old_alive[l])
+				{
+					continue;
+				}
+
+				const size_type p(i < l ? i*k_+l : l*k_+i);
+				const real_type s2_il(s2[p]/static_cast<real_type>(df));
+				const real_type w(::std::max(real_type(0), delta_/(2*r)*(h2*s2_il/(delta_*delta_)-r)));
+
+				if (sums_[i]/r < sums_[l]/r-w)
+				{
+					DCS_DEBUG_TRACE("[dcs::des::replications::kim2001_ranking_and_selection] Round " << r_ << ": design #" << i << " eliminated by design #" << l);
+
+					alive_[i] = false;
+					break;
+				}
+			}
+		}
+	}
+
+
+	/// Return the threshold constant \f$h^2\f$ for the given number of
+	/// replications.
+	private: real_type threshold(uint_type n) const
+	{
+		const real_type nu(static_cast<real_type>(n-1));
+		const real_type alpha(1-ci_level_);
+		const real_type eta(real_type(0.5)*(::std::pow(2*alpha/static_cast<real_type>(k_-1), -2/nu)-1));
+
+		return 2*eta*nu;
+	}
+
+
+	private: size_type k_;
+	private: real_type delta_;
+	private: real_type ci_level_;
+	private: uint_type n0_;
+	private: bool maximize_;
+	private: bool var_update_;
+	/// The number of replications of every surviving design.
+	private: uint_type r_;
+	private: uint_type tot_num_repl_;
+	private: real_type h2_;
+	private: ::std::vector<bool> alive_;
+	private: ::std::vector<uint_type> num_repl_;
+	/// Sums of observations (negated when minimizing).
+	private: ::std::vector<real_type> sums_;
+	/// Observations of the last round.
+	private: ::std::vector<real_type> obs_;
+	/// Means of differences of each pair (i<l) of designs.
+	private: ::std::vector<real_type> diff_means_;
+	/// Sums of squared deviations of differences of each pair (i<l).
+	private: ::std::vector<real_type> s2_;
+	/// The sums of squared deviations of the initial stage (KN).
+	private: ::std::vector<real_type> s2_fixed_;
+};
+
+
+template <typename RealT, typename UIntT>
+const RealT kim2001_ranking_and_selection<RealT,UIntT>::default_confidence_level = 0.95;
+
+}}} // Namespace dcs::des::replications
+
+
+#endif // DCS_DES_REPLICATIONS_KIM2001_RANKING_AND_SELECTION_HPP
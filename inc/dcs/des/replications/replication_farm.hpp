@@ -0,0 +1,754 @@
+/**
+ * \file dcs/des/replications/replication_farm.hpp
+ *
+ * \brief Farm of worker processes running independent replications.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_REPLICATIONS_REPLICATION_FARM_HPP
+#define DCS_DES_REPLICATIONS_REPLICATION_FARM_HPP
+
+
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <dcs/assert.hpp>
+#include <dcs/debug.hpp>
+#include <dcs/des/base_statistic.hpp>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/random_substream.hpp>
+#include <dcs/des/replications/banks2005_num_replications_detector.hpp>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <poll.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+
+namespace dcs { namespace des { namespace replications {
+
+/**
+ * \brief Farm of worker processes running independent replications.
+ *
+ * \tparam RealT The type used for real numbers.
+ * \tparam UIntT The type used for unsigned integral numbers.
+ * \tparam NumReplicationsDetectorT The type of the number of replications
+ *  detector.
+ *
+ * The coordinator (i.e., the calling process) forks the given number of
+ * worker processes, each connected to the coordinator by a Unix socket pair.
+ * Workers run the replications assigned by the coordinator and send back the
+ * replicate mean of each of them.
+ * Since every worker has its own address space, models which are not
+ * thread-safe (e.g., because of static members such as event identifiers) can
+ * be run in parallel, and a crashing replication does not bring the whole
+ * simulation down.
+ *
+ * Replications are run by the function object given to \c run, called in a
+ * worker as <tt>fun(replication, seed)</tt>; it must build the model (e.g., on
+ * top of a replications engine with a single replication), run the given
+ * replication with a random number generator seeded by \c seed and return its
+ * replicate mean.
+ * Seeds are derived from the base seed and the replication number by
+ * \c substream_seed.
+ *
+ * The coordinator applies the same stopping logic of the analyzable
+ * statistics of the replications engine: the number of replications is
+ * detected by the given detector and replications go on until the target
+ * relative precision is reached (or the detector gives up), then a stop
+ * command is sent to all the workers.
+ * Replicate means are consumed in replication order, so that the outcome only
+ * depends on the base seed (and not on the number of workers nor on their
+ * speed); replications run ahead by idle workers and not needed by the
+ * stopping rule are discarded.
+ *
+ * A worker that dies while running a replication is replaced by a new one and
+ * the replication is run again (with the same seed) up to the given number of
+ * retries.
+ * A replication throwing an exception makes the run fail.
+ *
+ * \note This class requires a POSIX system.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <
+	typename RealT=double,
+	typename UIntT=::std::size_t,
+	typename NumReplicationsDetectorT=banks2005_num_replications_detector<RealT,UIntT>
+>
+class replication_farm
+{
+	public: typedef RealT real_type;
+	public: typedef UIntT uint_type;
+	public: typedef ::std::size_t size_type;
+	public: typedef unsigned long seed_type;
+	public: typedef NumReplicationsDetectorT num_replications_detector_type;
+	private: typedef ::boost::uint64_t index_type;
+
+
+	public: static const seed_type default_seed = 5489UL;
+	public: static const uint_type default_min_num_replications = 2;
+	public: static const uint_type default_max_num_retries = 1;
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param num_workers The number of worker processes.
+	 * \param relative_precision The target relative precision of the
+	 *  confidence interval of the replicate means.
+	 * \param ci_level The level of the confidence interval.
+	 * \param min_num_repl The minimum number of replications to run.
+	 * \param seed The base seed.
+	 *
+	 * The number of replications detector is built for the same confidence
+	 * level, relative precision and minimum number of replications.
+	 */
+	public: explicit replication_farm(size_type num_workers,
+									  real_type relative_precision,
+									  real_type ci_level = base_statistic<real_type,uint_type>::default_confidence_level,
+									  uint_type min_num_repl = default_min_num_replications,
+									  seed_type seed = default_seed)
+	: num_workers_(num_workers),
+	  target_rel_prec_(relative_precision),
+	  num_repl_detector_(ci_level, relative_precision, min_num_repl),
+	  min_num_repl_(min_num_repl),
+	  seed_(seed),
+	  max_num_retries_(default_max_num_retries),
+	  stat_(ci_level),
+	  num_repl_(0),
+	  num_repl_detected_(false),
+	  prec_reached_(false),
+	  done_(false),
+	  num_crashes_(0),
+	  next_index_(0)
+	{
+		check_arguments(num_workers, relative_precision, min_num_repl);
+	}
+
+
+	/**
+	 * \brief A constructor.
+	 *
+	 * \param num_workers The number of worker processes.
+	 * \param relative_precision The target relative precision of the
+	 *  confidence interval of the replicate means.
+	 * \param num_repl_detector The number of replications detector (which
+	 *  should target the same relative precision).
+	 * \param ci_level The level of the confidence interval.
+	 * \param min_num_repl The minimum number of replications to run.
+	 * \param seed The base seed.
+	 */
+	public: replication_farm(size_type num_workers,
+							 real_type relative_precision,
+							 num_replications_detector_type const& num_repl_detector,
+							 real_type ci_level = base_statistic<real_type,uint_type>::default_confidence_level,
+							 uint_type min_num_repl = default_min_num_replications,
+							 seed_type seed = default_seed)
+	: num_workers_(num_workers),
+	  target_rel_prec_(relative_precision),
+	  num_repl_detector_(num_repl_detector),
+	  min_num_repl_(min_num_repl),
+	  seed_(seed),
+	  max_num_retries_(default_max_num_retries),
+	  stat_(ci_level),
+	  num_repl_(0),
+	  num_repl_detected_(false),
+	  prec_reached_(false),
+	  done_(false),
+	  num_crashes_(0),
+	  next_index_(0)
+	{
+		check_arguments(num_workers, relative_precision, min_num_repl);
+	}
+
+
+	public: ~replication_farm()
+	{
+		shutdown();
+	}
+
+
+	/// Set the number of times a replication is run again after the crash
+	/// of its worker.
+	public: void max_num_retries(uint_type n)
+	{
+		max_num_retries_ = n;
+	}
+
+
+	public: uint_type max_num_retries() const
+	{
+		return max_num_retries_;
+	}
+
+
+	/**
+	 * \brief Run replications until the stopping rule is satisfied.
+	 *
+	 * \return \c true if the target relative precision has been reached.
+	 */
+	public: template <typename FuncT>
+		bool run(FuncT fun)
+	{
+		reset();
+
+		for (size_type w = 0; w < num_workers_; ++w)
+		{
+			spawn(fun, w);
+		}
+
+		::std::vector<pollfd> fds;
+
+		while (!done_)
+		{
+			dispatch();
+
+			fds.clear();
+			for (size_type w = 0; w < workers_.size(); ++w)
+			{
+				if (workers_[w].busy)
+				{
+					pollfd pfd;
+					pfd.fd = workers_[w].fd;
+					pfd.events = POLLIN;
+					pfd.revents = 0;
+					fds.push_back(pfd);
+				}
+			}
+
+			if (fds.empty())
+			{
+				fail("no replication to wait for");
+			}
+
+			if (::poll(&fds[0], fds.size(), -1) < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				fail("poll failed");
+			}
+
+			for (size_type k = 0; k < fds.size() && !done_; ++k)
+			{
+				if (fds[k].revents == 0)
+				{
+					continue;
+				}
+
+				size_type w(worker_by_fd(fds[k].fd));
+				response msg;
+
+				if (read_all(fds[k].fd, &msg, sizeof(msg)))
+				{
+					workers_[w].busy = false;
+
+					if (msg.status != 0)
+					{
+						fail(::std::string("replication failed: ") + msg.what);
+					}
+
+					pending_[msg.index] = msg.value;
+					consume();
+				}
+				else
+				{
+					respawn(fun, w);
+				}
+			}
+		}
+
+		shutdown();
+
+		return prec_reached_;
+	}
+
+
+	/// Return the number of replications used by the estimate.
+	public: uint_type num_replications() const
+	{
+		return stat_.num_observations();
+	}
+
+
+	/// Return the number of worker crashes.
+	public: uint_type num_crashes() const
+	{
+		return num_crashes_;
+	}
+
+
+	public: bool target_precision_reached() const
+	{
+		return prec_reached_;
+	}
+
+
+	public: real_type estimate() const
+	{
+		return stat_.estimate();
+	}
+
+
+	public: real_type standard_deviation() const
+	{
+		return stat_.standard_deviation();
+	}
+
+
+	public: real_type half_width() const
+	{
+		return stat_.half_width();
+	}
+
+
+	public: real_type relative_precision() const
+	{
+		return stat_.relative_precision();
+	}
+
+
+	/// Command sent by the coordinator (the maximum index means stop).
+	private: struct request
+	{
+		index_type index;
+	};
+
+
+	/// Replicate summary sent by a worker.
+	private: struct response
+	{
+		index_type index;
+		real_type value;
+		int status;
+		char what[256];
+	};
+
+
+	private: struct worker
+	{
+		pid_t pid;
+		int fd;
+		bool busy;
+		index_type index;
+	};
+
+
+	private: static void check_arguments(size_type num_workers, real_type relative_precision, uint_type min_num_repl)
+	{
+		// pre: num_workers > 0
+		DCS_ASSERT(
+			num_workers > 0,
+			throw ::std::invalid_argument("[dcs::des::replications::replication_farm::ctor] Number of workers must be a positive number.")
+		);
+		// pre: relative_precision > 0
+		DCS_ASSERT(
+			relative_precision > 0,
+			throw ::std::invalid_argument("[dcs::des::replications::replication_farm::ctor] Relative precision must be a positive number.")
+		);
+		// pre: min_num_repl >= 2
+		DCS_ASSERT(
+			min_num_repl >= 2,
+			throw ::std::invalid_argument("[dcs::des::replications::replication_farm::ctor] Minimum number of replications must be at least 2.")
+		);
+	}
+
+
+	private: static index_type stop_index()
+	{
+		return ~index_type(0);
+	}
+
+
+	private: void reset()
+	{
+		shutdown();
+
+		num_repl_detector_.reset();
+		stat_.reset();
+		num_repl_ = min_num_repl_;
+		num_repl_detected_ = false;
+		prec_reached_ = false;
+		done_ = false;
+		num_crashes_ = 0;
+		next_index_ = 0;
+		retry_.clear();
+		num_retries_.clear();
+		pending_.clear();
+	}
+
+
+	private: template <typename FuncT>
+		void spawn(FuncT& fun, size_type w)
+	{
+		int sv[2];
+		if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+		{
+			fail("socketpair failed");
+		}
+
+		pid_t pid(::fork());
+		if (pid < 0)
+		{
+			::close(sv[0]);
+			::close(sv[1]);
+			fail("fork failed");
+		}
+
+		if (pid == 0)
+		{
+			// Worker: drop the coordinator ends of all the sockets
+			::close(sv[0]);
+			for (size_type i = 0; i < workers_.size(); ++i)
+			{
+				if (workers_[i].fd >= 0)
+				{
+					::close(workers_[i].fd);
+				}
+			}
+
+			serve(fun, sv[1]);
+
+			// Do not run the destructors and exit handlers of the coordinator
+			::_exit(0);
+		}
+
+		::close(sv[1]);
+
+		worker wk;
+		wk.pid = pid;
+		wk.fd = sv[0];
+		wk.busy = false;
+		wk.index = 0;
+
+		if (w < workers_.size())
+		{
+			workers_[w] = wk;
+		}
+		else
+		{
+			workers_.push_back(wk);
+		}
+	}
+
+
+	/// Replace a dead worker and reschedule its replication.
+	private: template <typename FuncT>
+		void respawn(FuncT& fun, size_type w)
+	{
+		::close(workers_[w].fd);
+		::waitpid(workers_[w].pid, 0, 0);
+		workers_[w].fd = -1;
+
+		++num_crashes_;
+
+		if (workers_[w].busy)
+		{
+			index_type i(workers_[w].index);
+
+			::std::clog << "[Warning] Worker running replication #" << i << " died." << ::std::endl;
+
+			if (num_retries_[i]++ >= max_num_retries_)
+			{
+				fail("worker died too many times");
+			}
+			retry_.push_front(i);
+		}
+
+		spawn(fun, w);
+	}
+
+
+	/// The loop of a worker process.
+	private: template <typename FuncT>
+		void serve(FuncT& fun, int fd)
+	{
+		request req;
+
+		while (read_all(fd, &req, sizeof(req)) && req.index != stop_index())
+		{
+			response msg;
+			::std::memset(&msg, 0, sizeof(msg));
+			msg.index = req.index;
+
+			try
+			{
+				msg.value = fun(static_cast<uint_type>(req.index), ::dcs::des::substream_seed(seed_, static_cast<size_type>(req.index)));
+			}
+			catch (::std::exception const& e)
+			{
+				msg.status = 1;
+				::std::strncpy(msg.what, e.what(), sizeof(msg.what)-1);
+			}
+			catch (...)
+			{
+				msg.status = 1;
+				::std::strncpy(msg.what, "unknown error", sizeof(msg.what)-1);
+			}
+
+			if (!write_all(fd, &msg, sizeof(msg)))
+			{
+				break;
+			}
+		}
+
+		::close(fd);
+	}
+
+
+	/// Assign a replication to every idle worker.
+	private: void dispatch()
+	{
+		// Do not run too much ahead of the replications consumed so far
+		const index_type max_index(static_cast<index_type>(stat_.num_observations())+2*num_workers_);
+
+		for (size_type w = 0; w < workers_.size(); ++w)
+		{
+			if (workers_[w].busy)
+			{
+				continue;
+			}
+
+			index_type i(0);
+			if (!retry_.empty())
+			{
+				i = retry_.front();
+				retry_.pop_front();
+			}
+			else if (next_index_ < max_index)
+			{
+				i = next_index_++;
+			}
+			else
+			{
+				break;
+			}
+
+			request req;
+			req.index = i;
+
+			workers_[w].busy = true;
+			workers_[w].index = i;
+
+			if (!write_all(workers_[w].fd, &req, sizeof(req)))
+			{
+				// The worker is dead: it will be detected by poll.
+				DCS_DEBUG_TRACE("[dcs::des::replications::replication_farm] Unable to send replication #" << i << " to worker " << workers_[w].pid);
+			}
+		}
+	}
+
+
+	/// Feed the stopping rule with the replicate means in replication order.
+	private: void consume()
+	{
+		typename ::std::map<index_type,real_type>::iterator it;
+
+		while (!done_
+			   && (it = pending_.find(static_cast<index_type>(stat_.num_observations()))) != pending_.end())
+		{
+			stat_(it->second);
+			pending_.erase(it);
+
+			check_stopping_rule();
+		}
+	}
+
+
+	/// Apply the stopping rule of the analyzable statistics of the
+	/// replications engine.
+	private: void check_stopping_rule()
+	{
+		const uint_type n(stat_.num_observations());
+
+		prec_reached_ = false;
+
+		if (num_repl_detected_ && n >= num_repl_)
+		{
+			prec_reached_ = stat_.relative_precision() <= target_rel_prec_;
+		}
+
+		if (!num_repl_detected_ || (n >= num_repl_ && !prec_reached_))
+		{
+			num_repl_detected_ = num_repl_detector_.detect(n, stat_.estimate(), stat_.standard_deviation());
+
+			if (num_repl_detected_)
+			{
+				if (num_repl_ < num_repl_detector_.estimated_number())
+				{
+					num_repl_ = ::std::max(num_repl_detector_.estimated_number(), min_num_repl_);
+				}
+				else if (num_repl_ <= n && !prec_reached_)
+				{
+					::std::clog << "[Warning] Replication farm will be stopped: unable to reach the wanted precision." << ::std::endl;
+
+					done_ = true;
+				}
+			}
+			else if (num_repl_detector_.aborted())
+			{
+				::std::clog << "[Warning] Replication farm will be stopped: number of replications detection has been aborted." << ::std::endl;
+
+				done_ = true;
+			}
+		}
+
+		if (prec_reached_)
+		{
+			done_ = true;
+		}
+
+		DCS_DEBUG_TRACE("[dcs::des::replications::replication_farm] Replication #" << n << " -- Estimate: " << stat_.estimate() << " (r.e. " << stat_.relative_precision() << ") -- Needed: " << num_repl_ << " -- Done: " << done_);
+	}
+
+
+	/// Broadcast the stop command and wait for all the workers to exit.
+	private: void shutdown()
+	{
+		request req;
+		req.index = stop_index();
+
+		for (size_type w = 0; w < workers_.size(); ++w)
+		{
+			if (workers_[w].fd >= 0)
+			{
+				write_all(workers_[w].fd, &req, sizeof(req));
+			}
+		}
+		for (size_type w = 0; w < workers_.size(); ++w)
+		{
+			if (workers_[w].fd >= 0)
+			{
+				::close(workers_[w].fd);
+				::waitpid(workers_[w].pid, 0, 0);
+			}
+		}
+
+		workers_.clear();
+	}
+
+
+	private: void fail(::std::string const& msg)
+	{
+		shutdown();
+
+		throw ::std::runtime_error("[dcs::des::replications::replication_farm::run] " + msg + ".");
+	}
+
+
+	private: size_type worker_by_fd(int fd) const
+	{
+		size_type w(0);
+		while (w < workers_.size() && workers_[w].fd != fd)
+		{
+			++w;
+		}
+		return w;
+	}
+
+
+	private: static bool read_all(int fd, void* buf, size_type n)
+	{
+		char* p(static_cast<char*>(buf));
+
+		while (n > 0)
+		{
+			ssize_t k(::read(fd, p, n));
+			if (k < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (k <= 0)
+			{
+				return false;
+			}
+			p += k;
+			n -= static_cast<size_type>(k);
+		}
+
+		return true;
+	}
+
+
+	private: static bool write_all(int fd, void const* buf, size_type n)
+	{
+		char const* p(static_cast<char const*>(buf));
+
+		while (n > 0)
+		{
+			// Do not raise SIGPIPE if the other end is gone
+			ssize_t k(::send(fd, p, n, MSG_NOSIGNAL));
+			if (k < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (k <= 0)
+			{
+				return false;
+			}
+			p += k;
+			n -= static_cast<size_type>(k);
+		}
+
+		return true;
+	}
+
+
+	private: size_type num_workers_;
+	private: real_type target_rel_prec_;
+	private: num_replications_detector_type num_repl_detector_;
+	private: uint_type min_num_repl_;
+	private: seed_type seed_;
+	private: uint_type max_num_retries_;
+	/// The estimator of the mean of replicate means.
+	private: mean_estimator<real_type,uint_type> stat_;
+	/// The number of replications to run.
+	private: uint_type num_repl_;
+	private: bool num_repl_detected_;
+	private: bool prec_reached_;
+	private: bool done_;
+	private: uint_type num_crashes_;
+	private: index_type next_index_;
+	private: ::std::vector<worker> workers_;
+	/// Replications lost because of a crash.
+	private: ::std::deque<index_type> retry_;
+	private: ::std::map<index_type,uint_type> num_retries_;
+	/// Replicate means received but not consumed yet.
+	private: ::std::map<index_type,real_type> pending_;
+};
+
+}}} // Namespace dcs::des::replications
+
+
+#endif // DCS_DES_REPLICATIONS_REPLICATION_FARM_HPP
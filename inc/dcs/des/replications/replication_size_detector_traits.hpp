@@ -0,0 +1,61 @@
+/**
+ * \file dcs/des/replications/replication_size_detector_traits.hpp
+ *
+ * \brief Traits class for replication size detectors.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_REPLICATIONS_REPLICATION_SIZE_DETECTOR_TRAITS_HPP
+#define DCS_DES_REPLICATIONS_REPLICATION_SIZE_DETECTOR_TRAITS_HPP
+
+
+namespace dcs { namespace des { namespace replications {
+
+/**
+ * \brief Traits class for replication size detectors.
+ *
+ * The \c retains_observations constant tells whether the observations passed
+ * to \c detect are retained by the detector, and must be taken back (by means
+ * of \c consumed_observations) once the replication size is detected, or are
+ * only looked at, so that the statistic must accumulate them by itself.
+ * Detectors retain their observations unless their traits are specialized.
+ *
+ * \tparam ReplicationSizeDetectorT The type of the replication size detector.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <typename ReplicationSizeDetectorT>
+struct replication_size_detector_traits
+{
+	typedef ReplicationSizeDetectorT replication_size_detector_type;
+
+	static const bool retains_observations = true;
+};
+
+template <typename ReplicationSizeDetectorT>
+const bool replication_size_detector_traits<ReplicationSizeDetectorT>::retains_observations;
+
+}}} // Namespace dcs::des::replications
+
+
+#endif // DCS_DES_REPLICATIONS_REPLICATION_SIZE_DETECTOR_TRAITS_HPP
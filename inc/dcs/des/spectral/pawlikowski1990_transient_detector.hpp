@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/storage.hpp>
 #include <boost/numeric/ublas/traits.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
@@ -41,6 +42,7 @@
 #include <cstddef>
 #include <dcs/assert.hpp>
 #include <dcs/debug.hpp>
+#include <dcs/des/memory_accounting.hpp>
 #include <dcs/math/constants.hpp>
 #include <dcs/math/function/sqr.hpp>
 #include <dcs/math/stats/distribution/students_t.hpp>
@@ -676,7 +678,7 @@ class pawlikowski1990_transient_detector
 	public: typedef ::std::size_t size_type;
 	public: typedef ::std::pair<real_type,real_type> sample_type;
 	public: typedef ::std::vector<sample_type> sample_container;
-	private: typedef ::boost::numeric::ublas::vector<real_type> vector_type;
+	private: typedef ::boost::numeric::ublas::vector<real_type, ::boost::numeric::ublas::unbounded_array<real_type, typename memory_accounting_allocator<real_type,detector_memory_category>::type> > vector_type;
 
 
 	/// Constant for setting the duration of batch size determination
@@ -961,6 +963,7 @@ class pawlikowski1990_transient_detector
 						= false;
 
 		num_obs_ = n0_
+				 = n0_star_
 				 = num_buf_obs_
 				 = n_t_
 				 = gamma_n0_star_
@@ -0,0 +1,177 @@
+/**
+ * \file dcs/des/static_engine.hpp
+ *
+ * \brief Discrete-event simulator engine core with a statically dispatched run
+ *  loop.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#ifndef DCS_DES_STATIC_ENGINE_HPP
+#define DCS_DES_STATIC_ENGINE_HPP
+
+
+#include <cstddef>
+#include <dcs/debug.hpp>
+#include <dcs/des/engine.hpp>
+#include <dcs/des/null_engine_hooks.hpp>
+
+
+namespace dcs { namespace des {
+
+/**
+ * \brief Discrete-event simulator engine core with a statically dispatched run
+ *  loop.
+ *
+ * \tparam DerivedT The engine class deriving from this one, which implements
+ *  the output analysis (Curiously Recurring Template Pattern).
+ * \tparam RealT The type used for real numbers.
+ * \tparam HooksT The type of the hooks called around each fired event (see
+ *  \c null_engine_hooks).
+ *
+ * The simulation is run as a sequence of experiments (e.g., one for the batch
+ * means method, one per replication for the independent replications method);
+ * each experiment fires the events of the future event list until the
+ * experiment is done or the list is empty.
+ * All the calls made per event (firing, hooks and output analysis) are bound
+ * at compile-time, so that the compiler can inline a single tight event loop.
+ *
+ * The derived class must provide (possibly as non-public members, in which
+ * case it has to declare this class as a friend) the following member
+ * functions:
+ * - <tt>bool more_experiments() const</tt>: tell if a new experiment has to be
+ *   run;
+ * - <tt>void prepare_experiment(engine_context_type& ctx)</tt>: prepare a new
+ *   experiment;
+ * - <tt>bool end_of_experiment() const</tt>: tell if the current experiment is
+ *   done;
+ * - <tt>void monitor_experiment()</tt>: update the state of output analysis
+ *   after each fired event;
+ * - <tt>void finalize_experiment(engine_context_type& ctx)</tt>: finalize the
+ *   current experiment.
+ * .
+ *
+ * Since this class derives from \c dcs::des::engine, the derived engine can be
+ * used everywhere the dynamic engine interface is expected.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+template <
+	typename DerivedT,
+	typename RealT=double,
+	typename HooksT=null_engine_hooks<RealT>
+>
+class static_engine: public engine<RealT>
+{
+	private: typedef engine<RealT> base_type;
+	public: typedef DerivedT derived_type;
+	public: typedef HooksT hooks_type;
+	public: typedef typename base_type::real_type real_type;
+	public: typedef typename base_type::engine_context_type engine_context_type;
+	public: typedef ::std::size_t size_type;
+
+
+	public: static_engine()
+	: base_type(),
+	  hooks_(),
+	  num_exps_(0)
+	{
+	}
+
+
+	public: explicit static_engine(hooks_type const& hooks)
+	: base_type(),
+	  hooks_(hooks),
+	  num_exps_(0)
+	{
+	}
+
+
+	public: hooks_type& hooks()
+	{
+		return hooks_;
+	}
+
+
+	public: hooks_type const& hooks() const
+	{
+		return hooks_;
+	}
+
+
+	/// Return the number of experiments started in the current run.
+	protected: size_type num_experiments() const
+	{
+		return num_exps_;
+	}
+
+
+	private: derived_type& derived()
+	{
+		return static_cast<derived_type&>(*this);
+	}
+
+
+	private: void do_run()
+	{
+		DCS_DEBUG_TRACE( "Begin SIMULATION" );
+
+		engine_context_type ctx(this);
+
+		num_exps_ = 0;
+
+		this->prepare_simulation(ctx);
+
+		while (derived().more_experiments())
+		{
+			++num_exps_;
+
+			derived().prepare_experiment(ctx);
+
+			while (!derived().end_of_experiment() && !this->future_event_list().empty())
+			{
+				DCS_DEBUG_TRACE_L(1, "Simulation time: " << this->simulated_time());
+
+				this->fire_next_event(ctx, hooks_);
+
+				derived().monitor_experiment();
+			}
+
+			derived().finalize_experiment(ctx);
+		}
+
+		this->finalize_simulation(ctx);
+
+		DCS_DEBUG_TRACE( "End SIMULATION" );
+	}
+
+
+	/// The hooks called around each fired event.
+	private: hooks_type hooks_;
+	/// The number of experiments started in the current run.
+	private: size_type num_exps_;
+};
+
+}} // Namespace dcs::des
+
+
+#endif // DCS_DES_STATIC_ENGINE_HPP
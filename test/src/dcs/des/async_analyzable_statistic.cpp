@@ -0,0 +1,272 @@
+/**
+ * \file async_analyzable_statistic.cpp
+ *
+ * \brief Test suite for the output analysis run by a helper thread.
+ *
+ * The test checks that:
+ * - a Batch Means statistic analyzed by a helper thread, through a small ring
+ *   which often fills up, gives exactly the same results of the same statistic
+ *   analyzed synchronously on the same observations;
+ * - an exception thrown by the wrapped statistic on the helper thread is
+ *   rethrown on the calling thread by the following queries and collected
+ *   observations, and does not prevent the helper thread from being stopped.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/async_analyzable_statistic.hpp>
+#include <dcs/des/base_analyzable_statistic.hpp>
+#include <dcs/des/batch_means/analyzable_statistic.hpp>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/statistic_categories.hpp>
+#include <dcs/macro.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::des::base_analyzable_statistic<real_type,uint_type> statistic_type;
+typedef dcs::des::async_analyzable_statistic<real_type,uint_type> async_statistic_type;
+typedef dcs::des::batch_means::analyzable_statistic< dcs::des::mean_estimator<real_type,uint_type> > batch_means_statistic_type;
+
+
+/// Number of observations collected by each statistic.
+const uint_type num_obs = 200000;
+/// Number of observations the ring of the asynchronous statistic can hold.
+const ::std::size_t ring_capacity = 64;
+/// Index of the observation making the failing statistic throw.
+const uint_type failing_obs = 10;
+/// Message of the exception thrown by the failing statistic.
+const char failure_message[] = "Failing statistic";
+
+
+/// Statistic throwing an exception at the \c failing_obs observation.
+class failing_statistic: public statistic_type
+{
+	public: failing_statistic()
+	: num_obs_(0)
+	{
+	}
+
+
+	private: dcs::des::statistic_category do_category() const
+	{
+		return dcs::des::mean_statistic;
+	}
+
+
+	private: void do_collect(real_type obs, real_type weight)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( obs );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( weight );
+
+		if (num_obs_++ == failing_obs)
+		{
+			throw ::std::runtime_error(failure_message);
+		}
+	}
+
+
+	private: void do_reset()
+	{
+		num_obs_ = 0;
+	}
+
+
+	private: uint_type do_num_observations() const
+	{
+		return num_obs_;
+	}
+
+
+	private: real_type do_estimate() const
+	{
+		return 0;
+	}
+
+
+	private: real_type do_variance() const
+	{
+		return 0;
+	}
+
+
+	private: real_type do_half_width() const
+	{
+		return 0;
+	}
+
+
+	private: real_type do_relative_precision() const
+	{
+		return 0;
+	}
+
+
+	private: uint_type do_max_num_observations() const
+	{
+		return num_observations_infinity;
+	}
+
+
+	private: bool do_steady_state_entered() const
+	{
+		return true;
+	}
+
+
+	private: uint_type do_transient_phase_length() const
+	{
+		return 0;
+	}
+
+
+	private: real_type do_steady_state_enter_time() const
+	{
+		return 0;
+	}
+
+
+	private: void do_steady_state_enter_time(real_type value)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( value );
+	}
+
+
+	private: bool do_observation_complete() const
+	{
+		return false;
+	}
+
+
+	private: uint_type num_obs_;
+};
+
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void test_same_results()
+{
+	dcs::shared_ptr<statistic_type> ptr_sync(new batch_means_statistic_type());
+	async_statistic_type async(dcs::shared_ptr<statistic_type>(new batch_means_statistic_type()), ring_capacity);
+
+	std::cout << "Synchronous and asynchronous analysis" << std::endl;
+
+	// An autocorrelated series with a transient phase, driven by a linear
+	// congruential generator.
+	unsigned long seed(5489UL);
+	real_type x(50);
+	for (uint_type i = 0; i < num_obs; ++i)
+	{
+		seed = (seed*1103515245UL+12345UL) % 2147483648UL;
+		x = 0.9*x+static_cast<real_type>(seed)/2147483648.0;
+
+		(*ptr_sync)(x);
+		async(x);
+	}
+
+	check_equal("Number of observations", async.num_observations(), ptr_sync->num_observations());
+	check_equal("Steady state entered", async.statistic()->steady_state_entered(), ptr_sync->steady_state_entered());
+	check_equal("Transient phase length", async.transient_phase_length(), ptr_sync->transient_phase_length());
+	check_equal("Estimate", async.estimate(), ptr_sync->estimate());
+	check_equal("Half width", async.half_width(), ptr_sync->half_width());
+	check_equal("Relative precision", async.relative_precision(), ptr_sync->relative_precision());
+	check_equal("Observation complete", async.observation_complete(), ptr_sync->observation_complete());
+}
+
+
+void test_exception()
+{
+	async_statistic_type async(dcs::shared_ptr<statistic_type>(new failing_statistic()), ring_capacity);
+
+	std::cout << "Exception on the helper thread" << std::endl;
+
+	std::string what;
+	try
+	{
+		for (uint_type i = 0; i < 2*failing_obs; ++i)
+		{
+			async(i);
+		}
+		async.flush();
+	}
+	catch (std::runtime_error const& e)
+	{
+		what = e.what();
+	}
+	check_equal("Exception rethrown", what, std::string(failure_message));
+
+	bool thrown(false);
+	try
+	{
+		async.estimate();
+	}
+	catch (std::runtime_error const&)
+	{
+		thrown = true;
+	}
+	check_equal("Exception rethrown by a query", thrown, true);
+
+	thrown = false;
+	try
+	{
+		async(0);
+	}
+	catch (std::runtime_error const&)
+	{
+		thrown = true;
+	}
+	check_equal("Exception rethrown by a collection", thrown, true);
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_same_results();
+	test_exception();
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,186 @@
+/**
+ * \file ctmc_simulator.cpp
+ *
+ * \brief Test suite for the CTMC simulator of Markovian queueing networks.
+ *
+ * Simulates M/M/1 and M/M/c FCFS stations and checks the per-run observations
+ * against the closed-form results (with a = lambda/mu and, for M/M/c, the
+ * Erlang C probability of waiting C(c,a)):
+ * - the mean response time is W = 1/mu + C(c,a)/(c*mu-lambda);
+ * - the mean waiting time is W-1/mu;
+ * - the mean number of busy servers is a;
+ * - the mean number of waiting customers just after an arrival (the arriving
+ *   customer included when it has to wait) is Lq + C(c,a), since by PASTA an
+ *   arrival sees the time-stationary number of customers in the station
+ *   (for M/M/1 this is rho/(1-rho)).
+ * It also checks that routes whose probabilities do not sum to 1 are
+ * rejected.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/model/qn/ctmc_simulator.hpp>
+#include <dcs/des/model/qn/output_statistic_category.hpp>
+#include <dcs/des/model/qn/queueing_network.hpp>
+#include <dcs/des/model/qn/queueing_network_traits.hpp>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <stdexcept>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::replications::engine<real_type,uint_type> des_engine_type;
+typedef dcs::des::model::qn::queueing_network<uint_type,real_type,random_generator_type,des_engine_type> network_type;
+typedef dcs::des::model::qn::queueing_network_traits<network_type> network_traits_type;
+typedef dcs::des::model::qn::ctmc_simulator<network_traits_type> simulator_type;
+typedef dcs::des::mean_estimator<real_type,uint_type> statistic_type;
+
+
+/// Relative tolerance of the comparisons with the closed-form results.
+const real_type tolerance = 0.03;
+
+
+int num_failures = 0;
+
+
+void check_close(char const* name, real_type actual, real_type expected)
+{
+	bool ok(std::abs(actual-expected) <= tolerance*std::abs(expected));
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void check(char const* name, bool ok)
+{
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+/// Return the Erlang C probability that an arrival has to wait.
+real_type erlang_c(uint_type c, real_type a)
+{
+	// Erlang B by recursion, then Erlang C
+	real_type b(1);
+	for (uint_type k = 1; k <= c; ++k)
+	{
+		b = a*b/(k+a*b);
+	}
+
+	real_type rho(a/c);
+
+	return b/(1-rho*(1-b));
+}
+
+
+void test_mmc(uint_type c, real_type lambda, real_type mu)
+{
+	const real_type horizon(2e6/lambda);
+	const real_type a(lambda/mu);
+	const real_type pw(erlang_c(c, a));
+	const real_type wq(pw/(c*mu-lambda));
+	const real_type lq(lambda*wq);
+
+	random_generator_type rng(5489UL);
+	simulator_type sim;
+
+	simulator_type::node_identifier_type k(sim.add_queueing_station(c));
+	simulator_type::class_identifier_type cls(sim.add_open_class(lambda, k));
+	sim.service_rate(k, cls, mu);
+	sim.add_route(k, cls, simulator_type::sink(), cls, 1);
+
+	dcs::shared_ptr<statistic_type> ptr_nw_stat(new statistic_type());
+	dcs::shared_ptr<statistic_type> ptr_nb_stat(new statistic_type());
+	dcs::shared_ptr<statistic_type> ptr_wt_stat(new statistic_type());
+	dcs::shared_ptr<statistic_type> ptr_rt_stat(new statistic_type());
+
+	sim.statistic(k, dcs::des::model::qn::num_waiting_statistic_category, ptr_nw_stat);
+	sim.statistic(k, dcs::des::model::qn::num_busy_statistic_category, ptr_nb_stat);
+	sim.statistic(k, dcs::des::model::qn::waiting_time_statistic_category, ptr_wt_stat);
+	sim.statistic(k, dcs::des::model::qn::response_time_statistic_category, ptr_rt_stat);
+
+	sim.evaluate(horizon, rng);
+
+	std::cout << "M/M/" << c << " (lambda: " << lambda << ", mu: " << mu << ")" << std::endl;
+	check_close("Number waiting at arrivals", ptr_nw_stat->estimate(), lq+pw);
+	check_close("Number of busy servers", ptr_nb_stat->estimate(), a);
+	check_close("Waiting time", ptr_wt_stat->estimate(), wq);
+	check_close("Response time", ptr_rt_stat->estimate(), wq+1/mu);
+}
+
+
+void test_route_probabilities()
+{
+	random_generator_type rng(5489UL);
+	simulator_type sim;
+
+	simulator_type::node_identifier_type k(sim.add_queueing_station(1));
+	simulator_type::class_identifier_type cls(sim.add_open_class(0.5, k));
+	sim.service_rate(k, cls, 1);
+	sim.add_route(k, cls, simulator_type::sink(), cls, 0.5);
+
+	bool rejected(false);
+	try
+	{
+		sim.evaluate(10, rng);
+	}
+	catch (::std::logic_error const&)
+	{
+		rejected = true;
+	}
+
+	std::cout << "Routing" << std::endl;
+	check("Routing probabilities not summing to 1 rejected", rejected);
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_mmc(1, 0.5, 1);
+	test_mmc(1, 0.7, 1);
+	test_mmc(3, 2, 1);
+	test_route_probabilities();
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,249 @@
+/**
+ * \file engine_time_resolution.cpp
+ *
+ * \brief Test suite for the integer-tick mode of the simulation engine.
+ *
+ * Events are scheduled at the begin of a replication with fire times falling
+ * on the same tick or on different ticks.
+ * The test checks that:
+ * - fire times are rounded to the nearest tick, and the simulated clock is
+ *   kept in ticks;
+ * - events sharing a tick fire in the order they have been scheduled, even
+ *   when their original fire times are in the opposite order;
+ * - an event scheduled slightly before the current time, but on the current
+ *   tick, fires at the current time right after the event scheduling it;
+ * - the conversions between times and ticks round to the nearest tick, and
+ *   invalid resolutions are rejected;
+ * - with the default (continuous) clock, fire times are left unchanged.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/macro.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::des::replications::engine<real_type,uint_type> des_engine_type;
+typedef des_engine_type::event_type event_type;
+typedef des_engine_type::engine_context_type engine_context_type;
+typedef des_engine_type::event_source_type event_source_type;
+typedef event_type::tick_type tick_type;
+
+
+/// A fired event: its label, fire time and simulated ticks.
+struct firing
+{
+	int label;
+	real_type time;
+	tick_type tick;
+};
+
+
+/// The engine running the test events.
+des_engine_type* ptr_eng = 0;
+/// The event source of the test events.
+dcs::shared_ptr<event_source_type> ptr_src;
+/// The fire times of the test events scheduled at the begin of a replication.
+std::vector<real_type> fire_times;
+/// The events fired so far.
+std::vector<firing> firings;
+/// The label of the event scheduling a further event (or zero for none).
+int rescheduling_label = 0;
+/// The time, relative to the current one, of the further event.
+real_type rescheduling_offset = 0;
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void process_begin_of_replication(event_type const& evt, engine_context_type& ctx)
+{
+	DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+
+	for (std::size_t i = 0; i < fire_times.size(); ++i)
+	{
+		ctx.schedule_event(ptr_src, fire_times[i], static_cast<int>(i+1));
+	}
+}
+
+
+void process_event(event_type const& evt, engine_context_type& ctx)
+{
+	firing f;
+	f.label = evt.unfolded_state<int>();
+	f.time = ctx.simulated_time();
+	f.tick = ptr_eng->simulated_ticks();
+	firings.push_back(f);
+
+	if (f.label == rescheduling_label)
+	{
+		ctx.schedule_event(ptr_src, f.time+rescheduling_offset, 0);
+	}
+}
+
+
+/// Run a replication firing events at the given times.
+void run(real_type resolution)
+{
+	des_engine_type eng(10, 1);
+
+	ptr_eng = &eng;
+	eng.time_resolution(resolution);
+	ptr_src = dcs::make_shared<event_source_type>("Test Event");
+	ptr_src->connect(&process_event);
+	eng.begin_of_replication_event_source().connect(&process_begin_of_replication);
+
+	firings.clear();
+
+	eng.run();
+
+	ptr_eng = 0;
+}
+
+
+void test_tick_mode()
+{
+	const real_type res(0.5);
+
+	std::cout << "Integer-tick mode" << std::endl;
+
+	// Labels: 1 and 3 on tick 2 (time 1), 2 on tick 2 with an earlier
+	// original time, 4 on tick 1 (time 0.5), 5 on tick 6 (time 3).
+	fire_times.clear();
+	fire_times.push_back(1.2);
+	fire_times.push_back(0.76);
+	fire_times.push_back(1.0);
+	fire_times.push_back(0.74);
+	fire_times.push_back(3.1);
+
+	// Event 5 schedules an event 0.1 time units in the past, but still on
+	// tick 6.
+	rescheduling_label = 5;
+	rescheduling_offset = -0.1;
+
+	run(res);
+
+	const int labels[] = {4, 1, 2, 3, 5, 0};
+	const real_type times[] = {0.5, 1, 1, 1, 3, 3};
+	const std::size_t n(sizeof(labels)/sizeof(labels[0]));
+
+	check_equal("Number of fired events", firings.size(), n);
+	for (std::size_t i = 0; i < n && i < firings.size(); ++i)
+	{
+		std::cout << "Event #" << i << std::endl;
+		check_equal("Label", firings[i].label, labels[i]);
+		check_equal("Fire time", firings[i].time, times[i]);
+		check_equal("Ticks", firings[i].tick, static_cast<tick_type>(times[i]/res));
+	}
+}
+
+
+void test_conversions()
+{
+	des_engine_type eng(10, 1);
+
+	std::cout << "Conversions" << std::endl;
+
+	bool thrown(false);
+	try
+	{
+		eng.to_ticks(1);
+	}
+	catch (std::logic_error const&)
+	{
+		thrown = true;
+	}
+	check_equal("Ticks without resolution rejected", thrown, true);
+
+	thrown = false;
+	try
+	{
+		eng.time_resolution(-1);
+	}
+	catch (std::invalid_argument const&)
+	{
+		thrown = true;
+	}
+	check_equal("Negative resolution rejected", thrown, true);
+
+	eng.time_resolution(0.5);
+	check_equal("Rounding up to a tick", eng.to_ticks(1.26), tick_type(3));
+	check_equal("Rounding down to a tick", eng.to_ticks(1.24), tick_type(2));
+	check_equal("Rounding a negative time", eng.to_ticks(-1.26), tick_type(-3));
+	check_equal("Time of a tick", eng.from_ticks(3), real_type(1.5));
+}
+
+
+void test_continuous_mode()
+{
+	std::cout << "Continuous mode" << std::endl;
+
+	fire_times.clear();
+	fire_times.push_back(1.2);
+	fire_times.push_back(0.76);
+	rescheduling_label = 0;
+
+	run(0);
+
+	check_equal("Number of fired events", firings.size(), std::size_t(2));
+	if (firings.size() == 2)
+	{
+		check_equal("First fire time", firings[0].time, real_type(0.76));
+		check_equal("Second fire time", firings[1].time, real_type(1.2));
+		check_equal("Ticks", firings[1].tick, tick_type(0));
+	}
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_tick_mode();
+	test_conversions();
+	test_continuous_mode();
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,305 @@
+/**
+ * \file heap_queueing_strategy.cpp
+ *
+ * \brief Test suite for heap-based queueing strategies and preemptive-resume
+ *  service.
+ *
+ * The test checks that:
+ * - a d-ary heap pops its elements in sorted order, for several arities;
+ * - a priority queue serves customers by priority and in FCFS order within
+ *   the same priority, and that a requeued (preempted) customer keeps its
+ *   place ahead of the customers with the same priority which arrived after
+ *   it;
+ * - an M/M/1 station with the preemptive SRPT discipline has the utilization
+ *   and throughput of any work-conserving discipline, and the mean response
+ *   time given by the Schrage-Miller formula.
+ *   The latter only holds if preempted customers resume their service with
+ *   the exact residual demand, and if the station releases and reassigns its
+ *   servers correctly when preempting.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/base_analyzable_statistic.hpp>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/model/qn/customer.hpp>
+#include <dcs/des/model/qn/deterministic_routing_strategy.hpp>
+#include <dcs/des/model/qn/detail/dary_heap.hpp>
+#include <dcs/des/model/qn/load_independent_service_strategy.hpp>
+#include <dcs/des/model/qn/network_node.hpp>
+#include <dcs/des/model/qn/open_customer_class.hpp>
+#include <dcs/des/model/qn/output_statistic_category.hpp>
+#include <dcs/des/model/qn/priority_queueing_strategy.hpp>
+#include <dcs/des/model/qn/queueing_network.hpp>
+#include <dcs/des/model/qn/queueing_network_traits.hpp>
+#include <dcs/des/model/qn/queueing_station_node.hpp>
+#include <dcs/des/model/qn/sink_node.hpp>
+#include <dcs/des/model/qn/source_node.hpp>
+#include <dcs/des/model/qn/srpt_queueing_strategy.hpp>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <dcs/math/stats/distributions.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::replications::engine<real_type,uint_type> des_engine_type;
+typedef dcs::des::base_analyzable_statistic<real_type,uint_type> statistic_type;
+typedef dcs::des::model::qn::queueing_network<uint_type,real_type,random_generator_type,des_engine_type> network_type;
+typedef dcs::des::model::qn::queueing_network_traits<network_type> network_traits_type;
+typedef dcs::des::model::qn::customer<network_traits_type> customer_type;
+typedef dcs::shared_ptr<customer_type> customer_pointer;
+typedef dcs::des::model::qn::network_node<network_traits_type> network_node_type;
+typedef dcs::des::model::qn::open_customer_class<network_traits_type> customer_class_type;
+typedef dcs::des::model::qn::deterministic_routing_strategy<network_traits_type> routing_strategy_type;
+typedef dcs::des::model::qn::srpt_queueing_strategy<network_traits_type> srpt_queueing_strategy_type;
+typedef dcs::des::model::qn::priority_queueing_strategy<network_traits_type> priority_queueing_strategy_type;
+typedef dcs::des::model::qn::load_independent_service_strategy<network_traits_type> service_strategy_type;
+
+
+enum network_node_category
+{
+	SOURCE_NODE,
+	STATION_NODE,
+	SINK_NODE
+};
+
+
+/// Relative tolerance of the comparisons with the closed-form results.
+const real_type tolerance = 0.03;
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void check_close(char const* name, real_type actual, real_type expected)
+{
+	bool ok(std::abs(actual-expected) <= tolerance*std::abs(expected));
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+template <std::size_t Arity>
+void test_dary_heap(char const* name)
+{
+	dcs::des::model::qn::detail::dary_heap<int,std::less<int>,Arity> heap;
+	std::vector<int> values;
+
+	// A pseudo-random sequence with repeated values.
+	for (int i = 0; i < 1000; ++i)
+	{
+		values.push_back((i*7919) % 263);
+		heap.push(values.back());
+	}
+	std::sort(values.begin(), values.end());
+
+	bool sorted(true);
+	for (std::size_t i = 0; i < values.size(); ++i)
+	{
+		if (heap.empty() || heap.top() != values[i])
+		{
+			sorted = false;
+			break;
+		}
+		heap.pop();
+	}
+
+	check_equal(name, sorted && heap.empty(), true);
+}
+
+
+customer_pointer make_customer(uint_type id, int priority)
+{
+	customer_pointer ptr_customer(new customer_type(id, 0, STATION_NODE));
+	ptr_customer->priority(priority);
+
+	return ptr_customer;
+}
+
+
+void test_priority_requeue()
+{
+	priority_queueing_strategy_type queue(true);
+
+	customer_pointer ptr_low1(make_customer(1, 1));
+	customer_pointer ptr_low2(make_customer(2, 1));
+	customer_pointer ptr_high(make_customer(3, 0));
+
+	std::cout << "Priority queue" << std::endl;
+
+	queue.push(ptr_low1);
+	check_equal("First arrival served", queue.peek()->id(), ptr_low1->id());
+	queue.pop();
+
+	// The first low-priority customer is in service: the high-priority arrival
+	// preempts it, a low-priority arrival does not.
+	queue.push(ptr_low2);
+	queue.push(ptr_high);
+	check_equal("High priority preempts", queue.preempts(ptr_high, ptr_low1, 1), true);
+	check_equal("Same priority does not preempt", queue.preempts(ptr_low2, ptr_low1, 1), false);
+
+	queue.requeue(ptr_low1);
+	check_equal("Queue size after requeue", queue.size(), priority_queueing_strategy_type::size_type(3));
+	check_equal("High priority served first", queue.peek()->id(), ptr_high->id());
+	queue.pop();
+	check_equal("Preempted customer served before later arrival", queue.peek()->id(), ptr_low1->id());
+	queue.pop();
+	check_equal("Later arrival served last", queue.peek()->id(), ptr_low2->id());
+	queue.pop();
+	check_equal("Queue empty", queue.empty(), true);
+}
+
+
+/**
+ * \brief Mean response time of an M/M/1 queue with the SRPT discipline.
+ *
+ * Integrates the Schrage-Miller formula for the response time of a job of
+ * size \f$x\f$:
+ * \f[
+ *  T(x) = \frac{\lambda\left(m_2(x) + x^2(1-F(x))\right)}{2(1-\rho(x))^2} + \int_0^x \frac{dt}{1-\rho(t)}
+ * \f]
+ * where \f$\rho(x)=\lambda\int_0^x t\,dF(t)\f$ and
+ * \f$m_2(x)=\int_0^x t^2\,dF(t)\f$, over the exponential size distribution.
+ */
+real_type srpt_mm1_response_time(real_type lambda, real_type mu)
+{
+	const real_type x_max(50/mu);
+	const std::size_t n(200000);
+	const real_type h(x_max/n);
+
+	real_type mean(0);
+	real_type residence(0);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		// Midpoint rule
+		const real_type x((i+0.5)*h);
+		const real_type e(std::exp(-mu*x));
+		const real_type rho_x(lambda*(1-e*(1+mu*x))/mu);
+		const real_type m2_x((2-e*(mu*mu*x*x+2*mu*x+2))/(mu*mu));
+
+		const real_type waiting(lambda*(m2_x+x*x*e)/(2*(1-rho_x)*(1-rho_x)));
+		const real_type t_x(waiting+residence+0.5*h/(1-rho_x));
+
+		mean += t_x*mu*e*h;
+		residence += h/(1-rho_x);
+	}
+
+	return mean;
+}
+
+
+void test_srpt_mm1(real_type lambda, real_type mu)
+{
+	const uint_type replication_length(static_cast<uint_type>(1e5/lambda));
+	const uint_type num_replications(5);
+	const real_type rho(lambda/mu);
+
+	dcs::shared_ptr<des_engine_type> ptr_eng(new des_engine_type(replication_length, num_replications));
+	dcs::shared_ptr<random_generator_type> ptr_rng(new random_generator_type(5489UL));
+
+	network_type qn(ptr_rng, ptr_eng);
+
+	dcs::shared_ptr<routing_strategy_type> ptr_routing(new routing_strategy_type());
+	ptr_routing->add_route(SOURCE_NODE, 0, STATION_NODE, 0);
+	ptr_routing->add_route(STATION_NODE, 0, SINK_NODE, 0);
+
+	std::vector< dcs::math::stats::any_distribution<real_type> > svc_distrs;
+	svc_distrs.push_back(dcs::math::stats::make_any_distribution(dcs::math::stats::exponential_distribution<real_type>(mu)));
+
+	dcs::shared_ptr<network_node_type> ptr_node;
+	ptr_node = dcs::make_shared< dcs::des::model::qn::source_node<network_traits_type> >(SOURCE_NODE, "Source", ptr_routing);
+	qn.add_node(ptr_node);
+	ptr_node = dcs::make_shared< dcs::des::model::qn::queueing_station_node<network_traits_type> >(
+			STATION_NODE,
+			"Station",
+			dcs::make_shared<srpt_queueing_strategy_type>(),
+			dcs::make_shared<service_strategy_type>(1, svc_distrs.begin(), svc_distrs.end()),
+			ptr_routing
+		);
+	qn.add_node(ptr_node);
+	ptr_node = dcs::make_shared< dcs::des::model::qn::sink_node<network_traits_type> >(SINK_NODE, "Sink");
+	qn.add_node(ptr_node);
+
+	dcs::shared_ptr<customer_class_type> ptr_class(new customer_class_type(0, "Open Class", dcs::math::stats::exponential_distribution<real_type>(lambda)));
+	ptr_class->reference_node(SOURCE_NODE);
+	qn.add_class(ptr_class);
+
+	dcs::shared_ptr<statistic_type> ptr_rt_stat(ptr_eng->make_analyzable_statistic(dcs::des::mean_estimator<real_type,uint_type>()));
+	dcs::shared_ptr<statistic_type> ptr_util_stat(ptr_eng->make_analyzable_statistic(dcs::des::mean_estimator<real_type,uint_type>()));
+	dcs::shared_ptr<statistic_type> ptr_tput_stat(ptr_eng->make_analyzable_statistic(dcs::des::mean_estimator<real_type,uint_type>()));
+	qn.get_node(STATION_NODE).statistic(dcs::des::model::qn::response_time_statistic_category, ptr_rt_stat);
+	qn.get_node(STATION_NODE).statistic(dcs::des::model::qn::utilization_statistic_category, ptr_util_stat);
+	qn.get_node(STATION_NODE).statistic(dcs::des::model::qn::throughput_statistic_category, ptr_tput_stat);
+
+	ptr_eng->run();
+
+	std::cout << "M/M/1 SRPT (lambda: " << lambda << ", mu: " << mu << ")" << std::endl;
+	check_close("Utilization", ptr_util_stat->estimate(), rho);
+	check_close("Throughput", ptr_tput_stat->estimate(), lambda);
+	check_close("Response time", ptr_rt_stat->estimate(), srpt_mm1_response_time(lambda, mu));
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_dary_heap<2>("Binary heap order");
+	test_dary_heap<4>("4-ary heap order");
+	test_dary_heap<8>("8-ary heap order");
+
+	test_priority_requeue();
+
+	test_srpt_mm1(0.5, 1);
+	test_srpt_mm1(0.8, 1);
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
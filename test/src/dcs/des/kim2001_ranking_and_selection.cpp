@@ -0,0 +1,203 @@
+/**
+ * \file kim2001_ranking_and_selection.cpp
+ *
+ * \brief Test suite for the KN and KN++ ranking-and-selection procedures.
+ *
+ * The competing designs produce normal replicate outputs whose means differ by
+ * at least the indifference-zone parameter from the best one.
+ * The test checks that:
+ * - both KN and KN++ select the best design, when maximizing and when
+ *   minimizing, and stop with the best design as the only survivor;
+ * - designs far from the best one are eliminated early, so that they run
+ *   fewer replications than the best one;
+ * - the estimates are reported as sample means of the original outputs;
+ * - with noise-free outputs every inferior design is eliminated right after
+ *   the initial stage.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/replications/kim2001_ranking_and_selection.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::replications::kim2001_ranking_and_selection<real_type,uint_type> procedure_type;
+
+
+/// Indifference-zone parameter.
+const real_type delta = 0.5;
+/// Number of initial replications.
+const uint_type num_init_repl = 10;
+/// Maximum number of replications of each design.
+const uint_type max_num_repl = 100000;
+
+
+/**
+ * \brief Designs with normal replicate outputs.
+ *
+ * Replication \c r of design \c i uses a random number seed depending only on
+ * \c r (common random numbers) and on \c i.
+ */
+struct normal_designs
+{
+	normal_designs(std::vector<real_type> const& means, real_type sd)
+	: means(means),
+	  sd(sd)
+	{
+	}
+
+	real_type operator()(std::size_t design, uint_type replication)
+	{
+		random_generator_type rng(static_cast<unsigned long>(5489UL+1000UL*replication+design));
+		boost::variate_generator< random_generator_type&, boost::normal_distribution<real_type> > normal(rng, boost::normal_distribution<real_type>(means[design], sd));
+
+		return normal();
+	}
+
+	std::vector<real_type> means;
+	real_type sd;
+};
+
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void test_selection(bool variance_update, bool maximize)
+{
+	// The best design is the third one; the first one is far behind.
+	const real_type sign(maximize ? 1 : -1);
+	std::vector<real_type> means;
+	means.push_back(sign*0);
+	means.push_back(sign*1.5);
+	means.push_back(sign*2);
+	means.push_back(sign*1.4);
+	const std::size_t best(2);
+
+	procedure_type procedure(means.size(), delta, 0.95, num_init_repl, maximize);
+	if (variance_update)
+	{
+		procedure.enable_variance_update();
+	}
+
+	std::cout << (variance_update ? "KN++" : "KN") << (maximize ? " (maximize)" : " (minimize)") << std::endl;
+
+	std::size_t selected(procedure.run(normal_designs(means, 1), max_num_repl));
+
+	check_equal("Selected design", selected, best);
+	check_equal("Number of surviving designs", procedure.num_surviving(), std::size_t(1));
+	check_equal("Best design survives", procedure.surviving(best), true);
+	check_equal("Far design dropped early", procedure.num_replications(0) < procedure.num_replications(best), true);
+	check_equal("Estimate sign", std::abs(procedure.estimate(best)-means[best]) < 0.5, true);
+
+	uint_type total(0);
+	for (std::size_t i = 0; i < means.size(); ++i)
+	{
+		total += procedure.num_replications(i);
+	}
+	check_equal("Total number of replications", procedure.total_num_replications(), total);
+}
+
+
+void test_noise_free()
+{
+	std::vector<real_type> means;
+	means.push_back(1);
+	means.push_back(3);
+	means.push_back(2);
+
+	procedure_type procedure(means.size(), delta, 0.95, num_init_repl);
+
+	std::cout << "Noise-free designs" << std::endl;
+
+	check_equal("Selected design", procedure.run(normal_designs(means, 0), max_num_repl), std::size_t(1));
+	check_equal("Total number of replications", procedure.total_num_replications(), static_cast<uint_type>(means.size()*num_init_repl));
+}
+
+
+void test_invalid_arguments()
+{
+	std::cout << "Invalid arguments" << std::endl;
+
+	bool thrown(false);
+	try
+	{
+		procedure_type procedure(1, delta);
+	}
+	catch (std::invalid_argument const&)
+	{
+		thrown = true;
+	}
+	check_equal("Single design rejected", thrown, true);
+
+	thrown = false;
+	try
+	{
+		procedure_type procedure(2, 0);
+	}
+	catch (std::invalid_argument const&)
+	{
+		thrown = true;
+	}
+	check_equal("Null indifference zone rejected", thrown, true);
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_selection(false, true);
+	test_selection(true, true);
+	test_selection(false, false);
+	test_selection(true, false);
+	test_noise_free();
+	test_invalid_arguments();
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,308 @@
+/**
+ * \file process.cpp
+ *
+ * \brief Test suite for the process-interaction modeling API.
+ *
+ * Jobs arriving at different times acquire a unit of a resource, hold it for
+ * a service time and release it.
+ * The test checks that:
+ * - jobs wait in FCFS order while all the units are busy, and get a unit as
+ *   soon as it is released;
+ * - a released unit is handed to the first waiting job only after the
+ *   releasing job has reached its next suspension point (or has terminated);
+ * - a job spawned with zero delay runs before the spawn returns, and a
+ *   process terminating at once is reported as such;
+ * - the numbers of busy units, of waiting jobs and of live processes are
+ *   right while the simulation runs and when it ends;
+ * - releasing a resource with no busy unit is rejected.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/process.hpp>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/functional/bind.hpp>
+#include <dcs/macro.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::des::replications::engine<real_type,uint_type> des_engine_type;
+typedef des_engine_type::event_type event_type;
+typedef des_engine_type::engine_context_type engine_context_type;
+typedef dcs::des::process_scheduler<real_type> scheduler_type;
+typedef dcs::des::process_resource<real_type> resource_type;
+
+
+/// Service time of every job.
+const real_type service_time = 3;
+/// Time at which the monitor samples the state of the resource.
+const real_type monitor_time = 2.5;
+
+
+/// Something happened to a job.
+struct record
+{
+	int job;
+	char what; ///< 'A' (acquired) or 'R' (released).
+	real_type time;
+};
+
+
+/// State shared by the processes of a run.
+struct model_data
+{
+	explicit model_data(uint_type capacity)
+	: resource(capacity),
+	  num_busy(0),
+	  num_waiting(0),
+	  num_processes(0)
+	{
+	}
+
+	resource_type resource;
+	std::vector<record> records;
+	/// State sampled by the monitor.
+	uint_type num_busy;
+	uint_type num_waiting;
+	uint_type num_processes;
+};
+
+
+void log(model_data& data, int job, char what, real_type time)
+{
+	record r;
+	r.job = job;
+	r.what = what;
+	r.time = time;
+	data.records.push_back(r);
+}
+
+
+/// A job using a unit of the resource for \c service_time.
+class job: public dcs::des::process<real_type>
+{
+	public: job(model_data& data, int id)
+	: ptr_data_(&data),
+	  id_(id)
+	{
+	}
+
+
+	private: void do_run(engine_context_type& ctx)
+	{
+		DCS_DES_PROCESS_BEGIN;
+			DCS_DES_PROCESS_ACQUIRE( ptr_data_->resource );
+			log(*ptr_data_, id_, 'A', ctx.simulated_time());
+			DCS_DES_PROCESS_HOLD( service_time );
+			DCS_DES_PROCESS_RELEASE( ptr_data_->resource );
+			// A waiting job must not get the unit before this point.
+			log(*ptr_data_, id_, 'R', ctx.simulated_time());
+		DCS_DES_PROCESS_END;
+	}
+
+
+	private: model_data* ptr_data_;
+	private: int id_;
+};
+
+
+/// A process sampling the state of the resource at \c monitor_time.
+class monitor: public dcs::des::process<real_type>
+{
+	public: explicit monitor(model_data& data)
+	: ptr_data_(&data)
+	{
+	}
+
+
+	private: void do_run(engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+
+		DCS_DES_PROCESS_BEGIN;
+			DCS_DES_PROCESS_HOLD( monitor_time );
+			ptr_data_->num_busy = ptr_data_->resource.num_busy();
+			ptr_data_->num_waiting = ptr_data_->resource.num_waiting();
+			ptr_data_->num_processes = this->scheduler().num_processes();
+		DCS_DES_PROCESS_END;
+	}
+
+
+	private: model_data* ptr_data_;
+};
+
+
+/// A process without suspension points.
+class instant: public dcs::des::process<real_type>
+{
+	private: void do_run(engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+
+		DCS_DES_PROCESS_BEGIN;
+		DCS_DES_PROCESS_END;
+	}
+};
+
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+/// Jobs arriving at times 0, 1 and 2.
+struct model
+{
+	model(model_data& data, dcs::shared_ptr<des_engine_type> const& ptr_eng)
+	: ptr_data(&data),
+	  sched(ptr_eng),
+	  busy_after_spawn(0),
+	  instant_spawned(true)
+	{
+		ptr_eng->begin_of_replication_event_source().connect(
+			dcs::functional::bind(
+				&model::process_begin_of_replication,
+				this,
+				dcs::functional::placeholders::_1,
+				dcs::functional::placeholders::_2
+			)
+		);
+	}
+
+	void process_begin_of_replication(event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+
+		sched.spawn(job(*ptr_data, 1));
+		busy_after_spawn = ptr_data->resource.num_busy();
+		sched.spawn(job(*ptr_data, 2), 1);
+		sched.spawn(job(*ptr_data, 3), 2);
+		sched.spawn(monitor(*ptr_data), 0);
+		instant_spawned = sched.spawn(instant()) != 0;
+	}
+
+	model_data* ptr_data;
+	scheduler_type sched;
+	uint_type busy_after_spawn;
+	bool instant_spawned;
+};
+
+
+void test_resource(uint_type capacity, record const* expected, std::size_t n)
+{
+	dcs::shared_ptr<des_engine_type> ptr_eng(new des_engine_type(100, 1));
+	model_data data(capacity);
+	model m(data, ptr_eng);
+
+	std::cout << "Resource with " << capacity << " unit(s)" << std::endl;
+
+	ptr_eng->run();
+
+	check_equal("Zero-delay spawn runs at once", m.busy_after_spawn, uint_type(1));
+	check_equal("Terminated process not returned", m.instant_spawned, false);
+	check_equal("Busy units at the monitor time", data.num_busy, capacity);
+	check_equal("Waiting jobs at the monitor time", data.num_waiting, 3-capacity);
+	check_equal("Live processes at the monitor time", data.num_processes, uint_type(4));
+	check_equal("Live processes at the end", m.sched.num_processes(), uint_type(0));
+	check_equal("Busy units at the end", data.resource.num_busy(), uint_type(0));
+
+	check_equal("Number of records", data.records.size(), n);
+	for (std::size_t i = 0; i < n && i < data.records.size(); ++i)
+	{
+		record const& r(data.records[i]);
+		check_equal("Record", r.job == expected[i].job && r.what == expected[i].what && r.time == expected[i].time, true);
+	}
+}
+
+
+void test_invalid_release()
+{
+	resource_type resource;
+
+	std::cout << "Invalid release" << std::endl;
+
+	bool thrown(false);
+	try
+	{
+		resource.release();
+	}
+	catch (std::logic_error const&)
+	{
+		thrown = true;
+	}
+	check_equal("Release without busy units rejected", thrown, true);
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	// One unit: jobs are served one after the other, and each one gets the
+	// unit right after the previous one has released it.
+	const record single[] = {
+		{1, 'A', 0},
+		{1, 'R', 3},
+		{2, 'A', 3},
+		{2, 'R', 6},
+		{3, 'A', 6},
+		{3, 'R', 9}
+	};
+	test_resource(1, single, sizeof(single)/sizeof(single[0]));
+
+	// Two units: the third job waits for the first one.
+	const record pair[] = {
+		{1, 'A', 0},
+		{2, 'A', 1},
+		{1, 'R', 3},
+		{3, 'A', 3},
+		{2, 'R', 4},
+		{3, 'R', 6}
+	};
+	test_resource(2, pair, sizeof(pair)/sizeof(pair[0]));
+
+	test_invalid_release();
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
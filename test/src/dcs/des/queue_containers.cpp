@@ -0,0 +1,299 @@
+/**
+ * \file queue_containers.cpp
+ *
+ * \brief Test suite for the allocation-free containers backing the FCFS and
+ *  LCFS queues.
+ *
+ * Each container goes through a deterministic sequence of pushes and pops,
+ * and is compared with a standard container after every operation.
+ * The test checks that:
+ * - the ring buffer keeps FIFO order while its head and tail wrap around, and
+ *   when its capacity grows while wrapped;
+ * - the array stack keeps LIFO order, also when its capacity grows;
+ * - the segmented ring keeps FIFO order across chunk boundaries, while drained
+ *   chunks are recycled, and after being cleared;
+ * - copies (and assignments) hold the same elements and are independent of
+ *   the original container;
+ * - popped elements are released at once (e.g., customer pointers).
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <dcs/des/detail/array_stack.hpp>
+#include <dcs/des/detail/ring_buffer.hpp>
+#include <dcs/des/detail/segmented_ring.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+typedef dcs::des::detail::ring_buffer<int> ring_buffer_type;
+typedef dcs::des::detail::array_stack<int> array_stack_type;
+/// A segmented ring with small chunks, to cross chunk boundaries often.
+typedef dcs::des::detail::segmented_ring<int,4> segmented_ring_type;
+
+
+/// Number of operations of each sequence.
+const int num_ops = 1000;
+
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+/// Tell if the next operation of a sequence is a push, with pushes prevailing
+/// in the first half of the sequence and pops in the second one.
+bool next_is_push(int i)
+{
+	const int r((i*7919) % 10);
+
+	return i < num_ops/2 ? r < 6 : r < 4;
+}
+
+
+/// Return the elements of a ring buffer, from the front.
+std::deque<int> contents(ring_buffer_type c)
+{
+	std::deque<int> d;
+	while (!c.empty())
+	{
+		d.push_back(c.front());
+		c.pop_front();
+	}
+	return d;
+}
+
+
+/// Return the elements of a segmented ring, from the front.
+std::deque<int> contents(segmented_ring_type const& c)
+{
+	return std::deque<int>(c.begin(), c.end());
+}
+
+
+void test_ring_buffer()
+{
+	const std::size_t capacity(5);
+
+	ring_buffer_type buf(capacity);
+	std::deque<int> ref;
+	bool same(true);
+	bool wrapped(false);
+
+	std::cout << "Ring buffer" << std::endl;
+
+	for (int i = 0; i < num_ops; ++i)
+	{
+		if (next_is_push(i) && !buf.full())
+		{
+			buf.push_back(i);
+			ref.push_back(i);
+		}
+		else if (!buf.empty())
+		{
+			buf.pop_front();
+			ref.pop_front();
+			wrapped = true;
+		}
+		same = same && buf.size() == ref.size() && (ref.empty() || buf.front() == ref.front());
+	}
+	check_equal("FIFO order with wraparound", same && wrapped, true);
+
+	// Wrap the buffer around, then grow it.
+	buf.clear();
+	ref.clear();
+	for (int i = 0; i < 4; ++i)
+	{
+		buf.push_back(i);
+		ref.push_back(i);
+	}
+	buf.pop_front();
+	buf.pop_front();
+	ref.pop_front();
+	ref.pop_front();
+	for (int i = 4; i < 7; ++i)
+	{
+		buf.push_back(i);
+		ref.push_back(i);
+	}
+	buf.reserve(2*capacity);
+	for (int i = 7; i < 12; ++i)
+	{
+		buf.push_back(i);
+		ref.push_back(i);
+	}
+	check_equal("Capacity after growth", buf.capacity(), 2*capacity);
+	check_equal("FIFO order after growth", contents(buf) == ref, true);
+
+	ring_buffer_type copy(buf);
+	copy.pop_front();
+	copy.push_back(100);
+	check_equal("Copy independent of the original", contents(buf) == ref, true);
+	ref.pop_front();
+	ref.push_back(100);
+	check_equal("Copy contents", contents(copy) == ref, true);
+}
+
+
+void test_array_stack()
+{
+	array_stack_type stack(3);
+	std::vector<int> ref;
+	bool same(true);
+
+	std::cout << "Array stack" << std::endl;
+
+	for (int i = 0; i < num_ops; ++i)
+	{
+		if (next_is_push(i))
+		{
+			if (stack.full())
+			{
+				stack.reserve(2*stack.capacity());
+			}
+			stack.push(i);
+			ref.push_back(i);
+		}
+		else if (!stack.empty())
+		{
+			stack.pop();
+			ref.pop_back();
+		}
+		same = same && stack.size() == ref.size() && (ref.empty() || stack.top() == ref.back());
+	}
+	check_equal("LIFO order with growth", same, true);
+
+	array_stack_type copy(stack);
+	if (!copy.empty())
+	{
+		copy.pop();
+	}
+	copy.push(-1);
+	check_equal("Copy independent of the original", stack.size() == ref.size() && (ref.empty() || stack.top() == ref.back()), true);
+	check_equal("Copy top", copy.top(), -1);
+}
+
+
+void test_segmented_ring()
+{
+	segmented_ring_type ring;
+	std::deque<int> ref;
+	bool same(true);
+
+	std::cout << "Segmented ring" << std::endl;
+
+	for (int i = 0; i < num_ops; ++i)
+	{
+		if (next_is_push(i))
+		{
+			ring.push_back(i);
+			ref.push_back(i);
+		}
+		else if (!ring.empty())
+		{
+			ring.pop_front();
+			ref.pop_front();
+		}
+		same = same && ring.size() == ref.size() && (ref.empty() || (ring.front() == ref.front() && ring.back() == ref.back()));
+
+		if (i == num_ops/2)
+		{
+			check_equal("Contents across chunks", contents(ring) == ref, true);
+
+			segmented_ring_type copy(ring);
+			segmented_ring_type assigned;
+			assigned.push_back(-1);
+			assigned = ring;
+			copy.push_back(-1);
+			assigned.pop_front();
+			check_equal("Copy independent of the original", contents(ring) == ref, true);
+			check_equal("Copy size", copy.size(), ref.size()+1);
+			check_equal("Assigned size", assigned.size(), ref.size()-1);
+		}
+	}
+	check_equal("FIFO order with recycled chunks", same, true);
+
+	ring.clear();
+	ref.clear();
+	for (int i = 0; i < 10; ++i)
+	{
+		ring.push_back(i);
+		ref.push_back(i);
+	}
+	check_equal("FIFO order after clear", contents(ring) == ref, true);
+}
+
+
+void test_release()
+{
+	typedef dcs::des::detail::segmented_ring<dcs::shared_ptr<int>,4> pointer_ring_type;
+	typedef dcs::des::detail::ring_buffer< dcs::shared_ptr<int> > pointer_buffer_type;
+	typedef dcs::des::detail::array_stack< dcs::shared_ptr<int> > pointer_stack_type;
+
+	dcs::shared_ptr<int> ptr(new int(0));
+	pointer_ring_type ring;
+	pointer_buffer_type buf(2);
+	pointer_stack_type stack(2);
+
+	std::cout << "Release of popped elements" << std::endl;
+
+	ring.push_back(ptr);
+	buf.push_back(ptr);
+	stack.push(ptr);
+	check_equal("References while queued", ptr.use_count(), 4L);
+
+	ring.pop_front();
+	buf.pop_front();
+	stack.pop();
+	check_equal("References after popping", ptr.use_count(), 1L);
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_ring_buffer();
+	test_array_stack();
+	test_segmented_ring();
+	test_release();
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,252 @@
+/**
+ * \file replication_farm.cpp
+ *
+ * \brief Test suite for the multi-process replication farm.
+ *
+ * Replications return a uniform number drawn from a generator seeded with the
+ * replication seed.
+ * The test checks that:
+ * - the estimate is the mean of the outputs of the first replications, in
+ *   replication order, and does not depend on the number of workers;
+ * - a worker dying while running a replication is replaced, and the
+ *   replication is run again with the same seed (so that the results do not
+ *   change), unless the maximum number of retries is exceeded;
+ * - an exception thrown by a replication makes the run fail with its message;
+ * - all the worker processes are reaped at the end of every run, either
+ *   successful or failed.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <boost/random/uniform_01.hpp>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <dcs/des/random_substream.hpp>
+#include <dcs/des/replications/replication_farm.hpp>
+#include <dcs/macro.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::replications::replication_farm<real_type,uint_type> farm_type;
+
+
+/// Target relative precision of the runs.
+const real_type relative_precision = 0.01;
+/// Replication whose worker dies or which throws an exception.
+const uint_type faulty_replication = 3;
+/// File whose removal tells the first run of the faulty replication.
+const char crash_marker[] = "replication_farm.crash";
+
+
+/// Replication returning a uniform number in [10,11).
+real_type replicate(uint_type replication, unsigned long seed)
+{
+	DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( replication );
+
+	random_generator_type rng(seed);
+
+	return 10+boost::uniform_01<random_generator_type&,real_type>(rng)();
+}
+
+
+/// Replication whose worker dies on the first run of the faulty replication
+/// (or on every run, if the crash is permanent).
+struct crashing_replication
+{
+	explicit crashing_replication(bool permanent)
+	: permanent(permanent)
+	{
+	}
+
+	real_type operator()(uint_type replication, unsigned long seed) const
+	{
+		// Only one process can remove the marker file.
+		if (replication == faulty_replication && (permanent || std::remove(crash_marker) == 0))
+		{
+			::_exit(EXIT_FAILURE);
+		}
+
+		return replicate(replication, seed);
+	}
+
+	bool permanent;
+};
+
+
+/// Replication throwing an exception when running the faulty replication.
+real_type throwing_replication(uint_type replication, unsigned long seed)
+{
+	if (replication == faulty_replication)
+	{
+		throw std::runtime_error("Faulty replication");
+	}
+
+	return replicate(replication, seed);
+}
+
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void check_close(char const* name, real_type actual, real_type expected)
+{
+	bool ok(std::abs(actual-expected) <= 1e-12*std::abs(expected));
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+/// Tell if all the child processes have been reaped.
+bool no_children()
+{
+	return ::waitpid(-1, 0, WNOHANG) < 0 && errno == ECHILD;
+}
+
+
+/// Return the mean of the outputs of the first \a n replications.
+real_type expected_estimate(uint_type n)
+{
+	real_type sum(0);
+	for (uint_type i = 0; i < n; ++i)
+	{
+		sum += replicate(i, dcs::des::substream_seed(farm_type::default_seed, i));
+	}
+	return sum/static_cast<real_type>(n);
+}
+
+
+void test_results()
+{
+	farm_type farm1(1, relative_precision);
+	farm_type farm3(3, relative_precision);
+
+	std::cout << "Results" << std::endl;
+
+	check_equal("Precision reached (1 worker)", farm1.run(&replicate), true);
+	check_equal("Precision reached (3 workers)", farm3.run(&replicate), true);
+	check_equal("Workers reaped", no_children(), true);
+	check_equal("Number of replications", farm3.num_replications(), farm1.num_replications());
+	check_equal("Estimate", farm3.estimate(), farm1.estimate());
+	check_close("Estimate of the first replications", farm1.estimate(), expected_estimate(farm1.num_replications()));
+	check_equal("Relative precision", farm1.relative_precision() <= relative_precision, true);
+}
+
+
+void test_crash()
+{
+	farm_type farm_ref(2, relative_precision);
+	farm_type farm(2, relative_precision);
+
+	std::cout << "Crashing worker" << std::endl;
+
+	farm_ref.run(&replicate);
+
+	std::FILE* marker(std::fopen(crash_marker, "w"));
+	if (marker)
+	{
+		std::fclose(marker);
+	}
+
+	check_equal("Precision reached", farm.run(crashing_replication(false)), true);
+	check_equal("Number of crashes", farm.num_crashes(), uint_type(1));
+	check_equal("Estimate unchanged", farm.estimate(), farm_ref.estimate());
+	check_equal("Workers reaped", no_children(), true);
+
+	farm.max_num_retries(0);
+
+	std::string what;
+	try
+	{
+		farm.run(crashing_replication(true));
+	}
+	catch (std::runtime_error const& e)
+	{
+		what = e.what();
+	}
+	check_equal("Too many crashes", what.find("worker died too many times") != std::string::npos, true);
+	check_equal("Workers reaped after a failure", no_children(), true);
+}
+
+
+void test_exception()
+{
+	farm_type farm(2, relative_precision);
+
+	std::cout << "Throwing replication" << std::endl;
+
+	std::string what;
+	try
+	{
+		farm.run(&throwing_replication);
+	}
+	catch (std::runtime_error const& e)
+	{
+		what = e.what();
+	}
+	check_equal("Exception reported", what.find("Faulty replication") != std::string::npos, true);
+	check_equal("Workers reaped after a failure", no_children(), true);
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_results();
+	test_crash();
+	test_exception();
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,291 @@
+/**
+ * \file replications_analyzable_statistic.cpp
+ *
+ * \brief Test suite for the transient phase deletion of the independent
+ *  replications output statistic.
+ *
+ * Each replication produces a fixed sequence of observations: a transient
+ * phase of large values followed by a steady state of unit values.
+ * A scripted transient phase detector recognizes the transient phase after a
+ * given number of observations and hands back the steady-state observations it
+ * consumed; replication size is fixed in advance.
+ * The test checks that:
+ * - the transient phase length is recorded;
+ * - the steady-state observations consumed by the detector are put back;
+ * - transient observations are deleted even though the replication size is
+ *   known from the start (so that the estimate is exactly 1);
+ * - with the pilot warm-up enabled, the detector only runs in the pilot
+ *   replications, and the later replications delete exactly the truncation
+ *   point estimated by the pilots (the longest transient phase times the
+ *   safety factor).
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/engine_traits.hpp>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/replications/analyzable_statistic.hpp>
+#include <dcs/des/replications/constant_num_replications_detector.hpp>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/des/replications/fixed_num_obs_replication_size_detector.hpp>
+#include <dcs/functional/bind.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+
+
+/// Number of transient observations of each replication.
+const uint_type transient_length = 6;
+/// Number of observations the transient detector needs to detect.
+const uint_type detection_length = 10;
+/// Number of steady-state observations of each replication.
+const uint_type replication_size = 20;
+/// Number of replications asked to the replications detector.
+const uint_type num_replications = 3;
+/// Number of pilot replications estimating the warm-up.
+const uint_type num_pilots = 2;
+/// Safety factor of the warm-up estimated by pilot replications.
+const real_type pilot_safety_factor = 1.5;
+
+
+/**
+ * \brief Transient phase detector recognizing a transient phase of
+ *  \c transient_length observations after \c detection_length observations.
+ */
+class scripted_transient_detector
+{
+	public: typedef double real_type;
+	public: typedef ::std::size_t uint_type;
+	public: typedef ::std::pair<real_type,real_type> sample_type;
+	public: typedef ::std::vector<sample_type> sample_container;
+
+
+	/// Number of observations passed to all the scripted detectors.
+	public: static uint_type num_detect_calls;
+
+
+	public: bool detect(real_type obs, real_type weight)
+	{
+		++num_detect_calls;
+		obs_.push_back(::std::make_pair(obs, weight));
+
+		return detected();
+	}
+
+
+	public: bool aborted() const
+	{
+		return false;
+	}
+
+
+	public: bool detected() const
+	{
+		return obs_.size() >= detection_length;
+	}
+
+
+	public: uint_type estimated_size() const
+	{
+		return transient_length;
+	}
+
+
+	public: void reset()
+	{
+		obs_.clear();
+	}
+
+
+	public: sample_container steady_state_observations() const
+	{
+		return sample_container(obs_.begin()+transient_length, obs_.end());
+	}
+
+
+	private: sample_container obs_;
+};
+
+scripted_transient_detector::uint_type scripted_transient_detector::num_detect_calls = 0;
+
+
+typedef dcs::des::replications::engine<real_type,uint_type> des_engine_type;
+typedef dcs::des::engine_traits<des_engine_type>::event_type event_type;
+typedef dcs::des::engine_traits<des_engine_type>::engine_context_type engine_context_type;
+typedef dcs::des::engine_traits<des_engine_type>::event_source_type event_source_type;
+typedef dcs::des::mean_estimator<real_type,uint_type> statistic_type;
+typedef dcs::des::replications::fixed_num_obs_replication_size_detector<real_type,uint_type> replication_size_detector_type;
+typedef dcs::des::replications::constant_num_replications_detector<real_type,uint_type> num_replications_detector_type;
+typedef dcs::des::replications::analyzable_statistic<
+			statistic_type,
+			scripted_transient_detector,
+			replication_size_detector_type,
+			num_replications_detector_type
+		> analyzable_statistic_type;
+
+
+/// Model producing a transient phase of large values followed by unit values.
+struct model
+{
+	void initialize(event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+
+		num_obs = 0;
+		ptr_eng->schedule_event(ptr_evt_src, ptr_eng->simulated_time()+1);
+	}
+
+
+	void observe(event_type const& evt, engine_context_type& ctx)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( evt );
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( ctx );
+
+		(*ptr_stat)(num_obs < transient_length ? 100 : 1);
+		++num_obs;
+		ptr_eng->schedule_event(ptr_evt_src, ptr_eng->simulated_time()+1);
+	}
+
+
+	des_engine_type* ptr_eng;
+	dcs::shared_ptr<event_source_type> ptr_evt_src;
+	dcs::shared_ptr<analyzable_statistic_type> ptr_stat;
+	uint_type num_obs;
+};
+
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+/// Build the model and its output statistic on the given engine.
+void setup(des_engine_type& eng, model& m)
+{
+	m.ptr_eng = &eng;
+	m.ptr_evt_src = dcs::make_shared<event_source_type>("Observation");
+	m.ptr_stat = dcs::des::make_analyzable_statistic(
+			statistic_type(),
+			scripted_transient_detector(),
+			replication_size_detector_type(replication_size),
+			num_replications_detector_type(num_replications),
+			eng,
+			0.01,
+			analyzable_statistic_type::default_max_num_obs
+		);
+	m.num_obs = 0;
+
+	eng.system_initialization_event_source().connect(
+			dcs::functional::bind(
+				&model::initialize,
+				&m,
+				dcs::functional::placeholders::_1,
+				dcs::functional::placeholders::_2
+			)
+		);
+	m.ptr_evt_src->connect(
+			dcs::functional::bind(
+				&model::observe,
+				&m,
+				dcs::functional::placeholders::_1,
+				dcs::functional::placeholders::_2
+			)
+		);
+}
+
+
+void test_transient_deletion()
+{
+	des_engine_type eng;
+	model m;
+
+	setup(eng, m);
+
+	eng.run();
+
+	std::cout << "Transient phase detection" << std::endl;
+	check_equal("Steady state entered", m.ptr_stat->steady_state_entered(), true);
+	check_equal("Transient phase length", m.ptr_stat->transient_phase_length(), transient_length);
+	// Observations used for detection are not lost: the replication lasts
+	// exactly the transient phase plus the replication size.
+	check_equal("Observations per replication", m.num_obs, transient_length+replication_size);
+	check_equal("Estimate", m.ptr_stat->estimate(), real_type(1));
+}
+
+
+void test_pilot_warmup()
+{
+	des_engine_type eng;
+	model m;
+
+	setup(eng, m);
+	m.ptr_stat->enable_pilot_warmup(num_pilots, pilot_safety_factor);
+	scripted_transient_detector::num_detect_calls = 0;
+
+	eng.run();
+
+	const uint_type truncation_point(static_cast<uint_type>(::std::ceil(transient_length*pilot_safety_factor)));
+
+	std::cout << "Pilot warm-up" << std::endl;
+	check_equal("Warm-up fixed", m.ptr_stat->pilot_warmup_fixed(), true);
+	check_equal("Truncation point", m.ptr_stat->pilot_truncation_point(), truncation_point);
+	// The detector only runs in pilot replications
+	check_equal("Observations passed to the detector", scripted_transient_detector::num_detect_calls, num_pilots*detection_length);
+	// The last replication deletes exactly the truncation point
+	check_equal("Transient phase length", m.ptr_stat->transient_phase_length(), truncation_point);
+	check_equal("Observations per replication", m.num_obs, truncation_point+replication_size);
+	check_equal("Estimate", m.ptr_stat->estimate(), real_type(1));
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_transient_deletion();
+	test_pilot_warmup();
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
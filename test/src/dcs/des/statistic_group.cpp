@@ -0,0 +1,334 @@
+/**
+ * \file statistic_group.cpp
+ *
+ * \brief Test suite for the decisions of a group of Batch Means output
+ *  statistics.
+ *
+ * The group has two members producing a transient phase of large values
+ * followed by constant values.
+ * Scripted detectors derive from the steady-state value both the time taken
+ * to detect the end of the transient phase and the batch size.
+ * The lead member has the longest transient phase but detects it first, while
+ * the other member detects its shorter transient phase last and has the
+ * largest batch size.
+ * The test checks that:
+ * - the truncation point of the group and the batch size are the ones of the
+ *   lead member with the lead series policy, and the largest ones with the
+ *   most conservative policy (not the ones of the member detecting last);
+ * - both members put back exactly their observations past the truncation
+ *   point of the group;
+ * - members build their batch means from their own blocks.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/batch_means/statistic_group.hpp>
+#include <dcs/macro.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+/// Observations greater than this are transient ones.
+const double transient_threshold = 10;
+/// Number of steady-state observations per unit of steady-state value the
+/// transient detector needs to detect.
+const ::std::size_t detection_lag = 2;
+/// Number of observations the batch size detector needs to detect.
+const ::std::size_t size_detection_length = 4;
+/// Number of observations whose mean is accumulated by members.
+const ::std::size_t block_size = 10;
+/// Number of steady-state observations fed to each member.
+const ::std::size_t num_steady_obs = 100;
+
+
+/**
+ * \brief Transient phase detector taking as transient the leading
+ *  observations greater than \c transient_threshold, and detecting after
+ *  \c detection_lag steady-state observations per unit of the first
+ *  steady-state value.
+ */
+class scripted_transient_detector
+{
+	public: typedef double real_type;
+	public: typedef ::std::size_t uint_type;
+	public: typedef ::std::pair<real_type,real_type> sample_type;
+	public: typedef ::std::vector<sample_type> sample_container;
+
+
+	public: scripted_transient_detector()
+	: num_trans_(0),
+	  num_steady_(0),
+	  lag_(0)
+	{
+	}
+
+
+	public: bool detect(real_type obs, real_type weight)
+	{
+		obs_.push_back(::std::make_pair(obs, weight));
+		if (obs > transient_threshold && num_steady_ == 0)
+		{
+			++num_trans_;
+		}
+		else
+		{
+			if (num_steady_++ == 0)
+			{
+				lag_ = static_cast<uint_type>(obs*detection_lag);
+			}
+		}
+
+		return detected();
+	}
+
+
+	public: bool aborted() const
+	{
+		return false;
+	}
+
+
+	public: bool detected() const
+	{
+		return num_steady_ > 0 && num_steady_ >= lag_;
+	}
+
+
+	public: uint_type estimated_size() const
+	{
+		return num_trans_;
+	}
+
+
+	public: void reset()
+	{
+		obs_.clear();
+		num_trans_ = num_steady_
+				   = lag_
+				   = 0;
+	}
+
+
+	public: sample_container steady_state_observations() const
+	{
+		return sample_container(obs_.begin()+num_trans_, obs_.end());
+	}
+
+
+	private: sample_container obs_;
+	private: uint_type num_trans_;
+	private: uint_type num_steady_;
+	private: uint_type lag_;
+};
+
+
+/**
+ * \brief Batch size detector detecting after \c size_detection_length
+ *  observations a batch size of ten times its first observation.
+ */
+class scripted_batch_size_detector
+{
+	public: typedef double real_type;
+	public: typedef ::std::size_t uint_type;
+	public: typedef ::std::vector<real_type> vector_type;
+
+
+	public: scripted_batch_size_detector()
+	: num_obs_(0),
+	  size_(0)
+	{
+	}
+
+
+	public: bool detect(real_type obs, real_type weight)
+	{
+		DCS_MACRO_SUPPRESS_UNUSED_VARIABLE_WARNING( weight );
+
+		if (num_obs_++ == 0)
+		{
+			size_ = static_cast<uint_type>(obs*10);
+		}
+
+		return num_obs_ >= size_detection_length;
+	}
+
+
+	public: bool aborted() const
+	{
+		return false;
+	}
+
+
+	public: uint_type estimated_size() const
+	{
+		return size_;
+	}
+
+
+	public: void reset()
+	{
+		num_obs_ = size_
+				 = 0;
+	}
+
+
+	private: uint_type num_obs_;
+	private: uint_type size_;
+};
+
+
+typedef scripted_transient_detector::real_type real_type;
+typedef scripted_transient_detector::uint_type uint_type;
+typedef dcs::des::batch_means::statistic_group<scripted_transient_detector,scripted_batch_size_detector> group_type;
+typedef dcs::des::batch_means::group_transient_detector<group_type> member_transient_detector_type;
+typedef dcs::des::batch_means::group_batch_size_detector<group_type> member_batch_size_detector_type;
+
+
+/// A member of the group, with its transient length and steady-state value.
+struct member
+{
+	member(dcs::shared_ptr<group_type> const& ptr_group, bool lead, uint_type trans_len, real_type value)
+	: id(ptr_group->add_member(lead)),
+	  trans_det(ptr_group, id),
+	  size_det(ptr_group, id),
+	  trans_len(trans_len),
+	  value(value),
+	  num_obs(0)
+	{
+	}
+
+	real_type next()
+	{
+		return num_obs++ < trans_len ? 100 : value;
+	}
+
+	group_type::member_identifier_type id;
+	member_transient_detector_type trans_det;
+	member_batch_size_detector_type size_det;
+	uint_type trans_len;
+	real_type value;
+	uint_type num_obs;
+};
+
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+/// Tell if all the given observations have the given value.
+bool all_equal(scripted_transient_detector::sample_container const& obs, real_type value)
+{
+	for (::std::size_t i = 0; i < obs.size(); ++i)
+	{
+		if (obs[i].first != value)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+void test_policy(dcs::des::batch_means::statistic_group_policy policy, char const* name)
+{
+	dcs::shared_ptr<group_type> ptr_group(new group_type(policy, scripted_transient_detector(), scripted_batch_size_detector(), block_size));
+
+	// Transient phase of 7 observations detected after 7+2 observations, and
+	// batch size of 10.
+	member lead_member(ptr_group, true, 7, 1);
+	// Transient phase of 3 observations detected after 3+10 observations, and
+	// batch size of 50.
+	member other_member(ptr_group, false, 3, 5);
+
+	const bool conservative(policy == dcs::des::batch_means::most_conservative_group_policy);
+	const uint_type trans_len(lead_member.trans_len);
+	const uint_type batch_size(static_cast<uint_type>((conservative ? other_member.value : lead_member.value)*10));
+
+	std::cout << "Policy: " << name << std::endl;
+
+	// Transient phase: observations are interleaved, as for members observed
+	// at the same rate.
+	while (!ptr_group->transient_phase_detected())
+	{
+		lead_member.trans_det.detect(lead_member.next(), 1);
+		other_member.trans_det.detect(other_member.next(), 1);
+	}
+
+	check_equal("Truncation point", ptr_group->decider_transient_length(), trans_len);
+	check_equal("Warm-up of the lead member", lead_member.trans_det.estimated_size(), trans_len);
+	check_equal("Warm-up of the other member", other_member.trans_det.estimated_size(), trans_len);
+
+	scripted_transient_detector::sample_container lead_obs(lead_member.trans_det.steady_state_observations());
+	scripted_transient_detector::sample_container other_obs(other_member.trans_det.steady_state_observations());
+
+	check_equal("Put back by the lead member", lead_obs.size(), ::std::size_t(lead_member.num_obs-trans_len));
+	check_equal("Put back by the other member", other_obs.size(), ::std::size_t(other_member.num_obs-trans_len));
+	check_equal("Put back steady-state values only", all_equal(lead_obs, lead_member.value) && all_equal(other_obs, other_member.value), true);
+
+	lead_member.trans_det.reset();
+	other_member.trans_det.reset();
+
+	// Batch size detection
+	for (::std::size_t i = 0; i < num_steady_obs; ++i)
+	{
+		lead_member.size_det.detect(lead_member.next(), 1);
+		other_member.size_det.detect(other_member.next(), 1);
+	}
+
+	check_equal("Batch size detected", ptr_group->batch_size_detected(), true);
+	check_equal("Batch size", ptr_group->batch_size(), batch_size);
+
+	member_batch_size_detector_type::vector_type other_means(other_member.size_det.computed_estimators());
+
+	check_equal("Batch means of the other member", other_means.size(), ::std::size_t(num_steady_obs/batch_size));
+	check_equal("Batch mean value of the other member", other_means.empty() ? real_type(0) : other_means.front(), other_member.value);
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_policy(dcs::des::batch_means::lead_series_group_policy, "lead series");
+	test_policy(dcs::des::batch_means::most_conservative_group_policy, "most conservative");
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,259 @@
+/**
+ * \file superposed_arrivals.cpp
+ *
+ * \brief Test suite for the superposition of Poisson arrival streams.
+ *
+ * The test checks that:
+ * - the alias table samples every outcome with a frequency close to its
+ *   normalized weight, never samples outcomes with a null weight, and rejects
+ *   negative or all-null weights;
+ * - a source node merging its Poisson classes into a single arrival chain
+ *   generates the customers of every class at the rate of that class, as a
+ *   source node keeping a chain per class does.
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/base_analyzable_statistic.hpp>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/model/qn/deterministic_routing_strategy.hpp>
+#include <dcs/des/model/qn/detail/alias_table.hpp>
+#include <dcs/des/model/qn/open_customer_class.hpp>
+#include <dcs/des/model/qn/output_statistic_category.hpp>
+#include <dcs/des/model/qn/queueing_network.hpp>
+#include <dcs/des/model/qn/queueing_network_traits.hpp>
+#include <dcs/des/model/qn/sink_node.hpp>
+#include <dcs/des/model/qn/source_node.hpp>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <dcs/math/stats/distributions.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::model::qn::detail::alias_table<real_type> alias_table_type;
+typedef dcs::des::replications::engine<real_type,uint_type> des_engine_type;
+typedef dcs::des::base_analyzable_statistic<real_type,uint_type> analyzable_statistic_type;
+typedef dcs::des::model::qn::queueing_network<uint_type,real_type,random_generator_type,des_engine_type> network_type;
+typedef dcs::des::model::qn::queueing_network_traits<network_type> network_traits_type;
+typedef dcs::des::model::qn::open_customer_class<network_traits_type> customer_class_type;
+typedef dcs::des::model::qn::source_node<network_traits_type> source_node_type;
+typedef dcs::des::model::qn::sink_node<network_traits_type> sink_node_type;
+typedef dcs::des::model::qn::deterministic_routing_strategy<network_traits_type> routing_strategy_type;
+
+
+/// Number of samples drawn from the alias table.
+const uint_type num_samples = 1000000;
+/// Largest difference between a sampled frequency and its probability.
+const real_type frequency_tolerance = 0.003;
+/// Simulation length.
+const real_type sim_length = 20000;
+/// Largest relative difference between a class rate and its estimate.
+const real_type rate_tolerance = 0.04;
+
+
+int num_failures = 0;
+
+
+template <typename T>
+void check_equal(char const* name, T actual, T expected)
+{
+	bool ok(actual == expected);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void check_close(char const* name, real_type actual, real_type expected, real_type tol)
+{
+	bool ok(std::abs(actual-expected) <= tol);
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void test_alias_table()
+{
+	std::vector<real_type> weights;
+	weights.push_back(1);
+	weights.push_back(2);
+	weights.push_back(0);
+	weights.push_back(3);
+	weights.push_back(4);
+	const real_type sum_weights(10);
+
+	alias_table_type table(weights.begin(), weights.end());
+	random_generator_type rng(5489UL);
+	std::vector<uint_type> counts(weights.size(), 0);
+
+	std::cout << "Alias table" << std::endl;
+
+	check_equal("Number of outcomes", table.size(), weights.size());
+
+	for (uint_type i = 0; i < num_samples; ++i)
+	{
+		++counts[table(rng)];
+	}
+	for (std::size_t k = 0; k < weights.size(); ++k)
+	{
+		check_close("Frequency", real_type(counts[k])/real_type(num_samples), weights[k]/sum_weights, frequency_tolerance);
+	}
+	check_equal("Null weight never sampled", counts[2], uint_type(0));
+
+	std::vector<real_type> single(3, 0);
+	single[1] = 5;
+	table.assign(single.begin(), single.end());
+	bool same(true);
+	for (uint_type i = 0; i < 1000; ++i)
+	{
+		same = same && table(rng) == 1;
+	}
+	check_equal("Single positive weight always sampled", same, true);
+}
+
+
+void test_invalid_weights()
+{
+	alias_table_type table;
+
+	std::cout << "Invalid weights" << std::endl;
+
+	std::vector<real_type> weights(2, 1);
+	weights[1] = -1;
+	bool thrown(false);
+	try
+	{
+		table.assign(weights.begin(), weights.end());
+	}
+	catch (std::invalid_argument const&)
+	{
+		thrown = true;
+	}
+	check_equal("Negative weight rejected", thrown, true);
+
+	weights[1] = 0;
+	weights[0] = 0;
+	thrown = false;
+	try
+	{
+		table.assign(weights.begin(), weights.end());
+	}
+	catch (std::invalid_argument const&)
+	{
+		thrown = true;
+	}
+	check_equal("All-null weights rejected", thrown, true);
+}
+
+
+/**
+ * \brief Simulate a source sending the customers of every class to a sink of
+ *  its own, and compare the arrival rate at every sink with the class rate.
+ */
+void test_class_rates(bool superpose)
+{
+	std::vector<real_type> rates;
+	rates.push_back(0.5);
+	rates.push_back(1);
+	rates.push_back(1.5);
+	const uint_type num_classes(rates.size());
+	const uint_type source_node_id(0);
+
+	dcs::shared_ptr<des_engine_type> ptr_eng = dcs::make_shared<des_engine_type>(sim_length, 1);
+	dcs::shared_ptr<random_generator_type> ptr_rng = dcs::make_shared<random_generator_type>(5489UL);
+
+	network_type qn(ptr_rng, ptr_eng);
+
+	// Class c goes to the sink with identifier c+1.
+	dcs::shared_ptr<routing_strategy_type> ptr_routing = dcs::make_shared<routing_strategy_type>();
+	for (uint_type c = 0; c < num_classes; ++c)
+	{
+		ptr_routing->add_route(source_node_id, c, c+1, c);
+	}
+
+	dcs::shared_ptr<source_node_type> ptr_source = dcs::make_shared<source_node_type>(source_node_id, "Source", ptr_routing);
+	ptr_source->superpose_poisson_classes(superpose);
+	qn.add_node(ptr_source);
+
+	std::vector< dcs::shared_ptr<analyzable_statistic_type> > arrival_stats;
+	for (uint_type c = 0; c < num_classes; ++c)
+	{
+		dcs::shared_ptr<sink_node_type> ptr_sink = dcs::make_shared<sink_node_type>(c+1, "Sink");
+		dcs::shared_ptr<analyzable_statistic_type> ptr_stat = ptr_eng->make_analyzable_statistic(dcs::des::mean_estimator<real_type,uint_type>());
+		ptr_sink->statistic(dcs::des::model::qn::num_arrivals_statistic_category, ptr_stat);
+		arrival_stats.push_back(ptr_stat);
+		qn.add_node(ptr_sink);
+	}
+
+	for (uint_type c = 0; c < num_classes; ++c)
+	{
+		dcs::shared_ptr<customer_class_type> ptr_class = dcs::make_shared<customer_class_type>(
+				c,
+				"Open Class",
+				dcs::math::stats::exponential_distribution<real_type>(rates[c])
+			);
+		ptr_class->reference_node(source_node_id);
+		qn.add_class(ptr_class);
+	}
+
+	std::cout << (superpose ? "Superposed classes" : "Separate classes") << std::endl;
+
+	ptr_eng->run();
+
+	for (uint_type c = 0; c < num_classes; ++c)
+	{
+		check_close("Class arrival rate", arrival_stats[c]->estimate()/sim_length, rates[c], rate_tolerance*rates[c]);
+	}
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_alias_table();
+	test_invalid_weights();
+	test_class_rates(false);
+	test_class_rates(true);
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,117 @@
+/**
+ * \file tandem_line_evaluator.cpp
+ *
+ * \brief Test suite for the max-plus (Lindley) tandem line evaluator.
+ *
+ * Evaluates an M/M/1 station and checks the per-customer observations against
+ * the closed-form results:
+ * - the mean number of waiting customers just after an arrival (the arriving
+ *   customer included when it has to wait) is rho/(1-rho), since by PASTA an
+ *   arrival sees the time-stationary number of customers in the station;
+ * - the mean waiting time is rho/(mu-lambda);
+ * - the mean response time is 1/(mu-lambda).
+ *
+ * Copyright (C) 2009-2012  Distributed Computing System (DCS) Group,
+ *                          Computer Science Institute,
+ *                          Department of Science and Technological Innovation,
+ *                          University of Piemonte Orientale,
+ *                          Alessandria (Italy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * \author Marco Guazzone (marco.guazzone@gmail.com)
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <dcs/des/mean_estimator.hpp>
+#include <dcs/des/model/qn/output_statistic_category.hpp>
+#include <dcs/des/model/qn/queueing_network.hpp>
+#include <dcs/des/model/qn/queueing_network_traits.hpp>
+#include <dcs/des/model/qn/tandem_line_evaluator.hpp>
+#include <dcs/des/replications/engine.hpp>
+#include <dcs/math/random/mersenne_twister.hpp>
+#include <dcs/math/stats/distributions.hpp>
+#include <dcs/memory.hpp>
+#include <iostream>
+
+
+namespace /*<unnamed>*/ {
+
+typedef double real_type;
+typedef ::std::size_t uint_type;
+typedef dcs::math::random::mt19937 random_generator_type;
+typedef dcs::des::replications::engine<real_type,uint_type> des_engine_type;
+typedef dcs::des::model::qn::queueing_network<uint_type,real_type,random_generator_type,des_engine_type> network_type;
+typedef dcs::des::model::qn::queueing_network_traits<network_type> network_traits_type;
+typedef dcs::des::model::qn::tandem_line_evaluator<network_traits_type> evaluator_type;
+typedef dcs::des::mean_estimator<real_type,uint_type> statistic_type;
+
+
+/// Relative tolerance of the comparisons with the closed-form results.
+const real_type tolerance = 0.03;
+
+int num_failures = 0;
+
+
+void check_close(char const* name, real_type actual, real_type expected)
+{
+	bool ok(std::abs(actual-expected) <= tolerance*std::abs(expected));
+
+	std::cout << (ok ? "[PASS] " : "[FAIL] ") << name << ": " << actual << " (expected: " << expected << ")" << std::endl;
+
+	if (!ok)
+	{
+		++num_failures;
+	}
+}
+
+
+void test_mm1(real_type lambda, real_type mu)
+{
+	const real_type horizon(2e6/lambda);
+	const real_type rho(lambda/mu);
+
+	random_generator_type rng(5489UL);
+
+	evaluator_type eval(dcs::math::stats::make_any_distribution(dcs::math::stats::exponential_distribution<real_type>(lambda)));
+	evaluator_type::size_type k(eval.add_station(dcs::math::stats::make_any_distribution(dcs::math::stats::exponential_distribution<real_type>(mu))));
+
+	dcs::shared_ptr<statistic_type> ptr_nw_stat(new statistic_type());
+	dcs::shared_ptr<statistic_type> ptr_wt_stat(new statistic_type());
+	dcs::shared_ptr<statistic_type> ptr_rt_stat(new statistic_type());
+	eval.statistic(k, dcs::des::model::qn::num_waiting_statistic_category, ptr_nw_stat);
+	eval.statistic(k, dcs::des::model::qn::waiting_time_statistic_category, ptr_wt_stat);
+	eval.statistic(k, dcs::des::model::qn::response_time_statistic_category, ptr_rt_stat);
+
+	eval.evaluate(horizon, rng);
+
+	std::cout << "M/M/1 (lambda: " << lambda << ", mu: " << mu << ")" << std::endl;
+	check_close("Number waiting at arrivals", ptr_nw_stat->estimate(), rho/(1-rho));
+	check_close("Waiting time", ptr_wt_stat->estimate(), rho/(mu-lambda));
+	check_close("Response time", ptr_rt_stat->estimate(), 1/(mu-lambda));
+}
+
+} // Namespace <unnamed>
+
+
+int main()
+{
+	test_mm1(0.3, 1);
+	test_mm1(0.5, 1);
+	test_mm1(0.7, 1);
+
+	return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}